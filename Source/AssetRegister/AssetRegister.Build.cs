@@ -25,7 +25,7 @@ public class AssetRegister : ModuleRules
 		PublicDependencyModuleNames.AddRange(
 			new string[]
 			{
-				"Core", "HTTP", "Json", "JsonUtilities", "DeveloperSettings"
+				"Core", "HTTP", "Json", "JsonUtilities", "DeveloperSettings", "Engine"
 				// ... add other public dependencies that you statically link with here ...
 			}
 			);
@@ -35,7 +35,6 @@ public class AssetRegister : ModuleRules
 			new string[]
 			{
 				"CoreUObject",
-				"Engine",
 				"Slate",
 				"SlateCore",
 				// ... add private dependencies that you statically link with here ...	
@@ -43,6 +42,13 @@ public class AssetRegister : ModuleRules
 			);
 		
 		
+		// FAssetRegisterMockServer and the tests using it are only compiled with WITH_DEV_AUTOMATION_TESTS
+		if (Target.bForceCompileDevelopmentAutomationTests
+			|| (Target.Configuration != UnrealTargetConfiguration.Shipping && Target.Configuration != UnrealTargetConfiguration.Test))
+		{
+			PrivateDependencyModuleNames.Add("HTTPServer");
+		}
+		
 		DynamicallyLoadedModuleNames.AddRange(
 			new string[]
 			{
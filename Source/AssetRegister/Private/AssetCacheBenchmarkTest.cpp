@@ -0,0 +1,146 @@
+#include "AssetRegisterAssetCache.h"
+#include "AssetRegisterLog.h"
+#include "AssetRegisterQueryingLibrary.h"
+#include "AssetRegisterSettings.h"
+#include "Async/ParallelFor.h"
+#include "Misc/AutomationTest.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(AssetCacheBenchmarkTest,
+								"UBFEmergenceDemo.sdk_unreal_asset_register.Source.AssetRegister.Private.AssetCacheBenchmarkTest",
+								EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+namespace AssetCacheBenchmark
+{
+	constexpr int32 NumAssets = 10000;
+	constexpr int32 NumLookups = 200000;
+	const TCHAR* CollectionId = TEXT("7668:root:1124");
+
+	FAsset MakeAsset(int32 Index)
+	{
+		FAsset Asset;
+		Asset.CollectionId = CollectionId;
+		Asset.TokenId = FString::FromInt(Index);
+		Asset.Profiles.Add(TEXT("asset-profile"), FString::Printf(TEXT("https://example.com/profiles/%d.json"), Index));
+		return Asset;
+	}
+
+	/** An asset selection of the given top level fields. */
+	TSharedRef<IQueryNode> MakeSelection(std::initializer_list<const TCHAR*> FieldNames)
+	{
+		TSharedRef<IQueryNode> Selection = MakeShared<IQueryNode>(TEXT("asset"));
+		for (const TCHAR* FieldName : FieldNames)
+		{
+			Selection->AddChild(MakeShared<IQueryNode>(FieldName));
+		}
+		return Selection;
+	}
+}
+
+/**
+ * Checks the hit/miss/eviction behaviour of FAssetRegisterAssetCache and measures the cost of its hit path,
+ * both directly and through GetAssetProfile, which completes without a request when the asset is cached.
+ */
+bool AssetCacheBenchmarkTest::RunTest(const FString& Parameters)
+{
+	using namespace AssetCacheBenchmark;
+
+	UAssetRegisterSettings* Settings = GetMutableDefault<UAssetRegisterSettings>();
+	const bool bOriginalEnableAssetCache = Settings->bEnableAssetCache;
+	const int32 OriginalMemoryBudget = Settings->AssetCacheMemoryBudget;
+	Settings->bEnableAssetCache = true;
+	Settings->AssetCacheMemoryBudget = 64;
+
+	const TSharedRef<IQueryNode> Profiles = MakeSelection({TEXT("profiles")});
+	const TSharedRef<IQueryNode> Metadata = MakeSelection({TEXT("metadata")});
+	const TSharedRef<IQueryNode> Links = MakeSelection({TEXT("links")});
+
+	FAssetRegisterAssetCache& Cache = FAssetRegisterAssetCache::Get();
+	Cache.Clear();
+	const FAssetRegisterAssetCacheStats StartStats = Cache.GetStats();
+
+	for (int32 Index = 0; Index < NumAssets; ++Index)
+	{
+		Cache.Add(MakeAsset(Index), *Profiles);
+	}
+	TestEqual(TEXT("All assets should be cached"), Cache.GetStats().NumEntries, NumAssets);
+
+	FAsset Asset;
+	TestTrue(TEXT("Cached profiles should be found"), Cache.Find(FAssetRegisterAssetKey(CollectionId, TEXT("42")), *Profiles, Asset));
+	TestEqual(TEXT("Cached asset should keep its profiles"), Asset.Profiles.FindRef(TEXT("asset-profile")), FString(TEXT("https://example.com/profiles/42.json")));
+	TestFalse(TEXT("Fields that were never fetched should miss"), Cache.Find(FAssetRegisterAssetKey(CollectionId, TEXT("42")), *Links, Asset));
+	TestFalse(TEXT("Unknown assets should miss"), Cache.Find(FAssetRegisterAssetKey(CollectionId, TEXT("-1")), *Profiles, Asset));
+
+	FAsset MetadataOnly;
+	MetadataOnly.CollectionId = CollectionId;
+	MetadataOnly.TokenId = TEXT("42");
+	MetadataOnly.Metadata.Id = TEXT("metadata-42");
+	Cache.Add(MetadataOnly, *Metadata);
+	TestTrue(TEXT("Merged entry should hold both field groups"),
+		Cache.Find(FAssetRegisterAssetKey(CollectionId, TEXT("42")), *MakeSelection({TEXT("profiles"), TEXT("metadata")}), Asset));
+	TestEqual(TEXT("Merged entry should keep the earlier profiles"), Asset.Profiles.Num(), 1);
+	TestEqual(TEXT("Merged entry should take the new metadata"), Asset.Metadata.Id, FString(TEXT("metadata-42")));
+
+	// single thread hit path
+	double StartTime = FPlatformTime::Seconds();
+	int32 NumHits = 0;
+	for (int32 Lookup = 0; Lookup < NumLookups; ++Lookup)
+	{
+		NumHits += Cache.Find(FAssetRegisterAssetKey(CollectionId, FString::FromInt(Lookup % NumAssets)), *Profiles, Asset) ? 1 : 0;
+	}
+	const double SingleThreadSeconds = FPlatformTime::Seconds() - StartTime;
+	TestEqual(TEXT("Every single thread lookup should hit"), NumHits, NumLookups);
+
+	// contended hit path, spread over the shards
+	std::atomic<int32> NumParallelHits = 0;
+	StartTime = FPlatformTime::Seconds();
+	ParallelFor(NumLookups, [&Cache, &Profiles, &NumParallelHits](int32 Lookup)
+	{
+		FAsset ParallelAsset;
+		if (Cache.Find(FAssetRegisterAssetKey(CollectionId, FString::FromInt(Lookup % NumAssets)), *Profiles, ParallelAsset))
+		{
+			++NumParallelHits;
+		}
+	});
+	const double ParallelSeconds = FPlatformTime::Seconds() - StartTime;
+	TestEqual(TEXT("Every parallel lookup should hit"), NumParallelHits.load(), NumLookups);
+
+	// end to end through the querying library
+	constexpr int32 NumProfileLookups = 10000;
+	int32 NumReady = 0;
+	StartTime = FPlatformTime::Seconds();
+	for (int32 Lookup = 0; Lookup < NumProfileLookups; ++Lookup)
+	{
+		TFuture<FLoadJsonResult> Future = UAssetRegisterQueryingLibrary::GetAssetProfile(FString::FromInt(Lookup % NumAssets), CollectionId);
+		NumReady += Future.IsReady() && Future.Get().bSuccess ? 1 : 0;
+	}
+	const double ProfileSeconds = FPlatformTime::Seconds() - StartTime;
+	TestEqual(TEXT("Cached GetAssetProfile calls should complete without a request"), NumReady, NumProfileLookups);
+
+	UE_LOG(LogAssetRegister, Display, TEXT("[AssetCacheBenchmark] Find: %.0f ns/op single thread, %.0f ns/op parallel. GetAssetProfile hit: %.0f ns/op"),
+		SingleThreadSeconds * 1e9 / NumLookups, ParallelSeconds * 1e9 / NumLookups, ProfileSeconds * 1e9 / NumProfileLookups);
+
+	// a budget far below what 10k assets take up has to evict the least recently used ones
+	Cache.Clear();
+	Settings->AssetCacheMemoryBudget = 1;
+	const uint64 EvictionsBefore = Cache.GetStats().Evictions;
+	for (int32 Index = 0; Index < NumAssets; ++Index)
+	{
+		Cache.Add(MakeAsset(Index), *Profiles);
+	}
+	const FAssetRegisterAssetCacheStats Stats = Cache.GetStats();
+	TestTrue(TEXT("Cache should stay within its memory budget"), Stats.MemoryUsed <= 1024 * 1024);
+	TestTrue(TEXT("Cache should have evicted assets"), Stats.Evictions > EvictionsBefore);
+	TestTrue(TEXT("Most recently added asset should still be cached"),
+		Cache.Find(FAssetRegisterAssetKey(CollectionId, FString::FromInt(NumAssets - 1)), *Profiles, Asset));
+	TestFalse(TEXT("First added asset should have been evicted"),
+		Cache.Find(FAssetRegisterAssetKey(CollectionId, TEXT("0")), *Profiles, Asset));
+
+	UE_LOG(LogAssetRegister, Display, TEXT("[AssetCacheBenchmark] hits %llu misses %llu evictions %llu, %d entries using %lld bytes"),
+		Stats.Hits - StartStats.Hits, Stats.Misses - StartStats.Misses, Stats.Evictions - StartStats.Evictions, Stats.NumEntries, Stats.MemoryUsed);
+
+	Cache.Clear();
+	Settings->bEnableAssetCache = bOriginalEnableAssetCache;
+	Settings->AssetCacheMemoryBudget = OriginalMemoryBudget;
+
+	return true;
+}
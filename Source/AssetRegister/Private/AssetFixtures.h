@@ -0,0 +1,136 @@
+#pragma once
+
+#include "AssetRegisterQueryingLibrary.h"
+#include "Schemas/Unions/NFTAssetLink.h"
+#include "Schemas/Unions/NFTAssetOwnership.h"
+
+/**
+ * Generated assets for tests and benchmarks, shaped like what GetAssets decodes.
+ */
+namespace AssetFixtures
+{
+	inline const TCHAR* CollectionId = TEXT("7668:root:1124");
+	inline const TCHAR* OwnerAddress = TEXT("0xffffffff00000000000000000000000000000f59");
+
+	inline FString MakeCursor(int32 Index)
+	{
+		return FString::Printf(TEXT("cursor-%d"), Index);
+	}
+
+	inline FAsset MakeAsset(int32 Index)
+	{
+		FAsset Asset;
+		Asset.CollectionId = CollectionId;
+		Asset.TokenId = FString::FromInt(Index);
+		Asset.AssetType = EAssetType::ERC721;
+		Asset.Profiles.Add(TEXT("asset-profile"), FString::Printf(TEXT("https://example.com/profiles/%d.json"), Index));
+
+		Asset.Collection.ChainId = TEXT("7668");
+		Asset.Collection.ChainType = TEXT("root");
+		Asset.Collection.Location = TEXT("1124");
+		Asset.Collection.Name = TEXT("Fixture Collection");
+
+		Asset.Metadata.Attributes.Add(TEXT("rarity"), Index % 10 == 0 ? TEXT("rare") : TEXT("common"));
+		FRawAttributes& RawAttribute = Asset.Metadata.RawAttributes.AddDefaulted_GetRef();
+		RawAttribute.Trait_type = TEXT("level");
+		RawAttribute.Value = FString::FromInt(Index % 7);
+		Asset.Metadata.Properties.JsonObjectFromString(FString::Printf(TEXT(R"({"name":"Fixture #%d","image":"https://example.com/images/%d.png"})"), Index, Index));
+
+		UNFTAssetOwnershipObject* Ownership = NewObject<UNFTAssetOwnershipObject>();
+		Ownership->Data.Owner.Address = OwnerAddress;
+		Asset.OwnershipWrapper.Ownership = Ownership;
+
+		return Asset;
+	}
+
+	/** Links Asset to NumChildren children with the token ids following its own. */
+	inline void AddChildLinks(FAsset& Asset, int32 NumChildren)
+	{
+		UNFTAssetLinkObject* Links = NewObject<UNFTAssetLinkObject>();
+		const int32 TokenId = FCString::Atoi(*Asset.TokenId);
+		for (int32 Child = 1; Child <= NumChildren; ++Child)
+		{
+			FLink& Link = Links->Data.ChildLinks.AddDefaulted_GetRef();
+			Link.Path = FString::Printf(TEXT("equipped_%d"), Child);
+			Link.Asset.CollectionId = Asset.CollectionId;
+			Link.Asset.TokenId = FString::FromInt(TokenId + Child);
+		}
+		Asset.LinkWrapper.Links = Links;
+	}
+
+	/**
+	 * The json of MakeAsset(Index) as the server returns it, with NumChildLinks links (see AddChildLinks) and the
+	 * metadata, profile and ownership fields a full selection has.
+	 */
+	inline FString MakeAssetJson(int32 Index, int32 NumChildLinks)
+	{
+		FString ChildLinks;
+		for (int32 Child = 1; Child <= NumChildLinks; ++Child)
+		{
+			ChildLinks += FString::Printf(TEXT(R"(%s{"path":"%s:%d#equipped_%d_accessory","asset":{"collectionId":"%s","tokenId":"%d"}})"),
+				Child > 1 ? TEXT(",") : TEXT(""), CollectionId, Index, Child, CollectionId, Index + Child);
+		}
+
+		return FString::Printf(TEXT(R"({"tokenId":"%d","collectionId":"%s","assetType":"ERC721",)"
+			R"("collection":{"chainId":"7668","chainType":"root","location":"1124","name":"Fixture Collection"},)"
+			R"("profiles":{"asset-profile":"https://example.com/profiles/%d.json"},)"
+			R"("metadata":{"attributes":{"rarity":"%s"},"rawAttributes":[{"trait_type":"level","value":"%d"}],)"
+			R"("properties":{"name":"Fixture #%d","image":"https://example.com/images/%d.png"}},)"
+			R"("ownership":{"owner":{"address":"%s"}},)"
+			R"("links":{"childLinks":[%s]}})"),
+			Index, CollectionId, Index, Index % 10 == 0 ? TEXT("rare") : TEXT("common"), Index % 7, Index, Index, OwnerAddress, *ChildLinks);
+	}
+
+	/** The json of assets 0 to NumAssets - 1, to serve with FAssetRegisterMockServer::SetAssets. */
+	inline TArray<FString> MakeAssetJsons(int32 NumAssets, int32 NumChildLinks)
+	{
+		TArray<FString> AssetJsons;
+		AssetJsons.Reserve(NumAssets);
+		for (int32 Index = 0; Index < NumAssets; ++Index)
+		{
+			AssetJsons.Add(MakeAssetJson(Index, NumChildLinks));
+		}
+		return AssetJsons;
+	}
+
+	/** A MakeAssetQuery response for asset Index. */
+	inline FString MakeAssetResponseJson(int32 Index, int32 NumChildLinks)
+	{
+		return FString::Printf(TEXT(R"({"data":{"asset":%s}})"), *MakeAssetJson(Index, NumChildLinks));
+	}
+
+	/** A MakeAssetsQuery response for the first page, of NumEdges assets, of an inventory of Total assets. */
+	inline FString MakeAssetsResponseJson(int32 NumEdges, int32 NumChildLinks, int32 Total)
+	{
+		TStringBuilder<1024> Edges;
+		for (int32 Index = 0; Index < NumEdges; ++Index)
+		{
+			Edges << (Index > 0 ? TEXT(",") : TEXT("")) << TEXT(R"({"cursor":")") << MakeCursor(Index) << TEXT(R"(","node":)")
+				<< MakeAssetJson(Index, NumChildLinks) << TEXT("}");
+		}
+
+		return FString::Printf(TEXT(R"({"data":{"assets":{"edges":[%s],"pageInfo":{"endCursor":"%s","hasNextPage":%s},"total":%d}}})"),
+			Edges.ToString(), *MakeCursor(NumEdges - 1), NumEdges < Total ? TEXT("true") : TEXT("false"), Total);
+	}
+
+	/** The page starting at FirstIndex of an inventory of Total assets. */
+	inline FAssets MakePage(int32 FirstIndex, int32 PageSize, int32 Total)
+	{
+		FAssets Page;
+		Page.Total = Total;
+
+		const int32 EndIndex = FMath::Min(FirstIndex + PageSize, Total);
+		for (int32 Index = FirstIndex; Index < EndIndex; ++Index)
+		{
+			FAssetEdge& Edge = Page.Edges.AddDefaulted_GetRef();
+			Edge.Cursor = MakeCursor(Index);
+			Edge.Node = MakeAsset(Index);
+		}
+
+		Page.PageInfo.StartCursor = MakeCursor(FirstIndex);
+		Page.PageInfo.EndCursor = MakeCursor(EndIndex - 1);
+		Page.PageInfo.HasPreviousPage = FirstIndex > 0;
+		Page.PageInfo.HasNextPage = EndIndex < Total;
+		return Page;
+	}
+}
@@ -70,6 +70,17 @@ bool AssetQueryGenerationTest::RunTest(const FString& Parameters)
 		QueryTestUtil::RemoveAllWhitespace(AssetQuery->GetQueryString()),
 		QueryTestUtil::RemoveAllWhitespace(ExpectedQueryString));
 
+	// the UTF-8 body is written compact and the TCHAR one pretty printed, so compare the queries they carry
+	const TSharedPtr<FJsonObject> QueryJsonUtf8 = QueryStringUtil::ParseJsonUtf8(AssetQuery->GetQueryJsonUtf8());
+	TSharedPtr<FJsonObject> QueryJson;
+	FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(AssetQuery->GetQueryJsonString()), QueryJson);
+	if (TestTrue(TEXT("Both query jsons should parse"), QueryJsonUtf8.IsValid() && QueryJson.IsValid()))
+	{
+		TestEqual(TEXT("UTF-8 query json should carry the same query as the TCHAR query json"),
+			QueryJsonUtf8->GetStringField(TEXT("query")),
+			QueryJson->GetStringField(TEXT("query")));
+	}
+
 	bool bHttpRequestCompleted = false;
 	UAssetRegisterQueryingLibrary::MakeAssetQuery(AssetQuery->GetQueryJsonString()).Next([this, &bHttpRequestCompleted]
 		(const FLoadAssetResult& Result)
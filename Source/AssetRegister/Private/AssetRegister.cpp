@@ -2,17 +2,50 @@
 
 #include "AssetRegister.h"
 
+#include "AssetRegisterCapture.h"
+#include "AssetRegisterCompletionQueue.h"
+#include "AssetRegisterDiskCache.h"
+#include "AssetRegisterSettings.h"
+#include "AssetRegisterTransport.h"
+#include "Misc/CommandLine.h"
+#include "Misc/Parse.h"
+
 #define LOCTEXT_NAMESPACE "FAssetRegisterModule"
 
 void FAssetRegisterModule::StartupModule()
 {
 	// This code will execute after your module is loaded into memory; the exact timing is specified in the .uplugin file per-module
+	const UAssetRegisterSettings* Settings = GetDefault<UAssetRegisterSettings>();
+	if (Settings && Settings->bUseMultiplexedConnection && !IsRunningCommandlet())
+	{
+		FAssetRegisterTransport::Preconnect();
+	}
+
+	if (Settings && Settings->bEnableDiskCache)
+	{
+		FAssetRegisterDiskCache::Get().Open(FAssetRegisterDiskCache::GetDefaultPath());
+	}
+
+	FString CapturePath;
+	if (FParse::Value(FCommandLine::Get(), TEXT("AssetRegisterCapture="), CapturePath))
+	{
+		FAssetRegisterRecorder::Get().Start();
+	}
 }
 
 void FAssetRegisterModule::ShutdownModule()
 {
 	// This function may be called during shutdown to clean up your module.  For modules that support dynamic reloading,
 	// we call this function before unloading the module.
+	// queued promises would be destroyed unset otherwise
+	FAssetRegisterCompletionQueue::Get().Flush();
+	FAssetRegisterDiskCache::Get().Close();
+
+	FString CapturePath;
+	if (FAssetRegisterRecorder::Get().IsRecording() && FParse::Value(FCommandLine::Get(), TEXT("AssetRegisterCapture="), CapturePath))
+	{
+		FAssetRegisterRecorder::Get().Stop().SaveToFile(CapturePath);
+	}
 }
 
 #undef LOCTEXT_NAMESPACE
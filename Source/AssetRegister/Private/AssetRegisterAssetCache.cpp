@@ -0,0 +1,418 @@
+// Copyright (c) 2025, Futureverse Corporation Limited. All rights reserved.
+
+#include "AssetRegisterAssetCache.h"
+
+#include "AssetRegisterGCUtil.h"
+#include "AssetRegisterSettings.h"
+#include "Schemas/Unions/NFTAssetLink.h"
+#include "Schemas/Unions/NFTAssetOwnership.h"
+
+namespace AssetRegisterAssetCache
+{
+	int64 EstimateMemoryUsage(const FString& String)
+	{
+		return String.GetAllocatedSize();
+	}
+
+	int64 EstimateMemoryUsage(const TSharedPtr<FJsonValue>& Value);
+
+	int64 EstimateMemoryUsage(const TSharedPtr<FJsonObject>& Object)
+	{
+		if (!Object.IsValid())
+		{
+			return 0;
+		}
+
+		int64 Size = sizeof(FJsonObject) + Object->Values.GetAllocatedSize();
+		for (const auto& Pair : Object->Values)
+		{
+			Size += EstimateMemoryUsage(Pair.Key) + EstimateMemoryUsage(Pair.Value);
+		}
+		return Size;
+	}
+
+	int64 EstimateMemoryUsage(const TSharedPtr<FJsonValue>& Value)
+	{
+		if (!Value.IsValid())
+		{
+			return 0;
+		}
+
+		switch (Value->Type)
+		{
+		case EJson::String:
+			return sizeof(FJsonValueString) + Value->AsString().GetAllocatedSize();
+		case EJson::Array:
+			{
+				const TArray<TSharedPtr<FJsonValue>>& Array = Value->AsArray();
+				int64 Size = sizeof(FJsonValueArray) + Array.GetAllocatedSize();
+				for (const TSharedPtr<FJsonValue>& Element : Array)
+				{
+					Size += EstimateMemoryUsage(Element);
+				}
+				return Size;
+			}
+		case EJson::Object:
+			return sizeof(FJsonValueObject) + EstimateMemoryUsage(Value->AsObject());
+		default:
+			return sizeof(FJsonValueNumber);
+		}
+	}
+
+	int64 EstimateMemoryUsage(const TMap<FString, FString>& Map)
+	{
+		int64 Size = Map.GetAllocatedSize();
+		for (const auto& Pair : Map)
+		{
+			Size += EstimateMemoryUsage(Pair.Key) + EstimateMemoryUsage(Pair.Value);
+		}
+		return Size;
+	}
+}
+
+FAssetRegisterAssetCache& FAssetRegisterAssetCache::Get()
+{
+	static FAssetRegisterAssetCache Cache;
+	return Cache;
+}
+
+FAssetRegisterAssetCache::FAssetRegisterAssetCache()
+{
+}
+
+bool FAssetRegisterAssetCache::Find(const FAssetRegisterAssetKey& Key, const IQueryNode& Selection, FAsset& OutAsset,
+	TSharedPtr<const IQueryNode>* OutKnownSelection, double* OutAge)
+{
+	const UAssetRegisterSettings* Settings = GetDefault<UAssetRegisterSettings>();
+	if (!Settings || !Settings->bEnableAssetCache)
+	{
+		return false;
+	}
+
+	FShard& Shard = GetShard(Key);
+	FScopeLock Lock(&Shard.CriticalSection);
+
+	const int32* Index = Shard.Lookup.Find(Key);
+	if (!Index)
+	{
+		++Misses;
+		return false;
+	}
+
+	FEntry& Entry = Shard.Entries[*Index];
+	if (Entry.ExpiresAt <= FPlatformTime::Seconds())
+	{
+		RemoveEntry(Shard, *Index);
+		++Expirations;
+		++Misses;
+		return false;
+	}
+
+	Unlink(Shard, *Index);
+	LinkAsNewest(Shard, *Index);
+
+	if (OutAge)
+	{
+		double FetchedAt = FPlatformTime::Seconds();
+		for (const auto& ChildPair : Selection.GetChildren())
+		{
+			if (const double* FieldFetchedAt = Entry.FetchedAt.Find(ChildPair.Key))
+			{
+				FetchedAt = FMath::Min(FetchedAt, *FieldFetchedAt);
+			}
+		}
+		*OutAge = FPlatformTime::Seconds() - FetchedAt;
+	}
+
+	if (!Entry.Selection->CoversSelection(Selection))
+	{
+		++PartialHits;
+		if (OutKnownSelection)
+		{
+			*OutKnownSelection = Entry.Selection;
+			OutAsset = Entry.Asset;
+		}
+		return false;
+	}
+
+	OutAsset = Entry.Asset;
+	++Hits;
+	return true;
+}
+
+void FAssetRegisterAssetCache::Add(const FAsset& Asset, const IQueryNode& Selection, double Age)
+{
+	const UAssetRegisterSettings* Settings = GetDefault<UAssetRegisterSettings>();
+	if (!Settings || !Settings->bEnableAssetCache)
+	{
+		return;
+	}
+
+	const FAssetRegisterAssetKey Key(Asset);
+	if (!ensureMsgf(Key.IsValid(), TEXT("FAssetRegisterAssetCache::Add asset needs a CollectionId and TokenId")))
+	{
+		return;
+	}
+
+	const double Now = FPlatformTime::Seconds();
+	const double FetchedAt = Now - Age;
+	const int64 ShardBudget = static_cast<int64>(Settings->AssetCacheMemoryBudget) * 1024 * 1024 / NumShards;
+
+	FShard& Shard = GetShard(Key);
+	FScopeLock Lock(&Shard.CriticalSection);
+
+	int32 Index;
+	if (const int32* ExistingIndex = Shard.Lookup.Find(Key))
+	{
+		Index = *ExistingIndex;
+		FEntry& Entry = Shard.Entries[Index];
+		Shard.MemoryUsed -= Entry.MemoryUsage;
+		Unlink(Shard, Index);
+
+		if (Entry.ExpiresAt <= Now)
+		{
+			Entry.Asset = Asset;
+			Entry.Selection = MakeSelection(Selection);
+			Entry.FetchedAt.Reset();
+		}
+		else
+		{
+			CopyFields(Asset, Entry.Asset, Selection);
+			TSharedRef<IQueryNode> MergedSelection = Entry.Selection->CloneNode();
+			MergedSelection->MergeSelection(Selection);
+			Entry.Selection = MergedSelection;
+		}
+	}
+	else
+	{
+		FEntry NewEntry;
+		NewEntry.Key = Key;
+		NewEntry.Asset = Asset;
+		NewEntry.Selection = MakeSelection(Selection);
+
+		Index = Shard.Entries.Add(MoveTemp(NewEntry));
+		Shard.Lookup.Add(Key, Index);
+	}
+
+	FEntry& Entry = Shard.Entries[Index];
+	SetFetchedAt(Entry, Selection, FetchedAt);
+
+	// the entry expires with its oldest field, so fields cached earlier keep their schedule and a refetch of all of
+	// them pushes the expiry out
+	double OldestFetchedAt = Entry.FetchedAt.IsEmpty() ? FetchedAt : TNumericLimits<double>::Max();
+	for (const TPair<FString, double>& FieldFetchedAt : Entry.FetchedAt)
+	{
+		OldestFetchedAt = FMath::Min(OldestFetchedAt, FieldFetchedAt.Value);
+	}
+	Entry.ExpiresAt = OldestFetchedAt + Settings->AssetCacheTimeToLive;
+	Entry.MemoryUsage = EstimateMemoryUsage(Entry.Asset);
+	Shard.MemoryUsed += Entry.MemoryUsage;
+	LinkAsNewest(Shard, Index);
+
+	while (Shard.MemoryUsed > ShardBudget && Shard.Oldest != Index)
+	{
+		RemoveEntry(Shard, Shard.Oldest);
+		++Evictions;
+	}
+}
+
+void FAssetRegisterAssetCache::Remove(const FAssetRegisterAssetKey& Key)
+{
+	FShard& Shard = GetShard(Key);
+	FScopeLock Lock(&Shard.CriticalSection);
+
+	if (const int32* Index = Shard.Lookup.Find(Key))
+	{
+		RemoveEntry(Shard, *Index);
+	}
+}
+
+void FAssetRegisterAssetCache::Clear()
+{
+	for (FShard& Shard : Shards)
+	{
+		FScopeLock Lock(&Shard.CriticalSection);
+		Shard.Lookup.Empty();
+		Shard.Entries.Empty();
+		Shard.Newest = INDEX_NONE;
+		Shard.Oldest = INDEX_NONE;
+		Shard.MemoryUsed = 0;
+	}
+}
+
+FAssetRegisterAssetCacheStats FAssetRegisterAssetCache::GetStats() const
+{
+	FAssetRegisterAssetCacheStats Stats;
+	Stats.Hits = Hits;
+	Stats.PartialHits = PartialHits;
+	Stats.Misses = Misses;
+	Stats.Evictions = Evictions;
+	Stats.Expirations = Expirations;
+
+	for (const FShard& Shard : Shards)
+	{
+		FScopeLock Lock(&Shard.CriticalSection);
+		Stats.NumEntries += Shard.Lookup.Num();
+		Stats.MemoryUsed += Shard.MemoryUsed;
+	}
+	return Stats;
+}
+
+void FAssetRegisterAssetCache::AddReferencedObjects(FReferenceCollector& Collector)
+{
+	for (FShard& Shard : Shards)
+	{
+		FScopeLock Lock(&Shard.CriticalSection);
+		for (FEntry& Entry : Shard.Entries)
+		{
+			AssetRegisterGCUtil::AddReferencedObjects(Collector, Entry.Asset);
+		}
+	}
+}
+
+FString FAssetRegisterAssetCache::GetReferencerName() const
+{
+	return TEXT("FAssetRegisterAssetCache");
+}
+
+int64 FAssetRegisterAssetCache::EstimateMemoryUsage(const FAsset& Asset)
+{
+	using namespace AssetRegisterAssetCache;
+
+	int64 Size = sizeof(FEntry) + sizeof(FAssetRegisterAssetKey) + sizeof(int32)
+		+ 2 * (EstimateMemoryUsage(Asset.CollectionId) + EstimateMemoryUsage(Asset.TokenId))
+		+ EstimateMemoryUsage(Asset.Id)
+		+ EstimateMemoryUsage(Asset.Collection.ChainId) + EstimateMemoryUsage(Asset.Collection.ChainType)
+		+ EstimateMemoryUsage(Asset.Collection.Id) + EstimateMemoryUsage(Asset.Collection.Location)
+		+ EstimateMemoryUsage(Asset.Collection.Name)
+		+ EstimateMemoryUsage(Asset.Profiles)
+		+ EstimateMemoryUsage(Asset.Metadata.Id) + EstimateMemoryUsage(Asset.Metadata.Uri)
+		+ EstimateMemoryUsage(Asset.Metadata.Attributes)
+		+ EstimateMemoryUsage(Asset.Metadata.Properties.JsonObject)
+		+ EstimateMemoryUsage(Asset.OriginalJsonData.JsonObject);
+
+	Size += Asset.Metadata.RawAttributes.GetAllocatedSize();
+	for (const FRawAttributes& RawAttribute : Asset.Metadata.RawAttributes)
+	{
+		Size += EstimateMemoryUsage(RawAttribute.Value) + EstimateMemoryUsage(RawAttribute.Trait_type);
+	}
+
+	if (const UNFTAssetOwnershipObject* Ownership = Cast<UNFTAssetOwnershipObject>(Asset.OwnershipWrapper.Ownership))
+	{
+		Size += sizeof(UNFTAssetOwnershipObject) + EstimateMemoryUsage(Ownership->Data.Owner.Address);
+	}
+
+	if (const UNFTAssetLinkObject* Links = Cast<UNFTAssetLinkObject>(Asset.LinkWrapper.Links))
+	{
+		Size += sizeof(UNFTAssetLinkObject) + Links->Data.ChildLinks.GetAllocatedSize();
+		for (const FLink& ChildLink : Links->Data.ChildLinks)
+		{
+			Size += EstimateMemoryUsage(ChildLink.Path)
+				+ EstimateMemoryUsage(ChildLink.Asset.CollectionId) + EstimateMemoryUsage(ChildLink.Asset.TokenId);
+		}
+	}
+
+	return Size;
+}
+
+void FAssetRegisterAssetCache::CopyFields(const FAsset& Source, FAsset& Target, const IQueryNode& Selection)
+{
+	for (const auto& ChildPair : Selection.GetChildren())
+	{
+		const FString& FieldName = ChildPair.Key;
+
+		// links and ownership are decoded into their wrappers
+		if (FieldName == TEXT("links"))
+		{
+			Target.LinkWrapper = Source.LinkWrapper;
+			Target.Links = Source.Links;
+		}
+		else if (FieldName == TEXT("ownership"))
+		{
+			Target.OwnershipWrapper = Source.OwnershipWrapper;
+			Target.Ownership = Source.Ownership;
+		}
+		else if (const FProperty* Property = FAsset::StaticStruct()->FindPropertyByName(FName(*FieldName)))
+		{
+			Property->CopyCompleteValue_InContainer(&Target, &Source);
+		}
+	}
+}
+
+TSharedRef<const IQueryNode> FAssetRegisterAssetCache::MakeSelection(const IQueryNode& Selection)
+{
+	// the identity of a cached asset is always known
+	TSharedRef<IQueryNode> OutSelection = MakeShared<IQueryNode>(Selection.GetName());
+	OutSelection->AddChild(MakeShared<IQueryNode>(TEXT("collectionId")));
+	OutSelection->AddChild(MakeShared<IQueryNode>(TEXT("tokenId")));
+	OutSelection->MergeSelection(Selection);
+	return OutSelection;
+}
+
+FAssetRegisterAssetCache::FShard& FAssetRegisterAssetCache::GetShard(const FAssetRegisterAssetKey& Key)
+{
+	return Shards[GetTypeHash(Key) % NumShards];
+}
+
+void FAssetRegisterAssetCache::Unlink(FShard& Shard, int32 Index)
+{
+	FEntry& Entry = Shard.Entries[Index];
+
+	if (Entry.Newer != INDEX_NONE)
+	{
+		Shard.Entries[Entry.Newer].Older = Entry.Older;
+	}
+	else
+	{
+		Shard.Newest = Entry.Older;
+	}
+
+	if (Entry.Older != INDEX_NONE)
+	{
+		Shard.Entries[Entry.Older].Newer = Entry.Newer;
+	}
+	else
+	{
+		Shard.Oldest = Entry.Newer;
+	}
+
+	Entry.Newer = INDEX_NONE;
+	Entry.Older = INDEX_NONE;
+}
+
+void FAssetRegisterAssetCache::LinkAsNewest(FShard& Shard, int32 Index)
+{
+	FEntry& Entry = Shard.Entries[Index];
+	Entry.Older = Shard.Newest;
+	Entry.Newer = INDEX_NONE;
+
+	if (Shard.Newest != INDEX_NONE)
+	{
+		Shard.Entries[Shard.Newest].Newer = Index;
+	}
+	Shard.Newest = Index;
+
+	if (Shard.Oldest == INDEX_NONE)
+	{
+		Shard.Oldest = Index;
+	}
+}
+
+void FAssetRegisterAssetCache::RemoveEntry(FShard& Shard, int32 Index)
+{
+	Unlink(Shard, Index);
+
+	FEntry& Entry = Shard.Entries[Index];
+	Shard.MemoryUsed -= Entry.MemoryUsage;
+	Shard.Lookup.Remove(Entry.Key);
+	Shard.Entries.RemoveAt(Index);
+}
+
+void FAssetRegisterAssetCache::SetFetchedAt(FEntry& Entry, const IQueryNode& Selection, double FetchedAt)
+{
+	for (const auto& ChildPair : Selection.GetChildren())
+	{
+		double& FieldFetchedAt = Entry.FetchedAt.FindOrAdd(ChildPair.Key, FetchedAt);
+		FieldFetchedAt = FMath::Max(FieldFetchedAt, FetchedAt);
+	}
+}
@@ -0,0 +1,254 @@
+// Copyright (c) 2025, Futureverse Corporation Limited. All rights reserved.
+
+#include "AssetRegisterAssetStream.h"
+
+#include "AssetRegisterLog.h"
+#include "AssetRegisterPageSizeTuner.h"
+#include "AssetRegisterSettings.h"
+
+TSharedRef<FAssetRegisterAssetStream> FAssetRegisterAssetStream::Create(const FAssetConnection& AssetsInput, int32 MaxItems,
+	const FAssetRegisterDeadline& Deadline, int32 PrefetchDepth)
+{
+	if (PrefetchDepth == INDEX_NONE)
+	{
+		const UAssetRegisterSettings* Settings = GetDefault<UAssetRegisterSettings>();
+		PrefetchDepth = Settings ? Settings->PagePrefetchDepth : 0;
+	}
+	
+	return MakeShareable(new FAssetRegisterAssetStream(AssetsInput, MaxItems, Deadline, PrefetchDepth));
+}
+
+FAssetRegisterAssetStream::FAssetRegisterAssetStream(const FAssetConnection& InAssetsInput, int32 InMaxItems,
+	const FAssetRegisterDeadline& InDeadline, int32 InPrefetchDepth)
+	: AssetsInput(InAssetsInput)
+	, PageSize(InAssetsInput.First > 0 ? FMath::TruncToInt32(InAssetsInput.First) : 100)
+	, MaxItems(FMath::Max(InMaxItems, 0))
+	, Deadline(InDeadline)
+	, PrefetchDepth(FMath::Max(InPrefetchDepth, 0))
+	, After(InAssetsInput.After)
+{
+	const UAssetRegisterSettings* Settings = GetDefault<UAssetRegisterSettings>();
+	bAdaptivePageSize = Settings && Settings->bAdaptivePageSize;
+	if (bAdaptivePageSize)
+	{
+		QueryShape = FAssetRegisterPageSizeTuner::GetQueryShape(AssetsInput);
+	}
+}
+
+TFuture<FLoadAssetsResult> FAssetRegisterAssetStream::Next()
+{
+	if (bDone || bPending.exchange(true))
+	{
+		UE_LOG(LogAssetRegister, Warning, TEXT("FAssetRegisterAssetStream::Next called %s"),
+			bDone ? TEXT("after the last page") : TEXT("before the previous page completed"));
+		auto OutResult = FLoadAssetsResult();
+		OutResult.SetFailure();
+		return MakeFulfilledPromise<FLoadAssetsResult>(MoveTemp(OutResult)).GetFuture();
+	}
+
+	TFuture<FLoadAssetsResult> Future;
+	{
+		FScopeLock Lock(&CriticalSection);
+		Waiting = MakeShared<TPromise<FLoadAssetsResult>>();
+		Future = Waiting->GetFuture();
+		
+		// otherwise the page was prefetched and may already be loaded
+		if (Pages.IsEmpty())
+		{
+			RequestPageLocked(After, GetNextPageSizeLocked());
+		}
+	}
+
+	ReturnLoadedPage();
+	return Future;
+}
+
+void FAssetRegisterAssetStream::RequestPageLocked(const FString& PageAfter, int32 First)
+{
+	TSharedRef<FPage> Page = MakeShared<FPage>();
+	Page->First = First;
+	Page->RequestTime = FPlatformTime::Seconds();
+	Pages.Add(Page);
+
+	FAssetConnection PageInput = AssetsInput;
+	PageInput.After = PageAfter;
+	PageInput.First = First;
+
+	// the stream is kept alive until its requests complete, so a consumer doesn't have to hold on to it between pages
+	UAssetRegisterQueryingLibrary::GetAssets(PageInput, Deadline, [Stream = AsShared(), Page](const FPageInfo& PageInfo, int64 NumBytes)
+	{
+		Stream->OnPageInfo(Page, PageInfo, NumBytes);
+	}).Next([Stream = AsShared(), Page](FLoadAssetsResult Result)
+	{
+		Stream->OnPageLoaded(Page, MoveTemp(Result));
+	});
+}
+
+int32 FAssetRegisterAssetStream::GetNextPageSizeLocked() const
+{
+	const int32 NextPageSize = bAdaptivePageSize ? FAssetRegisterPageSizeTuner::Get().GetPageSize(QueryShape, PageSize) : PageSize;
+	if (MaxItems == 0)
+	{
+		return NextPageSize;
+	}
+
+	int32 NumRequested = NumItems;
+	for (const TSharedRef<FPage>& Page : Pages)
+	{
+		NumRequested += Page->First;
+	}
+	return FMath::Min(NextPageSize, MaxItems - NumRequested);
+}
+
+void FAssetRegisterAssetStream::PrefetchLocked()
+{
+	while (!bDone && !Pages.IsEmpty() && Pages.Num() <= PrefetchDepth)
+	{
+		const TSharedRef<FPage> Last = Pages.Last();
+		const bool bFailed = Last->Result.IsSet() && !Last->Result->bSuccess;
+		if (!Last->bPageInfoKnown || bFailed || !Last->PageInfo.HasNextPage || Last->PageInfo.EndCursor.IsEmpty())
+		{
+			return;
+		}
+
+		const int32 First = GetNextPageSizeLocked();
+		if (First <= 0)
+		{
+			return;
+		}
+		RequestPageLocked(Last->PageInfo.EndCursor, First);
+	}
+}
+
+void FAssetRegisterAssetStream::OnPageInfo(const TSharedRef<FPage>& Page, const FPageInfo& PageInfo, int64 NumBytes)
+{
+	FScopeLock Lock(&CriticalSection);
+	if (!Pages.Contains(Page) || Page->Result.IsSet())
+	{
+		return;
+	}
+
+	Page->DownloadedTime = FPlatformTime::Seconds();
+	Page->NumBytes = NumBytes;
+	Page->PageInfo = PageInfo;
+	Page->bPageInfoKnown = true;
+	PrefetchLocked();
+}
+
+void FAssetRegisterAssetStream::OnPageLoaded(const TSharedRef<FPage>& Page, FLoadAssetsResult&& Result)
+{
+	{
+		FScopeLock Lock(&CriticalSection);
+		if (!Pages.Contains(Page))
+		{
+			return;
+		}
+
+		if (Result.bSuccess)
+		{
+			const FPageInfo& PageInfo = Result.Value.PageInfo;
+			if (Page->bPageInfoKnown && (PageInfo.EndCursor != Page->PageInfo.EndCursor || PageInfo.HasNextPage != Page->PageInfo.HasNextPage))
+			{
+				UE_LOG(LogAssetRegister, Verbose, TEXT("FAssetRegisterAssetStream page info read ahead of decoding was wrong, requesting the next page again"));
+				DropPagesAfterLocked(Page);
+			}
+			Page->PageInfo = PageInfo;
+			Page->bPageInfoKnown = true;
+		}
+		else
+		{
+			DropPagesAfterLocked(Page);
+		}
+		
+		// pages served from a cache say nothing about the server, and running out of time isn't the page's fault
+		if (bAdaptivePageSize && (Page->DownloadedTime > 0.0 || !Result.bSuccess) && !Deadline.HasExpired())
+		{
+			const double Now = FPlatformTime::Seconds();
+			FAssetRegisterPageSample Sample;
+			Sample.bSuccess = Result.bSuccess;
+			Sample.NumItems = Result.Value.Edges.Num();
+			Sample.NumBytes = Page->NumBytes;
+			Sample.ResponseSeconds = Now - Page->RequestTime;
+			Sample.DecodeSeconds = Page->DownloadedTime > 0.0 ? Now - Page->DownloadedTime : 0.0;
+			FAssetRegisterPageSizeTuner::Get().ReportPage(QueryShape, Page->First, Sample);
+		}
+		
+		Page->Result = MoveTemp(Result);
+		PrefetchLocked();
+	}
+
+	ReturnLoadedPage();
+}
+
+void FAssetRegisterAssetStream::DropPagesAfterLocked(const TSharedRef<FPage>& Page)
+{
+	const int32 Index = Pages.Find(Page);
+	if (Index != INDEX_NONE)
+	{
+		// their requests still complete, but are ignored
+		Pages.SetNum(Index + 1);
+	}
+}
+
+void FAssetRegisterAssetStream::ReturnLoadedPage()
+{
+	TSharedPtr<TPromise<FLoadAssetsResult>> Promise;
+	FLoadAssetsResult Result;
+	{
+		FScopeLock Lock(&CriticalSection);
+		if (!Waiting.IsValid() || Pages.IsEmpty() || !Pages[0]->Result.IsSet())
+		{
+			return;
+		}
+
+		Result = MoveTemp(Pages[0]->Result.GetValue());
+		Pages.RemoveAt(0);
+		
+		if (Result.bSuccess)
+		{
+			FAssets& Page = Result.Value;
+			if (MaxItems > 0 && NumItems + Page.Edges.Num() > MaxItems)
+			{
+				Page.Edges.SetNum(MaxItems - NumItems);
+			}
+
+			++NumPages;
+			NumItems += Page.Edges.Num();
+
+			const bool bReachedMaxItems = MaxItems > 0 && NumItems >= MaxItems;
+			if (bReachedMaxItems || !Page.PageInfo.HasNextPage || Page.PageInfo.EndCursor.IsEmpty() || Page.Edges.IsEmpty())
+			{
+				bDone = true;
+				Pages.Empty();
+			}
+			else
+			{
+				After = Page.PageInfo.EndCursor;
+				PrefetchLocked();
+			}
+		}
+		else
+		{
+			UE_LOG(LogAssetRegister, Warning, TEXT("FAssetRegisterAssetStream::Next failed to get page %d"), NumPages.load());
+		}
+
+		Promise = MoveTemp(Waiting);
+		bPending = false;
+	}
+	
+	Promise->SetValue(MoveTemp(Result));
+}
+
+void UAssetRegisterAssetStream::RequestNextPage(const FGetAssetsPageCompleted& OnPage)
+{
+	if (!Stream.IsValid())
+	{
+		OnPage.ExecuteIfBound(false, false, FAssets());
+		return;
+	}
+
+	Stream->Next().Next([OnPage, Stream = Stream](const FLoadAssetsResult& Result)
+	{
+		OnPage.ExecuteIfBound(Result.bSuccess, Stream->HasNext(), Result.Value);
+	});
+}
@@ -0,0 +1,234 @@
+// Copyright (c) 2025, Futureverse Corporation Limited. All rights reserved.
+
+#include "AssetRegisterCapture.h"
+
+#include "AssetRegisterLog.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/Compression.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+namespace AssetRegisterCapture
+{
+	struct FFileHeader
+	{
+		uint32 Magic = 0;
+		uint32 Version = 0;
+		uint32 NumEntries = 0;
+		uint32 UncompressedSize = 0;
+		uint32 CompressedSize = 0;
+		uint32 Padding = 0;
+	};
+	static_assert(sizeof(FFileHeader) == 24);
+
+	void SaveCapture(const FString& Path, FOutputDevice& Ar)
+	{
+		const FAssetRegisterCapture Capture = FAssetRegisterRecorder::Get().Stop();
+		const FString OutputPath = Path.IsEmpty() ? FAssetRegisterCapture::MakeDefaultPath() : Path;
+		if (Capture.SaveToFile(OutputPath))
+		{
+			Ar.Logf(TEXT("AssetRegister capture of %d requests saved to %s"), Capture.Entries.Num(), *FPaths::ConvertRelativePathToFull(OutputPath));
+		}
+		else
+		{
+			Ar.Logf(TEXT("AssetRegister capture could not be saved to %s"), *OutputPath);
+		}
+	}
+
+	static FAutoConsoleCommandWithArgsAndOutputDevice CaptureCommand(
+		TEXT("ar.capture"),
+		TEXT("Records the Asset Register requests and responses for replay. 'ar.capture start' starts recording, ")
+		TEXT("'ar.capture stop [Path]' saves what was recorded."),
+		FConsoleCommandWithArgsAndOutputDeviceDelegate::CreateLambda([](const TArray<FString>& Args, FOutputDevice& Ar)
+		{
+			if (Args.Num() > 0 && Args[0] == TEXT("start"))
+			{
+				FAssetRegisterRecorder::Get().Start();
+				Ar.Log(TEXT("AssetRegister capture started"));
+			}
+			else if (Args.Num() > 0 && Args[0] == TEXT("stop"))
+			{
+				SaveCapture(Args.Num() > 1 ? Args[1] : FString(), Ar);
+			}
+			else
+			{
+				Ar.Logf(TEXT("AssetRegister capture is %s"), FAssetRegisterRecorder::Get().IsRecording() ? TEXT("recording") : TEXT("stopped"));
+			}
+		}));
+}
+
+FArchive& operator<<(FArchive& Ar, FAssetRegisterCaptureEntry& Entry)
+{
+	Ar << Entry.Context << Entry.SendTime << Entry.Duration << Entry.ResponseCode << Entry.ETag << Entry.LastModified;
+	Ar << Entry.RequestContent << Entry.ResponseContent;
+	return Ar;
+}
+
+FString FAssetRegisterCapture::MakeDefaultPath()
+{
+	return FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("AssetRegister"), TEXT("Captures"),
+		FString::Printf(TEXT("Capture-%s.arcap"), *FDateTime::UtcNow().ToString()));
+}
+
+bool FAssetRegisterCapture::SaveToFile(const FString& Path) const
+{
+	TArray<uint8> Uncompressed;
+	FMemoryWriter Writer(Uncompressed);
+	for (const FAssetRegisterCaptureEntry& Entry : Entries)
+	{
+		Writer << const_cast<FAssetRegisterCaptureEntry&>(Entry);
+	}
+
+	int32 CompressedSize = FCompression::CompressMemoryBound(NAME_Zlib, Uncompressed.Num());
+	TArray<uint8> File;
+	File.SetNumUninitialized(sizeof(AssetRegisterCapture::FFileHeader) + CompressedSize);
+	if (!FCompression::CompressMemory(NAME_Zlib, File.GetData() + sizeof(AssetRegisterCapture::FFileHeader), CompressedSize,
+		Uncompressed.GetData(), Uncompressed.Num()))
+	{
+		UE_LOG(LogAssetRegister, Warning, TEXT("FAssetRegisterCapture::SaveToFile failed to compress %d entries"), Entries.Num());
+		return false;
+	}
+	File.SetNum(sizeof(AssetRegisterCapture::FFileHeader) + CompressedSize);
+
+	AssetRegisterCapture::FFileHeader Header;
+	Header.Magic = FileMagic;
+	Header.Version = FileVersion;
+	Header.NumEntries = Entries.Num();
+	Header.UncompressedSize = Uncompressed.Num();
+	Header.CompressedSize = CompressedSize;
+	FMemory::Memcpy(File.GetData(), &Header, sizeof(Header));
+
+	if (!FFileHelper::SaveArrayToFile(File, *Path))
+	{
+		UE_LOG(LogAssetRegister, Warning, TEXT("FAssetRegisterCapture::SaveToFile failed to write %s"), *Path);
+		return false;
+	}
+	return true;
+}
+
+bool FAssetRegisterCapture::LoadFromFile(const FString& Path)
+{
+	Entries.Reset();
+
+	TArray<uint8> File;
+	if (!FFileHelper::LoadFileToArray(File, *Path))
+	{
+		UE_LOG(LogAssetRegister, Warning, TEXT("FAssetRegisterCapture::LoadFromFile failed to read %s"), *Path);
+		return false;
+	}
+
+	AssetRegisterCapture::FFileHeader Header;
+	if (File.Num() >= static_cast<int32>(sizeof(Header)))
+	{
+		FMemory::Memcpy(&Header, File.GetData(), sizeof(Header));
+	}
+
+	TArray<uint8> Uncompressed;
+	const bool bValidHeader = Header.Magic == FileMagic
+		&& Header.Version == FileVersion
+		&& Header.UncompressedSize <= static_cast<uint32>(MAX_int32)
+		&& Header.NumEntries <= Header.UncompressedSize
+		&& sizeof(Header) + Header.CompressedSize == static_cast<uint64>(File.Num());
+	if (bValidHeader)
+	{
+		Uncompressed.SetNumUninitialized(Header.UncompressedSize);
+	}
+	if (!bValidHeader || !FCompression::UncompressMemory(NAME_Zlib, Uncompressed.GetData(), Uncompressed.Num(),
+		File.GetData() + sizeof(Header), Header.CompressedSize))
+	{
+		UE_LOG(LogAssetRegister, Warning, TEXT("FAssetRegisterCapture::LoadFromFile %s is outdated or corrupt"), *Path);
+		return false;
+	}
+
+	FMemoryReader Reader(Uncompressed);
+	Entries.SetNum(Header.NumEntries);
+	for (FAssetRegisterCaptureEntry& Entry : Entries)
+	{
+		Reader << Entry;
+	}
+	if (Reader.IsError() || !Reader.AtEnd())
+	{
+		UE_LOG(LogAssetRegister, Warning, TEXT("FAssetRegisterCapture::LoadFromFile %s is corrupt"), *Path);
+		Entries.Reset();
+		return false;
+	}
+	return true;
+}
+
+int64 FAssetRegisterCapture::GetNumContentBytes() const
+{
+	int64 NumBytes = 0;
+	for (const FAssetRegisterCaptureEntry& Entry : Entries)
+	{
+		NumBytes += Entry.RequestContent.Num() + Entry.ResponseContent.Num();
+	}
+	return NumBytes;
+}
+
+FAssetRegisterRecorder& FAssetRegisterRecorder::Get()
+{
+	static FAssetRegisterRecorder Recorder;
+	return Recorder;
+}
+
+void FAssetRegisterRecorder::Start(int64 InMaxContentBytes)
+{
+	FScopeLock Lock(&CriticalSection);
+	Capture.Entries.Reset();
+	NumContentBytes = 0;
+	MaxContentBytes = InMaxContentBytes;
+	bDroppedEntries = false;
+	StartTime = FPlatformTime::Seconds();
+	bRecording = true;
+
+	UE_LOG(LogAssetRegister, Log, TEXT("FAssetRegisterRecorder::Start recording requests"));
+}
+
+FAssetRegisterCapture FAssetRegisterRecorder::Stop()
+{
+	FScopeLock Lock(&CriticalSection);
+	bRecording = false;
+	NumContentBytes = 0;
+
+	UE_LOG(LogAssetRegister, Log, TEXT("FAssetRegisterRecorder::Stop recorded %d requests"), Capture.Entries.Num());
+	return MoveTemp(Capture);
+}
+
+TSharedPtr<FAssetRegisterCaptureEntry> FAssetRegisterRecorder::BeginEntry(const TCHAR* Context, TConstArrayView<uint8> RequestContent) const
+{
+	if (!bRecording)
+	{
+		return nullptr;
+	}
+
+	TSharedPtr<FAssetRegisterCaptureEntry> Entry = MakeShared<FAssetRegisterCaptureEntry>();
+	Entry->Context = Context;
+	Entry->SendTime = FPlatformTime::Seconds() - StartTime;
+	Entry->RequestContent.Append(RequestContent.GetData(), RequestContent.Num());
+	return Entry;
+}
+
+void FAssetRegisterRecorder::Record(FAssetRegisterCaptureEntry&& Entry)
+{
+	FScopeLock Lock(&CriticalSection);
+	if (!bRecording)
+	{
+		return;
+	}
+
+	const int64 EntryBytes = Entry.RequestContent.Num() + Entry.ResponseContent.Num();
+	if (NumContentBytes + EntryBytes > MaxContentBytes)
+	{
+		if (!bDroppedEntries)
+		{
+			UE_LOG(LogAssetRegister, Warning, TEXT("FAssetRegisterRecorder::Record capture reached %lld bytes, further requests are not recorded"), MaxContentBytes);
+			bDroppedEntries = true;
+		}
+		return;
+	}
+
+	NumContentBytes += EntryBytes;
+	Capture.Entries.Add(MoveTemp(Entry));
+}
@@ -0,0 +1,114 @@
+// Copyright (c) 2025, Futureverse Corporation Limited. All rights reserved.
+
+#include "AssetRegisterCompletionQueue.h"
+
+namespace AssetRegisterCompletionQueue
+{
+	thread_local const FAssetRegisterCompletionScope* CurrentScope = nullptr;
+}
+
+FAssetRegisterCompletionQueue& FAssetRegisterCompletionQueue::Get()
+{
+	static FAssetRegisterCompletionQueue Queue;
+	return Queue;
+}
+
+FAssetRegisterCompletionQueue::FAssetRegisterCompletionQueue()
+{
+	TickerHandle = FTSTicker::GetCoreTicker().AddTicker(TEXT("AssetRegisterCompletionQueue"), 0.f, [this](float)
+	{
+		const UAssetRegisterSettings* Settings = GetDefault<UAssetRegisterSettings>();
+		Drain(Settings ? Settings->CompletionFrameBudget / 1000.0 : 0.0);
+		return true;
+	});
+}
+
+void FAssetRegisterCompletionQueue::Enqueue(TUniqueFunction<void()>&& Completion)
+{
+	++NumQueued;
+	Completions.Enqueue(MoveTemp(Completion));
+}
+
+int32 FAssetRegisterCompletionQueue::Drain(double BudgetSeconds)
+{
+	check(IsInGameThread());
+
+	const double StartTime = FPlatformTime::Seconds();
+	int32 NumDrained = 0;
+	TUniqueFunction<void()> Completion;
+	while (Completions.Dequeue(Completion))
+	{
+		--NumQueued;
+		Completion();
+		++NumDrained;
+
+		if (FPlatformTime::Seconds() - StartTime >= BudgetSeconds)
+		{
+			break;
+		}
+	}
+
+	if (NumDrained > 0)
+	{
+		NumDelivered += NumDrained;
+		if (NumDrained > MaxDeliveredPerFrame)
+		{
+			MaxDeliveredPerFrame = NumDrained;
+		}
+		if (!Completions.IsEmpty())
+		{
+			++NumDeferredFrames;
+		}
+	}
+	return NumDrained;
+}
+
+void FAssetRegisterCompletionQueue::Flush()
+{
+	if (TickerHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+		TickerHandle.Reset();
+	}
+
+	TUniqueFunction<void()> Completion;
+	while (Completions.Dequeue(Completion))
+	{
+		--NumQueued;
+		Completion();
+		++NumDelivered;
+	}
+}
+
+FAssetRegisterCompletionQueueStats FAssetRegisterCompletionQueue::GetStats() const
+{
+	FAssetRegisterCompletionQueueStats Stats;
+	Stats.NumQueued = NumQueued;
+	Stats.NumDelivered = NumDelivered;
+	Stats.MaxDeliveredPerFrame = MaxDeliveredPerFrame;
+	Stats.NumDeferredFrames = NumDeferredFrames;
+	return Stats;
+}
+
+FAssetRegisterCompletionScope::FAssetRegisterCompletionScope(EAssetRegisterCompletionPolicy InPolicy)
+	: Policy(InPolicy)
+	, OuterScope(AssetRegisterCompletionQueue::CurrentScope)
+{
+	AssetRegisterCompletionQueue::CurrentScope = this;
+}
+
+FAssetRegisterCompletionScope::~FAssetRegisterCompletionScope()
+{
+	AssetRegisterCompletionQueue::CurrentScope = OuterScope;
+}
+
+EAssetRegisterCompletionPolicy FAssetRegisterCompletionScope::GetCurrentPolicy()
+{
+	if (AssetRegisterCompletionQueue::CurrentScope)
+	{
+		return AssetRegisterCompletionQueue::CurrentScope->Policy;
+	}
+
+	const UAssetRegisterSettings* Settings = GetDefault<UAssetRegisterSettings>();
+	return Settings ? Settings->CompletionPolicy : EAssetRegisterCompletionPolicy::Inline;
+}
@@ -0,0 +1,80 @@
+// Copyright (c) 2025, Futureverse Corporation Limited. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AssetRegisterGCUtil.h"
+
+/**
+ * Remembers the validators (ETag/Last-Modified) and decoded result of GET queries, so a 304 Not Modified
+ * response can resolve with the previously decoded value instead of downloading and decoding it again.
+ *
+ * @tparam TResult The decoded result type, e.g. FLoadAssetResult or FLoadAssetsResult.
+ */
+template<typename TResult>
+class TAssetRegisterConditionalCache : public FGCObject
+{
+public:
+	struct FEntry
+	{
+		FString ETag;
+		FString LastModified;
+		TResult Result;
+	};
+
+	explicit TAssetRegisterConditionalCache(const TCHAR* InName, int32 InMaxEntries = 256)
+		: Name(InName), MaxEntries(InMaxEntries) {}
+
+	/** Finds the cached entry for a GET URL. */
+	bool Find(const FString& URL, FEntry& OutEntry) const
+	{
+		FScopeLock Lock(&CriticalSection);
+		if (const FEntry* Entry = Entries.Find(URL))
+		{
+			OutEntry = *Entry;
+			return true;
+		}
+		return false;
+	}
+
+	/** Stores the validators and decoded result of a successful response, evicting an existing entry when full. */
+	void Store(const FString& URL, FEntry&& Entry)
+	{
+		FScopeLock Lock(&CriticalSection);
+		if (!Entries.Contains(URL) && Entries.Num() >= MaxEntries)
+		{
+			auto EvictIt = Entries.CreateIterator();
+			EvictIt.RemoveCurrent();
+		}
+		Entries.Remove(URL);
+		Entries.Add(URL, MoveTemp(Entry));
+	}
+
+	void Remove(const FString& URL)
+	{
+		FScopeLock Lock(&CriticalSection);
+		Entries.Remove(URL);
+	}
+
+	virtual void AddReferencedObjects(FReferenceCollector& Collector) override
+	{
+		FScopeLock Lock(&CriticalSection);
+		for (auto& Pair : Entries)
+		{
+			AssetRegisterGCUtil::AddReferencedObjects(Collector, Pair.Value.Result);
+		}
+	}
+
+	virtual FString GetReferencerName() const override
+	{
+		return Name;
+	}
+
+private:
+	mutable FCriticalSection CriticalSection;
+
+	TMap<FString, FEntry> Entries;
+
+	FString Name;
+	int32 MaxEntries;
+};
@@ -0,0 +1,119 @@
+// Copyright (c) 2025, Futureverse Corporation Limited. All rights reserved.
+
+#include "AssetRegisterCoroutines.h"
+
+#include "AssetRegisterTrace.h"
+
+FAssetRegisterCancellationToken::FAssetRegisterCancellationToken()
+	: State(MakeShared<FState>())
+{
+}
+
+void FAssetRegisterCancellationToken::Cancel()
+{
+	TMap<int32, TUniqueFunction<void()>> Callbacks;
+	{
+		FScopeLock Lock(&State->CriticalSection);
+		if (State->bCancelled)
+		{
+			return;
+		}
+		State->bCancelled = true;
+		Callbacks = MoveTemp(State->Callbacks);
+	}
+
+	for (TPair<int32, TUniqueFunction<void()>>& Callback : Callbacks)
+	{
+		Callback.Value();
+	}
+}
+
+bool FAssetRegisterCancellationToken::IsCancelled() const
+{
+	FScopeLock Lock(&State->CriticalSection);
+	return State->bCancelled;
+}
+
+int32 FAssetRegisterCancellationToken::Subscribe(TUniqueFunction<void()>&& OnCancel) const
+{
+	{
+		FScopeLock Lock(&State->CriticalSection);
+		if (!State->bCancelled)
+		{
+			const int32 Handle = State->NextHandle++;
+			State->Callbacks.Add(Handle, MoveTemp(OnCancel));
+			return Handle;
+		}
+	}
+
+	OnCancel();
+	return INDEX_NONE;
+}
+
+void FAssetRegisterCancellationToken::Unsubscribe(int32 Handle) const
+{
+	FScopeLock Lock(&State->CriticalSection);
+	State->Callbacks.Remove(Handle);
+}
+
+#if WITH_ASSETREGISTER_COROUTINES
+
+namespace AssetRegisterCoroutines
+{
+	TAssetRegisterAwaitable<FLoadJsonResult> GetAssetProfile(const FString& TokenId, const FString& CollectionId,
+		EAssetRegisterCompletionPolicy ResumeOn, const FAssetRegisterDeadline& Deadline)
+	{
+		FAssetRegisterCompletionScope Scope(ResumeOn);
+		return Await(UAssetRegisterQueryingLibrary::GetAssetProfile(TokenId, CollectionId, Deadline), ResumeOn);
+	}
+
+	TAssetRegisterAwaitable<FLoadAssetResult> GetAssetLinks(const FString& TokenId, const FString& CollectionId,
+		EAssetRegisterCompletionPolicy ResumeOn, const FAssetRegisterDeadline& Deadline)
+	{
+		FAssetRegisterCompletionScope Scope(ResumeOn);
+		return Await(UAssetRegisterQueryingLibrary::GetAssetLinks(TokenId, CollectionId, Deadline), ResumeOn);
+	}
+
+	TAssetRegisterAwaitable<FLoadAssetsResult> GetAssets(const FAssetConnection& AssetsInput,
+		EAssetRegisterCompletionPolicy ResumeOn, const FAssetRegisterDeadline& Deadline)
+	{
+		FAssetRegisterCompletionScope Scope(ResumeOn);
+		return Await(UAssetRegisterQueryingLibrary::GetAssets(AssetsInput, Deadline), ResumeOn);
+	}
+
+	TAssetRegisterAwaitable<FLoadAssetsResult> GetAllAssets(const FAssetConnection& AssetsInput,
+		EAssetRegisterCompletionPolicy ResumeOn, const FAssetRegisterDeadline& Deadline)
+	{
+		FAssetRegisterCompletionScope Scope(ResumeOn);
+		return Await(UAssetRegisterQueryingLibrary::GetAllAssets(AssetsInput, Deadline), ResumeOn);
+	}
+
+	TAssetRegisterAwaitable<FString> SendRequest(const FString& Content, EAssetRegisterCompletionPolicy ResumeOn)
+	{
+		return Await(UAssetRegisterQueryingLibrary::SendRequest(Content), ResumeOn);
+	}
+
+	TAssetRegisterAwaitable<FLoadAssetResult> MakeAssetQuery(const FAssetInput& Input, const TSharedPtr<FQueryNode<FAsset>>& AssetQuery,
+		EAssetRegisterCompletionPolicy ResumeOn, const FAssetRegisterDeadline& Deadline)
+	{
+		FAssetRegisterCompletionScope Scope(ResumeOn);
+		return Await(UAssetRegisterQueryingLibrary::MakeAssetQuery(Input, AssetQuery, Deadline), ResumeOn);
+	}
+
+	TAssetRegisterAwaitable<FLoadAssetsResult> MakeAssetsQuery(const TSharedPtr<FQueryNode<FAssets>>& AssetsQuery,
+		EAssetRegisterCompletionPolicy ResumeOn, const FAssetRegisterDeadline& Deadline)
+	{
+		if (!AssetsQuery.IsValid())
+		{
+			auto OutResult = FLoadAssetsResult();
+			OutResult.SetFailure();
+			return Await(MakeFulfilledPromise<FLoadAssetsResult>(MoveTemp(OutResult)).GetFuture(), ResumeOn);
+		}
+
+		FAssetRegisterCompletionScope Scope(ResumeOn);
+		const FAssetRegisterRequestScope RequestScope;
+		return Await(UAssetRegisterQueryingLibrary::MakeAssetsQuery(AssetsQuery->GetQueryJsonUtf8(), Deadline), ResumeOn);
+	}
+}
+
+#endif
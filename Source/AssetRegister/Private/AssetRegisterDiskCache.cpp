@@ -0,0 +1,816 @@
+// Copyright (c) 2025, Futureverse Corporation Limited. All rights reserved.
+
+#include "AssetRegisterDiskCache.h"
+
+#include "AssetRegisterLog.h"
+#include "AssetRegisterSettings.h"
+#include "Algo/BinarySearch.h"
+#include "Async/Async.h"
+#include "Async/MappedFileHandle.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "Hash/CityHash.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Schemas/Unions/NFTAssetLink.h"
+#include "Schemas/Unions/NFTAssetOwnership.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+namespace AssetRegisterDiskCache
+{
+	/**
+	 * The fields a record can hold: everything the library's queries select, down to the leaves SerializeAsset writes.
+	 * A selected member is only persisted if this covers its subselection.
+	 */
+	const IQueryNode& GetPersistableSelection()
+	{
+		static const TSharedRef<IQueryNode> Selection = []()
+		{
+			const auto AssetNode = MakeShared<FQueryNode<FAsset>>(QueryStringUtil::GetQueryName<FAsset>());
+			AssetNode->AddField(&FAsset::CollectionId)
+				->AddField(&FAsset::TokenId)
+				->AddField(&FAsset::Id)
+				->AddField(&FAsset::AssetType)
+				->AddField(&FAsset::Profiles);
+
+			AssetNode->OnMember(&FAsset::Collection)
+				->AddField(&FCollection::ChainId)
+				->AddField(&FCollection::ChainType)
+				->AddField(&FCollection::Id)
+				->AddField(&FCollection::Location)
+				->AddField(&FCollection::Name);
+
+			AssetNode->OnMember(&FAsset::Metadata)
+				->AddField(&FAssetMetadata::Id)
+				->AddField(&FAssetMetadata::Uri)
+				->AddField(&FAssetMetadata::Properties)
+				->AddField(&FAssetMetadata::Attributes)
+				->AddField(&FAssetMetadata::RawAttributes);
+
+			const auto OwnershipNode = AssetNode->OnMember(&FAsset::Ownership)->OnUnion<FNFTAssetOwnership>();
+			OwnershipNode->AddField(&FNFTAssetOwnership::Id);
+			OwnershipNode->OnMember(&FNFTAssetOwnership::Owner)->AddField(&FAccount::Address);
+
+			AssetNode->OnMember(&FAsset::Links)
+				->OnUnion<FNFTAssetLink>()
+					->OnArray(&FNFTAssetLink::ChildLinks)
+						->AddField(&FLink::Path)
+						->OnMember(&FLink::Asset)
+							->AddField(&FAsset::CollectionId)
+							->AddField(&FAsset::TokenId);
+
+			return StaticCastSharedRef<IQueryNode>(AssetNode);
+		}();
+		return *Selection;
+	}
+
+	/** The part of Selection a record can hold. */
+	TSharedRef<IQueryNode> GetPersistedSelection(const IQueryNode& Selection)
+	{
+		const IQueryNode& Persistable = GetPersistableSelection();
+
+		TSharedRef<IQueryNode> OutSelection = MakeShared<IQueryNode>(Selection.GetName());
+		for (const auto& ChildPair : Selection.GetChildren())
+		{
+			const TSharedPtr<IQueryNode>* PersistableChild = Persistable.GetChildren().Find(ChildPair.Key);
+			if (PersistableChild && (*PersistableChild)->CoversSelection(*ChildPair.Value))
+			{
+				OutSelection->AddChild(ChildPair.Value->CloneNode());
+			}
+		}
+		return OutSelection;
+	}
+
+	/**
+	 * Reads or writes the number of elements of Array and sizes it when loading. A count the rest of the archive
+	 * can't hold, at MinElementSize bytes per element, is corrupt and sets the archive error instead.
+	 *
+	 * @return False if the archive is in error.
+	 */
+	template<typename TElement>
+	bool SerializeNum(FArchive& Ar, TArray<TElement>& Array, int64 MinElementSize)
+	{
+		int32 Num = Array.Num();
+		Ar << Num;
+		if (Ar.IsLoading())
+		{
+			const int64 Remaining = Ar.TotalSize() - Ar.Tell();
+			if (Ar.IsError() || Num < 0 || (Ar.TotalSize() >= 0 && Num * MinElementSize > Remaining))
+			{
+				Ar.SetError();
+				return false;
+			}
+			Array.SetNum(Num);
+		}
+		return !Ar.IsError();
+	}
+
+	/** Reads or writes a selection tree, without its arguments. */
+	void SerializeSelection(FArchive& Ar, TSharedPtr<IQueryNode>& Selection, int32 Depth = 0)
+	{
+		FString Name = Selection.IsValid() ? Selection->GetName() : FString();
+		bool bIsUnion = Selection.IsValid() && Selection->IsUnion();
+		int32 NumChildren = Selection.IsValid() ? Selection->GetChildren().Num() : 0;
+		Ar << Name << bIsUnion << NumChildren;
+
+		// a corrupt record could nest arbitrarily deep
+		if (Depth > 16 || NumChildren < 0)
+		{
+			Ar.SetError();
+			return;
+		}
+
+		if (Ar.IsLoading())
+		{
+			Selection = MakeShared<IQueryNode>(Name, bIsUnion);
+			for (int32 ChildIndex = 0; ChildIndex < NumChildren && !Ar.IsError(); ++ChildIndex)
+			{
+				TSharedPtr<IQueryNode> Child;
+				SerializeSelection(Ar, Child, Depth + 1);
+				if (Child.IsValid())
+				{
+					Selection->AddChild(Child.ToSharedRef());
+				}
+			}
+		}
+		else
+		{
+			for (const auto& ChildPair : Selection->GetChildren())
+			{
+				TSharedPtr<IQueryNode> Child = ChildPair.Value;
+				SerializeSelection(Ar, Child, Depth + 1);
+			}
+		}
+	}
+
+	/** Reads or writes the members of an asset selected by the top level fields of Selection, in their order. */
+	void SerializeAsset(FArchive& Ar, FAsset& Asset, const IQueryNode& Selection)
+	{
+		for (const auto& ChildPair : Selection.GetChildren())
+		{
+			const FString& FieldName = ChildPair.Key;
+			if (FieldName == TEXT("id"))
+			{
+				Ar << Asset.Id;
+			}
+			else if (FieldName == TEXT("assetType"))
+			{
+				uint8 AssetType = static_cast<uint8>(Asset.AssetType);
+				Ar << AssetType;
+				Asset.AssetType = static_cast<EAssetType>(AssetType);
+			}
+			else if (FieldName == TEXT("collection"))
+			{
+				Ar << Asset.Collection.ChainId << Asset.Collection.ChainType << Asset.Collection.Id
+					<< Asset.Collection.Location << Asset.Collection.Name;
+			}
+			else if (FieldName == TEXT("profiles"))
+			{
+				Ar << Asset.Profiles;
+			}
+			else if (FieldName == TEXT("metadata"))
+			{
+				FAssetMetadata& Metadata = Asset.Metadata;
+				Ar << Metadata.Id << Metadata.Uri << Metadata.Attributes;
+
+				// two strings, each at least a length
+				if (!SerializeNum(Ar, Metadata.RawAttributes, 2 * sizeof(int32)))
+				{
+					return;
+				}
+				for (FRawAttributes& RawAttribute : Metadata.RawAttributes)
+				{
+					Ar << RawAttribute.Value << RawAttribute.Trait_type;
+				}
+
+				FString PropertiesJson;
+				if (Ar.IsSaving() && Metadata.Properties.JsonObject.IsValid())
+				{
+					Metadata.Properties.JsonObjectToString(PropertiesJson);
+				}
+				Ar << PropertiesJson;
+				if (Ar.IsLoading() && !PropertiesJson.IsEmpty())
+				{
+					Metadata.Properties.JsonObjectFromString(PropertiesJson);
+				}
+			}
+			else if (FieldName == TEXT("ownership"))
+			{
+				UNFTAssetOwnershipObject* Ownership = Cast<UNFTAssetOwnershipObject>(Asset.OwnershipWrapper.Ownership);
+				bool bHasOwnership = Ownership != nullptr;
+				Ar << bHasOwnership;
+				if (bHasOwnership)
+				{
+					if (Ar.IsLoading())
+					{
+						Ownership = NewObject<UNFTAssetOwnershipObject>();
+						Asset.OwnershipWrapper.Ownership = Ownership;
+					}
+					Ar << Ownership->Data.Id << Ownership->Data.Owner.Address;
+				}
+			}
+			else if (FieldName == TEXT("links"))
+			{
+				UNFTAssetLinkObject* Links = Cast<UNFTAssetLinkObject>(Asset.LinkWrapper.Links);
+				bool bHasLinks = Links != nullptr;
+				Ar << bHasLinks;
+				if (bHasLinks)
+				{
+					if (Ar.IsLoading())
+					{
+						Links = NewObject<UNFTAssetLinkObject>();
+						Asset.LinkWrapper.Links = Links;
+					}
+
+					if (!SerializeNum(Ar, Links->Data.ChildLinks, 3 * sizeof(int32)))
+					{
+						return;
+					}
+					for (FLink& ChildLink : Links->Data.ChildLinks)
+					{
+						Ar << ChildLink.Path << ChildLink.Asset.CollectionId << ChildLink.Asset.TokenId;
+					}
+				}
+			}
+		}
+	}
+
+	/**
+	 * Reads or writes an asset record: the asset key, the selection it was fetched with, and the selected members.
+	 * The key comes first, so a record can be checked against the key it was looked up with.
+	 */
+	void SerializeAssetRecord(FArchive& Ar, FAsset& Asset, TSharedPtr<IQueryNode>& Selection)
+	{
+		Ar << Asset.CollectionId << Asset.TokenId;
+		SerializeSelection(Ar, Selection);
+		if (!Ar.IsError())
+		{
+			SerializeAsset(Ar, Asset, *Selection);
+		}
+	}
+
+	/**
+	 * Reads or writes a GetAssets page. The assets on it are stored as separate records and only referenced by key.
+	 */
+	void SerializeAssetsPage(FArchive& Ar, TArray<uint8>& QueryContent, FAssets& Assets)
+	{
+		Ar << QueryContent;
+		Ar << Assets.Total;
+		Ar << Assets.PageInfo.EndCursor << Assets.PageInfo.HasNextPage << Assets.PageInfo.HasPreviousPage
+			<< Assets.PageInfo.NextPage << Assets.PageInfo.StartCursor;
+
+		if (!SerializeNum(Ar, Assets.Edges, 3 * sizeof(int32)))
+		{
+			return;
+		}
+		for (FAssetEdge& Edge : Assets.Edges)
+		{
+			Ar << Edge.Cursor << Edge.Node.CollectionId << Edge.Node.TokenId;
+		}
+	}
+}
+
+FAssetRegisterDiskCache& FAssetRegisterDiskCache::Get()
+{
+	static FAssetRegisterDiskCache Cache;
+	return Cache;
+}
+
+FString FAssetRegisterDiskCache::GetDefaultPath()
+{
+	return FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("AssetRegister"), TEXT("AssetCache.bin"));
+}
+
+FAssetRegisterDiskCache::~FAssetRegisterDiskCache()
+{
+	WaitForFlush();
+	UnmapFile();
+}
+
+bool FAssetRegisterDiskCache::Open(const FString& InPath)
+{
+	Close();
+
+	FScopeLock Lock(&CriticalSection);
+
+	Path = InPath;
+	IFileManager::Get().MakeDirectory(*FPaths::GetPath(Path), true);
+
+	const bool bMapped = MapFile();
+	bIsOpen = true;
+	FlushTickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FAssetRegisterDiskCache::Tick), 30.f);
+
+	UE_LOG(LogAssetRegister, Log, TEXT("FAssetRegisterDiskCache::Open %s with %d records"), *Path, Index.Num());
+	return bMapped;
+}
+
+void FAssetRegisterDiskCache::Close()
+{
+	if (!IsOpen())
+	{
+		return;
+	}
+
+	FTSTicker::GetCoreTicker().RemoveTicker(FlushTickerHandle);
+	Flush();
+
+	FScopeLock Lock(&CriticalSection);
+	UnmapFile();
+	PendingRecords.Empty();
+	FlushingRecords.Empty();
+	bIsOpen = false;
+}
+
+bool FAssetRegisterDiskCache::IsOpen() const
+{
+	FScopeLock Lock(&CriticalSection);
+	return bIsOpen;
+}
+
+bool FAssetRegisterDiskCache::FindAsset(const FAssetRegisterAssetKey& Key, FAsset& OutAsset,
+	TSharedPtr<const IQueryNode>& OutSelection, double& OutAge)
+{
+	FScopeLock Lock(&CriticalSection);
+	return bIsOpen && FindAssetLocked(Key, OutAsset, OutSelection, OutAge);
+}
+
+void FAssetRegisterDiskCache::AddAsset(const FAsset& Asset, const IQueryNode& Selection)
+{
+	FScopeLock Lock(&CriticalSection);
+	if (bIsOpen)
+	{
+		AddAssetLocked(Asset, Selection, FDateTime::UtcNow().GetTicks());
+	}
+}
+
+bool FAssetRegisterDiskCache::FindAssetsPage(TConstArrayView<uint8> QueryContent, const IQueryNode& RequiredSelection,
+	FAssets& OutAssets, bool& bOutStale)
+{
+	FScopeLock Lock(&CriticalSection);
+	if (!bIsOpen)
+	{
+		return false;
+	}
+
+	FIndexEntry Entry;
+	TConstArrayView<uint8> Bytes;
+	if (!FindRecord(HashQuery(QueryContent), ERecordKind::AssetsPage, Entry, Bytes))
+	{
+		return false;
+	}
+
+	FMemoryReaderView Reader(FMemoryView(Bytes.GetData(), Bytes.Num()));
+	TArray<uint8> RecordQueryContent;
+	FAssets Assets;
+	AssetRegisterDiskCache::SerializeAssetsPage(Reader, RecordQueryContent, Assets);
+	if (Reader.IsError() || RecordQueryContent.Num() != QueryContent.Num()
+		|| FMemory::Memcmp(RecordQueryContent.GetData(), QueryContent.GetData(), QueryContent.Num()) != 0)
+	{
+		return false;
+	}
+
+	bool bStale = IsStale(GetAge(Entry));
+	for (FAssetEdge& Edge : Assets.Edges)
+	{
+		TSharedPtr<const IQueryNode> Selection;
+		double Age = 0.0;
+		if (!FindAssetLocked(FAssetRegisterAssetKey(Edge.Node), Edge.Node, Selection, Age)
+			|| !Selection->CoversSelection(RequiredSelection))
+		{
+			return false;
+		}
+		bStale |= IsStale(Age);
+	}
+
+	OutAssets = MoveTemp(Assets);
+	bOutStale = bStale;
+	return true;
+}
+
+void FAssetRegisterDiskCache::AddAssetsPage(TConstArrayView<uint8> QueryContent, const FAssets& Assets, const IQueryNode& NodeSelection)
+{
+	FScopeLock Lock(&CriticalSection);
+	if (!bIsOpen)
+	{
+		return;
+	}
+
+	const int64 Now = FDateTime::UtcNow().GetTicks();
+	for (const FAssetEdge& Edge : Assets.Edges)
+	{
+		if (!FAssetRegisterAssetKey(Edge.Node).IsValid())
+		{
+			// a page whose assets can't be looked up again isn't worth storing
+			return;
+		}
+		AddAssetLocked(Edge.Node, NodeSelection, Now);
+	}
+
+	FPendingRecord Record;
+	Record.Entry.Hash = HashQuery(QueryContent);
+	Record.Entry.Kind = ERecordKind::AssetsPage;
+	Record.Entry.FetchedAt = Now;
+
+	TArray<uint8> RecordQueryContent(QueryContent);
+	FAssets Page;
+	Page.PageInfo = Assets.PageInfo;
+	Page.Total = Assets.Total;
+	Page.Edges.Reserve(Assets.Edges.Num());
+	for (const FAssetEdge& Edge : Assets.Edges)
+	{
+		FAssetEdge& PageEdge = Page.Edges.AddDefaulted_GetRef();
+		PageEdge.Cursor = Edge.Cursor;
+		PageEdge.Node.CollectionId = Edge.Node.CollectionId;
+		PageEdge.Node.TokenId = Edge.Node.TokenId;
+	}
+
+	FMemoryWriter Writer(Record.Bytes);
+	AssetRegisterDiskCache::SerializeAssetsPage(Writer, RecordQueryContent, Page);
+	Record.Entry.Size = Record.Bytes.Num();
+
+	PendingRecords.Add(Record.Entry.Hash, MoveTemp(Record));
+}
+
+bool FAssetRegisterDiskCache::Flush()
+{
+	WaitForFlush();
+	{
+		FScopeLock Lock(&CriticalSection);
+		if (!BeginFlushLocked())
+		{
+			return true;
+		}
+	}
+	return WriteFlushingRecords();
+}
+
+void FAssetRegisterDiskCache::WaitForFlush()
+{
+	if (FlushFuture.IsValid())
+	{
+		FlushFuture.Wait();
+		FlushFuture.Reset();
+	}
+}
+
+bool FAssetRegisterDiskCache::BeginFlushLocked()
+{
+	if (!bIsOpen || PendingRecords.IsEmpty())
+	{
+		return false;
+	}
+
+	FlushingRecords = MoveTemp(PendingRecords);
+	PendingRecords.Reset();
+	return true;
+}
+
+bool FAssetRegisterDiskCache::WriteFlushingRecords()
+{
+	// the mapped file and FlushingRecords only change at the end of a flush, so they are read without the lock and
+	// lookups aren't blocked while the new file is built and written
+	const double StartTime = FPlatformTime::Seconds();
+
+	struct FRecordRef
+	{
+		FIndexEntry Entry;
+		TConstArrayView<uint8> Bytes;
+	};
+
+	TArray<FRecordRef> Records;
+	Records.Reserve(Index.Num() + FlushingRecords.Num());
+	for (const FIndexEntry& Entry : Index)
+	{
+		if (!FlushingRecords.Contains(Entry.Hash) && Entry.Offset + Entry.Size <= static_cast<uint64>(FileData.Num()))
+		{
+			Records.Add({Entry, FileData.Slice(static_cast<int32>(Entry.Offset), static_cast<int32>(Entry.Size))});
+		}
+	}
+	for (const auto& Pair : FlushingRecords)
+	{
+		Records.Add({Pair.Value.Entry, Pair.Value.Bytes});
+	}
+
+	// newest first, so the oldest records are the ones that don't fit
+	Records.Sort([](const FRecordRef& A, const FRecordRef& B) { return A.Entry.FetchedAt > B.Entry.FetchedAt; });
+
+	const UAssetRegisterSettings* Settings = GetDefault<UAssetRegisterSettings>();
+	const int64 MaxSize = static_cast<int64>(Settings ? Settings->DiskCacheMaxSize : 256) * 1024 * 1024;
+	int64 FileSize = sizeof(FFileHeader);
+	int32 NumKept = 0;
+	for (; NumKept < Records.Num(); ++NumKept)
+	{
+		const int64 RecordSize = Align(Records[NumKept].Bytes.Num(), 8) + sizeof(FIndexEntry);
+		if (FileSize + RecordSize > MaxSize)
+		{
+			break;
+		}
+		FileSize += RecordSize;
+	}
+	Records.SetNum(NumKept);
+
+	TArray<uint8> NewFile;
+	NewFile.Reserve(FileSize);
+	NewFile.AddZeroed(sizeof(FFileHeader));
+
+	TArray<FIndexEntry> NewIndex;
+	NewIndex.Reserve(Records.Num());
+	for (const FRecordRef& Record : Records)
+	{
+		FIndexEntry& Entry = NewIndex.Add_GetRef(Record.Entry);
+		Entry.Offset = NewFile.Num();
+		Entry.Size = Record.Bytes.Num();
+
+		NewFile.Append(Record.Bytes.GetData(), Record.Bytes.Num());
+		NewFile.AddZeroed(Align(NewFile.Num(), 8) - NewFile.Num());
+	}
+	NewIndex.Sort([](const FIndexEntry& A, const FIndexEntry& B) { return A.Hash < B.Hash; });
+
+	FFileHeader Header;
+	Header.Magic = FileMagic;
+	Header.Version = FileVersion;
+	Header.NumRecords = NewIndex.Num();
+	Header.IndexOffset = NewFile.Num();
+	NewFile.Append(reinterpret_cast<const uint8*>(NewIndex.GetData()), NewIndex.Num() * sizeof(FIndexEntry));
+	Header.FileSize = NewFile.Num();
+	FMemory::Memcpy(NewFile.GetData(), &Header, sizeof(FFileHeader));
+
+	const FString TempPath = Path + TEXT(".tmp");
+	const bool bWritten = FFileHelper::SaveArrayToFile(NewFile, *TempPath);
+	NewFile.Empty();
+
+	FScopeLock Lock(&CriticalSection);
+	if (!bWritten)
+	{
+		UE_LOG(LogAssetRegister, Warning, TEXT("FAssetRegisterDiskCache::Flush failed to write %s"), *TempPath);
+		EndFlushLocked(false);
+		return false;
+	}
+
+	// the mapping has to be released before the file can be replaced
+	Records.Empty();
+	UnmapFile();
+	if (!IFileManager::Get().Move(*Path, *TempPath, true, true))
+	{
+		UE_LOG(LogAssetRegister, Warning, TEXT("FAssetRegisterDiskCache::Flush failed to replace %s"), *Path);
+		MapFile();
+		EndFlushLocked(false);
+		return false;
+	}
+
+	MapFile();
+	EndFlushLocked(true);
+
+	UE_LOG(LogAssetRegister, Verbose, TEXT("FAssetRegisterDiskCache::Flush wrote %d records (%lld bytes) in %.2fms"),
+		Header.NumRecords, Header.FileSize, (FPlatformTime::Seconds() - StartTime) * 1000.0);
+	return true;
+}
+
+void FAssetRegisterDiskCache::EndFlushLocked(bool bWritten)
+{
+	if (!bWritten)
+	{
+		// records added while flushing are newer than the ones that failed to be written
+		for (auto& Pair : FlushingRecords)
+		{
+			if (!PendingRecords.Contains(Pair.Key))
+			{
+				PendingRecords.Add(Pair.Key, MoveTemp(Pair.Value));
+			}
+		}
+	}
+	FlushingRecords.Empty();
+}
+
+int32 FAssetRegisterDiskCache::GetNumRecords() const
+{
+	FScopeLock Lock(&CriticalSection);
+
+	int32 NumRecords = Index.Num();
+	for (const auto& Pair : FlushingRecords)
+	{
+		if (Algo::BinarySearchBy(Index, Pair.Key, &FIndexEntry::Hash) == INDEX_NONE)
+		{
+			++NumRecords;
+		}
+	}
+	for (const auto& Pair : PendingRecords)
+	{
+		if (!FlushingRecords.Contains(Pair.Key) && Algo::BinarySearchBy(Index, Pair.Key, &FIndexEntry::Hash) == INDEX_NONE)
+		{
+			++NumRecords;
+		}
+	}
+	return NumRecords;
+}
+
+uint64 FAssetRegisterDiskCache::HashAssetKey(const FAssetRegisterAssetKey& Key)
+{
+	const FTCHARToUTF8 KeyUtf8(*Key.ToString());
+	return CityHash64(KeyUtf8.Get(), KeyUtf8.Length());
+}
+
+uint64 FAssetRegisterDiskCache::HashQuery(TConstArrayView<uint8> QueryContent)
+{
+	return CityHash64(reinterpret_cast<const char*>(QueryContent.GetData()), QueryContent.Num());
+}
+
+bool FAssetRegisterDiskCache::FindRecord(uint64 Hash, ERecordKind Kind, FIndexEntry& OutEntry, TConstArrayView<uint8>& OutBytes) const
+{
+	const FPendingRecord* Record = PendingRecords.Find(Hash);
+	if (!Record)
+	{
+		Record = FlushingRecords.Find(Hash);
+	}
+	if (Record)
+	{
+		if (Record->Entry.Kind != Kind)
+		{
+			return false;
+		}
+		OutEntry = Record->Entry;
+		OutBytes = Record->Bytes;
+		return true;
+	}
+
+	const int32 EntryIndex = Algo::BinarySearchBy(Index, Hash, &FIndexEntry::Hash);
+	if (EntryIndex == INDEX_NONE)
+	{
+		return false;
+	}
+
+	const FIndexEntry& Entry = Index[EntryIndex];
+	if (Entry.Kind != Kind || Entry.Offset + Entry.Size > static_cast<uint64>(FileData.Num()))
+	{
+		return false;
+	}
+
+	OutEntry = Entry;
+	OutBytes = FileData.Slice(static_cast<int32>(Entry.Offset), static_cast<int32>(Entry.Size));
+	return true;
+}
+
+bool FAssetRegisterDiskCache::FindAssetLocked(const FAssetRegisterAssetKey& Key, FAsset& OutAsset,
+	TSharedPtr<const IQueryNode>& OutSelection, double& OutAge) const
+{
+	FIndexEntry Entry;
+	TConstArrayView<uint8> Bytes;
+	if (!FindRecord(HashAssetKey(Key), ERecordKind::Asset, Entry, Bytes))
+	{
+		return false;
+	}
+
+	FMemoryReaderView Reader(FMemoryView(Bytes.GetData(), Bytes.Num()));
+	FAsset Asset;
+	TSharedPtr<IQueryNode> Selection;
+	AssetRegisterDiskCache::SerializeAssetRecord(Reader, Asset, Selection);
+	if (Reader.IsError() || !Selection.IsValid() || !(FAssetRegisterAssetKey(Asset) == Key))
+	{
+		return false;
+	}
+
+	OutAsset = MoveTemp(Asset);
+	OutSelection = Selection;
+	OutAge = GetAge(Entry);
+	return true;
+}
+
+void FAssetRegisterDiskCache::AddAssetLocked(const FAsset& Asset, const IQueryNode& Selection, int64 Now)
+{
+	const FAssetRegisterAssetKey Key(Asset);
+	if (!ensureMsgf(Key.IsValid(), TEXT("FAssetRegisterDiskCache::AddAsset asset needs a CollectionId and TokenId")))
+	{
+		return;
+	}
+
+	TSharedPtr<IQueryNode> RecordSelection = AssetRegisterDiskCache::GetPersistedSelection(Selection);
+	if (RecordSelection->GetChildren().IsEmpty())
+	{
+		return;
+	}
+
+	FPendingRecord Record;
+	Record.Entry.Hash = HashAssetKey(Key);
+	Record.Entry.Kind = ERecordKind::Asset;
+	Record.Entry.FetchedAt = Now;
+
+	FAsset RecordAsset = Asset;
+
+	FIndexEntry ExistingEntry;
+	TConstArrayView<uint8> ExistingBytes;
+	if (FindRecord(Record.Entry.Hash, ERecordKind::Asset, ExistingEntry, ExistingBytes) && !IsStale(GetAge(ExistingEntry)))
+	{
+		FMemoryReaderView Reader(FMemoryView(ExistingBytes.GetData(), ExistingBytes.Num()));
+		FAsset ExistingAsset;
+		TSharedPtr<IQueryNode> ExistingSelection;
+		AssetRegisterDiskCache::SerializeAssetRecord(Reader, ExistingAsset, ExistingSelection);
+		// a record refetching every stored field replaces the old one, fetched now
+		if (!Reader.IsError() && ExistingSelection.IsValid() && FAssetRegisterAssetKey(ExistingAsset) == Key
+			&& !RecordSelection->CoversSelection(*ExistingSelection))
+		{
+			// fields stored earlier keep their original fetch time
+			FAssetRegisterAssetCache::CopyFields(Asset, ExistingAsset, *RecordSelection);
+			ExistingSelection->MergeSelection(*RecordSelection);
+			RecordAsset = MoveTemp(ExistingAsset);
+			RecordSelection = ExistingSelection;
+			Record.Entry.FetchedAt = FMath::Min(Now, ExistingEntry.FetchedAt);
+		}
+	}
+
+	FMemoryWriter Writer(Record.Bytes);
+	AssetRegisterDiskCache::SerializeAssetRecord(Writer, RecordAsset, RecordSelection);
+	Record.Entry.Size = Record.Bytes.Num();
+
+	PendingRecords.Add(Record.Entry.Hash, MoveTemp(Record));
+}
+
+double FAssetRegisterDiskCache::GetAge(const FIndexEntry& Entry)
+{
+	return static_cast<double>(FDateTime::UtcNow().GetTicks() - Entry.FetchedAt) / ETimespan::TicksPerSecond;
+}
+
+bool FAssetRegisterDiskCache::IsStale(double Age)
+{
+	const UAssetRegisterSettings* Settings = GetDefault<UAssetRegisterSettings>();
+	const double Freshness = Settings ? Settings->DiskCacheFreshness : 0.0;
+	return Age > Freshness;
+}
+
+bool FAssetRegisterDiskCache::MapFile()
+{
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	if (!PlatformFile.FileExists(*Path))
+	{
+		return true;
+	}
+
+	MappedFile.Reset(PlatformFile.OpenMapped(*Path));
+	if (MappedFile.IsValid() && MappedFile->GetFileSize() > 0)
+	{
+		MappedRegion.Reset(MappedFile->MapRegion(0, MappedFile->GetFileSize()));
+	}
+
+	if (MappedRegion.IsValid())
+	{
+		FileData = MakeArrayView(MappedRegion->GetMappedPtr(), static_cast<int32>(MappedRegion->GetMappedSize()));
+	}
+	else
+	{
+		MappedFile.Reset();
+		if (!FFileHelper::LoadFileToArray(LoadedFile, *Path))
+		{
+			UE_LOG(LogAssetRegister, Warning, TEXT("FAssetRegisterDiskCache::Open failed to read %s"), *Path);
+			return false;
+		}
+		FileData = LoadedFile;
+	}
+
+	FFileHeader Header;
+	if (FileData.Num() >= static_cast<int32>(sizeof(FFileHeader)))
+	{
+		FMemory::Memcpy(&Header, FileData.GetData(), sizeof(FFileHeader));
+	}
+
+	const bool bValid = Header.Magic == FileMagic
+		&& Header.Version == FileVersion
+		&& Header.FileSize == static_cast<uint64>(FileData.Num())
+		&& Header.IndexOffset % 8 == 0
+		&& Header.IndexOffset + static_cast<uint64>(Header.NumRecords) * sizeof(FIndexEntry) == Header.FileSize;
+	if (!bValid)
+	{
+		UE_LOG(LogAssetRegister, Log, TEXT("FAssetRegisterDiskCache::Open %s is outdated or corrupt, starting empty"), *Path);
+		UnmapFile();
+		return false;
+	}
+
+	Index = MakeArrayView(reinterpret_cast<const FIndexEntry*>(FileData.GetData() + Header.IndexOffset), Header.NumRecords);
+	return true;
+}
+
+void FAssetRegisterDiskCache::UnmapFile()
+{
+	Index = TConstArrayView<FIndexEntry>();
+	FileData = TConstArrayView<uint8>();
+	MappedRegion.Reset();
+	MappedFile.Reset();
+	LoadedFile.Empty();
+}
+
+bool FAssetRegisterDiskCache::Tick(float DeltaTime)
+{
+	if (FlushFuture.IsValid() && !FlushFuture.IsReady())
+	{
+		return true;
+	}
+
+	{
+		FScopeLock Lock(&CriticalSection);
+		if (!BeginFlushLocked())
+		{
+			return true;
+		}
+	}
+	FlushFuture = Async(EAsyncExecution::ThreadPool, [this]() { return WriteFlushingRecords(); });
+	return true;
+}
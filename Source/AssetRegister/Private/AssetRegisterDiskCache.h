@@ -0,0 +1,162 @@
+// Copyright (c) 2025, Futureverse Corporation Limited. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AssetRegisterAssetCache.h"
+#include "Async/Future.h"
+#include "Containers/Ticker.h"
+#include "Schemas/Assets.h"
+
+class IMappedFileHandle;
+class IMappedFileRegion;
+
+/**
+ * Persistent cache of decoded assets and GetAssets pages, kept in a versioned binary file that is memory-mapped
+ * when opened. The file ends with an index sorted by key hash, so a lookup is a binary search over the mapped
+ * index and only the records that are asked for get decoded.
+ *
+ * File layout, little-endian and 8-byte aligned:
+ *   FFileHeader
+ *   Records, each FArchive serialized (see SerializeAssetRecord/SerializeAssetsPage in the .cpp)
+ *   FIndexEntry[NumRecords], sorted by Hash
+ *
+ * Added records are kept in memory and written together with the mapped ones by Flush(), which runs periodically on
+ * a worker while there are unwritten records, and on Close(). Lookups only wait for it while the new file replaces the
+ * old one. Open, Close and Flush are called from the game thread.
+ */
+class FAssetRegisterDiskCache
+{
+public:
+	static FAssetRegisterDiskCache& Get();
+
+	/** Saved/AssetRegister/AssetCache.bin */
+	static FString GetDefaultPath();
+
+	~FAssetRegisterDiskCache();
+
+	/**
+	 * Opens the cache file at InPath. A missing, outdated or corrupt file leaves the cache empty, and is replaced on the next Flush().
+	 *
+	 * @return False if the file existed but couldn't be used.
+	 */
+	bool Open(const FString& InPath);
+
+	/** Flushes and closes the cache file. */
+	void Close();
+
+	bool IsOpen() const;
+
+	/**
+	 * Finds an asset and the selection of the fields stored for it.
+	 *
+	 * @param OutAge Seconds since the asset was fetched. It is stale once that exceeds UAssetRegisterSettings::DiskCacheFreshness.
+	 */
+	bool FindAsset(const FAssetRegisterAssetKey& Key, FAsset& OutAsset, TSharedPtr<const IQueryNode>& OutSelection, double& OutAge);
+
+	/**
+	 * Adds the fields of an asset selected by Selection, merging them into the record of an asset that is already
+	 * cached and not stale. Only fields the record format can hold are stored.
+	 */
+	void AddAsset(const FAsset& Asset, const IQueryNode& Selection);
+
+	/**
+	 * Finds the page a GetAssets query returned, with every asset on it.
+	 *
+	 * @param QueryContent The UTF-8 {"query": ...} json body of the query.
+	 * @param RequiredSelection The fields every asset on the page needs to have stored.
+	 * @param bOutStale Set when the page or any of its assets is stale.
+	 */
+	bool FindAssetsPage(TConstArrayView<uint8> QueryContent, const IQueryNode& RequiredSelection, FAssets& OutAssets, bool& bOutStale);
+
+	/** Adds the page a GetAssets query returned, and the fields NodeSelection selects of the assets on it. */
+	void AddAssetsPage(TConstArrayView<uint8> QueryContent, const FAssets& Assets, const IQueryNode& NodeSelection);
+
+	/**
+	 * Writes the mapped and added records to a new file, dropping the oldest ones above UAssetRegisterSettings::DiskCacheMaxSize,
+	 * and maps it in place of the old one. Waits for a periodic flush in progress first.
+	 */
+	bool Flush();
+
+	int32 GetNumRecords() const;
+
+private:
+	enum class ERecordKind : uint8
+	{
+		Asset,
+		AssetsPage,
+	};
+
+	struct FFileHeader
+	{
+		uint32 Magic = 0;
+		uint32 Version = 0;
+		uint32 NumRecords = 0;
+		uint32 Padding = 0;
+		uint64 IndexOffset = 0;
+		uint64 FileSize = 0;
+	};
+	static_assert(sizeof(FFileHeader) == 32);
+
+	struct FIndexEntry
+	{
+		uint64 Hash = 0;
+		uint64 Offset = 0;
+		uint32 Size = 0;
+		ERecordKind Kind = ERecordKind::Asset;
+		uint8 Padding[3] = {};
+		/** UTC ticks of when the record was fetched. */
+		int64 FetchedAt = 0;
+	};
+	static_assert(sizeof(FIndexEntry) == 32);
+
+	struct FPendingRecord
+	{
+		FIndexEntry Entry;
+		TArray<uint8> Bytes;
+	};
+
+	static constexpr uint32 FileMagic = 0x43445241; // "ARDC"
+	static constexpr uint32 FileVersion = 2;
+
+	static uint64 HashAssetKey(const FAssetRegisterAssetKey& Key);
+	static uint64 HashQuery(TConstArrayView<uint8> QueryContent);
+
+	/** Finds a pending or mapped record, CriticalSection has to be held while OutBytes is used. */
+	bool FindRecord(uint64 Hash, ERecordKind Kind, FIndexEntry& OutEntry, TConstArrayView<uint8>& OutBytes) const;
+	bool FindAssetLocked(const FAssetRegisterAssetKey& Key, FAsset& OutAsset, TSharedPtr<const IQueryNode>& OutSelection, double& OutAge) const;
+	void AddAssetLocked(const FAsset& Asset, const IQueryNode& Selection, int64 Now);
+	/** Seconds since the record was fetched. */
+	static double GetAge(const FIndexEntry& Entry);
+	static bool IsStale(double Age);
+
+	bool MapFile();
+	void UnmapFile();
+
+	/** Moves the pending records to FlushingRecords, false if there are none. */
+	bool BeginFlushLocked();
+	/** Writes the mapped and flushing records to a new file, taking CriticalSection only to replace the old one. */
+	bool WriteFlushingRecords();
+	/** Drops FlushingRecords, or makes them pending again if they weren't written. */
+	void EndFlushLocked(bool bWritten);
+	void WaitForFlush();
+
+	bool Tick(float DeltaTime);
+
+	mutable FCriticalSection CriticalSection;
+	FString Path;
+	bool bIsOpen = false;
+
+	TUniquePtr<IMappedFileHandle> MappedFile;
+	TUniquePtr<IMappedFileRegion> MappedRegion;
+	/** The file contents when the platform can't map files. */
+	TArray<uint8> LoadedFile;
+	TConstArrayView<uint8> FileData;
+	TConstArrayView<FIndexEntry> Index;
+
+	TMap<uint64, FPendingRecord> PendingRecords;
+	/** The records being written by a flush, still found by lookups until the new file is mapped. */
+	TMap<uint64, FPendingRecord> FlushingRecords;
+	FTSTicker::FDelegateHandle FlushTickerHandle;
+	TFuture<bool> FlushFuture;
+};
@@ -0,0 +1,124 @@
+// Copyright (c) 2025, Futureverse Corporation Limited. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/GCObject.h"
+#include "AssetRegisterQueryingLibrary.h"
+
+/**
+ * Helpers for keeping the UObjects created while decoding an asset (ownership and link objects) alive
+ * while a decoded asset is held outside of a UPROPERTY, e.g. in a cache.
+ */
+namespace AssetRegisterGCUtil
+{
+	inline void AddReferencedObjects(FReferenceCollector& Collector, FAsset& Asset)
+	{
+		Collector.AddReferencedObject(Asset.LinkWrapper.Links);
+		Collector.AddReferencedObject(Asset.OwnershipWrapper.Ownership);
+	}
+
+	inline void AddReferencedObjects(FReferenceCollector& Collector, FAssets& Assets)
+	{
+		for (FAssetEdge& Edge : Assets.Edges)
+		{
+			AddReferencedObjects(Collector, Edge.Node);
+		}
+	}
+
+	inline void AddReferencedObjects(FReferenceCollector& Collector, FLoadAssetResult& Result)
+	{
+		AddReferencedObjects(Collector, Result.Value);
+	}
+
+	inline void AddReferencedObjects(FReferenceCollector& Collector, FLoadAssetsResult& Result)
+	{
+		AddReferencedObjects(Collector, Result.Value);
+	}
+
+	inline void AddReferencedObjects(FReferenceCollector& Collector, FLoadAssetBatchResult& Result)
+	{
+		for (FLoadAssetResult& AssetResult : Result.Value)
+		{
+			AddReferencedObjects(Collector, AssetResult);
+		}
+	}
+
+	/**
+	 * Sets or clears EInternalObjectFlags::Async on the UObjects of an asset decoded off the game thread. GC keeps
+	 * objects with the flag alive, so a decoded asset can wait for the game thread without being referenced, and the
+	 * flag has to be cleared once it got there for the objects to be collected again.
+	 */
+	inline void SetAsyncFlags(TConstArrayView<UObject*> Objects, bool bAsync)
+	{
+		for (UObject* Object : Objects)
+		{
+			if (!Object)
+			{
+				continue;
+			}
+			if (bAsync)
+			{
+				Object->SetInternalFlags(EInternalObjectFlags::Async);
+			}
+			else
+			{
+				Object->ClearInternalFlags(EInternalObjectFlags::Async);
+			}
+		}
+	}
+
+	inline void SetAsyncFlags(FAsset& Asset, bool bAsync)
+	{
+		SetAsyncFlags({static_cast<UObject*>(Asset.LinkWrapper.Links), static_cast<UObject*>(Asset.OwnershipWrapper.Ownership)}, bAsync);
+	}
+
+	inline void SetAsyncFlags(FLoadAssetResult& Result, bool bAsync)
+	{
+		SetAsyncFlags(Result.Value, bAsync);
+	}
+
+	inline void SetAsyncFlags(FLoadAssetsResult& Result, bool bAsync)
+	{
+		for (FAssetEdge& Edge : Result.Value.Edges)
+		{
+			SetAsyncFlags(Edge.Node, bAsync);
+		}
+	}
+
+	inline void SetAsyncFlags(FLoadAssetBatchResult& Result, bool bAsync)
+	{
+		for (FLoadAssetResult& AssetResult : Result.Value)
+		{
+			SetAsyncFlags(AssetResult, bAsync);
+		}
+	}
+
+	/** Adds the UObjects of a decoded asset to OutObjects, e.g. to clear their flags once the asset was moved on. */
+	inline void GetObjects(const FAsset& Asset, TArray<UObject*>& OutObjects)
+	{
+		OutObjects.Add(Asset.LinkWrapper.Links);
+		OutObjects.Add(Asset.OwnershipWrapper.Ownership);
+	}
+
+	inline void GetObjects(const FLoadAssetResult& Result, TArray<UObject*>& OutObjects)
+	{
+		GetObjects(Result.Value, OutObjects);
+	}
+
+	inline void GetObjects(const FLoadAssetsResult& Result, TArray<UObject*>& OutObjects)
+	{
+		for (const FAssetEdge& Edge : Result.Value.Edges)
+		{
+			GetObjects(Edge.Node, OutObjects);
+		}
+	}
+
+	inline void GetObjects(const FLoadAssetBatchResult& Result, TArray<UObject*>& OutObjects)
+	{
+		for (const FLoadAssetResult& AssetResult : Result.Value)
+		{
+			GetObjects(AssetResult, OutObjects);
+		}
+	}
+}
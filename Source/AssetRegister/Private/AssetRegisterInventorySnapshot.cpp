@@ -0,0 +1,260 @@
+// Copyright (c) 2025, Futureverse Corporation Limited. All rights reserved.
+
+#include "AssetRegisterInventorySnapshot.h"
+
+#include "AssetRegisterGCUtil.h"
+#include "AssetRegisterLog.h"
+#include "AssetRegisterTrace.h"
+#include "AssetRegisterTransport.h"
+#include "QueryStringUtil.h"
+#include "Hash/CityHash.h"
+#include "Interfaces/IHttpResponse.h"
+
+TSharedRef<FAssetRegisterInventorySnapshot> FAssetRegisterInventorySnapshot::Create(const FAssetConnection& AssetsInput)
+{
+	return MakeShareable(new FAssetRegisterInventorySnapshot(AssetsInput));
+}
+
+FAssetRegisterInventorySnapshot::FAssetRegisterInventorySnapshot(const FAssetConnection& InAssetsInput)
+	: AssetsInput(InAssetsInput)
+{
+	if (AssetsInput.First <= 0)
+	{
+		AssetsInput.First = 100;
+	}
+}
+
+TFuture<FLoadInventoryDiffResult> FAssetRegisterInventorySnapshot::Refresh(const FAssetRegisterDeadline& Deadline)
+{
+	if (bPending.exchange(true))
+	{
+		UE_LOG(LogAssetRegister, Warning, TEXT("FAssetRegisterInventorySnapshot::Refresh called before the previous refresh completed"));
+		auto OutResult = FLoadInventoryDiffResult();
+		OutResult.SetFailure();
+		return MakeFulfilledPromise<FLoadInventoryDiffResult>(MoveTemp(OutResult)).GetFuture();
+	}
+
+	const TSharedRef<FRefresh> NewRefresh = MakeShared<FRefresh>();
+	NewRefresh->PageInput = AssetsInput;
+	NewRefresh->Deadline = Deadline;
+	{
+		FScopeLock Lock(&CriticalSection);
+		Pending = NewRefresh;
+	}
+
+	TFuture<FLoadInventoryDiffResult> Future = NewRefresh->Promise.GetFuture();
+	RequestPage(NewRefresh);
+	return Future;
+}
+
+FLoadInventoryDiffResult FAssetRegisterInventorySnapshot::ApplyResponses(TConstArrayView<TArray<uint8>> PageResponses)
+{
+	if (bPending.exchange(true))
+	{
+		UE_LOG(LogAssetRegister, Warning, TEXT("FAssetRegisterInventorySnapshot::ApplyResponses called while a refresh is pending"));
+		auto OutResult = FLoadInventoryDiffResult();
+		OutResult.SetFailure();
+		return OutResult;
+	}
+
+	const TSharedRef<FRefresh> NewRefresh = MakeShared<FRefresh>();
+	{
+		FScopeLock Lock(&CriticalSection);
+		Pending = NewRefresh;
+	}
+
+	for (const TArray<uint8>& Response : PageResponses)
+	{
+		FPageInfo PageInfo;
+		if (!ApplyPage(*NewRefresh, Response, PageInfo))
+		{
+			return Finish(*NewRefresh, false);
+		}
+	}
+
+	Commit(*NewRefresh);
+	return Finish(*NewRefresh, true);
+}
+
+FAssets FAssetRegisterInventorySnapshot::GetAssets() const
+{
+	FScopeLock Lock(&CriticalSection);
+
+	FAssets Assets;
+	Assets.Edges.Reserve(Nodes.Num());
+	for (const FNode& Node : Nodes)
+	{
+		FAssetEdge& Edge = Assets.Edges.AddDefaulted_GetRef();
+		Edge.Cursor = Node.Cursor;
+		Edge.Node = Node.Asset;
+	}
+	Assets.PageInfo.EndCursor = Nodes.IsEmpty() ? FString() : Nodes.Last().Cursor;
+	Assets.Total = Nodes.Num();
+	return Assets;
+}
+
+int32 FAssetRegisterInventorySnapshot::GetNumAssets() const
+{
+	FScopeLock Lock(&CriticalSection);
+	return Nodes.Num();
+}
+
+void FAssetRegisterInventorySnapshot::RequestPage(const TSharedRef<FRefresh>& InRefresh)
+{
+	const FAssetRegisterRequestScope RequestScope;
+	FAssetRegisterRequest Request;
+	Request.Context = TEXT("RefreshInventorySnapshot");
+	Request.Content = UAssetRegisterQueryingLibrary::GetAssetsQueryNode(InRefresh->PageInput)->GetQueryJsonUtf8();
+	Request.Deadline = InRefresh->Deadline;
+
+	FAssetRegisterTransport::ProcessRequest(MoveTemp(Request)).Next([Snapshot = AsShared(), InRefresh](const FHttpResponsePtr& Response)
+	{
+		FPageInfo PageInfo;
+		if (!Response.IsValid() || Response->GetContent().IsEmpty() || !Snapshot->ApplyPage(*InRefresh, Response->GetContent(), PageInfo))
+		{
+			Snapshot->Finish(*InRefresh, false);
+			return;
+		}
+
+		if (PageInfo.HasNextPage && !PageInfo.EndCursor.IsEmpty())
+		{
+			InRefresh->PageInput.After = PageInfo.EndCursor;
+			Snapshot->RequestPage(InRefresh);
+			return;
+		}
+
+		Snapshot->Commit(*InRefresh);
+		Snapshot->Finish(*InRefresh, true);
+	});
+}
+
+bool FAssetRegisterInventorySnapshot::ApplyPage(FRefresh& InRefresh, TConstArrayView<uint8> Response, FPageInfo& OutPageInfo) const
+{
+	TArray<QueryStringUtil::FEdgeUtf8> Edges;
+	int32 EdgesEnd = INDEX_NONE;
+	if (!QueryStringUtil::TryFindEdgesUtf8(Response, Edges, &EdgesEnd))
+	{
+		UE_LOG(LogAssetRegister, Error, TEXT("FAssetRegisterInventorySnapshot::ApplyPage response has no assets edges"));
+		return false;
+	}
+	QueryStringUtil::TryFindPageInfoUtf8(Response, OutPageInfo.EndCursor, OutPageInfo.HasNextPage, EdgesEnd);
+
+	FScopeLock Lock(&CriticalSection);
+	for (const QueryStringUtil::FEdgeUtf8& Edge : Edges)
+	{
+		FNode Node;
+		Node.Hash = CityHash64(reinterpret_cast<const char*>(Edge.Node.GetData()), Edge.Node.Num());
+		Node.Cursor = Edge.Cursor;
+
+		const int32* UnchangedIndex = NodesByHash.Find(Node.Hash);
+		if (UnchangedIndex)
+		{
+			Node.Asset = Nodes[*UnchangedIndex].Asset;
+		}
+		else
+		{
+			// skipping the node would report its asset as removed
+			FLoadAssetResult Result = UAssetRegisterQueryingLibrary::DecodeAssetNode(Edge.Node);
+			if (!Result.bSuccess)
+			{
+				UE_LOG(LogAssetRegister, Error, TEXT("FAssetRegisterInventorySnapshot::ApplyPage failed to decode the node at cursor %s"), *Edge.Cursor);
+				return false;
+			}
+			Node.Asset = MoveTemp(Result.Value);
+		}
+
+		// an asset can show up again on the next page if the inventory changed while paging
+		const FAssetRegisterAssetKey Key(Node.Asset);
+		bool bAlreadyInRefresh = false;
+		InRefresh.Keys.Add(Key, &bAlreadyInRefresh);
+		if (bAlreadyInRefresh)
+		{
+			continue;
+		}
+
+		if (UnchangedIndex)
+		{
+			++InRefresh.Diff.NumUnchanged;
+		}
+		else if (NodesByKey.Contains(Key))
+		{
+			InRefresh.Diff.Changed.Add(Node.Asset);
+		}
+		else
+		{
+			InRefresh.Diff.Added.Add(Node.Asset);
+		}
+		InRefresh.Nodes.Add(MoveTemp(Node));
+	}
+	return true;
+}
+
+void FAssetRegisterInventorySnapshot::Commit(FRefresh& InRefresh)
+{
+	FScopeLock Lock(&CriticalSection);
+
+	for (const FNode& Node : Nodes)
+	{
+		const FAssetRegisterAssetKey Key(Node.Asset);
+		if (!InRefresh.Keys.Contains(Key))
+		{
+			InRefresh.Diff.Removed.Add(Key);
+		}
+	}
+
+	Nodes = MoveTemp(InRefresh.Nodes);
+	NodesByHash.Reset();
+	NodesByKey.Reset();
+	for (int32 Index = 0; Index < Nodes.Num(); ++Index)
+	{
+		NodesByHash.Add(Nodes[Index].Hash, Index);
+		NodesByKey.Add(FAssetRegisterAssetKey(Nodes[Index].Asset), Index);
+	}
+}
+
+FLoadInventoryDiffResult FAssetRegisterInventorySnapshot::Finish(FRefresh& InRefresh, bool bSuccess)
+{
+	auto OutResult = FLoadInventoryDiffResult();
+	if (bSuccess)
+	{
+		OutResult.SetResult(MoveTemp(InRefresh.Diff));
+	}
+	else
+	{
+		OutResult.SetFailure();
+	}
+
+	{
+		FScopeLock Lock(&CriticalSection);
+		Pending.Reset();
+	}
+	bPending = false;
+
+	if (bSuccess && !OutResult.Value.IsEmpty())
+	{
+		OnChanged.Broadcast(OutResult.Value);
+	}
+	InRefresh.Promise.SetValue(OutResult);
+	return OutResult;
+}
+
+void FAssetRegisterInventorySnapshot::AddReferencedObjects(FReferenceCollector& Collector)
+{
+	FScopeLock Lock(&CriticalSection);
+	for (FNode& Node : Nodes)
+	{
+		AssetRegisterGCUtil::AddReferencedObjects(Collector, Node.Asset);
+	}
+	if (Pending.IsValid())
+	{
+		for (FNode& Node : Pending->Nodes)
+		{
+			AssetRegisterGCUtil::AddReferencedObjects(Collector, Node.Asset);
+		}
+	}
+}
+
+FString FAssetRegisterInventorySnapshot::GetReferencerName() const
+{
+	return TEXT("FAssetRegisterInventorySnapshot");
+}
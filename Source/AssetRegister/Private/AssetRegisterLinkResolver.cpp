@@ -0,0 +1,173 @@
+// Copyright (c) 2025, Futureverse Corporation Limited. All rights reserved.
+
+#include "AssetRegisterLinkResolver.h"
+
+#include "AssetRegisterGCUtil.h"
+#include "AssetRegisterLog.h"
+#include "AssetRegisterSettings.h"
+#include "Schemas/Link.h"
+#include "Schemas/Unions/NFTAssetLink.h"
+
+namespace AssetRegisterLinkResolver
+{
+	/** The fields GetAssetLinks selects, so both load the same cached links. */
+	const TSharedRef<const IQueryNode>& GetLinksSelection()
+	{
+		static const TSharedRef<const IQueryNode> Selection = []()
+		{
+			const TSharedRef<FQueryNode<FAsset>> AssetNode = MakeShared<FQueryNode<FAsset>>(QueryStringUtil::GetQueryName<FAsset>());
+			AssetNode->OnMember(&FAsset::Links)
+			->OnUnion<FNFTAssetLink>()
+				->OnArray(&FNFTAssetLink::ChildLinks)
+					->AddField(&FLink::Path)
+					->OnMember(&FLink::Asset)
+						->AddField(&FAsset::CollectionId)
+						->AddField(&FAsset::TokenId);
+			return AssetNode;
+		}();
+		return Selection;
+	}
+}
+
+TFuture<FLoadLinkGraphResult> FAssetRegisterLinkResolver::Resolve(const FAssetRegisterAssetKey& Root, int32 MaxDepth,
+	const FAssetRegisterDeadline& Deadline)
+{
+	const TSharedRef<FAssetRegisterLinkResolver> Resolver = MakeShareable(new FAssetRegisterLinkResolver(MaxDepth, Deadline));
+	TFuture<FLoadLinkGraphResult> Future = Resolver->Promise.GetFuture();
+	Resolver->ResolveLevel({Resolver->AddNode(Root, 0)});
+	return Future;
+}
+
+FAssetRegisterLinkResolver::FAssetRegisterLinkResolver(int32 InMaxDepth, const FAssetRegisterDeadline& InDeadline)
+	: MaxDepth(FMath::Max(InMaxDepth, 1))
+	, Deadline(InDeadline)
+{
+}
+
+int32 FAssetRegisterLinkResolver::AddNode(const FAssetRegisterAssetKey& Key, int32 Depth)
+{
+	const int32 Index = Graph.Nodes.AddDefaulted();
+	Graph.Nodes[Index].Key = Key;
+	Graph.Nodes[Index].Depth = Depth;
+	Graph.NodeIndices.Add(Key, Index);
+	return Index;
+}
+
+void FAssetRegisterLinkResolver::ResolveLevel(TArray<int32>&& Level)
+{
+	if (Deadline.HasExpired())
+	{
+		UE_LOG(LogAssetRegister, Verbose, TEXT("FAssetRegisterLinkResolver::ResolveLevel deadline expired after %d levels"), Graph.NumLevels);
+		bPartial = true;
+		Finish();
+		return;
+	}
+
+	TArray<FAssetRegisterAssetKey> Keys;
+	Keys.Reserve(Level.Num());
+	for (const int32 Index : Level)
+	{
+		Keys.Add(Graph.Nodes[Index].Key);
+	}
+	++Graph.NumLevels;
+
+	const UAssetRegisterSettings* Settings = GetDefault<UAssetRegisterSettings>();
+	UAssetRegisterQueryingLibrary::GetAssetsBatched(Keys, AssetRegisterLinkResolver::GetLinksSelection(), Settings->AssetLinksFreshness, Deadline).Next(
+	[Resolver = AsShared(), Level = MoveTemp(Level)](const TArray<FLoadAssetResult>& Results)
+	{
+		FAssetRegisterLinkGraph& Graph = Resolver->Graph;
+		TArray<int32> NextLevel;
+		FScopeLock Lock(&Resolver->CriticalSection);
+		for (int32 LevelIndex = 0; LevelIndex < Level.Num(); ++LevelIndex)
+		{
+			const int32 NodeIndex = Level[LevelIndex];
+			const FLoadAssetResult& Result = Results[LevelIndex];
+			if (!Result.bSuccess)
+			{
+				UE_LOG(LogAssetRegister, Warning, TEXT("FAssetRegisterLinkResolver::ResolveLevel failed to load links for %s"),
+					*Graph.Nodes[NodeIndex].Key.ToString());
+				Resolver->bPartial = true;
+				continue;
+			}
+
+			Graph.Nodes[NodeIndex].Asset = Result.Value;
+			Graph.Nodes[NodeIndex].bResolved = true;
+
+			const UNFTAssetLinkObject* Links = Cast<UNFTAssetLinkObject>(Result.Value.LinkWrapper.Links);
+			if (!Links)
+			{
+				continue;
+			}
+
+			const int32 ChildDepth = Graph.Nodes[NodeIndex].Depth + 1;
+			for (const FLink& ChildLink : Links->Data.ChildLinks)
+			{
+				const FAssetRegisterAssetKey ChildKey(ChildLink.Asset.CollectionId, ChildLink.Asset.TokenId);
+				if (!ChildKey.IsValid())
+				{
+					continue;
+				}
+
+				// an asset already in the graph is a shared child or closes a cycle, either way it is resolved once
+				int32 ChildIndex = INDEX_NONE;
+				if (const int32* ExistingIndex = Graph.NodeIndices.Find(ChildKey))
+				{
+					ChildIndex = *ExistingIndex;
+				}
+				else
+				{
+					ChildIndex = Resolver->AddNode(ChildKey, ChildDepth);
+					if (ChildDepth < Resolver->MaxDepth)
+					{
+						NextLevel.Add(ChildIndex);
+					}
+				}
+				Graph.Nodes[NodeIndex].Children.Add({ChildLink.Path, ChildIndex});
+			}
+		}
+
+		Lock.Unlock();
+
+		if (NextLevel.IsEmpty())
+		{
+			Resolver->Finish();
+			return;
+		}
+		Resolver->ResolveLevel(MoveTemp(NextLevel));
+	});
+}
+
+void FAssetRegisterLinkResolver::Finish()
+{
+	FScopeLock Lock(&CriticalSection);
+	auto OutResult = FLoadLinkGraphResult();
+	if (!Graph.Nodes[0].bResolved)
+	{
+		OutResult.SetFailure();
+	}
+	else if (bPartial)
+	{
+		OutResult.SetPartialResult(MoveTemp(Graph));
+	}
+	else
+	{
+		OutResult.SetResult(MoveTemp(Graph));
+	}
+	Lock.Unlock();
+
+	Promise.SetValue(MoveTemp(OutResult));
+}
+
+void FAssetRegisterLinkResolver::AddReferencedObjects(FReferenceCollector& Collector)
+{
+	FScopeLock Lock(&CriticalSection);
+	for (FAssetRegisterLinkNode& Node : Graph.Nodes)
+	{
+		AssetRegisterGCUtil::AddReferencedObjects(Collector, Node.Asset);
+	}
+}
+
+FString FAssetRegisterLinkResolver::GetReferencerName() const
+{
+	return TEXT("FAssetRegisterLinkResolver");
+}
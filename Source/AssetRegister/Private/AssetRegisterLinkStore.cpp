@@ -0,0 +1,308 @@
+// Copyright (c) 2025, Futureverse Corporation Limited. All rights reserved.
+
+#include "AssetRegisterLinkStore.h"
+
+#include "AssetRegisterSettings.h"
+#include "Schemas/Unions/NFTAssetLink.h"
+#include "Schemas/Unions/NFTAssetOwnership.h"
+
+namespace AssetRegisterLinkStore
+{
+	/** Whether Selection selects the parentLink of an asset's links, directly or on one of its union types. */
+	bool SelectsParentLink(const IQueryNode& Selection)
+	{
+		const TSharedPtr<IQueryNode>* Links = Selection.GetChildren().Find(TEXT("links"));
+		if (!Links || !Links->IsValid())
+		{
+			return false;
+		}
+		
+		if ((*Links)->GetChildren().Contains(TEXT("parentLink")))
+		{
+			return true;
+		}
+		for (const auto& ChildPair : (*Links)->GetChildren())
+		{
+			if (ChildPair.Value.IsValid() && ChildPair.Value->IsUnion() && ChildPair.Value->GetChildren().Contains(TEXT("parentLink")))
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+}
+
+FAssetRegisterLinkStore& FAssetRegisterLinkStore::Get()
+{
+	static FAssetRegisterLinkStore Store;
+	return Store;
+}
+
+template<typename TVisit>
+void FAssetRegisterLinkStore::WalkLocked(int32 Start, bool bParents, int32 MaxDepth, TVisit Visit) const
+{
+	TBitArray<> Visited(false, Nodes.Num());
+	TArray<int32> Queue;
+	Queue.Add(Start);
+	Visited[Start] = true;
+
+	int32 Depth = 0;
+	for (int32 LevelStart = 0; LevelStart < Queue.Num() && (MaxDepth == INDEX_NONE || Depth <= MaxDepth); ++Depth)
+	{
+		const int32 LevelEnd = Queue.Num();
+		for (int32 QueueIndex = LevelStart; QueueIndex < LevelEnd; ++QueueIndex)
+		{
+			const int32 Node = Queue[QueueIndex];
+			Visit(Node, Depth);
+
+			auto Enqueue = [&Visited, &Queue](int32 Next)
+			{
+				if (!Visited[Next])
+				{
+					Visited[Next] = true;
+					Queue.Add(Next);
+				}
+			};
+			if (bParents)
+			{
+				for (const int32 Parent : Nodes[Node].Parents)
+				{
+					Enqueue(Parent);
+				}
+			}
+			else
+			{
+				for (const FEdge& Edge : Nodes[Node].Children)
+				{
+					Enqueue(Edge.Node);
+				}
+			}
+		}
+		LevelStart = LevelEnd;
+	}
+}
+
+void FAssetRegisterLinkStore::AddAsset(const FAsset& Asset, const IQueryNode* Selection)
+{
+	const UAssetRegisterSettings* Settings = GetDefault<UAssetRegisterSettings>();
+	const FAssetRegisterAssetKey Key(Asset);
+	if (!Settings || !Settings->bEnableLinkStore || !Key.IsValid())
+	{
+		return;
+	}
+
+	const UNFTAssetOwnershipObject* Ownership = Cast<UNFTAssetOwnershipObject>(Asset.OwnershipWrapper.Ownership);
+	const UNFTAssetLinkObject* Links = Cast<UNFTAssetLinkObject>(Asset.LinkWrapper.Links);
+	if (!Ownership && !Links)
+	{
+		return;
+	}
+
+	FScopeLock Lock(&CriticalSection);
+	const int32 Index = FindOrAddNodeLocked(Key);
+
+	if (Ownership && !Ownership->Data.Owner.Address.IsEmpty())
+	{
+		FString& Owner = Nodes[Index].Owner;
+		if (!Owner.IsEmpty() && Owner != Ownership->Data.Owner.Address)
+		{
+			RemoveChildLinksLocked(Index);
+			RemoveParentLinksLocked(Index);
+			++NumOwnerChanges;
+		}
+		Owner = Ownership->Data.Owner.Address;
+	}
+
+	if (Links)
+	{
+		SetChildLinksLocked(Index, Links->Data.ChildLinks);
+
+		const FAssetRegisterAssetKey ParentKey(Links->Data.ParentLink);
+		if (Selection && AssetRegisterLinkStore::SelectsParentLink(*Selection))
+		{
+			RemoveParentLinksLocked(Index);
+		}
+		if (ParentKey.IsValid())
+		{
+			AddLinkLocked(FindOrAddNodeLocked(ParentKey), Index, FString());
+		}
+	}
+}
+
+void FAssetRegisterLinkStore::SetChildLinks(const FAssetRegisterAssetKey& Parent, TConstArrayView<FLink> ChildLinks)
+{
+	if (!Parent.IsValid())
+	{
+		return;
+	}
+
+	FScopeLock Lock(&CriticalSection);
+	SetChildLinksLocked(FindOrAddNodeLocked(Parent), ChildLinks);
+}
+
+void FAssetRegisterLinkStore::Invalidate(const FAssetRegisterAssetKey& Key)
+{
+	FScopeLock Lock(&CriticalSection);
+	if (const int32* Index = NodeIndices.Find(Key))
+	{
+		RemoveChildLinksLocked(*Index);
+		RemoveParentLinksLocked(*Index);
+		Nodes[*Index].Owner.Reset();
+	}
+}
+
+void FAssetRegisterLinkStore::Clear()
+{
+	FScopeLock Lock(&CriticalSection);
+	Nodes.Empty();
+	NodeIndices.Empty();
+	NumLinks = 0;
+	NumOwnerChanges = 0;
+}
+
+bool FAssetRegisterLinkStore::HasChildLinks(const FAssetRegisterAssetKey& Key) const
+{
+	FScopeLock Lock(&CriticalSection);
+	const int32* Index = NodeIndices.Find(Key);
+	return Index && Nodes[*Index].bHasChildLinks;
+}
+
+TArray<FAssetRegisterChildLink> FAssetRegisterLinkStore::GetChildren(const FAssetRegisterAssetKey& Key) const
+{
+	TArray<FAssetRegisterChildLink> Children;
+
+	FScopeLock Lock(&CriticalSection);
+	if (const int32* Index = NodeIndices.Find(Key))
+	{
+		for (const FEdge& Edge : Nodes[*Index].Children)
+		{
+			Children.Add({Edge.Path, Nodes[Edge.Node].Key});
+		}
+	}
+	return Children;
+}
+
+TArray<FAssetRegisterAssetKey> FAssetRegisterLinkStore::GetParents(const FAssetRegisterAssetKey& Key) const
+{
+	TArray<FAssetRegisterAssetKey> Parents;
+
+	FScopeLock Lock(&CriticalSection);
+	if (const int32* Index = NodeIndices.Find(Key))
+	{
+		for (const int32 Parent : Nodes[*Index].Parents)
+		{
+			Parents.Add(Nodes[Parent].Key);
+		}
+	}
+	return Parents;
+}
+
+TArray<FAssetRegisterAssetKey> FAssetRegisterLinkStore::GetSubtree(const FAssetRegisterAssetKey& Key, int32 MaxDepth) const
+{
+	TArray<FAssetRegisterAssetKey> Subtree;
+
+	FScopeLock Lock(&CriticalSection);
+	if (const int32* Index = NodeIndices.Find(Key))
+	{
+		WalkLocked(*Index, false, MaxDepth, [this, &Subtree](int32 Node, int32 Depth)
+		{
+			if (Depth > 0)
+			{
+				Subtree.Add(Nodes[Node].Key);
+			}
+		});
+	}
+	return Subtree;
+}
+
+TArray<FAssetRegisterAssetKey> FAssetRegisterLinkStore::GetRoots(const FAssetRegisterAssetKey& Key) const
+{
+	TArray<FAssetRegisterAssetKey> Roots;
+
+	FScopeLock Lock(&CriticalSection);
+	if (const int32* Index = NodeIndices.Find(Key))
+	{
+		WalkLocked(*Index, true, INDEX_NONE, [this, &Roots](int32 Node, int32 Depth)
+		{
+			if (Depth > 0 && Nodes[Node].Parents.IsEmpty())
+			{
+				Roots.Add(Nodes[Node].Key);
+			}
+		});
+	}
+	return Roots;
+}
+
+FAssetRegisterLinkStoreStats FAssetRegisterLinkStore::GetStats() const
+{
+	FScopeLock Lock(&CriticalSection);
+
+	FAssetRegisterLinkStoreStats Stats;
+	Stats.NumAssets = Nodes.Num();
+	Stats.NumLinks = NumLinks;
+	Stats.NumOwnerChanges = NumOwnerChanges;
+	return Stats;
+}
+
+int32 FAssetRegisterLinkStore::FindOrAddNodeLocked(const FAssetRegisterAssetKey& Key)
+{
+	if (const int32* Index = NodeIndices.Find(Key))
+	{
+		return *Index;
+	}
+
+	const int32 Index = Nodes.AddDefaulted();
+	Nodes[Index].Key = Key;
+	NodeIndices.Add(Key, Index);
+	return Index;
+}
+
+void FAssetRegisterLinkStore::SetChildLinksLocked(int32 Parent, TConstArrayView<FLink> ChildLinks)
+{
+	RemoveChildLinksLocked(Parent);
+	Nodes[Parent].bHasChildLinks = true;
+
+	for (const FLink& ChildLink : ChildLinks)
+	{
+		const FAssetRegisterAssetKey ChildKey(ChildLink.Asset.CollectionId, ChildLink.Asset.TokenId);
+		if (ChildKey.IsValid())
+		{
+			AddLinkLocked(Parent, FindOrAddNodeLocked(ChildKey), ChildLink.Path);
+		}
+	}
+}
+
+void FAssetRegisterLinkStore::AddLinkLocked(int32 Parent, int32 Child, const FString& Path)
+{
+	for (const FEdge& Edge : Nodes[Parent].Children)
+	{
+		if (Edge.Node == Child)
+		{
+			return;
+		}
+	}
+
+	Nodes[Parent].Children.Add({Child, Path});
+	Nodes[Child].Parents.Add(Parent);
+	++NumLinks;
+}
+
+void FAssetRegisterLinkStore::RemoveChildLinksLocked(int32 Parent)
+{
+	for (const FEdge& Edge : Nodes[Parent].Children)
+	{
+		Nodes[Edge.Node].Parents.RemoveSingleSwap(Parent);
+	}
+	NumLinks -= Nodes[Parent].Children.Num();
+	Nodes[Parent].Children.Reset();
+	Nodes[Parent].bHasChildLinks = false;
+}
+
+void FAssetRegisterLinkStore::RemoveParentLinksLocked(int32 Child)
+{
+	for (const int32 Parent : Nodes[Child].Parents)
+	{
+		NumLinks -= Nodes[Parent].Children.RemoveAllSwap([Child](const FEdge& Edge) { return Edge.Node == Child; });
+	}
+	Nodes[Child].Parents.Reset();
+}
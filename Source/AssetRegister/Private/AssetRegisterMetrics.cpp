@@ -0,0 +1,354 @@
+// Copyright (c) 2025, Futureverse Corporation Limited. All rights reserved.
+
+#include "AssetRegisterMetrics.h"
+
+#include "AssetRegisterAssetCache.h"
+#include "AssetRegisterNegativeCache.h"
+#include "AssetRegisterRequestScheduler.h"
+#include "HAL/IConsoleManager.h"
+#include "Interfaces/IHttpResponse.h"
+#include "ProfilingDebugging/CsvProfiler.h"
+
+CSV_DEFINE_CATEGORY(AssetRegister, true);
+
+namespace AssetRegisterMetrics
+{
+	static FAutoConsoleCommandWithArgsAndOutputDevice StatsCommand(
+		TEXT("ar.stats"),
+		TEXT("Prints the Asset Register request metrics. 'ar.stats reset' clears them."),
+		FConsoleCommandWithArgsAndOutputDeviceDelegate::CreateLambda([](const TArray<FString>& Args, FOutputDevice& Ar)
+		{
+			if (Args.Num() > 0 && Args[0] == TEXT("reset"))
+			{
+				FAssetRegisterMetrics::Get().Reset();
+				Ar.Log(TEXT("AssetRegister metrics reset"));
+				return;
+			}
+
+			TArray<FString> Lines;
+			FAssetRegisterMetrics::Get().GetSnapshot().ToString().ParseIntoArrayLines(Lines, false);
+			for (const FString& Line : Lines)
+			{
+				Ar.Log(Line);
+			}
+		}));
+
+	double ToMilliseconds(uint64 Microseconds)
+	{
+		return Microseconds / 1000.0;
+	}
+
+	FString FormatLatencyRow(const FString& Name, const FAssetRegisterHistogram& Latency, uint64 NumErrors)
+	{
+		return FString::Printf(TEXT("  %-24s %8llu %8llu %9.1f %9.1f %9.1f %9.1f\n"), *Name, Latency.GetTotalCount(), NumErrors,
+			ToMilliseconds(Latency.GetValueAtPercentile(50.0)), ToMilliseconds(Latency.GetValueAtPercentile(95.0)),
+			ToMilliseconds(Latency.GetValueAtPercentile(99.0)), ToMilliseconds(Latency.GetMax()));
+	}
+}
+
+const TCHAR* LexToString(EAssetRegisterErrorClass ErrorClass)
+{
+	switch (ErrorClass)
+	{
+	case EAssetRegisterErrorClass::Connection: return TEXT("Connection");
+	case EAssetRegisterErrorClass::Timeout: return TEXT("Timeout");
+	case EAssetRegisterErrorClass::RateLimited: return TEXT("RateLimited");
+	case EAssetRegisterErrorClass::ClientError: return TEXT("ClientError");
+	case EAssetRegisterErrorClass::ServerError: return TEXT("ServerError");
+	case EAssetRegisterErrorClass::Decode: return TEXT("Decode");
+	default: return TEXT("Unknown");
+	}
+}
+
+FAssetRegisterHistogram::FAssetRegisterHistogram()
+{
+	Counts.SetNumZeroed(GetCountsIndex(MaxValue) + 1);
+}
+
+int32 FAssetRegisterHistogram::GetCountsIndex(uint64 Value)
+{
+	// the power of two bucket above the first, which covers [0, 2 * SubBucketHalfCount) linearly
+	const int32 BucketIndex = 64 - static_cast<int32>(FMath::CountLeadingZeros64(Value | SubBucketMask)) - (SubBucketHalfCountMagnitude + 1);
+	const int32 SubBucketIndex = static_cast<int32>(Value >> BucketIndex);
+	return ((BucketIndex + 1) << SubBucketHalfCountMagnitude) + SubBucketIndex - SubBucketHalfCount;
+}
+
+uint64 FAssetRegisterHistogram::GetHighestEquivalentValue(int32 CountsIndex)
+{
+	int32 BucketIndex = (CountsIndex >> SubBucketHalfCountMagnitude) - 1;
+	int32 SubBucketIndex = (CountsIndex & (SubBucketHalfCount - 1)) + SubBucketHalfCount;
+	if (BucketIndex < 0)
+	{
+		SubBucketIndex -= SubBucketHalfCount;
+		BucketIndex = 0;
+	}
+	return (static_cast<uint64>(SubBucketIndex) << BucketIndex) + (1ull << BucketIndex) - 1;
+}
+
+void FAssetRegisterHistogram::Record(uint64 Value, uint64 Count)
+{
+	Value = FMath::Min(Value, MaxValue);
+	Counts[GetCountsIndex(Value)] += Count;
+	TotalCount += Count;
+	Sum += Value * Count;
+	Min = FMath::Min(Min, Value);
+	Max = FMath::Max(Max, Value);
+}
+
+void FAssetRegisterHistogram::Add(const FAssetRegisterHistogram& Other)
+{
+	for (int32 Index = 0; Index < Counts.Num(); ++Index)
+	{
+		Counts[Index] += Other.Counts[Index];
+	}
+	TotalCount += Other.TotalCount;
+	Sum += Other.Sum;
+	Min = FMath::Min(Min, Other.Min);
+	Max = FMath::Max(Max, Other.Max);
+}
+
+void FAssetRegisterHistogram::Reset()
+{
+	FMemory::Memzero(Counts.GetData(), Counts.Num() * sizeof(uint64));
+	TotalCount = 0;
+	Sum = 0;
+	Min = MAX_uint64;
+	Max = 0;
+}
+
+uint64 FAssetRegisterHistogram::GetValueAtPercentile(double Percentile) const
+{
+	if (TotalCount == 0)
+	{
+		return 0;
+	}
+
+	const uint64 TargetCount = FMath::Max<uint64>(1, static_cast<uint64>(FMath::CeilToDouble(FMath::Clamp(Percentile, 0.0, 100.0) / 100.0 * TotalCount)));
+	uint64 CumulativeCount = 0;
+	for (int32 Index = 0; Index < Counts.Num(); ++Index)
+	{
+		CumulativeCount += Counts[Index];
+		if (CumulativeCount >= TargetCount)
+		{
+			return FMath::Min(GetHighestEquivalentValue(Index), Max);
+		}
+	}
+	return Max;
+}
+
+void FAssetRegisterRateCounter::Add(double Now, uint64 Amount)
+{
+	const int64 Second = FMath::FloorToInt64(Now);
+	const int32 Slot = static_cast<int32>(Second % WindowSeconds);
+	if (Seconds[Slot] != Second)
+	{
+		Seconds[Slot] = Second;
+		Amounts[Slot] = 0;
+	}
+	Amounts[Slot] += Amount;
+	Total += Amount;
+}
+
+double FAssetRegisterRateCounter::GetRate(double Now) const
+{
+	const int64 Second = FMath::FloorToInt64(Now);
+	uint64 WindowAmount = 0;
+	for (int32 Slot = 0; Slot < WindowSeconds; ++Slot)
+	{
+		if (Second - Seconds[Slot] < WindowSeconds)
+		{
+			WindowAmount += Amounts[Slot];
+		}
+	}
+	return static_cast<double>(WindowAmount) / WindowSeconds;
+}
+
+FString FAssetRegisterMetricsSnapshot::ToString() const
+{
+	using namespace AssetRegisterMetrics;
+
+	FString Report = TEXT("AssetRegister metrics\n");
+	Report += FString::Printf(TEXT("  Requests: %llu (%.1f/s), errors: %llu (%.1f/s), 304 Not Modified: %llu\n"),
+		NumRequests, RequestsPerSecond, NumErrors, ErrorsPerSecond, NumNotModified);
+
+	Report += TEXT("  Errors by class:");
+	for (int32 Index = 0; Index < static_cast<int32>(EAssetRegisterErrorClass::Num); ++Index)
+	{
+		Report += FString::Printf(TEXT(" %s %llu"), LexToString(static_cast<EAssetRegisterErrorClass>(Index)), NumErrorsByClass[Index]);
+	}
+	Report += TEXT("\n");
+
+	Report += FString::Printf(TEXT("  Bytes sent: %.1f KB, received: %.1f KB (%.1f KB/s)\n"),
+		BytesSent / 1024.0, BytesReceived / 1024.0, BytesReceivedPerSecond / 1024.0);
+	Report += FString::Printf(TEXT("  In flight: %d (max %d), queued: %d (max %d)\n"), NumInFlight, MaxInFlight, NumQueued, MaxQueued);
+	Report += FString::Printf(TEXT("  Asset cache hit rate: %.1f%%, negative cache hits: %llu\n"), AssetCacheHitRate * 100.0, NegativeCacheHits);
+
+	Report += FString::Printf(TEXT("  %-24s %8s %8s %9s %9s %9s %9s\n"), TEXT("Latency (ms)"), TEXT("Count"), TEXT("Errors"),
+		TEXT("p50"), TEXT("p95"), TEXT("p99"), TEXT("Max"));
+	Report += FormatLatencyRow(TEXT("All"), Latency, NumErrors);
+
+	TArray<FString> QueryTypes;
+	Queries.GetKeys(QueryTypes);
+	QueryTypes.Sort();
+	for (const FString& QueryType : QueryTypes)
+	{
+		const FAssetRegisterQueryMetrics& Query = Queries[QueryType];
+		Report += FormatLatencyRow(QueryType, Query.Latency, Query.NumErrors);
+	}
+	return Report;
+}
+
+FAssetRegisterMetrics& FAssetRegisterMetrics::Get()
+{
+	static FAssetRegisterMetrics Metrics;
+	return Metrics;
+}
+
+FAssetRegisterMetrics::FAssetRegisterMetrics()
+{
+	TickerHandle = FTSTicker::GetCoreTicker().AddTicker(TEXT("AssetRegisterMetrics"), 0.f, [this](float DeltaTime)
+	{
+		return Tick(DeltaTime);
+	});
+}
+
+void FAssetRegisterMetrics::RecordRequest(const TCHAR* QueryType, int64 NumBytes)
+{
+	const double Now = FPlatformTime::Seconds();
+
+	FScopeLock Lock(&CriticalSection);
+	Requests.Add(Now);
+	BytesSent += NumBytes;
+	++FindOrAddQuery(QueryType).NumRequests;
+}
+
+void FAssetRegisterMetrics::RecordResponse(const TCHAR* QueryType, double LatencySeconds, int64 NumBytes, int32 ResponseCode,
+	TOptional<EAssetRegisterErrorClass> ErrorClass)
+{
+	const double Now = FPlatformTime::Seconds();
+	const uint64 LatencyMicroseconds = static_cast<uint64>(FMath::Max(LatencySeconds, 0.0) * 1000000.0);
+
+	FScopeLock Lock(&CriticalSection);
+	FAssetRegisterQueryMetrics& Query = FindOrAddQuery(QueryType);
+	Query.Latency.Record(LatencyMicroseconds);
+	Latency.Record(LatencyMicroseconds);
+	FrameMaxLatency = FMath::Max(FrameMaxLatency, LatencySeconds * 1000.0);
+	BytesReceived.Add(Now, NumBytes);
+
+	if (ResponseCode == EHttpResponseCodes::NotModified)
+	{
+		++NumNotModified;
+	}
+
+	if (ErrorClass.IsSet())
+	{
+		Errors.Add(Now);
+		++NumErrorsByClass[static_cast<int32>(ErrorClass.GetValue())];
+		++Query.NumErrors;
+	}
+}
+
+void FAssetRegisterMetrics::RecordError(const TCHAR* QueryType, EAssetRegisterErrorClass ErrorClass)
+{
+	const double Now = FPlatformTime::Seconds();
+
+	FScopeLock Lock(&CriticalSection);
+	Errors.Add(Now);
+	++NumErrorsByClass[static_cast<int32>(ErrorClass)];
+	++FindOrAddQuery(QueryType).NumErrors;
+}
+
+TOptional<EAssetRegisterErrorClass> FAssetRegisterMetrics::ClassifyResponse(bool bWasSuccessful, int32 ResponseCode, bool bDeadlineExpired)
+{
+	if (!bWasSuccessful || ResponseCode == 0)
+	{
+		return bDeadlineExpired ? EAssetRegisterErrorClass::Timeout : EAssetRegisterErrorClass::Connection;
+	}
+	if (ResponseCode == EHttpResponseCodes::TooManyRequests)
+	{
+		return EAssetRegisterErrorClass::RateLimited;
+	}
+	if (ResponseCode >= 500)
+	{
+		return EAssetRegisterErrorClass::ServerError;
+	}
+	if (ResponseCode >= 400)
+	{
+		return EAssetRegisterErrorClass::ClientError;
+	}
+	return {};
+}
+
+FAssetRegisterMetricsSnapshot FAssetRegisterMetrics::GetSnapshot() const
+{
+	const double Now = FPlatformTime::Seconds();
+
+	FAssetRegisterMetricsSnapshot Snapshot;
+	Snapshot.NumInFlight = FAssetRegisterRequestScheduler::Get().GetNumInFlight();
+	Snapshot.NumQueued = FAssetRegisterRequestScheduler::Get().GetNumQueued();
+	Snapshot.AssetCacheHitRate = FAssetRegisterAssetCache::Get().GetStats().GetHitRate();
+	Snapshot.NegativeCacheHits = FAssetRegisterNegativeCache::Get().GetStats().Hits;
+
+	FScopeLock Lock(&CriticalSection);
+	Snapshot.NumRequests = Requests.GetTotal();
+	Snapshot.RequestsPerSecond = Requests.GetRate(Now);
+	Snapshot.NumErrors = Errors.GetTotal();
+	Snapshot.ErrorsPerSecond = Errors.GetRate(Now);
+	FMemory::Memcpy(Snapshot.NumErrorsByClass, NumErrorsByClass, sizeof(NumErrorsByClass));
+	Snapshot.NumNotModified = NumNotModified;
+	Snapshot.BytesSent = BytesSent;
+	Snapshot.BytesReceived = BytesReceived.GetTotal();
+	Snapshot.BytesReceivedPerSecond = BytesReceived.GetRate(Now);
+	Snapshot.MaxInFlight = FMath::Max(MaxInFlight, Snapshot.NumInFlight);
+	Snapshot.MaxQueued = FMath::Max(MaxQueued, Snapshot.NumQueued);
+	Snapshot.Latency = Latency;
+	Snapshot.Queries = Queries;
+	return Snapshot;
+}
+
+void FAssetRegisterMetrics::Reset()
+{
+	FScopeLock Lock(&CriticalSection);
+	Requests = FAssetRegisterRateCounter();
+	Errors = FAssetRegisterRateCounter();
+	BytesReceived = FAssetRegisterRateCounter();
+	FMemory::Memzero(NumErrorsByClass, sizeof(NumErrorsByClass));
+	NumNotModified = 0;
+	BytesSent = 0;
+	MaxInFlight = 0;
+	MaxQueued = 0;
+	Latency.Reset();
+	Queries.Reset();
+	LastNumRequests = 0;
+	LastNumErrors = 0;
+	LastBytesReceived = 0;
+	FrameMaxLatency = 0.0;
+}
+
+bool FAssetRegisterMetrics::Tick(float DeltaTime)
+{
+	const int32 NumInFlight = FAssetRegisterRequestScheduler::Get().GetNumInFlight();
+	const int32 NumQueued = FAssetRegisterRequestScheduler::Get().GetNumQueued();
+
+	FScopeLock Lock(&CriticalSection);
+	MaxInFlight = FMath::Max(MaxInFlight, NumInFlight);
+	MaxQueued = FMath::Max(MaxQueued, NumQueued);
+
+	CSV_CUSTOM_STAT(AssetRegister, InFlight, NumInFlight, ECsvCustomStatOp::Set);
+	CSV_CUSTOM_STAT(AssetRegister, Queued, NumQueued, ECsvCustomStatOp::Set);
+	CSV_CUSTOM_STAT(AssetRegister, Requests, static_cast<int32>(Requests.GetTotal() - LastNumRequests), ECsvCustomStatOp::Set);
+	CSV_CUSTOM_STAT(AssetRegister, Errors, static_cast<int32>(Errors.GetTotal() - LastNumErrors), ECsvCustomStatOp::Set);
+	CSV_CUSTOM_STAT(AssetRegister, KBReceived, static_cast<float>((BytesReceived.GetTotal() - LastBytesReceived) / 1024.0), ECsvCustomStatOp::Set);
+	CSV_CUSTOM_STAT(AssetRegister, MaxLatencyMs, static_cast<float>(FrameMaxLatency), ECsvCustomStatOp::Set);
+
+	LastNumRequests = Requests.GetTotal();
+	LastNumErrors = Errors.GetTotal();
+	LastBytesReceived = BytesReceived.GetTotal();
+	FrameMaxLatency = 0.0;
+	return true;
+}
+
+FAssetRegisterQueryMetrics& FAssetRegisterMetrics::FindOrAddQuery(const TCHAR* QueryType)
+{
+	return Queries.FindOrAdd(QueryType);
+}
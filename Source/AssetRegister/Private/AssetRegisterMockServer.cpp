@@ -0,0 +1,970 @@
+// Copyright (c) 2025, Futureverse Corporation Limited. All rights reserved.
+
+#include "AssetRegisterMockServer.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "AssetRegisterCapture.h"
+#include "AssetRegisterLog.h"
+#include "Containers/Ticker.h"
+#include "Dom/JsonObject.h"
+#include "GenericPlatform/GenericPlatformHttp.h"
+#include "HttpPath.h"
+#include "HttpServerModule.h"
+#include "HttpServerRequest.h"
+#include "HttpServerResponse.h"
+#include "IHttpRouter.h"
+#include "Misc/Base64.h"
+#include "Misc/Parse.h"
+#include "QueryStringUtil.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+
+namespace AssetRegisterMockServer
+{
+	constexpr int32 StatusOk = 200;
+	constexpr int32 StatusBadRequest = 400;
+	constexpr int32 StatusNotModified = 304;
+	constexpr int32 StatusTooManyRequests = 429;
+	constexpr int32 StatusServiceUnavailable = 503;
+
+	const TArray<FString>* FindHeader(const FHttpServerRequest& Request, const FString& HeaderName)
+	{
+		for (const auto& Pair : Request.Headers)
+		{
+			if (Pair.Key.Equals(HeaderName, ESearchCase::IgnoreCase))
+			{
+				return &Pair.Value;
+			}
+		}
+		return nullptr;
+	}
+
+	/** A field of a query, with the fields selected on it. */
+	struct FSelection
+	{
+		FString Alias;
+		FString Name;
+		TSharedRef<FJsonObject> Arguments = MakeShared<FJsonObject>();
+		TArray<FSelection> Children;
+
+		/** The name of the field in the response. */
+		const FString& GetResponseName() const
+		{
+			return Alias.IsEmpty() ? Name : Alias;
+		}
+	};
+
+	/**
+	 * Parses the subset of GraphQL the SDK writes: one query of fields with aliases, arguments and inline fragments.
+	 * Variables, directives and named fragments aren't supported. The type conditions of inline fragments are ignored,
+	 * their fields are selected on the enclosing field.
+	 */
+	class FQueryParser
+	{
+	public:
+		explicit FQueryParser(const FString& InQuery)
+			: Query(InQuery)
+		{
+		}
+
+		bool Parse(TArray<FSelection>& OutSelections)
+		{
+			SkipIgnored();
+			if (!Peek(TEXT('{')))
+			{
+				FString Operation;
+				if (!ParseName(Operation) || Operation != TEXT("query"))
+				{
+					return Fail(TEXT("only queries are supported"));
+				}
+				SkipIgnored();
+				FString OperationName;
+				if (!Peek(TEXT('{')) && !Peek(TEXT('(')) && !ParseName(OperationName))
+				{
+					return false;
+				}
+				SkipIgnored();
+				if (Peek(TEXT('(')))
+				{
+					return Fail(TEXT("variables are not supported"));
+				}
+			}
+
+			if (!ParseSelectionSet(OutSelections))
+			{
+				return false;
+			}
+			SkipIgnored();
+			return Position == Query.Len() || Fail(TEXT("unexpected characters after the query"));
+		}
+
+		const FString& GetError() const
+		{
+			return Error;
+		}
+
+	private:
+		bool Fail(const FString& Message)
+		{
+			if (Error.IsEmpty())
+			{
+				Error = FString::Printf(TEXT("%s at %d"), *Message, Position);
+			}
+			return false;
+		}
+
+		void SkipIgnored()
+		{
+			while (Position < Query.Len())
+			{
+				const TCHAR Char = Query[Position];
+				if (Char == TEXT('#'))
+				{
+					while (Position < Query.Len() && Query[Position] != TEXT('\n'))
+					{
+						++Position;
+					}
+				}
+				else if (FChar::IsWhitespace(Char) || Char == TEXT(','))
+				{
+					++Position;
+				}
+				else
+				{
+					break;
+				}
+			}
+		}
+
+		bool Peek(TCHAR Char) const
+		{
+			return Position < Query.Len() && Query[Position] == Char;
+		}
+
+		bool Consume(TCHAR Char)
+		{
+			SkipIgnored();
+			if (!Peek(Char))
+			{
+				return Fail(FString::Printf(TEXT("expected '%c'"), Char));
+			}
+			++Position;
+			return true;
+		}
+
+		bool ParseName(FString& OutName)
+		{
+			SkipIgnored();
+			const int32 Start = Position;
+			while (Position < Query.Len() && (FChar::IsAlnum(Query[Position]) || Query[Position] == TEXT('_')))
+			{
+				++Position;
+			}
+			if (Position == Start || FChar::IsDigit(Query[Start]))
+			{
+				return Fail(TEXT("expected a name"));
+			}
+			OutName = Query.Mid(Start, Position - Start);
+			return true;
+		}
+
+		bool ParseSelectionSet(TArray<FSelection>& OutSelections)
+		{
+			if (!Consume(TEXT('{')))
+			{
+				return false;
+			}
+
+			while (true)
+			{
+				SkipIgnored();
+				if (Peek(TEXT('}')))
+				{
+					++Position;
+					return true;
+				}
+				if (Position >= Query.Len())
+				{
+					return Fail(TEXT("unterminated selection set"));
+				}
+
+				if (Query.Mid(Position, 3) == TEXT("..."))
+				{
+					Position += 3;
+					FString On;
+					FString TypeCondition;
+					if (!ParseName(On) || On != TEXT("on") || !ParseName(TypeCondition))
+					{
+						return Fail(TEXT("only inline fragments with a type condition are supported"));
+					}
+					if (!ParseSelectionSet(OutSelections))
+					{
+						return false;
+					}
+					continue;
+				}
+
+				FSelection& Selection = OutSelections.AddDefaulted_GetRef();
+				if (!ParseName(Selection.Name))
+				{
+					return false;
+				}
+				SkipIgnored();
+				if (Peek(TEXT(':')))
+				{
+					++Position;
+					Selection.Alias = MoveTemp(Selection.Name);
+					if (!ParseName(Selection.Name))
+					{
+						return false;
+					}
+					SkipIgnored();
+				}
+				if (Peek(TEXT('(')) && !ParseArguments(*Selection.Arguments))
+				{
+					return false;
+				}
+				SkipIgnored();
+				if (Peek(TEXT('@')))
+				{
+					return Fail(TEXT("directives are not supported"));
+				}
+				if (Peek(TEXT('{')) && !ParseSelectionSet(Selection.Children))
+				{
+					return false;
+				}
+			}
+		}
+
+		bool ParseArguments(FJsonObject& OutArguments)
+		{
+			if (!Consume(TEXT('(')))
+			{
+				return false;
+			}
+			while (true)
+			{
+				SkipIgnored();
+				if (Peek(TEXT(')')))
+				{
+					++Position;
+					return true;
+				}
+
+				FString Name;
+				TSharedPtr<FJsonValue> Value;
+				if (!ParseName(Name) || !Consume(TEXT(':')) || !ParseValue(Value))
+				{
+					return false;
+				}
+				OutArguments.SetField(Name, Value);
+			}
+		}
+
+		bool ParseValue(TSharedPtr<FJsonValue>& OutValue)
+		{
+			SkipIgnored();
+			if (Position >= Query.Len())
+			{
+				return Fail(TEXT("expected a value"));
+			}
+
+			const TCHAR Char = Query[Position];
+			if (Char == TEXT('"'))
+			{
+				FString String;
+				if (!ParseString(String))
+				{
+					return false;
+				}
+				OutValue = MakeShared<FJsonValueString>(String);
+				return true;
+			}
+			if (Char == TEXT('['))
+			{
+				++Position;
+				TArray<TSharedPtr<FJsonValue>> Values;
+				while (true)
+				{
+					SkipIgnored();
+					if (Peek(TEXT(']')))
+					{
+						++Position;
+						OutValue = MakeShared<FJsonValueArray>(Values);
+						return true;
+					}
+					if (!ParseValue(Values.AddDefaulted_GetRef()))
+					{
+						return false;
+					}
+				}
+			}
+			if (Char == TEXT('{'))
+			{
+				++Position;
+				TSharedRef<FJsonObject> Object = MakeShared<FJsonObject>();
+				while (true)
+				{
+					SkipIgnored();
+					if (Peek(TEXT('}')))
+					{
+						++Position;
+						OutValue = MakeShared<FJsonValueObject>(Object);
+						return true;
+					}
+					FString Name;
+					TSharedPtr<FJsonValue> Value;
+					if (!ParseName(Name) || !Consume(TEXT(':')) || !ParseValue(Value))
+					{
+						return false;
+					}
+					Object->SetField(Name, Value);
+				}
+			}
+			if (Char == TEXT('$'))
+			{
+				return Fail(TEXT("variables are not supported"));
+			}
+			if (Char == TEXT('-') || FChar::IsDigit(Char))
+			{
+				const int32 Start = Position++;
+				while (Position < Query.Len() && (FChar::IsDigit(Query[Position]) || FCString::Strchr(TEXT(".eE+-"), Query[Position])))
+				{
+					++Position;
+				}
+				OutValue = MakeShared<FJsonValueNumber>(FCString::Atod(*Query.Mid(Start, Position - Start)));
+				return true;
+			}
+
+			FString Name;
+			if (!ParseName(Name))
+			{
+				return false;
+			}
+			if (Name == TEXT("true") || Name == TEXT("false"))
+			{
+				OutValue = MakeShared<FJsonValueBoolean>(Name == TEXT("true"));
+			}
+			else if (Name == TEXT("null"))
+			{
+				OutValue = MakeShared<FJsonValueNull>();
+			}
+			else
+			{
+				// enum values are compared as strings
+				OutValue = MakeShared<FJsonValueString>(Name);
+			}
+			return true;
+		}
+
+		bool ParseString(FString& OutString)
+		{
+			++Position;
+			while (Position < Query.Len())
+			{
+				const TCHAR Char = Query[Position++];
+				if (Char == TEXT('"'))
+				{
+					return true;
+				}
+				if (Char != TEXT('\\'))
+				{
+					OutString.AppendChar(Char);
+					continue;
+				}
+				if (Position >= Query.Len())
+				{
+					break;
+				}
+
+				const TCHAR Escaped = Query[Position++];
+				switch (Escaped)
+				{
+				case TEXT('n'): OutString.AppendChar(TEXT('\n')); break;
+				case TEXT('r'): OutString.AppendChar(TEXT('\r')); break;
+				case TEXT('t'): OutString.AppendChar(TEXT('\t')); break;
+				case TEXT('b'): OutString.AppendChar(TEXT('\b')); break;
+				case TEXT('f'): OutString.AppendChar(TEXT('\f')); break;
+				case TEXT('u'):
+					if (Position + 4 > Query.Len())
+					{
+						return Fail(TEXT("invalid unicode escape"));
+					}
+					OutString.AppendChar(static_cast<TCHAR>(FParse::HexNumber(*Query.Mid(Position, 4))));
+					Position += 4;
+					break;
+				default: OutString.AppendChar(Escaped); break;
+				}
+			}
+			return Fail(TEXT("unterminated string"));
+		}
+
+		const FString& Query;
+		int32 Position = 0;
+		FString Error;
+	};
+
+	/** The fields of Value selected by Selections, recursing into objects and arrays. Values without a selection are copied whole. */
+	TSharedPtr<FJsonValue> Project(const TSharedPtr<FJsonValue>& Value, const TArray<FSelection>& Selections)
+	{
+		if (!Value.IsValid() || Selections.IsEmpty())
+		{
+			return Value.IsValid() ? Value : MakeShared<FJsonValueNull>();
+		}
+
+		if (Value->Type == EJson::Array)
+		{
+			TArray<TSharedPtr<FJsonValue>> Projected;
+			for (const TSharedPtr<FJsonValue>& Element : Value->AsArray())
+			{
+				Projected.Add(Project(Element, Selections));
+			}
+			return MakeShared<FJsonValueArray>(Projected);
+		}
+
+		if (Value->Type != EJson::Object)
+		{
+			return Value;
+		}
+
+		const TSharedPtr<FJsonObject> Object = Value->AsObject();
+		TSharedRef<FJsonObject> Projected = MakeShared<FJsonObject>();
+		for (const FSelection& Selection : Selections)
+		{
+			Projected->SetField(Selection.GetResponseName(), Project(Object->TryGetField(Selection.Name), Selection.Children));
+		}
+		return MakeShared<FJsonValueObject>(Projected);
+	}
+
+	FString GetStringField(const TSharedPtr<FJsonObject>& Object, const TCHAR* FieldName)
+	{
+		FString Value;
+		if (Object.IsValid())
+		{
+			Object->TryGetStringField(FieldName, Value);
+		}
+		return Value;
+	}
+
+	FString GetOwnerAddress(const TSharedPtr<FJsonObject>& Asset)
+	{
+		const TSharedPtr<FJsonObject>* Ownership = nullptr;
+		const TSharedPtr<FJsonObject>* Owner = nullptr;
+		if (Asset->TryGetObjectField(TEXT("ownership"), Ownership) && (*Ownership)->TryGetObjectField(TEXT("owner"), Owner))
+		{
+			return GetStringField(*Owner, TEXT("address"));
+		}
+		return FString();
+	}
+
+	/** The cursor of an asset in an assets response, its ids base64 encoded. */
+	FString MakeCursor(const TSharedPtr<FJsonObject>& Asset)
+	{
+		return FBase64::Encode(GetStringField(Asset, TEXT("collectionId")) + TEXT(":") + GetStringField(Asset, TEXT("tokenId")));
+	}
+
+	TArray<FString> GetStringArrayArgument(const FSelection& Selection, const TCHAR* Name)
+	{
+		TArray<FString> Values;
+		Selection.Arguments->TryGetStringArrayField(Name, Values);
+		return Values;
+	}
+
+	TSharedPtr<FJsonValue> ResolveAsset(const FSelection& Selection, const TArray<TSharedPtr<FJsonObject>>& Assets)
+	{
+		const FString TokenId = GetStringField(Selection.Arguments, TEXT("tokenId"));
+		const FString CollectionId = GetStringField(Selection.Arguments, TEXT("collectionId"));
+		for (const TSharedPtr<FJsonObject>& Asset : Assets)
+		{
+			if (GetStringField(Asset, TEXT("tokenId")) == TokenId && GetStringField(Asset, TEXT("collectionId")) == CollectionId)
+			{
+				return MakeShared<FJsonValueObject>(Asset);
+			}
+		}
+		return MakeShared<FJsonValueNull>();
+	}
+
+	TSharedPtr<FJsonValue> ResolveAssets(const FSelection& Selection, const TArray<TSharedPtr<FJsonObject>>& Assets, FString& OutError)
+	{
+		const TArray<FString> CollectionIds = GetStringArrayArgument(Selection, TEXT("collectionIds"));
+		const TArray<FString> Addresses = GetStringArrayArgument(Selection, TEXT("addresses"));
+
+		TArray<TSharedPtr<FJsonObject>> Matches;
+		for (const TSharedPtr<FJsonObject>& Asset : Assets)
+		{
+			const bool bCollectionMatches = CollectionIds.IsEmpty() || CollectionIds.Contains(GetStringField(Asset, TEXT("collectionId")));
+			const FString OwnerAddress = GetOwnerAddress(Asset);
+			const bool bAddressMatches = Addresses.IsEmpty() || Addresses.ContainsByPredicate([&OwnerAddress](const FString& Address)
+			{
+				return Address.Equals(OwnerAddress, ESearchCase::IgnoreCase);
+			});
+			if (bCollectionMatches && bAddressMatches)
+			{
+				Matches.Add(Asset);
+			}
+		}
+
+		int32 First = 100;
+		Selection.Arguments->TryGetNumberField(TEXT("first"), First);
+
+		int32 StartIndex = 0;
+		FString After;
+		if (Selection.Arguments->TryGetStringField(TEXT("after"), After) && !After.IsEmpty())
+		{
+			const int32 AfterIndex = Matches.IndexOfByPredicate([&After](const TSharedPtr<FJsonObject>& Asset)
+			{
+				return MakeCursor(Asset) == After;
+			});
+			if (AfterIndex == INDEX_NONE)
+			{
+				OutError = FString::Printf(TEXT("invalid cursor %s"), *After);
+				return MakeShared<FJsonValueNull>();
+			}
+			StartIndex = AfterIndex + 1;
+		}
+		const int32 EndIndex = FMath::Min(StartIndex + FMath::Max(First, 0), Matches.Num());
+
+		TArray<TSharedPtr<FJsonValue>> Edges;
+		for (int32 Index = StartIndex; Index < EndIndex; ++Index)
+		{
+			TSharedRef<FJsonObject> Edge = MakeShared<FJsonObject>();
+			Edge->SetStringField(TEXT("cursor"), MakeCursor(Matches[Index]));
+			Edge->SetObjectField(TEXT("node"), Matches[Index]);
+			Edges.Add(MakeShared<FJsonValueObject>(Edge));
+		}
+
+		const bool bHasNextPage = EndIndex < Matches.Num();
+		TSharedRef<FJsonObject> PageInfo = MakeShared<FJsonObject>();
+		PageInfo->SetBoolField(TEXT("hasNextPage"), bHasNextPage);
+		PageInfo->SetBoolField(TEXT("hasPreviousPage"), StartIndex > 0);
+		if (EndIndex > StartIndex)
+		{
+			PageInfo->SetStringField(TEXT("startCursor"), MakeCursor(Matches[StartIndex]));
+			PageInfo->SetStringField(TEXT("endCursor"), MakeCursor(Matches[EndIndex - 1]));
+		}
+		if (bHasNextPage)
+		{
+			PageInfo->SetStringField(TEXT("nextPage"), MakeCursor(Matches[EndIndex - 1]));
+		}
+
+		TSharedRef<FJsonObject> Connection = MakeShared<FJsonObject>();
+		Connection->SetArrayField(TEXT("edges"), Edges);
+		Connection->SetObjectField(TEXT("pageInfo"), PageInfo);
+		Connection->SetNumberField(TEXT("total"), Matches.Num());
+		return MakeShared<FJsonValueObject>(Connection);
+	}
+
+	FString MakeErrorJson(const FString& Message)
+	{
+		return FString::Printf(TEXT(R"({"data":null,"errors":[{"message":"%s"}]})"), *Message.ReplaceCharWithEscapedChar());
+	}
+
+	/** The query of a UTF-8 {"query": ...} json body. */
+	FString GetQueryFromBody(TConstArrayView<uint8> Body)
+	{
+		const FUTF8ToTCHAR BodyString(reinterpret_cast<const ANSICHAR*>(Body.GetData()), Body.Num());
+		TSharedPtr<FJsonObject> BodyObject;
+		FString Query;
+		if (FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(FString(BodyString.Length(), BodyString.Get())), BodyObject) && BodyObject.IsValid())
+		{
+			BodyObject->TryGetStringField(TEXT("query"), Query);
+		}
+		return Query;
+	}
+
+	/** The query of a POST body or GET URL. */
+	FString GetRequestQuery(const FHttpServerRequest& Request)
+	{
+		if (Request.Verb != EHttpServerRequestVerbs::VERB_GET)
+		{
+			return GetQueryFromBody(Request.Body);
+		}
+
+		FString Query = Request.QueryParams.FindRef(TEXT("query"));
+		// depending on the engine version the parameters arrive encoded, decoding twice would turn the '+' of cursors into spaces
+		if (Query.Contains(TEXT("%")))
+		{
+			Query = FGenericPlatformHttp::UrlDecode(Query);
+		}
+		return Query;
+	}
+
+	/** Query without whitespace and commas outside of strings, so it matches however it was formatted or sent. */
+	FString MakeQueryKey(const FString& Query)
+	{
+		FString Key;
+		Key.Reserve(Query.Len());
+
+		bool bInString = false;
+		bool bEscaped = false;
+		for (const TCHAR Char : Query)
+		{
+			if (bInString)
+			{
+				Key.AppendChar(Char);
+				bInString = bEscaped || Char != TEXT('"');
+				bEscaped = !bEscaped && Char == TEXT('\\');
+				continue;
+			}
+			if (!FChar::IsWhitespace(Char) && Char != TEXT(','))
+			{
+				Key.AppendChar(Char);
+				bInString = Char == TEXT('"');
+			}
+		}
+		return Key;
+	}
+}
+
+FAssetRegisterMockServer::FAssetRegisterMockServer(uint32 InPort) : Port(InPort)
+{
+}
+
+FAssetRegisterMockServer::~FAssetRegisterMockServer()
+{
+	Stop();
+}
+
+bool FAssetRegisterMockServer::Start()
+{
+	Router = FHttpServerModule::Get().GetHttpRouter(Port, /* bFailOnBindFailure */ true);
+	if (!Router.IsValid())
+	{
+		UE_LOG(LogAssetRegister, Error, TEXT("FAssetRegisterMockServer::Start failed to bind port %u"), Port);
+		return false;
+	}
+
+	RouteHandle = Router->BindRoute(FHttpPath(TEXT("/graphql")), EHttpServerRequestVerbs::VERB_GET | EHttpServerRequestVerbs::VERB_POST,
+		FHttpRequestHandler::CreateRaw(this, &FAssetRegisterMockServer::HandleRequest));
+
+	NumRequests = 0;
+	NumNotModified = 0;
+	NumGetRequests = 0;
+	NumFailed = 0;
+
+	FHttpServerModule::Get().StartAllListeners();
+	return RouteHandle.IsValid();
+}
+
+void FAssetRegisterMockServer::Stop()
+{
+	if (Router.IsValid() && RouteHandle.IsValid())
+	{
+		Router->UnbindRoute(RouteHandle);
+	}
+	RouteHandle.Reset();
+	Router.Reset();
+}
+
+FString FAssetRegisterMockServer::GetURL() const
+{
+	return FString::Printf(TEXT("http://localhost:%u/graphql"), Port);
+}
+
+void FAssetRegisterMockServer::SetResponse(const FString& InJson, const FString& InETag)
+{
+	FScopeLock Lock(&CriticalSection);
+	ResponseJson = InJson;
+	ETag = InETag;
+	CapturedQueries.Reset();
+}
+
+void FAssetRegisterMockServer::SetAssets(const TArray<FString>& AssetJsons)
+{
+	TArray<TSharedPtr<FJsonObject>> ParsedAssets;
+	for (const FString& AssetJson : AssetJsons)
+	{
+		TSharedPtr<FJsonObject> Asset;
+		if (FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(AssetJson), Asset) && Asset.IsValid())
+		{
+			ParsedAssets.Add(Asset);
+		}
+		else
+		{
+			UE_LOG(LogAssetRegister, Warning, TEXT("FAssetRegisterMockServer::SetAssets skipped invalid asset json %s"), *AssetJson);
+		}
+	}
+
+	FScopeLock Lock(&CriticalSection);
+	Assets = MoveTemp(ParsedAssets);
+	ResponseJson.Reset();
+	CapturedQueries.Reset();
+}
+
+void FAssetRegisterMockServer::SetCapture(const FAssetRegisterCapture& Capture, float Speed)
+{
+	using namespace AssetRegisterMockServer;
+
+	TMap<FString, FCapturedQuery> NewCapturedQueries;
+	for (const FAssetRegisterCaptureEntry& Entry : Capture.Entries)
+	{
+		FCapturedQuery& CapturedQuery = NewCapturedQueries.FindOrAdd(MakeQueryKey(GetQueryFromBody(Entry.RequestContent)));
+		FCapturedResponse& Response = CapturedQuery.Responses.AddDefaulted_GetRef();
+		Response.StatusCode = Entry.ResponseCode;
+		Response.Json = QueryStringUtil::Utf8ToString(Entry.ResponseContent);
+		Response.ETag = Entry.ETag;
+		Response.Delay = Speed > 0.f ? Entry.Duration / Speed : 0.0;
+
+		// a 304 revalidated the previous response, which a client without it is sent instead
+		if (Response.StatusCode == StatusNotModified && CapturedQuery.Responses.Num() > 1)
+		{
+			const FCapturedResponse& Previous = CapturedQuery.Responses[CapturedQuery.Responses.Num() - 2];
+			Response.Json = Previous.Json;
+			Response.ETag = Response.ETag.IsEmpty() ? Previous.ETag : Response.ETag;
+		}
+	}
+
+	FScopeLock Lock(&CriticalSection);
+	CapturedQueries = MoveTemp(NewCapturedQueries);
+	ResponseJson.Reset();
+	ETag.Reset();
+	Assets.Reset();
+}
+
+void FAssetRegisterMockServer::SetFailureRate(float Probability, int32 StatusCode, int32 Seed)
+{
+	FScopeLock Lock(&CriticalSection);
+	FailureProbability = Probability;
+	FailureStatusCode = StatusCode;
+	FailureRandom.Initialize(Seed);
+}
+
+void FAssetRegisterMockServer::FailNextRequests(int32 InNumRequests, int32 StatusCode)
+{
+	FScopeLock Lock(&CriticalSection);
+	NumFailNext = InNumRequests;
+	FailNextStatusCode = StatusCode;
+}
+
+void FAssetRegisterMockServer::SetRateLimit(float RequestsPerSecond)
+{
+	FScopeLock Lock(&CriticalSection);
+	RateLimit = RequestsPerSecond;
+	RateLimitTokens = FMath::Max(RequestsPerSecond, 1.f);
+	RateLimitTime = FPlatformTime::Seconds();
+}
+
+TOptional<int32> FAssetRegisterMockServer::TakeInjectedFailure()
+{
+	FScopeLock Lock(&CriticalSection);
+	if (NumFailNext > 0)
+	{
+		--NumFailNext;
+		return FailNextStatusCode;
+	}
+
+	if (RateLimit > 0.f)
+	{
+		// a token bucket holding up to a second of requests
+		const double Now = FPlatformTime::Seconds();
+		RateLimitTokens = FMath::Min(RateLimitTokens + static_cast<float>((Now - RateLimitTime) * RateLimit), FMath::Max(RateLimit, 1.f));
+		RateLimitTime = Now;
+		if (RateLimitTokens < 1.f)
+		{
+			return AssetRegisterMockServer::StatusTooManyRequests;
+		}
+		RateLimitTokens -= 1.f;
+	}
+
+	if (FailureProbability > 0.f && FailureRandom.FRand() < FailureProbability)
+	{
+		return FailureStatusCode;
+	}
+	return {};
+}
+
+FAssetRegisterMockServer::FCapturedResponse FAssetRegisterMockServer::TakeCapturedResponse(const FString& Query)
+{
+	using namespace AssetRegisterMockServer;
+
+	FCapturedResponse Response;
+	{
+		FScopeLock Lock(&CriticalSection);
+		if (FCapturedQuery* CapturedQuery = CapturedQueries.Find(MakeQueryKey(Query)))
+		{
+			Response = CapturedQuery->Responses[CapturedQuery->NextResponse];
+			CapturedQuery->NextResponse = FMath::Min(CapturedQuery->NextResponse + 1, CapturedQuery->Responses.Num() - 1);
+		}
+		else
+		{
+			Response.StatusCode = StatusBadRequest;
+			Response.Json = MakeErrorJson(TEXT("The query was not recorded in the capture"));
+			return Response;
+		}
+	}
+
+	// a connection failure can't be replayed over HTTP
+	if (Response.StatusCode == 0 || (Response.StatusCode == StatusNotModified && Response.Json.IsEmpty()))
+	{
+		Response.StatusCode = StatusServiceUnavailable;
+		Response.Json = MakeErrorJson(TEXT("No response was recorded"));
+	}
+	return Response;
+}
+
+FString FAssetRegisterMockServer::ExecuteQuery(const FString& Query, int32& OutStatusCode) const
+{
+	using namespace AssetRegisterMockServer;
+
+	OutStatusCode = StatusOk;
+
+	TArray<FSelection> Selections;
+	FQueryParser Parser(Query);
+	if (!Parser.Parse(Selections))
+	{
+		OutStatusCode = StatusBadRequest;
+		return MakeErrorJson(Parser.GetError());
+	}
+
+	TSharedRef<FJsonObject> Data = MakeShared<FJsonObject>();
+	TArray<FString> Errors;
+	{
+		FScopeLock Lock(&CriticalSection);
+		for (const FSelection& Selection : Selections)
+		{
+			TSharedPtr<FJsonValue> Value;
+			if (Selection.Name == TEXT("asset"))
+			{
+				Value = Project(ResolveAsset(Selection, Assets), Selection.Children);
+			}
+			else if (Selection.Name == TEXT("assets"))
+			{
+				FString Error;
+				Value = Project(ResolveAssets(Selection, Assets, Error), Selection.Children);
+				if (!Error.IsEmpty())
+				{
+					Errors.Add(Error);
+				}
+			}
+			else if (Selection.Name == TEXT("__typename"))
+			{
+				Value = MakeShared<FJsonValueString>(TEXT("Query"));
+			}
+			else
+			{
+				Errors.Add(FString::Printf(TEXT("Cannot query field \"%s\" on type \"Query\""), *Selection.Name));
+				Value = MakeShared<FJsonValueNull>();
+			}
+			Data->SetField(Selection.GetResponseName(), Value);
+		}
+	}
+
+	TSharedRef<FJsonObject> Response = MakeShared<FJsonObject>();
+	Response->SetObjectField(TEXT("data"), Data);
+	if (!Errors.IsEmpty())
+	{
+		TArray<TSharedPtr<FJsonValue>> ErrorValues;
+		for (const FString& Error : Errors)
+		{
+			TSharedRef<FJsonObject> ErrorObject = MakeShared<FJsonObject>();
+			ErrorObject->SetStringField(TEXT("message"), Error);
+			ErrorValues.Add(MakeShared<FJsonValueObject>(ErrorObject));
+		}
+		Response->SetArrayField(TEXT("errors"), ErrorValues);
+	}
+
+	FString Json;
+	FJsonSerializer::Serialize(Response, TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&Json));
+	return Json;
+}
+
+bool FAssetRegisterMockServer::HandleRequest(const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete)
+{
+	++NumRequests;
+	if (Request.Verb == EHttpServerRequestVerbs::VERB_GET)
+	{
+		++NumGetRequests;
+	}
+
+	if (const TOptional<int32> FailureCode = TakeInjectedFailure())
+	{
+		++NumFailed;
+		SendResponse(OnComplete, FailureCode.GetValue(), AssetRegisterMockServer::MakeErrorJson(
+			FailureCode.GetValue() == AssetRegisterMockServer::StatusTooManyRequests ? TEXT("Too Many Requests") : TEXT("Injected failure")), FString());
+		return true;
+	}
+
+	FString Json;
+	FString CurrentETag;
+	bool bHasCapture = false;
+	{
+		FScopeLock Lock(&CriticalSection);
+		Json = ResponseJson;
+		CurrentETag = ETag;
+		bHasCapture = !CapturedQueries.IsEmpty();
+	}
+
+	int32 StatusCode = AssetRegisterMockServer::StatusOk;
+	double Delay = 0.0;
+	if (bHasCapture)
+	{
+		FCapturedResponse Captured = TakeCapturedResponse(AssetRegisterMockServer::GetRequestQuery(Request));
+		StatusCode = Captured.StatusCode;
+		Json = MoveTemp(Captured.Json);
+		CurrentETag = MoveTemp(Captured.ETag);
+		Delay = Captured.Delay;
+	}
+
+	const TArray<FString>* IfNoneMatch = AssetRegisterMockServer::FindHeader(Request, TEXT("If-None-Match"));
+	if (!CurrentETag.IsEmpty() && IfNoneMatch && IfNoneMatch->Contains(CurrentETag))
+	{
+		++NumNotModified;
+		SendResponse(OnComplete, AssetRegisterMockServer::StatusNotModified, FString(), CurrentETag, Delay);
+		return true;
+	}
+
+	if (StatusCode == AssetRegisterMockServer::StatusNotModified)
+	{
+		// recorded as a revalidation, but this client has nothing to revalidate
+		StatusCode = AssetRegisterMockServer::StatusOk;
+	}
+	else if (!bHasCapture && Json.IsEmpty())
+	{
+		Json = ExecuteQuery(AssetRegisterMockServer::GetRequestQuery(Request), StatusCode);
+	}
+
+	SendResponse(OnComplete, StatusCode, MoveTemp(Json), CurrentETag, Delay);
+	return true;
+}
+
+void FAssetRegisterMockServer::SendResponse(const FHttpResultCallback& OnComplete, int32 StatusCode, FString&& Json,
+	const FString& ResponseETag, double ExtraDelay) const
+{
+	double Delay = Latency + ExtraDelay;
+	if (BytesPerSecond > 0)
+	{
+		Delay += static_cast<double>(FTCHARToUTF8(*Json).Length()) / BytesPerSecond;
+	}
+
+	auto Respond = [OnComplete, StatusCode, Json = MoveTemp(Json), ResponseETag]()
+	{
+		TUniquePtr<FHttpServerResponse> Response = StatusCode == AssetRegisterMockServer::StatusNotModified
+			? MakeUnique<FHttpServerResponse>()
+			: FHttpServerResponse::Create(Json, TEXT("application/json"));
+		Response->Code = static_cast<EHttpServerResponseCodes>(StatusCode);
+		if (StatusCode == AssetRegisterMockServer::StatusTooManyRequests)
+		{
+			Response->Headers.Add(TEXT("Retry-After"), {TEXT("1")});
+		}
+		if (!ResponseETag.IsEmpty() && (StatusCode == AssetRegisterMockServer::StatusOk || StatusCode == AssetRegisterMockServer::StatusNotModified))
+		{
+			Response->Headers.Add(TEXT("ETag"), {ResponseETag});
+		}
+		OnComplete(MoveTemp(Response));
+	};
+
+	if (Delay > 0.0)
+	{
+		FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda([Respond](float)
+		{
+			Respond();
+			return false;
+		}), Delay);
+		return;
+	}
+
+	Respond();
+}
+
+#endif
@@ -0,0 +1,166 @@
+// Copyright (c) 2025, Futureverse Corporation Limited. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "HttpResultCallback.h"
+#include "HttpRouteHandle.h"
+#include "Math/RandomStream.h"
+#include <atomic>
+
+class FJsonObject;
+struct FAssetRegisterCapture;
+class IHttpRouter;
+struct FHttpServerRequest;
+
+/**
+ * Local stand-in for the Asset Register GraphQL endpoint, used by tests that need a real HTTP round trip.
+ *
+ * Answers GET and POST requests on /graphql either with a fixed json body (SetResponse), or by running the query
+ * against a dataset of assets (SetAssets). Queries are parsed as far as the SDK writes them: `asset` and `assets`
+ * root fields, aliases (as in batched queries), arguments and inline fragments. Responses hold only the selected fields,
+ * and `assets` filters by collectionIds and addresses and pages with first/after, using the asset ids as cursors.
+ *
+ * It can also replay traffic recorded with FAssetRegisterRecorder (SetCapture), answering each query with its recorded
+ * response after the recorded time.
+ *
+ * Latency, bandwidth, failures and rate limiting can be injected. Answers 304 Not Modified when the request's
+ * If-None-Match matches the configured ETag. Requests are handled on the game thread.
+ */
+class FAssetRegisterMockServer
+{
+public:
+	explicit FAssetRegisterMockServer(uint32 InPort = 8760);
+	~FAssetRegisterMockServer();
+
+	/** Binds the /graphql route and starts listening. */
+	bool Start();
+	
+	/** Unbinds the route and stops listening. */
+	void Stop();
+
+	/** The URL to point UAssetRegisterSettings::AssetRegisterURL at. */
+	FString GetURL() const;
+
+	/**
+	 * Sets the json body returned for every query.
+	 *
+	 * @param InJson The response body.
+	 * @param InETag The ETag to serve the body with, or empty to send no ETag.
+	 */
+	void SetResponse(const FString& InJson, const FString& InETag = FString());
+
+	/**
+	 * Answers queries from a dataset instead of a fixed body, see AssetFixtures::MakeAssetJson. Assets are paged in
+	 * the order given. Clears the body set with SetResponse.
+	 *
+	 * @param AssetJsons Asset nodes with every field a query may select.
+	 */
+	void SetAssets(const TArray<FString>& AssetJsons);
+
+	/**
+	 * Answers queries with the responses recorded in Capture instead, each after its recorded duration over Speed.
+	 * A query recorded more than once gets its responses in the recorded order, then the last one again. Requests
+	 * that failed without a response are answered with 503, and queries that weren't recorded with 400.
+	 * Clears the body set with SetResponse and the dataset set with SetAssets.
+	 *
+	 * @param Speed How many times faster than recorded to answer, 0 to answer at once.
+	 */
+	void SetCapture(const FAssetRegisterCapture& Capture, float Speed = 1.f);
+
+	/** Delays every response by InLatency seconds, standing in for the round trip to the real endpoint. */
+	void SetLatency(float InLatency) { Latency = InLatency; }
+
+	/** Further delays every response by its size over InBytesPerSecond, 0 for no limit. */
+	void SetBandwidth(int64 InBytesPerSecond) { BytesPerSecond = InBytesPerSecond; }
+
+	/**
+	 * Fails requests at random with StatusCode, e.g. 500, 503 or 429.
+	 *
+	 * @param Probability Chance of each request failing, 0 to stop failing.
+	 * @param Seed Seeds the random stream, so a run fails the same requests every time.
+	 */
+	void SetFailureRate(float Probability, int32 StatusCode = 500, int32 Seed = 0);
+
+	/** Fails the next NumRequests requests with StatusCode. */
+	void FailNextRequests(int32 NumRequests, int32 StatusCode = 500);
+
+	/** Answers 429 Too Many Requests, with a Retry-After header, to requests past RequestsPerSecond. 0 for no limit. */
+	void SetRateLimit(float RequestsPerSecond);
+
+	/** Number of requests received since Start. */
+	int32 GetNumRequests() const { return NumRequests; }
+	
+	/** Number of requests answered with 304 Not Modified since Start. */
+	int32 GetNumNotModified() const { return NumNotModified; }
+
+	/** Number of GET requests received since Start. */
+	int32 GetNumGetRequests() const { return NumGetRequests; }
+
+	/** Number of requests failed by SetFailureRate, FailNextRequests or SetRateLimit since Start. */
+	int32 GetNumFailed() const { return NumFailed; }
+
+private:
+	bool HandleRequest(const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete);
+
+	/** The status code to fail the request with, if it should fail. */
+	TOptional<int32> TakeInjectedFailure();
+
+	/** Runs the query in a request body or GET URL against Assets. */
+	FString ExecuteQuery(const FString& Query, int32& OutStatusCode) const;
+
+	struct FCapturedResponse
+	{
+		int32 StatusCode = 0;
+		FString Json;
+		FString ETag;
+		/** Seconds to wait before answering, the recorded duration over the replay speed. */
+		double Delay = 0.0;
+	};
+
+	struct FCapturedQuery
+	{
+		TArray<FCapturedResponse> Responses;
+		int32 NextResponse = 0;
+	};
+
+	/** The next recorded response to Query, see SetCapture. */
+	FCapturedResponse TakeCapturedResponse(const FString& Query);
+
+	/** Answers after the latency, bandwidth and ExtraDelay, with an empty body if StatusCode is 304. */
+	void SendResponse(const FHttpResultCallback& OnComplete, int32 StatusCode, FString&& Json, const FString& ResponseETag,
+		double ExtraDelay = 0.0) const;
+
+	uint32 Port;
+	TSharedPtr<IHttpRouter> Router;
+	FHttpRouteHandle RouteHandle;
+
+	mutable FCriticalSection CriticalSection;
+	FString ResponseJson;
+	FString ETag;
+	TArray<TSharedPtr<FJsonObject>> Assets;
+	/** By the query with whitespace removed. */
+	TMap<FString, FCapturedQuery> CapturedQueries;
+
+	float FailureProbability = 0.f;
+	int32 FailureStatusCode = 500;
+	FRandomStream FailureRandom;
+	int32 NumFailNext = 0;
+	int32 FailNextStatusCode = 500;
+
+	float RateLimit = 0.f;
+	float RateLimitTokens = 0.f;
+	double RateLimitTime = 0.0;
+
+	std::atomic<float> Latency = 0.f;
+	std::atomic<int64> BytesPerSecond = 0;
+	std::atomic<int32> NumRequests = 0;
+	std::atomic<int32> NumNotModified = 0;
+	std::atomic<int32> NumGetRequests = 0;
+	std::atomic<int32> NumFailed = 0;
+};
+
+#endif
@@ -0,0 +1,118 @@
+// Copyright (c) 2025, Futureverse Corporation Limited. All rights reserved.
+
+#include "AssetRegisterNegativeCache.h"
+
+#include "AssetRegisterSettings.h"
+
+FAssetRegisterNegativeCache& FAssetRegisterNegativeCache::Get()
+{
+	static FAssetRegisterNegativeCache Cache;
+	return Cache;
+}
+
+bool FAssetRegisterNegativeCache::Contains(const FAssetRegisterAssetKey& Key, EAssetRegisterMiss Miss)
+{
+	const UAssetRegisterSettings* Settings = GetDefault<UAssetRegisterSettings>();
+	if (!Settings || !Settings->bEnableNegativeCache || NumEntries == 0)
+	{
+		return false;
+	}
+
+	FScopeLock Lock(&CriticalSection);
+
+	const double* ExpiresAt = Misses.Find({Key, Miss});
+	if (!ExpiresAt || *ExpiresAt <= FPlatformTime::Seconds())
+	{
+		return false;
+	}
+
+	++Hits;
+	return true;
+}
+
+void FAssetRegisterNegativeCache::Add(const FAssetRegisterAssetKey& Key, EAssetRegisterMiss Miss)
+{
+	const UAssetRegisterSettings* Settings = GetDefault<UAssetRegisterSettings>();
+	if (!Settings || !Settings->bEnableNegativeCache || !Key.IsValid())
+	{
+		return;
+	}
+
+	const double Now = FPlatformTime::Seconds();
+	const FMissKey MissKey{Key, Miss};
+	const double ExpiresAt = Now + Settings->NegativeCacheTimeToLive;
+
+	FScopeLock Lock(&CriticalSection);
+
+	Misses.Add(MissKey, ExpiresAt);
+	Queue.Add({MissKey, ExpiresAt});
+	TrimLocked(Now, Settings->NegativeCacheMaxEntries);
+	NumEntries = Misses.Num();
+}
+
+void FAssetRegisterNegativeCache::Remove(const FAssetRegisterAssetKey& Key)
+{
+	if (NumEntries == 0)
+	{
+		return;
+	}
+
+	FScopeLock Lock(&CriticalSection);
+
+	// the queued entries are skipped once their key is gone
+	Misses.Remove({Key, EAssetRegisterMiss::Asset});
+	Misses.Remove({Key, EAssetRegisterMiss::AssetProfile});
+	NumEntries = Misses.Num();
+}
+
+void FAssetRegisterNegativeCache::Clear()
+{
+	FScopeLock Lock(&CriticalSection);
+	Misses.Empty();
+	Queue.Empty();
+	QueueHead = 0;
+	NumEntries = 0;
+}
+
+FAssetRegisterNegativeCacheStats FAssetRegisterNegativeCache::GetStats() const
+{
+	FAssetRegisterNegativeCacheStats Stats;
+	Stats.Hits = Hits;
+	Stats.Evictions = Evictions;
+	Stats.NumEntries = NumEntries;
+	return Stats;
+}
+
+void FAssetRegisterNegativeCache::TrimLocked(double Now, int32 MaxEntries)
+{
+	while (QueueHead < Queue.Num())
+	{
+		const FQueuedMiss& Front = Queue[QueueHead];
+		const double* ExpiresAt = Misses.Find(Front.MissKey);
+		if (!ExpiresAt || *ExpiresAt != Front.ExpiresAt)
+		{
+			// removed, or re-added further back in the queue
+			++QueueHead;
+			continue;
+		}
+
+		const bool bExpired = Front.ExpiresAt <= Now;
+		if (!bExpired && Misses.Num() <= MaxEntries)
+		{
+			break;
+		}
+
+		Misses.Remove(Front.MissKey);
+		++QueueHead;
+		if (!bExpired)
+		{
+			++Evictions;
+		}
+	}
+
+	if (QueueHead > Queue.Num() / 2)
+	{
+		Queue.RemoveAt(0, QueueHead);
+		QueueHead = 0;
+	}
+}
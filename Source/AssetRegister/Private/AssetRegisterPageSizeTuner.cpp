@@ -0,0 +1,105 @@
+// Copyright (c) 2025, Futureverse Corporation Limited. All rights reserved.
+
+#include "AssetRegisterPageSizeTuner.h"
+
+#include "AssetRegisterLog.h"
+#include "AssetRegisterQueryingLibrary.h"
+#include "AssetRegisterSettings.h"
+#include "Hash/CityHash.h"
+
+namespace AssetRegisterPageSizeTuner
+{
+	/** How much better a page has to do than the one before to be worth growing the page size for. */
+	constexpr double MinImprovement = 1.05;
+}
+
+FAssetRegisterPageSizeTuner& FAssetRegisterPageSizeTuner::Get()
+{
+	static FAssetRegisterPageSizeTuner Tuner;
+	return Tuner;
+}
+
+uint64 FAssetRegisterPageSizeTuner::GetQueryShape(const FAssetConnection& AssetsInput)
+{
+	FAssetConnection ShapeInput = AssetsInput;
+	ShapeInput.After.Reset();
+	ShapeInput.Before.Reset();
+	ShapeInput.First = 0;
+	ShapeInput.Last = 0;
+
+	const TArray<uint8> Query = UAssetRegisterQueryingLibrary::GetAssetsQueryNode(ShapeInput)->GetQueryJsonUtf8();
+	return CityHash64(reinterpret_cast<const char*>(Query.GetData()), Query.Num());
+}
+
+int32 FAssetRegisterPageSizeTuner::GetPageSize(uint64 Shape, int32 InitialPageSize) const
+{
+	FScopeLock Lock(&CriticalSection);
+	const FAssetRegisterPageSizeStats* Stats = Shapes.Find(Shape);
+	return Stats ? Stats->PageSize : InitialPageSize;
+}
+
+void FAssetRegisterPageSizeTuner::ReportPage(uint64 Shape, int32 PageSize, const FAssetRegisterPageSample& Sample)
+{
+	const UAssetRegisterSettings* Settings = GetDefault<UAssetRegisterSettings>();
+	const int32 MinPageSize = FMath::Max(Settings->MinAdaptivePageSize, 1);
+	const int32 MaxPageSize = FMath::Max(Settings->MaxAdaptivePageSize, MinPageSize);
+
+	FScopeLock Lock(&CriticalSection);
+
+	FAssetRegisterPageSizeStats& Stats = Shapes.FindOrAdd(Shape);
+	if (Stats.PageSize == 0)
+	{
+		Stats.PageSize = FMath::Clamp(PageSize, MinPageSize, MaxPageSize);
+	}
+	++Stats.NumPages;
+	Stats.LastResponseSeconds = Sample.ResponseSeconds;
+	Stats.LastDecodeSeconds = Sample.DecodeSeconds;
+
+	const bool bSlow = Sample.ResponseSeconds > Settings->SlowPageTime || Sample.DecodeSeconds > Settings->SlowPageDecodeTime;
+	if (!Sample.bSuccess || bSlow)
+	{
+		const int32 OldPageSize = Stats.PageSize;
+		Stats.PageSize = FMath::Max(FMath::Min(Stats.PageSize, PageSize) / 2, MinPageSize);
+		// throughput is learned again at the new size
+		Stats.ItemsPerSecond = 0.0;
+		Stats.BytesPerSecond = 0.0;
+		if (Stats.PageSize != OldPageSize)
+		{
+			++Stats.NumBackoffs;
+			UE_LOG(LogAssetRegister, Verbose, TEXT("FAssetRegisterPageSizeTuner %s page of %d after %.3fs (%.3fs decoding), backing off to %d"),
+				Sample.bSuccess ? TEXT("slow") : TEXT("failed"), PageSize, Sample.ResponseSeconds, Sample.DecodeSeconds, Stats.PageSize);
+		}
+		return;
+	}
+
+	// a page requested with an older size, or a short last page, says nothing about the current size
+	if (PageSize != Stats.PageSize || Sample.NumItems < PageSize || Sample.ResponseSeconds <= 0.0)
+	{
+		return;
+	}
+
+	const double ItemsPerSecond = Sample.NumItems / Sample.ResponseSeconds;
+	const bool bImproved = ItemsPerSecond > Stats.ItemsPerSecond * AssetRegisterPageSizeTuner::MinImprovement;
+	Stats.ItemsPerSecond = ItemsPerSecond;
+	Stats.BytesPerSecond = Sample.NumBytes / Sample.ResponseSeconds;
+
+	if (bImproved && Stats.PageSize < MaxPageSize)
+	{
+		Stats.PageSize = FMath::Min(Stats.PageSize * 2, MaxPageSize);
+		++Stats.NumGrowths;
+		UE_LOG(LogAssetRegister, Verbose, TEXT("FAssetRegisterPageSizeTuner page of %d at %.0f items/s, growing to %d"),
+			PageSize, ItemsPerSecond, Stats.PageSize);
+	}
+}
+
+TMap<uint64, FAssetRegisterPageSizeStats> FAssetRegisterPageSizeTuner::GetStats() const
+{
+	FScopeLock Lock(&CriticalSection);
+	return Shapes;
+}
+
+void FAssetRegisterPageSizeTuner::Reset()
+{
+	FScopeLock Lock(&CriticalSection);
+	Shapes.Empty();
+}
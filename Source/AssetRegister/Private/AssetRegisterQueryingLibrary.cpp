@@ -4,329 +4,1150 @@
 #include "AssetRegisterQueryingLibrary.h"
 
 #include "AssetRegisterLog.h"
+#include "AssetRegisterAssetStream.h"
+#include "AssetRegisterAssetCache.h"
+#include "AssetRegisterCompletionQueue.h"
+#include "AssetRegisterDiskCache.h"
+#include "AssetRegisterFutures.h"
+#include "AssetRegisterGCUtil.h"
+#include "AssetRegisterLinkStore.h"
+#include "AssetRegisterMetrics.h"
+#include "AssetRegisterNegativeCache.h"
 #include "AssetRegisterSettings.h"
+#include "AssetRegisterTrace.h"
 #include "HttpModule.h"
 #include "AssetRegisterQueryBuilder.h"
+#include "AssetRegisterConditionalCache.h"
+#include "AssetRegisterTransport.h"
+#include "Async/Async.h"
+#include "Hash/CityHash.h"
 #include "Interfaces/IHttpResponse.h"
 #include "Schemas/Asset.h"
 #include "Schemas/Unions/AssetLink.h"
 #include "Schemas/Unions/NFTAssetLink.h"
 #include "Schemas/Inputs/AssetInput.h"
 #include "Schemas/Unions/NFTAssetOwnership.h"
+#include "UObject/GarbageCollection.h"
 
-void UAssetRegisterQueryingLibrary::GetAssetProfile(const FString& TokenId, const FString& CollectionId,
-	const FGetJsonCompleted& OnCompleted)
+namespace AssetRegisterQuerying
 {
-	auto AssetQuery = FAssetRegisterQueryBuilder::AddAssetQuery(FAssetInput(TokenId, CollectionId));
+	TAssetRegisterConditionalCache<FLoadAssetResult>& GetAssetConditionalCache()
+	{
+		static TAssetRegisterConditionalCache<FLoadAssetResult> Cache(TEXT("AssetRegister.AssetConditionalCache"));
+		return Cache;
+	}
 
-	AssetQuery->AddField(&FAsset::Id)
-		->AddField<FAsset>(&FAsset::Profiles);
+	TAssetRegisterConditionalCache<FLoadAssetsResult>& GetAssetsConditionalCache()
+	{
+		static TAssetRegisterConditionalCache<FLoadAssetsResult> Cache(TEXT("AssetRegister.AssetsConditionalCache"));
+		return Cache;
+	}
 
-	MakeAssetQuery(AssetQuery->GetQueryJsonString()).Next([OnCompleted, TokenId, CollectionId]
-		(const FLoadAssetResult& Result)
+	TAssetRegisterConditionalCache<FLoadAssetBatchResult>& GetAssetBatchConditionalCache()
 	{
-		FAsset Asset = Result.Value;
+		static TAssetRegisterConditionalCache<FLoadAssetBatchResult> Cache(TEXT("AssetRegister.AssetBatchConditionalCache"));
+		return Cache;
+	}
 
-		if (!Result.bSuccess)
+	/** Sets Promise to Result on the thread Policy completes queries on. */
+	template<typename TResult>
+	void CompleteQuery(EAssetRegisterCompletionPolicy Policy, const TSharedPtr<TPromise<TResult>>& Promise, TResult&& Result,
+		uint64 RequestId)
+	{
+		switch (Policy)
 		{
-			UE_LOG(LogAssetRegister, Warning, TEXT("[UGetAssetProfile] failed to load remote AssetProfile for %s:%s"), *CollectionId, *TokenId);
+		case EAssetRegisterCompletionPolicy::GameThread:
+			// nothing references the decoded objects while they are queued
+			AssetRegisterGCUtil::SetAsyncFlags(Result, true);
+			FAssetRegisterCompletionQueue::Get().Enqueue([Promise, Result = MoveTemp(Result), RequestId]() mutable
+			{
+				AssetRegisterGCUtil::SetAsyncFlags(Result, false);
+				ASSETREGISTER_TRACE_PHASE(RequestId, Dispatch);
+				Promise->SetValue(MoveTemp(Result));
+			});
+			break;
+		case EAssetRegisterCompletionPolicy::Worker:
+			{
+				// the flags keep the decoded objects alive while the continuations run, which have to reference
+				// them (UPROPERTY, FGCObject) to keep them past that
+				AssetRegisterGCUtil::SetAsyncFlags(Result, true);
+				TArray<UObject*> Objects;
+				AssetRegisterGCUtil::GetObjects(Result, Objects);
+				{
+					ASSETREGISTER_TRACE_PHASE(RequestId, Dispatch);
+					Promise->SetValue(MoveTemp(Result));
+				}
+				AssetRegisterGCUtil::SetAsyncFlags(Objects, false);
+			}
+			break;
+		default:
+			{
+				ASSETREGISTER_TRACE_PHASE(RequestId, Dispatch);
+				Promise->SetValue(MoveTemp(Result));
+			}
+			break;
 		}
+	}
 
-		const FString AssetProfileKey = TEXT("asset-profile");
-		const FString AssetProfileURI = Asset.Profiles.Contains(AssetProfileKey) ? Asset.Profiles[AssetProfileKey] : TEXT("");
-		OnCompleted.ExecuteIfBound(Asset.Profiles.Contains(AssetProfileKey),AssetProfileURI);
+	/**
+	 * Sends a query and decodes its response. If the query can be sent as a GET, a previously decoded result
+	 * for the same URL is revalidated with its ETag/Last-Modified and reused when the server answers 304.
+	 * OnContent is called with a downloaded response body before it is decoded.
+	 *
+	 * The response is decoded, and the query completes, where FAssetRegisterCompletionScope::GetCurrentPolicy says
+	 * at the time of the call. Decode has to return a fulfilled future, it runs while garbage collection is locked.
+	 */
+	template<typename TResult, typename TDecodeFunc>
+	TFuture<TResult> SendQuery(TArray<uint8>&& Content, const TCHAR* Context, const FAssetRegisterDeadline& Deadline,
+		TAssetRegisterConditionalCache<TResult>& ConditionalCache, TDecodeFunc Decode,
+		TFunction<void(TConstArrayView<uint8>)> OnContent = nullptr)
+	{
+		TSharedPtr<TPromise<TResult>> Promise = MakeShared<TPromise<TResult>>();
+		const EAssetRegisterCompletionPolicy Policy = FAssetRegisterCompletionScope::GetCurrentPolicy();
+
+		FAssetRegisterRequest Request;
+		Request.Context = Context;
+		Request.Id = AssetRegisterTrace::TakeScopedRequestId();
+		Request.Deadline = Deadline;
+		const uint64 RequestId = Request.Id;
+
+		typename TAssetRegisterConditionalCache<TResult>::FEntry CachedEntry;
+		if (FAssetRegisterTransport::TryMakeGetURL(Content, Request.GetURL) && ConditionalCache.Find(Request.GetURL, CachedEntry))
+		{
+			Request.ETag = MoveTemp(CachedEntry.ETag);
+			Request.LastModified = MoveTemp(CachedEntry.LastModified);
+		}
+		
+		Request.Content = MoveTemp(Content);
+		const FString GetURL = Request.GetURL;
+
+		FAssetRegisterTransport::ProcessRequest(MoveTemp(Request)).Next(
+		[Promise, Policy, Context, RequestId, GetURL, &ConditionalCache, Decode, OnContent = MoveTemp(OnContent)](const FHttpResponsePtr& Response)
+		{
+			if (Response.IsValid() && Response->GetResponseCode() == EHttpResponseCodes::NotModified)
+			{
+				// looked up again rather than kept from the send, the cache keeps its UObjects from being garbage
+				// collected only while it holds the entry
+				typename TAssetRegisterConditionalCache<TResult>::FEntry CachedEntry;
+				if (!GetURL.IsEmpty() && ConditionalCache.Find(GetURL, CachedEntry))
+				{
+					UE_LOG(LogAssetRegister, Verbose, TEXT("UAssetRegisterQueryingLibrary::%s reusing decoded result for %s"), Context, *GetURL);
+					CompleteQuery(Policy, Promise, MoveTemp(CachedEntry.Result), RequestId);
+					return;
+				}
+				
+				UE_LOG(LogAssetRegister, Warning, TEXT("UAssetRegisterQueryingLibrary::%s got 304 Not Modified without a cached result"), Context);
+			}
+			
+			if (!Response.IsValid() || Response->GetContent().IsEmpty())
+			{
+				auto Result = TResult();
+				Result.SetFailure();
+				CompleteQuery(Policy, Promise, MoveTemp(Result), RequestId);
+				return;
+			}
+
+			if (OnContent)
+			{
+				OnContent(Response->GetContent());
+			}
+
+			auto DecodeResponse = [RequestId, Response, Decode]()
+			{
+				TSharedPtr<FJsonObject> RootObject;
+				{
+					ASSETREGISTER_TRACE_PHASE(RequestId, Parse);
+					RootObject = QueryStringUtil::ParseJsonUtf8(Response->GetContent());
+				}
+
+				ASSETREGISTER_TRACE_PHASE(RequestId, Decode);
+				return Decode(RootObject).Get();
+			};
+
+			auto CompleteDecoded = [Promise, Policy, Context, RequestId, GetURL, Response, &ConditionalCache](TResult&& LoadResult)
+			{
+				// error responses were already counted by the transport
+				if (!LoadResult.bSuccess && !LoadResult.bNotFound && Response->GetResponseCode() < 400)
+				{
+					FAssetRegisterMetrics::Get().RecordError(Context, EAssetRegisterErrorClass::Decode);
+				}
+
+				FString ETag = Response->GetHeader(TEXT("ETag"));
+				FString LastModified = Response->GetHeader(TEXT("Last-Modified"));
+				if (!GetURL.IsEmpty() && LoadResult.bSuccess && (!ETag.IsEmpty() || !LastModified.IsEmpty()))
+				{
+					ConditionalCache.Store(GetURL, {MoveTemp(ETag), MoveTemp(LastModified), LoadResult});
+				}
+				CompleteQuery(Policy, Promise, MoveTemp(LoadResult), RequestId);
+			};
+
+			if (Policy == EAssetRegisterCompletionPolicy::Inline)
+			{
+				CompleteDecoded(DecodeResponse());
+				return;
+			}
+
+			AsyncTask(ENamedThreads::AnyBackgroundThreadNormalTask,
+			[DecodeResponse = MoveTemp(DecodeResponse), CompleteDecoded = MoveTemp(CompleteDecoded)]()
+			{
+				// decoding creates UObjects, GC must not run before they are flagged, which keeps them alive until
+				// CompleteQuery hands them over. The continuations run after the guard is released.
+				TResult LoadResult;
+				{
+					FGCScopeGuard GCGuard;
+					LoadResult = DecodeResponse();
+					AssetRegisterGCUtil::SetAsyncFlags(LoadResult, true);
+				}
+				CompleteDecoded(MoveTemp(LoadResult));
+			});
+		});
+
+		return Promise->GetFuture();
+	}
+
+	/** Builds a selection of asset fields, for the queries that are answered from the asset caches. */
+	TSharedRef<const IQueryNode> MakeAssetSelection(TFunctionRef<void(FQueryNode<FAsset>&)> Select)
+	{
+		const auto AssetNode = MakeShared<FQueryNode<FAsset>>(QueryStringUtil::GetQueryName<FAsset>());
+		Select(*AssetNode);
+		return AssetNode;
+	}
+
+	/** The asset fields selected by UAssetRegisterQueryingLibrary::GetAssetsQueryNode. */
+	const IQueryNode& GetAssetsNodeSelection()
+	{
+		static const TSharedRef<const IQueryNode> Selection = []()
+		{
+			const TSharedPtr<IQueryNode> EdgesNode = UAssetRegisterQueryingLibrary::GetAssetsQueryNode(FAssetConnection())->GetChildren().FindRef(TEXT("edges"));
+			const TSharedPtr<IQueryNode> AssetNode = EdgesNode.IsValid() ? EdgesNode->GetChildren().FindRef(TEXT("node")) : nullptr;
+			return AssetNode.IsValid() ? AssetNode->CloneNode() : MakeShared<IQueryNode>(QueryStringUtil::GetQueryName<FAsset>());
+		}();
+		return *Selection;
+	}
+
+	/**
+	 * Ids of the cached assets and pages currently refetched in the background, so each is refetched only once,
+	 * with the callbacks waiting for the refetched asset.
+	 */
+	FCriticalSection RevalidationsCriticalSection;
+	TMap<FString, TArray<TFunction<void(const FLoadAssetResult&)>>> Revalidations;
+
+	/** @return False if Id is already being refetched, OnRevalidated is then called when that refetch completes. */
+	bool BeginRevalidation(const FString& Id, TFunction<void(const FLoadAssetResult&)>&& OnRevalidated = nullptr)
+	{
+		FScopeLock Lock(&RevalidationsCriticalSection);
+		const bool bInFlight = Revalidations.Contains(Id);
+		TArray<TFunction<void(const FLoadAssetResult&)>>& Callbacks = Revalidations.FindOrAdd(Id);
+		if (OnRevalidated)
+		{
+			Callbacks.Add(MoveTemp(OnRevalidated));
+		}
+		return !bInFlight;
+	}
+
+	void EndRevalidation(const FString& Id, const FLoadAssetResult& Result = FLoadAssetResult())
+	{
+		TArray<TFunction<void(const FLoadAssetResult&)>> Callbacks;
+		{
+			FScopeLock Lock(&RevalidationsCriticalSection);
+			Revalidations.RemoveAndCopyValue(Id, Callbacks);
+		}
+		
+		for (const TFunction<void(const FLoadAssetResult&)>& Callback : Callbacks)
+		{
+			Callback(Result);
+		}
+	}
+
+	void CacheAsset(const FAsset& Asset, const IQueryNode& Selection)
+	{
+		FAssetRegisterAssetCache::Get().Add(Asset, Selection);
+		FAssetRegisterDiskCache::Get().AddAsset(Asset, Selection);
+		FAssetRegisterLinkStore::Get().AddAsset(Asset, &Selection);
+	}
+
+	/** Sends an asset query selecting Selection, and caches the fields it returns under Key. */
+	TFuture<FLoadAssetResult> FetchAsset(const FAssetRegisterAssetKey& Key, const IQueryNode& Selection,
+		const FAssetRegisterDeadline& Deadline)
+	{
+		const FAssetRegisterRequestScope RequestScope;
+		auto AssetQuery = FAssetRegisterQueryBuilder::AddAssetQuery(FAssetInput(Key.TokenId, Key.CollectionId));
+		AssetQuery->MergeSelection(Selection);
+		
+		return UAssetRegisterQueryingLibrary::MakeAssetQuery(AssetQuery->GetQueryJsonUtf8(), Deadline).Next(
+		[Key, FetchedSelection = Selection.CloneNode()](const FLoadAssetResult& Result)
+		{
+			if (!Result.bSuccess)
+			{
+				if (Result.bNotFound)
+				{
+					FAssetRegisterNegativeCache::Get().Add(Key, EAssetRegisterMiss::Asset);
+				}
+				return Result;
+			}
+
+			// single asset queries don't select the ids they were made with
+			FLoadAssetResult OutResult = Result;
+			OutResult.Value.CollectionId = Key.CollectionId;
+			OutResult.Value.TokenId = Key.TokenId;
+			CacheAsset(OutResult.Value, *FetchedSelection);
+			return OutResult;
+		});
+	}
+
+	/**
+	 * Refetches the fields Selection selects of a cached asset in the background, and calls OnRevalidated with the
+	 * result. Lookups revalidating the same fields of an asset at once share one request.
+	 */
+	void RevalidateAsset(const FAssetRegisterAssetKey& Key, const IQueryNode& Selection,
+		TFunction<void(const FLoadAssetResult&)>&& OnRevalidated)
+	{
+		TArray<FString> FieldNames;
+		Selection.GetChildren().GenerateKeyArray(FieldNames);
+		FieldNames.Sort();
+		const FString RevalidationId = FString::Printf(TEXT("%s:%s"), *Key.ToString(), *FString::Join(FieldNames, TEXT(",")));
+		
+		if (BeginRevalidation(RevalidationId, MoveTemp(OnRevalidated)))
+		{
+			FetchAsset(Key, Selection, FAssetRegisterDeadline()).Next([RevalidationId](const FLoadAssetResult& Result)
+			{
+				EndRevalidation(RevalidationId, Result);
+			});
+		}
+	}
+
+	/**
+	 * Loads the fields Selection selects of an asset. The asset is looked up in the memory cache, then in the disk
+	 * cache, and only the fields neither of them knows are requested. A disk hit is promoted to the memory cache.
+	 *
+	 * An asset the server answered doesn't exist fails without a request while it is in the negative cache.
+	 *
+	 * A cached asset older than Freshness (or UAssetRegisterSettings::DiskCacheFreshness, when it was loaded from
+	 * disk) is refetched: with bStaleWhileRevalidate it is returned right away and refetched in the background,
+	 * calling OnRevalidated with the asset that was returned and the refetched result, otherwise it is refetched
+	 * before returning.
+	 */
+	TFuture<FLoadAssetResult> LoadAsset(const FAssetRegisterAssetKey& Key, const TSharedRef<const IQueryNode>& Selection,
+		double Freshness, const FAssetRegisterDeadline& Deadline,
+		TFunction<void(const FAsset&, const FLoadAssetResult&)> OnRevalidated = nullptr)
+	{
+		const UAssetRegisterSettings* Settings = GetDefault<UAssetRegisterSettings>();
+		
+		FAsset KnownAsset;
+		TSharedPtr<const IQueryNode> KnownSelection;
+		double Age = 0.0;
+		bool bHit = FAssetRegisterAssetCache::Get().Find(Key, *Selection, KnownAsset, &KnownSelection, &Age);
+
+		if (!bHit && !KnownSelection.IsValid() && FAssetRegisterNegativeCache::Get().Contains(Key, EAssetRegisterMiss::Asset))
+		{
+			auto OutResult = FLoadAssetResult();
+			OutResult.SetNotFound();
+			return MakeFulfilledPromise<FLoadAssetResult>(MoveTemp(OutResult)).GetFuture();
+		}
+
+		if (!bHit && !KnownSelection.IsValid() && FAssetRegisterDiskCache::Get().FindAsset(Key, KnownAsset, KnownSelection, Age))
+		{
+			FAssetRegisterAssetCache::Get().Add(KnownAsset, *KnownSelection, Age);
+			Freshness = FMath::Min<double>(Freshness, Settings->DiskCacheFreshness);
+			bHit = KnownSelection->CoversSelection(*Selection);
+		}
+
+		if (bHit)
+		{
+			if (Age > Freshness)
+			{
+				if (!Settings->bStaleWhileRevalidate)
+				{
+					return FetchAsset(Key, *Selection, Deadline);
+				}
+				
+				UE_LOG(LogAssetRegister, VeryVerbose, TEXT("UAssetRegisterQueryingLibrary::LoadAsset serving %s %.1fs old, refetching in the background"),
+					*Key.ToString(), Age);
+				RevalidateAsset(Key, *Selection, [StaleAsset = KnownAsset, OnRevalidated = MoveTemp(OnRevalidated)](const FLoadAssetResult& Result)
+				{
+					if (OnRevalidated)
+					{
+						OnRevalidated(StaleAsset, Result);
+					}
+				});
+			}
+			
+			auto OutResult = FLoadAssetResult();
+			OutResult.SetResult(MoveTemp(KnownAsset));
+			return MakeFulfilledPromise<FLoadAssetResult>(MoveTemp(OutResult)).GetFuture();
+		}
+
+		if (!KnownSelection.IsValid())
+		{
+			return FetchAsset(Key, *Selection, Deadline);
+		}
+
+		const TSharedPtr<IQueryNode> MissingSelection = Selection->GetMissingSelection(*KnownSelection);
+		UE_LOG(LogAssetRegister, VeryVerbose, TEXT("UAssetRegisterQueryingLibrary::LoadAsset %s only requests %s"),
+			*Key.ToString(), *MissingSelection->GetQueryString());
+		
+		return FetchAsset(Key, *MissingSelection, Deadline).Next(
+		[KnownAsset = MoveTemp(KnownAsset), MissingSelection](const FLoadAssetResult& Result)
+		{
+			if (!Result.bSuccess)
+			{
+				return Result;
+			}
+
+			auto OutResult = FLoadAssetResult();
+			OutResult.SetResult(KnownAsset);
+			FAssetRegisterAssetCache::CopyFields(Result.Value, OutResult.Value, *MissingSelection);
+			return OutResult;
+		});
+	}
+
+	/** Whether two assets link to the same children at the same paths. */
+	bool HaveSameChildLinks(const FAsset& A, const FAsset& B)
+	{
+		const UNFTAssetLinkObject* LinksA = Cast<UNFTAssetLinkObject>(A.LinkWrapper.Links);
+		const UNFTAssetLinkObject* LinksB = Cast<UNFTAssetLinkObject>(B.LinkWrapper.Links);
+		if (!LinksA || !LinksB)
+		{
+			return LinksA == LinksB;
+		}
+		
+		const TArray<FLink>& ChildLinksA = LinksA->Data.ChildLinks;
+		const TArray<FLink>& ChildLinksB = LinksB->Data.ChildLinks;
+		if (ChildLinksA.Num() != ChildLinksB.Num())
+		{
+			return false;
+		}
+		
+		for (int32 Index = 0; Index < ChildLinksA.Num(); ++Index)
+		{
+			if (ChildLinksA[Index].Path != ChildLinksB[Index].Path
+				|| ChildLinksA[Index].Asset.CollectionId != ChildLinksB[Index].Asset.CollectionId
+				|| ChildLinksA[Index].Asset.TokenId != ChildLinksB[Index].Asset.TokenId)
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	/** The first field of Sort that isn't a member of FAsset, e.g. a nested one, so CompareAssets can't order by it. */
+	const FSort* FindUnresolvedSortField(const TArray<FSort>& Sort)
+	{
+		return Sort.FindByPredicate([](const FSort& SortField)
+		{
+			return FAsset::StaticStruct()->FindPropertyByName(FName(*SortField.Name)) == nullptr;
+		});
+	}
+
+	/** Whether Value is a non-negative integer written out in digits, like a token id. */
+	bool IsDigits(const FString& Value)
+	{
+		if (Value.IsEmpty())
+		{
+			return false;
+		}
+		for (const TCHAR Char : Value)
+		{
+			if (!FChar::IsDigit(Char))
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	/**
+	 * Orders two IsDigits strings by the integers they spell. Exact for any length, where a double rounds ids past
+	 * 2^53 together.
+	 */
+	int32 CompareDigits(FStringView A, FStringView B)
+	{
+		auto StripLeadingZeros = [](FStringView Digits)
+		{
+			int32 NumZeros = 0;
+			while (NumZeros < Digits.Len() - 1 && Digits[NumZeros] == '0')
+			{
+				++NumZeros;
+			}
+			return Digits.RightChop(NumZeros);
+		};
+
+		A = StripLeadingZeros(A);
+		B = StripLeadingZeros(B);
+		if (A.Len() != B.Len())
+		{
+			return A.Len() < B.Len() ? -1 : 1;
+		}
+		return A.Compare(B);
+	}
+
+	/**
+	 * Orders two assets by the fields of Sort, in the order they are listed. Fields FindUnresolvedSortField reports
+	 * are skipped.
+	 *
+	 * @return Negative if A comes first, positive if B does, 0 if Sort doesn't tell them apart.
+	 */
+	int32 CompareAssets(const FAsset& A, const FAsset& B, const TArray<FSort>& Sort)
+	{
+		for (const FSort& SortField : Sort)
+		{
+			const FProperty* Property = FAsset::StaticStruct()->FindPropertyByName(FName(*SortField.Name));
+			if (!Property)
+			{
+				continue;
+			}
+
+			FString ValueA;
+			FString ValueB;
+			if (const FStrProperty* StrProperty = CastField<FStrProperty>(Property))
+			{
+				ValueA = StrProperty->GetPropertyValue_InContainer(&A);
+				ValueB = StrProperty->GetPropertyValue_InContainer(&B);
+			}
+			else
+			{
+				Property->ExportText_InContainer(0, ValueA, &A, &A, nullptr, PPF_None);
+				Property->ExportText_InContainer(0, ValueB, &B, &B, nullptr, PPF_None);
+			}
+
+			// token ids are numbers sent as strings
+			int32 Order = 0;
+			if (IsDigits(ValueA) && IsDigits(ValueB))
+			{
+				Order = CompareDigits(ValueA, ValueB);
+			}
+			else if (ValueA.IsNumeric() && ValueB.IsNumeric())
+			{
+				const double NumberA = FCString::Atod(*ValueA);
+				const double NumberB = FCString::Atod(*ValueB);
+				Order = NumberA < NumberB ? -1 : (NumberA > NumberB ? 1 : 0);
+			}
+			else
+			{
+				Order = ValueA.Compare(ValueB);
+			}
+
+			if (Order != 0)
+			{
+				return SortField.Order == ESortOrder::DESC ? -Order : Order;
+			}
+		}
+		return 0;
+	}
+
+	/**
+	 * K-way merge of sub-query results that are each in Sort order. Assets Sort doesn't tell apart keep the order of
+	 * the sub-queries.
+	 */
+	FAssets MergePartitions(const TArray<FLoadAssetsResult>& Partitions, const TArray<FSort>& Sort, bool bRemoveDuplicates)
+	{
+		struct FHead
+		{
+			int32 Partition = 0;
+			int32 Edge = 0;
+		};
+
+		auto GetEdge = [&Partitions](const FHead& Head) -> const FAssetEdge&
+		{
+			return Partitions[Head.Partition].Value.Edges[Head.Edge];
+		};
+		auto ComesFirst = [&GetEdge, &Sort](const FHead& A, const FHead& B)
+		{
+			const int32 Order = CompareAssets(GetEdge(A).Node, GetEdge(B).Node, Sort);
+			return Order != 0 ? Order < 0 : A.Partition < B.Partition;
+		};
+
+		FAssets OutAssets;
+		TArray<FHead> Heads;
+		for (int32 Partition = 0; Partition < Partitions.Num(); ++Partition)
+		{
+			OutAssets.Total += Partitions[Partition].Value.Total;
+			if (!Partitions[Partition].Value.Edges.IsEmpty())
+			{
+				Heads.HeapPush({Partition, 0}, ComesFirst);
+			}
+		}
+
+		TSet<FAssetRegisterAssetKey> Seen;
+		while (!Heads.IsEmpty())
+		{
+			FHead Head;
+			Heads.HeapPop(Head, ComesFirst);
+
+			const FAssetEdge& Edge = GetEdge(Head);
+			const FAssetRegisterAssetKey Key(Edge.Node);
+			bool bAlreadySeen = false;
+			if (bRemoveDuplicates && Key.IsValid())
+			{
+				Seen.Add(Key, &bAlreadySeen);
+			}
+			if (!bAlreadySeen)
+			{
+				OutAssets.Edges.Add(Edge);
+			}
+
+			if (++Head.Edge < Partitions[Head.Partition].Value.Edges.Num())
+			{
+				Heads.HeapPush(Head, ComesFirst);
+			}
+		}
+
+		if (bRemoveDuplicates)
+		{
+			OutAssets.Total = OutAssets.Edges.Num();
+		}
+		return OutAssets;
+	}
+
+	/** Sends a GetAssets query, and caches the page and the assets it returns. */
+	TFuture<FLoadAssetsResult> FetchAssets(TArray<uint8>&& QueryContent, const FAssetRegisterDeadline& Deadline,
+		const TFunction<void(const FPageInfo&, int64)>& OnPageInfo = nullptr)
+	{
+		TArray<uint8> PageKey = QueryContent;
+		
+		return UAssetRegisterQueryingLibrary::MakeAssetsQuery(MoveTemp(QueryContent), Deadline, OnPageInfo).Next([PageKey = MoveTemp(PageKey)]
+		(const FLoadAssetsResult& Result)
+		{
+			if (!Result.bSuccess)
+			{
+				UE_LOG(LogAssetRegister, Warning, TEXT("UAssetRegisterQueryingLibrary::GetAssets failed to get assets"));
+				auto OutResult = FLoadAssetsResult();
+				OutResult.SetFailure();
+				return OutResult;
+			}
+			
+			for (const FAssetEdge& Edge : Result.Value.Edges)
+			{
+				const FAssetRegisterAssetKey Key(Edge.Node);
+				if (Key.IsValid())
+				{
+					FAssetRegisterAssetCache::Get().Add(Edge.Node, GetAssetsNodeSelection());
+					FAssetRegisterNegativeCache::Get().Remove(Key);
+				}
+			}
+			FAssetRegisterDiskCache::Get().AddAssetsPage(PageKey, Result.Value, GetAssetsNodeSelection());
+			
+			return Result;
+		});
+	}
+}
+
+void UAssetRegisterQueryingLibrary::GetAssetProfile(const FString& TokenId, const FString& CollectionId,
+	const FGetJsonCompleted& OnCompleted)
+{
+	GetAssetProfile(TokenId, CollectionId).Next([OnCompleted](const FLoadJsonResult& Result)
+	{
+		OnCompleted.ExecuteIfBound(Result.bSuccess, Result.Value);
 	});
 }
 
 TFuture<FLoadJsonResult> UAssetRegisterQueryingLibrary::GetAssetProfile(const FString& TokenId,
-	const FString& CollectionId)
+	const FString& CollectionId, const FAssetRegisterDeadline& Deadline, const TFunction<void(const FLoadJsonResult&)>& OnChanged)
 {
-	TSharedPtr<TPromise<FLoadJsonResult>> Promise = MakeShareable(new TPromise<FLoadJsonResult>());
-	
-	auto AssetQuery = FAssetRegisterQueryBuilder::AddAssetQuery(FAssetInput(TokenId, CollectionId));
-
-	AssetQuery->AddField<FAsset>(&FAsset::Profiles);
+	static const TSharedRef<const IQueryNode> Selection = AssetRegisterQuerying::MakeAssetSelection([](FQueryNode<FAsset>& AssetNode)
+	{
+		AssetNode.AddField<FAsset>(&FAsset::Profiles);
+	});
 	
-	MakeAssetQuery(AssetQuery->GetQueryJsonString()).Next([Promise, TokenId, CollectionId]
-	(const FLoadAssetResult& Result)
+	auto ToProfileResult = [](const FAsset& Asset)
 	{
-		FAsset Asset = Result.Value;
+		const FString AssetProfileKey = TEXT("asset-profile");
 		
 		auto OutResult = FLoadJsonResult();
-		
+		if (const FString* AssetProfile = Asset.Profiles.Find(AssetProfileKey))
+		{
+			OutResult.SetResult(*AssetProfile);
+		}
+		else
+		{
+			OutResult.SetNotFound();
+		}
+		return OutResult;
+	};
+	
+	TFunction<void(const FAsset&, const FLoadAssetResult&)> OnRevalidated;
+	if (OnChanged)
+	{
+		OnRevalidated = [OnChanged, ToProfileResult](const FAsset& StaleAsset, const FLoadAssetResult& Result)
+		{
+			if (!Result.bSuccess)
+			{
+				return;
+			}
+			
+			const FLoadJsonResult StaleResult = ToProfileResult(StaleAsset);
+			const FLoadJsonResult RefreshedResult = ToProfileResult(Result.Value);
+			if (RefreshedResult.bSuccess != StaleResult.bSuccess || !RefreshedResult.Value.Equals(StaleResult.Value, ESearchCase::CaseSensitive))
+			{
+				OnChanged(RefreshedResult);
+			}
+		};
+	}
+	
+	const FAssetRegisterAssetKey Key(CollectionId, TokenId);
+	if (FAssetRegisterNegativeCache::Get().Contains(Key, EAssetRegisterMiss::AssetProfile))
+	{
+		auto OutResult = FLoadJsonResult();
+		OutResult.SetNotFound();
+		return MakeFulfilledPromise<FLoadJsonResult>(MoveTemp(OutResult)).GetFuture();
+	}
+	
+	const UAssetRegisterSettings* Settings = GetDefault<UAssetRegisterSettings>();
+	return AssetRegisterQuerying::LoadAsset(Key, Selection, Settings->AssetProfileFreshness, Deadline, MoveTemp(OnRevalidated)).Next(
+	[Key, ToProfileResult](const FLoadAssetResult& Result)
+	{
 		if (!Result.bSuccess)
 		{
-			UE_LOG(LogAssetRegister, Warning, TEXT("[UGetAssetProfile] failed to load remote AssetProfile for %s:%s"), *CollectionId, *TokenId);
+			UE_LOG(LogAssetRegister, Warning, TEXT("[UGetAssetProfile] failed to load remote AssetProfile for %s:%s"), *Key.CollectionId, *Key.TokenId);
+			auto OutResult = FLoadJsonResult();
 			OutResult.SetFailure();
-			Promise->SetValue(OutResult);
-			return;
+			OutResult.bNotFound = Result.bNotFound;
+			return OutResult;
 		}
 		
-		const FString AssetProfileKey = TEXT("asset-profile");
-		if (Asset.Profiles.Contains(AssetProfileKey))
+		FLoadJsonResult OutResult = ToProfileResult(Result.Value);
+		if (OutResult.bNotFound)
 		{
-			OutResult.SetResult(Asset.Profiles[AssetProfileKey]);
+			FAssetRegisterNegativeCache::Get().Add(Key, EAssetRegisterMiss::AssetProfile);
 		}
-		else
+		return OutResult;
+	});
+}
+
+void UAssetRegisterQueryingLibrary::GetAssetLinks(const FString& TokenId, const FString& CollectionId,
+	const FGetAssetCompleted& OnCompleted)
+{
+	GetAssetLinks(TokenId, CollectionId).Next([OnCompleted](const FLoadAssetResult& Result)
+	{
+		const UNFTAssetLinkObject* Links = Cast<UNFTAssetLinkObject>(Result.Value.LinkWrapper.Links);
+		OnCompleted.ExecuteIfBound(Result.bSuccess && Links && !Links->Data.ChildLinks.IsEmpty(), Result.Value);
+	});
+}
+
+TFuture<FLoadAssetResult> UAssetRegisterQueryingLibrary::GetAssetLinks(const FString& TokenId,
+	const FString& CollectionId, const FAssetRegisterDeadline& Deadline, const TFunction<void(const FLoadAssetResult&)>& OnChanged)
+{
+	static const TSharedRef<const IQueryNode> Selection = AssetRegisterQuerying::MakeAssetSelection([](FQueryNode<FAsset>& AssetNode)
+	{
+		AssetNode.OnMember(&FAsset::Links)
+		->OnUnion<FNFTAssetLink>()
+			->OnArray(&FNFTAssetLink::ChildLinks)
+				->AddField(&FLink::Path)
+				->OnMember(&FLink::Asset)
+					->AddField(&FAsset::CollectionId)
+					->AddField(&FAsset::TokenId);
+	});
+	
+	auto ToLinksResult = [](const FAsset& Asset)
+	{
+		auto OutResult = FLoadAssetResult();
+		if (!Cast<UNFTAssetLinkObject>(Asset.LinkWrapper.Links))
+		{
+			UE_LOG(LogAssetRegister, Error, TEXT("UAssetRegisterQueryingLibrary::GetAssetLinks Failed to get NFTAssetLink Data!"));
+			OutResult.SetFailure();
+			return OutResult;
+		}
+		
+		OutResult.SetResult(Asset);
+		return OutResult;
+	};
+	
+	TFunction<void(const FAsset&, const FLoadAssetResult&)> OnRevalidated;
+	if (OnChanged)
+	{
+		OnRevalidated = [OnChanged, ToLinksResult](const FAsset& StaleAsset, const FLoadAssetResult& Result)
+		{
+			if (Result.bSuccess && !AssetRegisterQuerying::HaveSameChildLinks(StaleAsset, Result.Value))
+			{
+				OnChanged(ToLinksResult(Result.Value));
+			}
+		};
+	}
+	
+	const FAssetRegisterAssetKey Key(CollectionId, TokenId);
+	const UAssetRegisterSettings* Settings = GetDefault<UAssetRegisterSettings>();
+	return AssetRegisterQuerying::LoadAsset(Key, Selection, Settings->AssetLinksFreshness, Deadline, MoveTemp(OnRevalidated)).Next(
+	[Key, ToLinksResult](const FLoadAssetResult& Result)
+	{
+		if (!Result.bSuccess)
 		{
+			UE_LOG(LogAssetRegister, Warning, TEXT("UAssetRegisterQueryingLibrary::GetAssetLinks failed to load get links for %s:%s"), *Key.CollectionId, *Key.TokenId);
+			auto OutResult = FLoadAssetResult();
 			OutResult.SetFailure();
+			return OutResult;
 		}
-
-		Promise->SetValue(OutResult);
+		
+		return ToLinksResult(Result.Value);
 	});
+}
 
-	return Promise->GetFuture();
+void UAssetRegisterQueryingLibrary::GetAssets(const FAssetConnection& AssetsInput, const FGetAssetsCompleted& OnCompleted)
+{
+	GetAssets(AssetsInput).Next([OnCompleted](const FLoadAssetsResult& Result)
+	{
+		OnCompleted.ExecuteIfBound(Result.bSuccess, Result.Value);
+	});
 }
 
-void UAssetRegisterQueryingLibrary::GetAssetLinks(const FString& TokenId, const FString& CollectionId,
-	const FGetAssetCompleted& OnCompleted)
+TFuture<FLoadAssetsResult> UAssetRegisterQueryingLibrary::GetAssets(const FAssetConnection& AssetsInput,
+	const FAssetRegisterDeadline& Deadline, const TFunction<void(const FPageInfo&, int64)>& OnPageInfo)
 {
-	auto AssetQuery = FAssetRegisterQueryBuilder::AddAssetQuery(FAssetInput(TokenId, CollectionId));
-	AssetQuery->OnMember(&FAsset::Links)
-	->OnUnion<FNFTAssetLink>()
-		->OnArray(&FNFTAssetLink::ChildLinks)
-			->AddField(&FLink::Path)
-			->OnMember(&FLink::Asset)
-				->AddField(&FAsset::CollectionId)
-				->AddField(&FAsset::TokenId);
+	const FAssetRegisterRequestScope RequestScope;
+	TArray<uint8> QueryContent = GetAssetsQueryNode(AssetsInput)->GetQueryJsonUtf8();
 	
-	MakeAssetQuery(AssetQuery->GetQueryJsonString()).Next([OnCompleted, TokenId, CollectionId]
-	(const FLoadAssetResult& Result)
+	FAssets CachedAssets;
+	bool bStale = false;
+	// without stale-while-revalidate a stale page is refetched before returning
+	if (FAssetRegisterDiskCache::Get().FindAssetsPage(QueryContent, AssetRegisterQuerying::GetAssetsNodeSelection(), CachedAssets, bStale)
+		&& (!bStale || GetDefault<UAssetRegisterSettings>()->bStaleWhileRevalidate))
 	{
-		if (!Result.bSuccess)
+		for (const FAssetEdge& Edge : CachedAssets.Edges)
 		{
-			UE_LOG(LogAssetRegister, Warning, TEXT("UAssetRegisterQueryingLibrary::GetAssetLinks failed to load get links for %s:%s"), *CollectionId, *TokenId);
-			OnCompleted.ExecuteIfBound(false, FAsset());
-			return;
+			FAssetRegisterAssetCache::Get().Add(Edge.Node, AssetRegisterQuerying::GetAssetsNodeSelection());
 		}
 		
-		FAsset OutAsset = Result.Value;
-		auto Links = Cast<UNFTAssetLinkObject>(OutAsset.LinkWrapper.Links);
-		if (!Links)
+		const FString RevalidationId = FString::Printf(TEXT("page:%llx"), CityHash64(reinterpret_cast<const char*>(QueryContent.GetData()), QueryContent.Num()));
+		if (bStale && AssetRegisterQuerying::BeginRevalidation(RevalidationId))
 		{
-			UE_LOG(LogAssetRegister, Error, TEXT("UAssetRegisterQueryingLibrary::GetAssetLinks Failed to get NFTAssetLink Data!"));
-			OnCompleted.ExecuteIfBound(false, OutAsset);
-			return;
+			AssetRegisterQuerying::FetchAssets(MoveTemp(QueryContent), FAssetRegisterDeadline()).Next([RevalidationId](const FLoadAssetsResult&)
+			{
+				AssetRegisterQuerying::EndRevalidation(RevalidationId);
+			});
 		}
 		
-		OnCompleted.ExecuteIfBound(!Links->Data.ChildLinks.IsEmpty(), OutAsset);
-	});
+		auto OutResult = FLoadAssetsResult();
+		OutResult.SetResult(MoveTemp(CachedAssets));
+		return MakeFulfilledPromise<FLoadAssetsResult>(MoveTemp(OutResult)).GetFuture();
+	}
+	
+	return AssetRegisterQuerying::FetchAssets(MoveTemp(QueryContent), Deadline, OnPageInfo);
 }
 
-TFuture<FLoadAssetResult> UAssetRegisterQueryingLibrary::GetAssetLinks(const FString& TokenId,
-	const FString& CollectionId)
+struct FGetAllAssetsState
 {
-	TSharedPtr<TPromise<FLoadAssetResult>> Promise = MakeShareable(new TPromise<FLoadAssetResult>());
-	TFuture<FLoadAssetResult> Future = Promise->GetFuture();
-	
-	auto AssetQuery = FAssetRegisterQueryBuilder::AddAssetQuery(FAssetInput(TokenId, CollectionId));
-	AssetQuery->OnMember(&FAsset::Links)
-	->OnUnion<FNFTAssetLink>()
-		->OnArray(&FNFTAssetLink::ChildLinks)
-			->AddField(&FLink::Path)
-			->OnMember(&FLink::Asset)
-				->AddField(&FAsset::CollectionId)
-				->AddField(&FAsset::TokenId);
-
-	MakeAssetQuery(AssetQuery->GetQueryJsonString()).Next([Promise, TokenId, CollectionId]
-	(const FLoadAssetResult& Result)
+	TSharedPtr<FAssetRegisterAssetStream> Stream;
+	FAssetRegisterDeadline Deadline;
+	FAssets Assets;
+	TPromise<FLoadAssetsResult> Promise;
+};
+
+namespace AssetRegisterQuerying
+{
+	/** Adds a page to a GetAllAssets result, or completes it. @return Whether the next page should be requested. */
+	bool AddAllAssetsPage(FGetAllAssetsState& State, const FLoadAssetsResult& Result)
 	{
-		auto OutResult = FLoadAssetResult();
 		if (!Result.bSuccess)
 		{
-			UE_LOG(LogAssetRegister, Warning, TEXT("UAssetRegisterQueryingLibrary::GetAssetLinks failed to load get links for %s:%s"), *CollectionId, *TokenId);
+			// the request was cut off by the deadline, GetNextAssetsPage returns what we have so far
+			if (State.Deadline.HasExpired())
+			{
+				return true;
+			}
+			
+			UE_LOG(LogAssetRegister, Warning, TEXT("UAssetRegisterQueryingLibrary::GetAllAssets failed to get page %d"), State.Stream->GetNumPages());
+			auto OutResult = FLoadAssetsResult();
 			OutResult.SetFailure();
-			Promise->SetValue(OutResult);
-			return;
+			State.Promise.SetValue(MoveTemp(OutResult));
+			return false;
 		}
+
+		State.Assets.Edges.Append(Result.Value.Edges);
+		State.Assets.PageInfo = Result.Value.PageInfo;
+		State.Assets.Total = Result.Value.Total;
 		
-		FAsset OutAsset = Result.Value;
-		auto Links = Cast<UNFTAssetLinkObject>(OutAsset.LinkWrapper.Links);
-		if (!Links)
+		if (!State.Stream->HasNext())
 		{
-			UE_LOG(LogAssetRegister, Error, TEXT("UAssetRegisterQueryingLibrary::GetAssetLinks Failed to get NFTAssetLink Data!"));
-			OutResult.SetFailure();
-			Promise->SetValue(OutResult);
-			return;
+			auto OutResult = FLoadAssetsResult();
+			OutResult.SetResult(MoveTemp(State.Assets));
+			State.Promise.SetValue(MoveTemp(OutResult));
+			return false;
 		}
-		
-		OutResult.SetResult(OutAsset);
-		Promise->SetValue(OutResult);
-	});
-
-	return Future;
+		return true;
+	}
 }
 
-void UAssetRegisterQueryingLibrary::GetAssets(const FAssetConnection& AssetsInput, const FGetAssetsCompleted& OnCompleted)
+void UAssetRegisterQueryingLibrary::GetAllAssets(const FAssetConnection& AssetsInput, float TimeoutSeconds,
+	const FGetAllAssetsCompleted& OnCompleted)
 {
-	const auto AssetsQuery = GetAssetsQueryNode(AssetsInput);
+	const FAssetRegisterDeadline Deadline = TimeoutSeconds > 0.f ? FAssetRegisterDeadline::After(TimeoutSeconds) : FAssetRegisterDeadline();
 	
-	MakeAssetsQuery(AssetsQuery->GetQueryJsonString()).Next([OnCompleted]
-	(const FLoadAssetsResult& Result)
+	GetAllAssets(AssetsInput, Deadline).Next([OnCompleted](const FLoadAssetsResult& Result)
 	{
-		if (!Result.bSuccess)
-		{
-			UE_LOG(LogAssetRegister, Warning, TEXT("UAssetRegisterQueryingLibrary::GetAssets failed to get assets"));
-			OnCompleted.ExecuteIfBound(false, FAssets());
-			return;
-		}
-		
-		FAssets Assets = Result.Value;
-		OnCompleted.ExecuteIfBound(true, Assets);
+		OnCompleted.ExecuteIfBound(Result.bSuccess, Result.bPartial, Result.Value);
 	});
 }
 
-TFuture<FLoadAssetsResult> UAssetRegisterQueryingLibrary::GetAssets(const FAssetConnection& AssetsInput)
+TFuture<FLoadAssetsResult> UAssetRegisterQueryingLibrary::GetAllAssets(const FAssetConnection& AssetsInput,
+	const FAssetRegisterDeadline& Deadline)
 {
-	TSharedPtr<TPromise<FLoadAssetsResult>> Promise = MakeShared<TPromise<FLoadAssetsResult>>();
-	
-	const auto AssetsQuery = GetAssetsQueryNode(AssetsInput);
-	
-	MakeAssetsQuery(AssetsQuery->GetQueryJsonString()).Next([Promise]
-	(const FLoadAssetsResult& Result)
+	TSharedRef<FGetAllAssetsState> State = MakeShared<FGetAllAssetsState>();
+	State->Stream = FAssetRegisterAssetStream::Create(AssetsInput, 0, Deadline);
+	State->Deadline = Deadline;
+
+	TFuture<FLoadAssetsResult> Future = State->Promise.GetFuture();
+	GetNextAssetsPage(State);
+	return Future;
+}
+
+void UAssetRegisterQueryingLibrary::GetNextAssetsPage(const TSharedRef<FGetAllAssetsState>& State)
+{
+	// pages served from a cache are ready at once, they are taken in a loop rather than nesting a continuation per page
+	while (true)
 	{
-		if (!Result.bSuccess)
+		if (State->Deadline.HasExpired())
 		{
-			UE_LOG(LogAssetRegister, Warning, TEXT("UAssetRegisterQueryingLibrary::GetAssets failed to get assets"));
+			UE_LOG(LogAssetRegister, Log, TEXT("UAssetRegisterQueryingLibrary::GetAllAssets deadline expired after %d pages, returning %d assets"),
+				State->Stream->GetNumPages(), State->Assets.Edges.Num());
 			auto OutResult = FLoadAssetsResult();
-			OutResult.SetFailure();
-			Promise->SetValue(OutResult);
+			OutResult.SetPartialResult(MoveTemp(State->Assets));
+			State->Promise.SetValue(MoveTemp(OutResult));
 			return;
 		}
-		Promise->SetValue(Result);
-	});
 
-	return Promise->GetFuture();
+		TFuture<FLoadAssetsResult> Page = State->Stream->Next();
+		if (!Page.IsReady())
+		{
+			Page.Next([State](const FLoadAssetsResult& Result)
+			{
+				if (AssetRegisterQuerying::AddAllAssetsPage(*State, Result))
+				{
+					GetNextAssetsPage(State);
+				}
+			});
+			return;
+		}
+
+		if (!AssetRegisterQuerying::AddAllAssetsPage(*State, Page.Get()))
+		{
+			return;
+		}
+	}
 }
 
-TFuture<FLoadAssetsResult> UAssetRegisterQueryingLibrary::MakeAssetsQuery(const FString& QueryContent)
+void UAssetRegisterQueryingLibrary::GetAllAssetsPartitioned(const FAssetConnection& AssetsInput, EAssetRegisterPartition Partition,
+	float TimeoutSeconds, const FGetAllAssetsCompleted& OnCompleted)
 {
-	TSharedPtr<TPromise<FLoadAssetsResult>> Promise = MakeShared<TPromise<FLoadAssetsResult>>();
+	const FAssetRegisterDeadline Deadline = TimeoutSeconds > 0.f ? FAssetRegisterDeadline::After(TimeoutSeconds) : FAssetRegisterDeadline();
 	
-	FString URL;
-	const UAssetRegisterSettings* Settings = GetDefault<UAssetRegisterSettings>();
-	check(Settings);
-	
-	if (Settings)
+	GetAllAssetsPartitioned(AssetsInput, Partition, Deadline).Next([OnCompleted](const FLoadAssetsResult& Result)
+	{
+		OnCompleted.ExecuteIfBound(Result.bSuccess, Result.bPartial, Result.Value);
+	});
+}
+
+TFuture<FLoadAssetsResult> UAssetRegisterQueryingLibrary::GetAllAssetsPartitioned(const FAssetConnection& AssetsInput,
+	EAssetRegisterPartition Partition, const FAssetRegisterDeadline& Deadline)
+{
+	TArray<FString> PartitionKeys;
+	for (const FString& Key : Partition == EAssetRegisterPartition::ByCollection ? AssetsInput.CollectionIds : AssetsInput.Addresses)
 	{
-		URL = Settings->AssetRegisterURL;
+		PartitionKeys.AddUnique(Key);
 	}
-	else
+	if (PartitionKeys.Num() < 2)
 	{
-		UE_LOG(LogAssetRegister, Warning, TEXT("UAssetRegisterQueryingLibrary::MakeAssetsQuery UAssetRegisterSettings was null, returning empty string"));
-		auto Result = FLoadAssetsResult();
-		Result.SetFailure();
-		Promise->SetValue(Result);
+		return GetAllAssets(AssetsInput, Deadline);
 	}
 
-	const TSharedRef<IHttpRequest> Request = FHttpModule::Get().CreateRequest();
-	
-	Request->SetURL(URL);
-	Request->SetVerb(TEXT("POST"));
-	Request->SetHeader("content-type", "application/json");
-	
-	UE_LOG(LogAssetRegister, Verbose, TEXT("UAssetRegisterQueryingLibrary::MakeAssetsQuery Sending Request. URL: %s Content: %s"), *URL, *QueryContent);
-	Request->SetContentAsString(QueryContent);
-	Request->SetTimeout(60);
+	// the server sorts by fields the merge can't compare, so only a single query returns them in order
+	if (const FSort* SortField = AssetRegisterQuerying::FindUnresolvedSortField(AssetsInput.Sort))
+	{
+		UE_LOG(LogAssetRegister, Warning, TEXT("UAssetRegisterQueryingLibrary::GetAllAssetsPartitioned can't merge by sort field '%s', sending a single query instead"),
+			*SortField->Name);
+		return GetAllAssets(AssetsInput, Deadline);
+	}
 
-	auto RequestCallback = [Promise]
-	(FHttpRequestPtr Request, const FHttpResponsePtr& Response, bool bWasSuccessful) mutable
+	// every sub-query goes through the request scheduler, so MaxConcurrentRequests still applies
+	TArray<TFuture<FLoadAssetsResult>> Futures;
+	for (const FString& Key : PartitionKeys)
 	{
-		auto Result = FLoadAssetsResult();
-		if (Response == nullptr)
-		{
-			Result.SetFailure();
-			Promise->SetValue(Result);
-			return;
-		}
-		if (!bWasSuccessful || !Response.IsValid())
-		{
-			Result.SetFailure();
-			Promise->SetValue(Result);
-			return;
-		}
-		if (Response->GetContentAsString().IsEmpty())
+		FAssetConnection PartitionInput = AssetsInput;
+		TArray<FString>& PartitionValues = Partition == EAssetRegisterPartition::ByCollection ? PartitionInput.CollectionIds : PartitionInput.Addresses;
+		PartitionValues = {Key};
+		Futures.Add(GetAllAssets(PartitionInput, Deadline));
+	}
+
+	return AssetRegisterFutures::WhenAll(MoveTemp(Futures)).Next([Sort = AssetsInput.Sort, bRemoveDuplicates = AssetsInput.RemoveDuplicates,
+		NumPartitions = PartitionKeys.Num()](const TArray<FLoadAssetsResult>& Results)
+	{
+		auto OutResult = FLoadAssetsResult();
+		for (const FLoadAssetsResult& Result : Results)
 		{
-			Result.SetFailure();
-			Promise->SetValue(Result);
-			return;
+			if (!Result.bSuccess)
+			{
+				UE_LOG(LogAssetRegister, Warning, TEXT("UAssetRegisterQueryingLibrary::GetAllAssetsPartitioned failed to get one of %d partitions"),
+					NumPartitions);
+				OutResult.SetFailure();
+				return OutResult;
+			}
+			OutResult.bPartial |= Result.bPartial;
 		}
-	
-		HandleAssetsResponse(Response->GetContentAsString()).Next([Promise](const FLoadAssetsResult& LoadResult)
+
+		OutResult.SetResult(AssetRegisterQuerying::MergePartitions(Results, Sort, bRemoveDuplicates));
+		return OutResult;
+	});
+}
+
+UAssetRegisterAssetStream* UAssetRegisterQueryingLibrary::StreamAssets(const FAssetConnection& AssetsInput, int32 MaxItems)
+{
+	UAssetRegisterAssetStream* Stream = NewObject<UAssetRegisterAssetStream>();
+	Stream->SetStream(StreamAssets(AssetsInput, MaxItems, FAssetRegisterDeadline()));
+	return Stream;
+}
+
+TSharedRef<FAssetRegisterAssetStream> UAssetRegisterQueryingLibrary::StreamAssets(const FAssetConnection& AssetsInput,
+	int32 MaxItems, const FAssetRegisterDeadline& Deadline)
+{
+	return FAssetRegisterAssetStream::Create(AssetsInput, MaxItems, Deadline);
+}
+
+TFuture<FLoadAssetsResult> UAssetRegisterQueryingLibrary::MakeAssetsQuery(const FString& QueryContent)
+{
+	const FTCHARToUTF8 QueryContentUtf8(*QueryContent, QueryContent.Len());
+	return MakeAssetsQuery(TArray<uint8>(reinterpret_cast<const uint8*>(QueryContentUtf8.Get()), QueryContentUtf8.Length()));
+}
+
+TFuture<FLoadAssetsResult> UAssetRegisterQueryingLibrary::MakeAssetsQuery(TArray<uint8>&& QueryContentUtf8,
+	const FAssetRegisterDeadline& Deadline, const TFunction<void(const FPageInfo&, int64)>& OnPageInfo)
+{
+	TFunction<void(TConstArrayView<uint8>)> OnContent;
+	if (OnPageInfo)
+	{
+		OnContent = [OnPageInfo](TConstArrayView<uint8> Content)
 		{
-			Promise->SetValue(LoadResult);
-		});
-	};
+			FPageInfo PageInfo;
+			if (QueryStringUtil::TryFindPageInfoUtf8(Content, PageInfo.EndCursor, PageInfo.HasNextPage))
+			{
+				OnPageInfo(PageInfo, Content.Num());
+			}
+		};
+	}
 	
-	Request->OnProcessRequestComplete().BindLambda(RequestCallback);
-	Request->ProcessRequest();
-
-	return Promise->GetFuture();
+	return AssetRegisterQuerying::SendQuery(MoveTemp(QueryContentUtf8), TEXT("MakeAssetsQuery"), Deadline,
+		AssetRegisterQuerying::GetAssetsConditionalCache(), [](const TSharedPtr<FJsonObject>& RootObject)
+	{
+		return HandleAssetsResponse(RootObject);
+	}, MoveTemp(OnContent));
 }
 
 TFuture<FLoadAssetResult> UAssetRegisterQueryingLibrary::MakeAssetQuery(const FString& QueryContent)
 {
-	TSharedPtr<TPromise<FLoadAssetResult>> Promise = MakeShared<TPromise<FLoadAssetResult>>();
-	
-	FString URL;
-	const UAssetRegisterSettings* Settings = GetDefault<UAssetRegisterSettings>();
-	check(Settings);
-	
-	if (Settings)
+	const FTCHARToUTF8 QueryContentUtf8(*QueryContent, QueryContent.Len());
+	return MakeAssetQuery(TArray<uint8>(reinterpret_cast<const uint8*>(QueryContentUtf8.Get()), QueryContentUtf8.Length()));
+}
+
+TFuture<FLoadAssetResult> UAssetRegisterQueryingLibrary::MakeAssetQuery(TArray<uint8>&& QueryContentUtf8,
+	const FAssetRegisterDeadline& Deadline)
+{
+	return AssetRegisterQuerying::SendQuery(MoveTemp(QueryContentUtf8), TEXT("MakeAssetQuery"), Deadline,
+		AssetRegisterQuerying::GetAssetConditionalCache(), [](const TSharedPtr<FJsonObject>& RootObject)
 	{
-		URL = Settings->AssetRegisterURL;
-	}
-	else
+		return HandleAssetResponse(RootObject);
+	});
+}
+
+TFuture<FLoadAssetResult> UAssetRegisterQueryingLibrary::MakeAssetQuery(const FAssetInput& Input,
+	const TSharedPtr<FQueryNode<FAsset>>& AssetQuery, const FAssetRegisterDeadline& Deadline)
+{
+	const FAssetRegisterAssetKey Key(Input.CollectionId, Input.TokenId);
+	if (!AssetQuery.IsValid() || !Key.IsValid())
 	{
-		UE_LOG(LogAssetRegister, Warning, TEXT("UAssetRegisterQueryingLibrary::MakeAssetQuery UAssetRegisterSettings was null, returning empty string"));
-		auto Result = FLoadAssetResult();
-		Result.SetFailure();
-		Promise->SetValue(Result);
+		UE_LOG(LogAssetRegister, Warning, TEXT("UAssetRegisterQueryingLibrary::MakeAssetQuery needs a selection, a TokenId and a CollectionId"));
+		auto OutResult = FLoadAssetResult();
+		OutResult.SetFailure();
+		return MakeFulfilledPromise<FLoadAssetResult>(MoveTemp(OutResult)).GetFuture();
 	}
-
-	const TSharedRef<IHttpRequest> Request = FHttpModule::Get().CreateRequest();
 	
-	Request->SetURL(URL);
-	Request->SetVerb(TEXT("POST"));
-	Request->SetHeader("content-type", "application/json");
-	
-	UE_LOG(LogAssetRegister, Verbose, TEXT("UAssetRegisterQueryingLibrary::MakeAssetQuery Sending Request. URL: %s Content: %s"), *URL, *QueryContent);
-	Request->SetContentAsString(QueryContent);
-	Request->SetTimeout(60);
+	// arbitrary selections are served for as long as the asset cache keeps them
+	return AssetRegisterQuerying::LoadAsset(Key, AssetQuery->CloneNode(), TNumericLimits<double>::Max(), Deadline);
+}
+
+TFuture<TArray<FLoadAssetResult>> UAssetRegisterQueryingLibrary::GetAssetsBatched(const TArray<FAssetRegisterAssetKey>& Keys,
+	const TSharedRef<const IQueryNode>& Selection, double Freshness, const FAssetRegisterDeadline& Deadline)
+{
+	const UAssetRegisterSettings* Settings = GetDefault<UAssetRegisterSettings>();
+	TArray<FLoadAssetResult> Results;
+	Results.SetNum(Keys.Num());
 
-	auto RequestCallback = [Promise]
-	(FHttpRequestPtr Request, const FHttpResponsePtr& Response, bool bWasSuccessful) mutable
+	// what the caches can't answer is selected under an alias per asset
+	TArray<TSharedPtr<IQueryNode>> AssetQueries;
+	TArray<int32> QueryIndices;
+	for (int32 Index = 0; Index < Keys.Num(); ++Index)
 	{
-		auto Result = FLoadAssetResult();
-		if (Response == nullptr)
+		const FAssetRegisterAssetKey& Key = Keys[Index];
+		if (FAssetRegisterNegativeCache::Get().Contains(Key, EAssetRegisterMiss::Asset))
 		{
-			Result.SetFailure();
-			Promise->SetValue(Result);
-			return;
+			Results[Index].SetNotFound();
+			continue;
 		}
-		if (!bWasSuccessful || !Response.IsValid())
+
+		FAsset KnownAsset;
+		TSharedPtr<const IQueryNode> KnownSelection;
+		double Age = 0.0;
+		if (FAssetRegisterAssetCache::Get().Find(Key, *Selection, KnownAsset, nullptr, &Age) && Age <= Freshness)
 		{
-			Result.SetFailure();
-			Promise->SetValue(Result);
-			return;
+			Results[Index].SetResult(MoveTemp(KnownAsset));
+			continue;
 		}
-		if (Response->GetContentAsString().IsEmpty())
+		if (FAssetRegisterDiskCache::Get().FindAsset(Key, KnownAsset, KnownSelection, Age) && KnownSelection->CoversSelection(*Selection)
+			&& Age <= FMath::Min<double>(Freshness, Settings->DiskCacheFreshness))
 		{
-			Result.SetFailure();
-			Promise->SetValue(Result);
-			return;
+			FAssetRegisterAssetCache::Get().Add(KnownAsset, *KnownSelection, Age);
+			Results[Index].SetResult(MoveTemp(KnownAsset));
+			continue;
 		}
-	
-		HandleAssetResponse(Response->GetContentAsString()).Next([Promise](const FLoadAssetResult& LoadResult)
+
+		auto AssetQuery = FAssetRegisterQueryBuilder::AddAssetQuery(FAssetInput(Key.TokenId, Key.CollectionId));
+		AssetQuery->MergeSelection(*Selection);
+		AssetQuery->SetAlias(FString::Printf(TEXT("asset%d"), Index));
+		AssetQueries.Add(AssetQuery);
+		QueryIndices.Add(Index);
+	}
+
+	if (AssetQueries.IsEmpty())
+	{
+		return MakeFulfilledPromise<TArray<FLoadAssetResult>>(MoveTemp(Results)).GetFuture();
+	}
+
+	const FAssetRegisterRequestScope RequestScope;
+	TArray<FString> Aliases;
+	Aliases.Reserve(AssetQueries.Num());
+	for (const TSharedPtr<IQueryNode>& AssetQuery : AssetQueries)
+	{
+		Aliases.Add(AssetQuery->GetAlias());
+	}
+
+	return AssetRegisterQuerying::SendQuery(IQueryNode::GetBatchQueryJsonUtf8(AssetQueries), TEXT("GetAssetsBatched"), Deadline,
+		AssetRegisterQuerying::GetAssetBatchConditionalCache(), [Aliases](const TSharedPtr<FJsonObject>& RootObject)
+	{
+		return HandleAssetBatchResponse(RootObject, Aliases);
+	}).Next([Keys, Results = MoveTemp(Results), QueryIndices, FetchedSelection = Selection->CloneNode()]
+	(const FLoadAssetBatchResult& BatchResult) mutable
+	{
+		if (!BatchResult.bSuccess)
 		{
-			Promise->SetValue(LoadResult);
-		});
-	};
-	
-	Request->OnProcessRequestComplete().BindLambda(RequestCallback);
-	Request->ProcessRequest();
+			return MoveTemp(Results);
+		}
 
-	return Promise->GetFuture();
+		for (int32 QueryIndex = 0; QueryIndex < QueryIndices.Num(); ++QueryIndex)
+		{
+			const int32 Index = QueryIndices[QueryIndex];
+			const FAssetRegisterAssetKey& Key = Keys[Index];
+			FLoadAssetResult Result = BatchResult.Value[QueryIndex];
+			if (Result.bNotFound)
+			{
+				FAssetRegisterNegativeCache::Get().Add(Key, EAssetRegisterMiss::Asset);
+			}
+			else if (Result.bSuccess)
+			{
+				// single asset queries don't select the ids they were made with
+				Result.Value.CollectionId = Key.CollectionId;
+				Result.Value.TokenId = Key.TokenId;
+				AssetRegisterQuerying::CacheAsset(Result.Value, *FetchedSelection);
+			}
+			Results[Index] = MoveTemp(Result);
+		}
+		return MoveTemp(Results);
+	});
 }
 
 TFuture<FString> UAssetRegisterQueryingLibrary::SendRequest(const FString& RawContent)
@@ -334,74 +1155,37 @@ TFuture<FString> UAssetRegisterQueryingLibrary::SendRequest(const FString& RawCo
 	TSharedPtr<TPromise<FString>> Promise = MakeShareable(new TPromise<FString>());
 	TFuture<FString> Future = Promise->GetFuture();
 
-	FString URL;
-	const UAssetRegisterSettings* Settings = GetDefault<UAssetRegisterSettings>();
-	check(Settings);
-	
-	if (Settings)
-	{
-		URL = Settings->AssetRegisterURL;
-	}
-	else
-	{
-		UE_LOG(LogAssetRegister, Warning, TEXT("[UGetAssetProfile] UAssetRegisterSettings was null, returning empty string"));
-		Promise->SetValue(TEXT(""));
-	}
-	
-	const TSharedRef<IHttpRequest> Request = FHttpModule::Get().CreateRequest();
+	const FTCHARToUTF8 RawContentUtf8(*RawContent, RawContent.Len());
 	
-	Request->SetURL(URL);
-	Request->SetVerb(TEXT("POST"));
-	Request->SetHeader("content-type", "application/json");
-
-	TSharedRef<FJsonObject> JsonBody = MakeShared<FJsonObject>();
-	JsonBody->SetStringField("query", RawContent);
-
-	FString Content;
-	TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Content);
-	FJsonSerializer::Serialize(JsonBody, Writer);
-
-	UE_LOG(LogAssetRegister, Verbose, TEXT("UAssetRegisterQueryingLibrary::Sending Request. URL: %s Content: %s"), *URL, *Content);
-	Request->SetContentAsString(Content);
-	Request->SetTimeout(60);
+	const FAssetRegisterRequestScope RequestScope;
+	FAssetRegisterRequest Request;
+	Request.Context = TEXT("SendRequest");
+	Request.Content = QueryStringUtil::MakeQueryJsonUtf8(FUtf8StringView(reinterpret_cast<const UTF8CHAR*>(RawContentUtf8.Get()), RawContentUtf8.Length()));
 	
-	auto RequestCallback = [Promise]
-	(FHttpRequestPtr Request, const FHttpResponsePtr& Response, bool bWasSuccessful) mutable
+	FAssetRegisterTransport::ProcessRequest(MoveTemp(Request)).Next([Promise](const FHttpResponsePtr& Response)
 	{
-		if (Response == nullptr)
+		if (!Response.IsValid())
 		{
 			Promise->SetValue(TEXT(""));
 			return;
 		}
-		if (bWasSuccessful && Response.IsValid())
-		{
-			UE_LOG(LogAssetRegister, Verbose, TEXT("UAssetRegisterQueryingLibrary::SendRequest Response: %s"), *Response->GetContentAsString());
-			Promise->SetValue(Response->GetContentAsString());
-		}
-		else
-		{
-			Promise->SetValue(TEXT(""));
-		}
-	};
-	
-	Request->OnProcessRequestComplete().BindLambda(RequestCallback);
-	Request->ProcessRequest();
+		
+		Promise->SetValue(QueryStringUtil::Utf8ToString(Response->GetContent()));
+	});
 
 	return Future;
 }
 
-TFuture<FLoadAssetsResult> UAssetRegisterQueryingLibrary::HandleAssetsResponse(const FString& ResponseJson)
+TFuture<FLoadAssetsResult> UAssetRegisterQueryingLibrary::HandleAssetsResponse(const TSharedPtr<FJsonObject>& RootObject)
 {
-	UE_LOG(LogAssetRegister, Verbose, TEXT("UAssetRegisterQueryingLibrary::HandleAssetsResponse Attempting to handle Response: %s"), *ResponseJson);
-	
 	TSharedPtr<TPromise<FLoadAssetsResult>> Promise = MakeShared<TPromise<FLoadAssetsResult>>();
 
 	FAssets OutAssets = FAssets();
 
 	FAssets Assets;
-	if (!QueryStringUtil::TryGetModel(ResponseJson, Assets))
+	if (!RootObject.IsValid() || !QueryStringUtil::TryGetModel(RootObject, Assets))
 	{
-		UE_LOG(LogAssetRegister, Error, TEXT("Failed to get Assets Object from Json: %s!"), *ResponseJson);
+		UE_LOG(LogAssetRegister, Error, TEXT("Failed to get Assets Object from Json!"));
 		auto OutResult = FLoadAssetsResult();
 		OutResult.SetFailure();
 		Promise->SetValue(OutResult);
@@ -415,38 +1199,27 @@ TFuture<FLoadAssetsResult> UAssetRegisterQueryingLibrary::HandleAssetsResponse(c
 	{
 		AssetEdgeCursors.Add(AssetEdge.Cursor);
 	}
-	
-	TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(ResponseJson);
-	TSharedPtr<FJsonObject> RootObject;
-	FJsonSerializer::Deserialize(Reader, RootObject);
 
 	TArray<TSharedPtr<FJsonValue>> AssetNodes;
 	QueryStringUtil::FindAllFieldsRecursively(RootObject, TEXT("node"), AssetNodes);
 	
 	TArray<TFuture<FLoadAssetResult>> LoadAssetFutures;
-	TSharedPtr<TArray<FAsset>> LoadedAssets = MakeShared<TArray<FAsset>>();
+	LoadAssetFutures.Reserve(AssetNodes.Num());
 	
 	for (const auto& AssetNode : AssetNodes)
 	{
 		auto AssetNodeObject = AssetNode->AsObject();
 
-		// wrap json under "asset" field
-		TSharedRef<FJsonObject> AssetBody = MakeShared<FJsonObject>();
+		// wrap json under "asset" field, sharing the already parsed node instead of re-serializing it
+		TSharedPtr<FJsonObject> AssetBody = MakeShared<FJsonObject>();
 		AssetBody->SetObjectField("asset", AssetNodeObject);
 		
-		FString AssetJsonString;
-		FJsonObjectWrapper ObjectWrapper;
-		ObjectWrapper.JsonObject = AssetBody;
-		ObjectWrapper.JsonObjectToString(AssetJsonString);
-		
-		TFuture<FLoadAssetResult> LoadAssetFuture = HandleAssetResponse(AssetJsonString).Next(
-		[LoadedAssets, AssetNodeObject](const FLoadAssetResult& AssetResult)
+		TFuture<FLoadAssetResult> LoadAssetFuture = HandleAssetResponse(AssetBody).Next(
+		[AssetNodeObject](FLoadAssetResult AssetResult)
 		{
 			if (AssetResult.bSuccess)
 			{
-				auto Asset = AssetResult.Value;
-				Asset.OriginalJsonData.JsonObject = AssetNodeObject;
-				LoadedAssets->Add(Asset);
+				AssetResult.Value.OriginalJsonData.JsonObject = AssetNodeObject;
 			}
 
 			return AssetResult;
@@ -454,44 +1227,56 @@ TFuture<FLoadAssetsResult> UAssetRegisterQueryingLibrary::HandleAssetsResponse(c
 		LoadAssetFutures.Add(MoveTemp(LoadAssetFuture));
 	}
 	
-	WhenAll(LoadAssetFutures).Next([Promise, &OutAssets, LoadedAssets, AssetEdgeCursors](const TArray<FLoadAssetResult>& Results)
+	// results come back in the order of the nodes, so each asset is paired with the cursor of its own edge
+	AssetRegisterFutures::WhenAll(MoveTemp(LoadAssetFutures)).Next(
+	[Promise, OutAssets = MoveTemp(OutAssets), AssetEdgeCursors = MoveTemp(AssetEdgeCursors)](TArray<FLoadAssetResult> Results) mutable
 	{
-		ensure(AssetEdgeCursors.Num() == LoadedAssets->Num());
-		for (int i = 0; i < LoadedAssets->Num(); ++i)
+		OutAssets.Edges.Reserve(Results.Num());
+		for (int32 i = 0; i < Results.Num(); ++i)
 		{
-			FAssetEdge Edge;
-			Edge.Node = (*LoadedAssets)[i];
-			Edge.Cursor = AssetEdgeCursors[i];
-			OutAssets.Edges.Add(Edge);
+			if (!Results[i].bSuccess)
+			{
+				continue;
+			}
+			
+			FAssetEdge& Edge = OutAssets.Edges.AddDefaulted_GetRef();
+			Edge.Node = MoveTemp(Results[i].Value);
+			if (AssetEdgeCursors.IsValidIndex(i))
+			{
+				Edge.Cursor = MoveTemp(AssetEdgeCursors[i]);
+			}
 		}
 		
 		auto OutResult = FLoadAssetsResult();
-		OutResult.SetResult(OutAssets);
-		Promise->SetValue(OutResult);
+		OutResult.SetResult(MoveTemp(OutAssets));
+		Promise->SetValue(MoveTemp(OutResult));
 	});
 	
 	return Promise->GetFuture();
 }
 
-TFuture<FLoadAssetResult> UAssetRegisterQueryingLibrary::HandleAssetResponse(const FString& ResponseJson)
+TFuture<FLoadAssetResult> UAssetRegisterQueryingLibrary::HandleAssetResponse(const TSharedPtr<FJsonObject>& RootObject)
 {
-	UE_LOG(LogAssetRegister, Verbose, TEXT("UAssetRegisterQueryingLibrary::HandleAssetResponse Attempting to handle Response: %s"), *ResponseJson);
-	
 	TSharedPtr<TPromise<FLoadAssetResult>> Promise = MakeShared<TPromise<FLoadAssetResult>>();
 	auto Result = FLoadAssetResult();
 
+	// a token that doesn't exist is answered with a null asset
+	const TSharedPtr<FJsonValue> AssetValue = QueryStringUtil::FindFieldRecursively(RootObject, TEXT("asset"));
+	if (AssetValue.IsValid() && AssetValue->IsNull())
+	{
+		Result.SetNotFound();
+		Promise->SetValue(Result);
+		return Promise->GetFuture();
+	}
+
 	FAsset OutAsset;
-	if (!QueryStringUtil::TryGetModel(ResponseJson, OutAsset))
+	if (!RootObject.IsValid() || !QueryStringUtil::TryGetModel(RootObject, OutAsset))
 	{
-		UE_LOG(LogAssetRegister, Error, TEXT("Failed to get Asset Object from Json: %s!"), *ResponseJson);
+		UE_LOG(LogAssetRegister, Error, TEXT("Failed to get Asset Object from Json!"));
 		Result.SetFailure();
 		Promise->SetValue(Result);
 		return Promise->GetFuture();
 	}
-	
-	TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(ResponseJson);
-	TSharedPtr<FJsonObject> RootObject;
-	FJsonSerializer::Deserialize(Reader, RootObject);
 
 	const TSharedPtr<FJsonValue> MetadataObject = QueryStringUtil::FindFieldRecursively(RootObject, TEXT("metadata"));
 	if (MetadataObject)
@@ -505,9 +1290,13 @@ TFuture<FLoadAssetResult> UAssetRegisterQueryingLibrary::HandleAssetResponse(con
 	
 	// manually try to get FNFTAssetOwnershipData
 	FNFTAssetOwnership NFTOwnershipData;
-	if (QueryStringUtil::TryGetModelField(ResponseJson, TEXT("ownership"), NFTOwnershipData))
+	if (QueryStringUtil::TryGetModelField(RootObject, TEXT("ownership"), NFTOwnershipData))
 	{
-		UNFTAssetOwnershipObject* NFTOwnership = NewObject<UNFTAssetOwnershipObject>();
+		UNFTAssetOwnershipObject* NFTOwnership;
+		{
+			ASSETREGISTER_TRACE_PHASE(0, CreateObjects);
+			NFTOwnership = NewObject<UNFTAssetOwnershipObject>();
+		}
 		NFTOwnership->Data = NFTOwnershipData;
 		
 		OutAsset.OwnershipWrapper.Ownership = NFTOwnership;
@@ -515,9 +1304,13 @@ TFuture<FLoadAssetResult> UAssetRegisterQueryingLibrary::HandleAssetResponse(con
 	
 	// manually try to get FNFTAssetLinkData
 	FNFTAssetLink NFTAssetLinkData;
-	if (QueryStringUtil::TryGetModelField(ResponseJson, TEXT("links"), NFTAssetLinkData))
+	if (QueryStringUtil::TryGetModelField(RootObject, TEXT("links"), NFTAssetLinkData))
 	{
-		UNFTAssetLinkObject* NFTAssetLink = NewObject<UNFTAssetLinkObject>();
+		UNFTAssetLinkObject* NFTAssetLink;
+		{
+			ASSETREGISTER_TRACE_PHASE(0, CreateObjects);
+			NFTAssetLink = NewObject<UNFTAssetLinkObject>();
+		}
 		NFTAssetLink->Data = NFTAssetLinkData;
 				
 		for (FLink& ChildLink : NFTAssetLink->Data.ChildLinks)
@@ -542,6 +1335,81 @@ TFuture<FLoadAssetResult> UAssetRegisterQueryingLibrary::HandleAssetResponse(con
 	return Promise->GetFuture();
 }
 
+TFuture<FLoadAssetBatchResult> UAssetRegisterQueryingLibrary::HandleAssetBatchResponse(const TSharedPtr<FJsonObject>& RootObject,
+	const TArray<FString>& Aliases)
+{
+	auto OutResult = FLoadAssetBatchResult();
+	const TSharedPtr<FJsonObject>* DataObject = nullptr;
+	if (!RootObject.IsValid() || !RootObject->TryGetObjectField(TEXT("data"), DataObject))
+	{
+		UE_LOG(LogAssetRegister, Error, TEXT("UAssetRegisterQueryingLibrary::HandleAssetBatchResponse Failed to get data Object from Json!"));
+		OutResult.SetFailure();
+		return MakeFulfilledPromise<FLoadAssetBatchResult>(MoveTemp(OutResult)).GetFuture();
+	}
+
+	TArray<FLoadAssetResult> AssetResults;
+	AssetResults.SetNum(Aliases.Num());
+	for (int32 Index = 0; Index < Aliases.Num(); ++Index)
+	{
+		const TSharedPtr<FJsonValue> AssetValue = (*DataObject)->TryGetField(Aliases[Index]);
+		if (!AssetValue.IsValid())
+		{
+			continue;
+		}
+
+		TSharedPtr<FJsonObject> AssetBody = MakeShared<FJsonObject>();
+		AssetBody->SetField(TEXT("asset"), AssetValue);
+
+		// HandleAssetResponse decodes synchronously
+		AssetResults[Index] = HandleAssetResponse(AssetBody).Get();
+	}
+
+	OutResult.SetResult(MoveTemp(AssetResults));
+	return MakeFulfilledPromise<FLoadAssetBatchResult>(MoveTemp(OutResult)).GetFuture();
+}
+
+FLoadAssetResult UAssetRegisterQueryingLibrary::DecodeAssetNode(TConstArrayView<uint8> NodeUtf8)
+{
+	const TSharedPtr<FJsonObject> AssetNodeObject = QueryStringUtil::ParseJsonUtf8(NodeUtf8);
+	if (!AssetNodeObject.IsValid())
+	{
+		auto Result = FLoadAssetResult();
+		if (FUtf8StringView(reinterpret_cast<const UTF8CHAR*>(NodeUtf8.GetData()), NodeUtf8.Num()).TrimStartAndEnd() == UTF8TEXTVIEW("null"))
+		{
+			Result.SetNotFound();
+		}
+		else
+		{
+			UE_LOG(LogAssetRegister, Error, TEXT("UAssetRegisterQueryingLibrary::DecodeAssetNode node isn't a json object"));
+			Result.SetFailure();
+		}
+		return Result;
+	}
+
+	TSharedPtr<FJsonObject> AssetBody = MakeShared<FJsonObject>();
+	AssetBody->SetObjectField("asset", AssetNodeObject);
+
+	// HandleAssetResponse decodes synchronously
+	FLoadAssetResult Result = HandleAssetResponse(AssetBody).Get();
+	if (Result.bSuccess)
+	{
+		Result.Value.OriginalJsonData.JsonObject = AssetNodeObject;
+	}
+	return Result;
+}
+
+FLoadAssetResult UAssetRegisterQueryingLibrary::DecodeAssetResponse(const TSharedPtr<FJsonObject>& RootObject)
+{
+	// HandleAssetResponse decodes synchronously
+	return HandleAssetResponse(RootObject).Get();
+}
+
+FLoadAssetsResult UAssetRegisterQueryingLibrary::DecodeAssetsResponse(const TSharedPtr<FJsonObject>& RootObject)
+{
+	// HandleAssetsResponse decodes synchronously
+	return HandleAssetsResponse(RootObject).Get();
+}
+
 TSharedPtr<FQueryNode<FAssets>> UAssetRegisterQueryingLibrary::GetAssetsQueryNode(const FAssetConnection& AssetsInput)
 {
 	auto AssetsQuery = FAssetRegisterQueryBuilder::AddAssetsQuery(AssetsInput);
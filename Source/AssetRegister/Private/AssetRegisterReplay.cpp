@@ -0,0 +1,145 @@
+// Copyright (c) 2025, Futureverse Corporation Limited. All rights reserved.
+
+#include "AssetRegisterReplay.h"
+
+#include "AssetRegisterCapture.h"
+#include "AssetRegisterLog.h"
+#include "AssetRegisterQueryingLibrary.h"
+#include "AssetRegisterTransport.h"
+#include "Containers/Ticker.h"
+#include "QueryStringUtil.h"
+#include <atomic>
+
+namespace AssetRegisterReplay
+{
+	enum class EQueryKind : uint8
+	{
+		Asset,
+		Assets,
+		Other,
+	};
+
+	/** Which library query decodes the recorded response, judging by its root fields. */
+	EQueryKind GetQueryKind(const FAssetRegisterCaptureEntry& Entry)
+	{
+		const TSharedPtr<FJsonObject> RootObject = QueryStringUtil::ParseJsonUtf8(Entry.ResponseContent);
+		const TSharedPtr<FJsonObject>* DataObject = nullptr;
+		if (!RootObject.IsValid() || !RootObject->TryGetObjectField(TEXT("data"), DataObject))
+		{
+			return EQueryKind::Other;
+		}
+
+		if ((*DataObject)->Values.Num() == 1 && (*DataObject)->HasField(TEXT("assets")))
+		{
+			return EQueryKind::Assets;
+		}
+		if ((*DataObject)->Values.Num() == 1 && (*DataObject)->HasField(TEXT("asset")))
+		{
+			return EQueryKind::Asset;
+		}
+		return EQueryKind::Other;
+	}
+
+	struct FPendingRequest
+	{
+		TArray<uint8> Content;
+		EQueryKind Kind = EQueryKind::Other;
+		/** Seconds from the start of the replay. */
+		double SendTime = 0.0;
+	};
+
+	struct FState
+	{
+		TArray<FPendingRequest> Requests;
+		TArray<FAssetRegisterReplayResult> Results;
+		int32 NumSent = 0;
+		std::atomic<int32> NumPending = 0;
+		double StartTime = 0.0;
+		TPromise<TArray<FAssetRegisterReplayResult>> Promise;
+
+		void Finish(int32 Index, double SendTime, bool bSuccess)
+		{
+			Results[Index].Latency = FPlatformTime::Seconds() - SendTime;
+			Results[Index].bSuccess = bSuccess;
+			if (--NumPending == 0)
+			{
+				Promise.SetValue(MoveTemp(Results));
+			}
+		}
+	};
+
+	void Send(const TSharedRef<FState>& State, int32 Index)
+	{
+		FPendingRequest& Request = State->Requests[Index];
+		const double SendTime = FPlatformTime::Seconds();
+		switch (Request.Kind)
+		{
+		case EQueryKind::Asset:
+			UAssetRegisterQueryingLibrary::MakeAssetQuery(MoveTemp(Request.Content)).Next([State, Index, SendTime](const FLoadAssetResult& Result)
+			{
+				State->Finish(Index, SendTime, Result.bSuccess);
+			});
+			break;
+		case EQueryKind::Assets:
+			UAssetRegisterQueryingLibrary::MakeAssetsQuery(MoveTemp(Request.Content)).Next([State, Index, SendTime](const FLoadAssetsResult& Result)
+			{
+				State->Finish(Index, SendTime, Result.bSuccess);
+			});
+			break;
+		default:
+		{
+			FAssetRegisterRequest TransportRequest;
+			TransportRequest.Context = TEXT("Replay");
+			TransportRequest.Content = MoveTemp(Request.Content);
+			FAssetRegisterTransport::ProcessRequest(MoveTemp(TransportRequest)).Next([State, Index, SendTime](const FHttpResponsePtr& Response)
+			{
+				State->Finish(Index, SendTime, Response.IsValid());
+			});
+			break;
+		}
+		}
+	}
+}
+
+TFuture<TArray<FAssetRegisterReplayResult>> FAssetRegisterReplay::Run(const FAssetRegisterCapture& Capture, float Speed)
+{
+	using namespace AssetRegisterReplay;
+
+	const TSharedRef<FState> State = MakeShared<FState>();
+	TFuture<TArray<FAssetRegisterReplayResult>> Future = State->Promise.GetFuture();
+	if (Capture.Entries.IsEmpty())
+	{
+		State->Promise.SetValue(TArray<FAssetRegisterReplayResult>());
+		return Future;
+	}
+
+	const double FirstSendTime = Capture.Entries[0].SendTime;
+	for (const FAssetRegisterCaptureEntry& Entry : Capture.Entries)
+	{
+		FPendingRequest& Request = State->Requests.AddDefaulted_GetRef();
+		Request.Content = Entry.RequestContent;
+		Request.Kind = GetQueryKind(Entry);
+		Request.SendTime = Speed > 0.f ? (Entry.SendTime - FirstSendTime) / Speed : 0.0;
+
+		FAssetRegisterReplayResult& Result = State->Results.AddDefaulted_GetRef();
+		Result.Context = Entry.Context;
+		Result.NumBytes = Entry.ResponseContent.Num();
+	}
+	State->NumPending = State->Requests.Num();
+	State->StartTime = FPlatformTime::Seconds();
+
+	UE_LOG(LogAssetRegister, Log, TEXT("FAssetRegisterReplay::Run replaying %d requests at %.1fx"), State->Requests.Num(), Speed);
+
+	// requests are sent from the game thread as their time comes, like the game would have
+	FTSTicker::GetCoreTicker().AddTicker(TEXT("AssetRegisterReplay"), 0.f, [State](float)
+	{
+		const double Elapsed = FPlatformTime::Seconds() - State->StartTime;
+		while (State->NumSent < State->Requests.Num() && State->Requests[State->NumSent].SendTime <= Elapsed)
+		{
+			Send(State, State->NumSent++);
+		}
+		return State->NumSent < State->Requests.Num();
+	});
+
+	return Future;
+}
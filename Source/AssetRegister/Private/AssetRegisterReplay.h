@@ -0,0 +1,43 @@
+// Copyright (c) 2025, Futureverse Corporation Limited. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FAssetRegisterCapture;
+
+/**
+ * The outcome of a replayed request.
+ */
+struct FAssetRegisterReplayResult
+{
+	/** Context of the recorded request. */
+	FString Context;
+
+	/** Seconds from sending the request to its decoded result. */
+	double Latency = 0.0;
+
+	/** Bytes of the recorded response. */
+	int64 NumBytes = 0;
+
+	/** Whether the request succeeded, and asset and assets queries were decoded. */
+	bool bSuccess = false;
+};
+
+/**
+ * Sends the requests of a capture again, at their recorded times, through the whole client pipeline: the scheduler,
+ * the transport, and for asset and assets queries UAssetRegisterQueryingLibrary::MakeAssetQuery/MakeAssetsQuery with
+ * their decoding. Other requests only go through the transport.
+ *
+ * Point UAssetRegisterSettings::AssetRegisterURL at a FAssetRegisterMockServer answering from the same capture, see
+ * FAssetRegisterMockServer::SetCapture, to replay without network.
+ */
+class FAssetRegisterReplay
+{
+public:
+	/**
+	 * @param Speed How many times faster than recorded to send the requests, 0 to send them all at once.
+	 * @return A future resolving to a result per entry of Capture, in the same order, once every request completed.
+	 */
+	static TFuture<TArray<FAssetRegisterReplayResult>> Run(const FAssetRegisterCapture& Capture, float Speed = 1.f);
+};
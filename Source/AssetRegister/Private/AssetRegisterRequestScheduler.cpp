@@ -0,0 +1,125 @@
+// Copyright (c) 2025, Futureverse Corporation Limited. All rights reserved.
+
+#include "AssetRegisterRequestScheduler.h"
+
+#include "AssetRegisterSettings.h"
+
+FAssetRegisterRequestScheduler& FAssetRegisterRequestScheduler::Get()
+{
+	static FAssetRegisterRequestScheduler Scheduler;
+	return Scheduler;
+}
+
+void FAssetRegisterRequestScheduler::Schedule(const FString& Host, TFunction<void()>&& Start)
+{
+	TArray<TFunction<void()>> ToStart;
+	{
+		FScopeLock Lock(&CriticalSection);
+		Queue.Add({Host, MoveTemp(Start)});
+		PopStartable(ToStart);
+	}
+
+	for (TFunction<void()>& StartFunction : ToStart)
+	{
+		StartFunction();
+	}
+}
+
+void FAssetRegisterRequestScheduler::Finish(const FString& Host, bool bConnected)
+{
+	Release(Host, bConnected);
+}
+
+void FAssetRegisterRequestScheduler::Cancel(const FString& Host)
+{
+	Release(Host, TOptional<bool>());
+}
+
+void FAssetRegisterRequestScheduler::Release(const FString& Host, TOptional<bool> bConnected)
+{
+	TArray<TFunction<void()>> ToStart;
+	{
+		FScopeLock Lock(&CriticalSection);
+		--NumInFlight;
+		// whether it connected or not, everything queued behind the host's first request is released together,
+		// so an unreachable host fails a burst at once instead of one request at a time
+		const bool bOpenedGate = GatingHosts.Remove(Host) > 0;
+		if (int32* NumInFlightToHost = NumInFlightByHost.Find(Host); NumInFlightToHost && --(*NumInFlightToHost) <= 0)
+		{
+			NumInFlightByHost.Remove(Host);
+		}
+		
+		if (bConnected.IsSet() && bConnected.GetValue())
+		{
+			ConnectedHosts.Add(Host);
+		}
+		else if (bConnected.IsSet())
+		{
+			ConnectedHosts.Remove(Host);
+		}
+		
+		PopStartable(ToStart, bOpenedGate ? &Host : nullptr);
+	}
+
+	for (TFunction<void()>& StartFunction : ToStart)
+	{
+		StartFunction();
+	}
+}
+
+int32 FAssetRegisterRequestScheduler::GetNumInFlight() const
+{
+	FScopeLock Lock(&CriticalSection);
+	return NumInFlight;
+}
+
+int32 FAssetRegisterRequestScheduler::GetNumQueued() const
+{
+	FScopeLock Lock(&CriticalSection);
+	return Queue.Num();
+}
+
+bool FAssetRegisterRequestScheduler::CanStart(const FString& Host) const
+{
+	const UAssetRegisterSettings* Settings = GetDefault<UAssetRegisterSettings>();
+	
+	if (Settings->MaxConcurrentRequests > 0 && NumInFlight >= Settings->MaxConcurrentRequests)
+	{
+		return false;
+	}
+
+	if (Settings->bUseMultiplexedConnection && GatingHosts.Contains(Host))
+	{
+		return false;
+	}
+
+	return true;
+}
+
+void FAssetRegisterRequestScheduler::PopStartable(TArray<TFunction<void()>>& OutStart, const FString* OpenedHost)
+{
+	const bool bUseMultiplexedConnection = GetDefault<UAssetRegisterSettings>()->bUseMultiplexedConnection;
+	
+	for (int32 Index = 0; Index < Queue.Num();)
+	{
+		const FString& Host = Queue[Index].Host;
+		if (!CanStart(Host))
+		{
+			++Index;
+			continue;
+		}
+
+		// until a connection to the host exists, only let one request through so it's the one paying for DNS/TLS
+		// and everything queued behind it can reuse (or multiplex over) its connection
+		if (bUseMultiplexedConnection && !ConnectedHosts.Contains(Host) && !NumInFlightByHost.Contains(Host)
+			&& (!OpenedHost || *OpenedHost != Host))
+		{
+			GatingHosts.Add(Host);
+		}
+
+		++NumInFlight;
+		++NumInFlightByHost.FindOrAdd(Host);
+		OutStart.Add(MoveTemp(Queue[Index].Start));
+		Queue.RemoveAt(Index);
+	}
+}
@@ -0,0 +1,69 @@
+// Copyright (c) 2025, Futureverse Corporation Limited. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Decides when queued Asset Register requests are started.
+ *
+ * Limits the number of requests in flight to UAssetRegisterSettings::MaxConcurrentRequests, and when
+ * bUseMultiplexedConnection is enabled, holds requests to a host without a connection back until the first request
+ * to it completes, so the rest of a burst shares that connection instead of each paying for connection setup.
+ * The held requests are released together whether or not that request connected.
+ */
+class FAssetRegisterRequestScheduler
+{
+public:
+	static FAssetRegisterRequestScheduler& Get();
+
+	/**
+	 * Queues a request. Start is called (possibly immediately, on the calling thread) once the request may be sent.
+	 * Every scheduled request must be followed by a call to Finish once it completes.
+	 *
+	 * @param Host The host the request is sent to.
+	 * @param Start Sends the request.
+	 */
+	void Schedule(const FString& Host, TFunction<void()>&& Start);
+
+	/**
+	 * Marks a request to Host as completed and starts queued requests that are now allowed to run.
+	 *
+	 * @param bConnected Whether the request reached the server, i.e. there is now a live connection to Host and later
+	 * requests to it aren't held back.
+	 */
+	void Finish(const FString& Host, bool bConnected);
+
+	/** Marks a started request to Host as dropped without being sent, e.g. because its deadline passed while queued. */
+	void Cancel(const FString& Host);
+
+	int32 GetNumInFlight() const;
+	int32 GetNumQueued() const;
+
+private:
+	struct FQueuedRequest
+	{
+		FString Host;
+		TFunction<void()> Start;
+	};
+
+	void Release(const FString& Host, TOptional<bool> bConnected);
+	
+	bool CanStart(const FString& Host) const;
+	
+	/**
+	 * Moves the queued requests that may start now into OutStart.
+	 *
+	 * @param OpenedHost The host whose first request just completed, its queued requests start without a new one
+	 * holding them back.
+	 */
+	void PopStartable(TArray<TFunction<void()>>& OutStart, const FString* OpenedHost = nullptr);
+
+	mutable FCriticalSection CriticalSection;
+	TArray<FQueuedRequest> Queue;
+	TMap<FString, int32> NumInFlightByHost;
+	TSet<FString> ConnectedHosts;
+	/** Hosts without a connection whose first request is in flight, requests to them are held back until it completes. */
+	TSet<FString> GatingHosts;
+	int32 NumInFlight = 0;
+};
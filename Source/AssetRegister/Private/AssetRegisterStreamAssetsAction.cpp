@@ -0,0 +1,104 @@
+// Copyright (c) 2025, Futureverse Corporation Limited. All rights reserved.
+
+#include "AssetRegisterStreamAssetsAction.h"
+
+#include "AssetRegisterAssetStream.h"
+#include "AssetRegisterCompletionQueue.h"
+#include "AssetRegisterGCUtil.h"
+#include "AssetRegisterLog.h"
+
+UAssetRegisterStreamAssetsAction* UAssetRegisterStreamAssetsAction::StreamAssetPages(UObject* WorldContextObject,
+	const FAssetConnection& AssetsInput, int32 MaxItems, float TimeoutSeconds)
+{
+	UAssetRegisterStreamAssetsAction* Action = NewObject<UAssetRegisterStreamAssetsAction>();
+	Action->AssetsInput = AssetsInput;
+	Action->MaxItems = MaxItems;
+	Action->TimeoutSeconds = TimeoutSeconds;
+	Action->RegisterWithGameInstance(WorldContextObject);
+	return Action;
+}
+
+void UAssetRegisterStreamAssetsAction::Activate()
+{
+	const FAssetRegisterDeadline Deadline = TimeoutSeconds > 0.f ? FAssetRegisterDeadline::After(TimeoutSeconds) : FAssetRegisterDeadline();
+	Stream = FAssetRegisterAssetStream::Create(AssetsInput, MaxItems, Deadline);
+	bRunning = true;
+	RequestNextPage();
+}
+
+void UAssetRegisterStreamAssetsAction::Cancel()
+{
+	if (bRunning)
+	{
+		UE_LOG(LogAssetRegister, Verbose, TEXT("UAssetRegisterStreamAssetsAction::Cancel after %d pages"), NumPages);
+		Finish();
+	}
+}
+
+void UAssetRegisterStreamAssetsAction::RequestNextPage()
+{
+	Stream->Next().Next([WeakThis = TWeakObjectPtr<UAssetRegisterStreamAssetsAction>(this)](FLoadAssetsResult Result)
+	{
+		if (IsInGameThread())
+		{
+			if (UAssetRegisterStreamAssetsAction* Action = WeakThis.Get())
+			{
+				Action->OnPageLoaded(MoveTemp(Result));
+			}
+			return;
+		}
+
+		// nothing references the decoded objects while they wait for the game thread
+		AssetRegisterGCUtil::SetAsyncFlags(Result, true);
+		FAssetRegisterCompletionQueue::Get().Enqueue([WeakThis, Result = MoveTemp(Result)]() mutable
+		{
+			AssetRegisterGCUtil::SetAsyncFlags(Result, false);
+			if (UAssetRegisterStreamAssetsAction* Action = WeakThis.Get())
+			{
+				Action->OnPageLoaded(MoveTemp(Result));
+			}
+		});
+	});
+}
+
+void UAssetRegisterStreamAssetsAction::OnPageLoaded(FLoadAssetsResult&& Result)
+{
+	if (!bRunning)
+	{
+		return;
+	}
+
+	if (!Result.bSuccess)
+	{
+		UE_LOG(LogAssetRegister, Warning, TEXT("UAssetRegisterStreamAssetsAction::OnPageLoaded failed to load page %d"), NumPages + 1);
+		OnFailed.Broadcast(FAssets(), NumItems);
+		Finish();
+		return;
+	}
+
+	++NumPages;
+	NumItems += Result.Value.Edges.Num();
+	OnPage.Broadcast(Result.Value, NumItems);
+
+	// OnPage may have cancelled
+	if (!bRunning)
+	{
+		return;
+	}
+
+	if (Stream->HasNext())
+	{
+		RequestNextPage();
+		return;
+	}
+
+	OnCompleted.Broadcast(FAssets(), NumItems);
+	Finish();
+}
+
+void UAssetRegisterStreamAssetsAction::Finish()
+{
+	bRunning = false;
+	Stream.Reset();
+	SetReadyToDestroy();
+}
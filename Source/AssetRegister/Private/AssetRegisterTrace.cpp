@@ -0,0 +1,101 @@
+// Copyright (c) 2025, Futureverse Corporation Limited. All rights reserved.
+
+#include "AssetRegisterTrace.h"
+
+#include <atomic>
+
+UE_TRACE_CHANNEL_DEFINE(AssetRegisterChannel);
+
+UE_TRACE_EVENT_BEGIN(AssetRegister, RequestPhase)
+	UE_TRACE_EVENT_FIELD(uint64, RequestId)
+	UE_TRACE_EVENT_FIELD(uint64, StartCycle)
+	UE_TRACE_EVENT_FIELD(uint64, EndCycle)
+	UE_TRACE_EVENT_FIELD(uint64, NumBytes)
+	UE_TRACE_EVENT_FIELD(uint8, Phase)
+UE_TRACE_EVENT_END()
+
+DEFINE_STAT(STAT_AssetRegister_QueryBuild);
+DEFINE_STAT(STAT_AssetRegister_Serialize);
+DEFINE_STAT(STAT_AssetRegister_Parse);
+DEFINE_STAT(STAT_AssetRegister_Decode);
+DEFINE_STAT(STAT_AssetRegister_CreateObjects);
+DEFINE_STAT(STAT_AssetRegister_Dispatch);
+DEFINE_STAT(STAT_AssetRegister_QueueWait);
+DEFINE_STAT(STAT_AssetRegister_Network);
+DEFINE_STAT(STAT_AssetRegister_BytesReceived);
+DEFINE_STAT(STAT_AssetRegister_Requests);
+
+namespace AssetRegisterTrace
+{
+	std::atomic<uint64> LastRequestId = 0;
+	thread_local uint64 CurrentRequestId = 0;
+	/** The ID of the innermost FAssetRegisterRequestScope, until a request is sent with it. */
+	thread_local uint64 ScopedRequestId = 0;
+
+	uint64 NewRequestId()
+	{
+		return ++LastRequestId;
+	}
+
+	uint64 GetCurrentRequestId()
+	{
+		return CurrentRequestId;
+	}
+
+	uint64 TakeScopedRequestId()
+	{
+		const uint64 RequestId = ScopedRequestId != 0 ? ScopedRequestId : NewRequestId();
+		ScopedRequestId = 0;
+		return RequestId;
+	}
+
+	void TracePhase(uint64 RequestId, EAssetRegisterPhase Phase, uint64 StartCycles, uint64 NumBytes)
+	{
+		UE_TRACE_LOG(AssetRegister, RequestPhase, AssetRegisterChannel)
+			<< RequestPhase.RequestId(RequestId)
+			<< RequestPhase.StartCycle(StartCycles)
+			<< RequestPhase.EndCycle(FPlatformTime::Cycles64())
+			<< RequestPhase.NumBytes(NumBytes)
+			<< RequestPhase.Phase(static_cast<uint8>(Phase));
+	}
+}
+
+FAssetRegisterRequestScope::FAssetRegisterRequestScope()
+	: OuterRequestId(AssetRegisterTrace::CurrentRequestId)
+	, OuterScopedRequestId(AssetRegisterTrace::ScopedRequestId)
+{
+	const uint64 RequestId = AssetRegisterTrace::NewRequestId();
+	AssetRegisterTrace::CurrentRequestId = RequestId;
+	AssetRegisterTrace::ScopedRequestId = RequestId;
+}
+
+FAssetRegisterRequestScope::~FAssetRegisterRequestScope()
+{
+	AssetRegisterTrace::CurrentRequestId = OuterRequestId;
+	AssetRegisterTrace::ScopedRequestId = OuterScopedRequestId;
+}
+
+FAssetRegisterPhaseScope::FAssetRegisterPhaseScope(uint64 InRequestId, EAssetRegisterPhase InPhase)
+	: Phase(InPhase)
+{
+	if (!AssetRegisterTrace::IsEnabled())
+	{
+		return;
+	}
+
+	OuterRequestId = AssetRegisterTrace::CurrentRequestId;
+	RequestId = InRequestId != 0 ? InRequestId : OuterRequestId;
+	AssetRegisterTrace::CurrentRequestId = RequestId;
+	StartCycles = FPlatformTime::Cycles64();
+}
+
+FAssetRegisterPhaseScope::~FAssetRegisterPhaseScope()
+{
+	if (StartCycles == 0)
+	{
+		return;
+	}
+
+	AssetRegisterTrace::CurrentRequestId = OuterRequestId;
+	AssetRegisterTrace::TracePhase(RequestId, Phase, StartCycles);
+}
@@ -0,0 +1,277 @@
+// Copyright (c) 2025, Futureverse Corporation Limited. All rights reserved.
+
+#include "AssetRegisterTransport.h"
+
+#include "AssetRegisterCapture.h"
+#include "AssetRegisterLog.h"
+#include "AssetRegisterMetrics.h"
+#include "AssetRegisterRequestScheduler.h"
+#include "AssetRegisterSettings.h"
+#include "AssetRegisterTrace.h"
+#include "HttpModule.h"
+#include "QueryStringUtil.h"
+#include "GenericPlatform/GenericPlatformHttp.h"
+#include "Interfaces/IHttpResponse.h"
+
+namespace AssetRegisterTransport
+{
+	/** The shortest timeout a request is sent with, since a timeout of 0 means none to the HTTP module. */
+	constexpr float MinRequestTimeout = 0.01f;
+
+	/**
+	 * Collapses the indentation and newlines of a serialized query into single spaces (outside of string literals),
+	 * since every whitespace character costs three characters once URL encoded.
+	 */
+	FString CompactQuery(const FString& Query)
+	{
+		FString OutQuery;
+		OutQuery.Reserve(Query.Len());
+
+		bool bInString = false;
+		bool bEscaped = false;
+		bool bPendingSpace = false;
+
+		for (const TCHAR Char : Query)
+		{
+			if (bInString)
+			{
+				OutQuery.AppendChar(Char);
+				bInString = bEscaped || Char != '"';
+				bEscaped = !bEscaped && Char == '\\';
+				continue;
+			}
+
+			if (FChar::IsWhitespace(Char))
+			{
+				bPendingSpace = !OutQuery.IsEmpty();
+				continue;
+			}
+
+			if (bPendingSpace)
+			{
+				OutQuery.AppendChar(' ');
+				bPendingSpace = false;
+			}
+
+			OutQuery.AppendChar(Char);
+			bInString = Char == '"';
+		}
+
+		return OutQuery;
+	}
+
+	bool IsReadOnlyQuery(const FString& Query)
+	{
+		const FString TrimmedQuery = Query.TrimStart();
+		return TrimmedQuery.StartsWith(TEXT("{")) || TrimmedQuery.StartsWith(TEXT("query"));
+	}
+}
+
+bool FAssetRegisterTransport::TryMakeGetURL(TConstArrayView<uint8> Content, FString& OutURL)
+{
+	const UAssetRegisterSettings* Settings = GetDefault<UAssetRegisterSettings>();
+	if (!Settings || !Settings->bUseGetForReadQueries)
+	{
+		return false;
+	}
+
+	const TSharedPtr<FJsonObject> Body = QueryStringUtil::ParseJsonUtf8(Content);
+	FString Query;
+	if (!Body.IsValid() || !Body->TryGetStringField(TEXT("query"), Query) || !AssetRegisterTransport::IsReadOnlyQuery(Query))
+	{
+		return false;
+	}
+
+	FString URL = Settings->AssetRegisterURL;
+	URL += URL.Contains(TEXT("?")) ? TEXT("&query=") : TEXT("?query=");
+	URL += FGenericPlatformHttp::UrlEncode(AssetRegisterTransport::CompactQuery(Query));
+
+	const TSharedPtr<FJsonObject>* Variables = nullptr;
+	if (Body->TryGetObjectField(TEXT("variables"), Variables) && Variables && (*Variables)->Values.Num() > 0)
+	{
+		FString VariablesJson;
+		TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&VariablesJson);
+		FJsonSerializer::Serialize(Variables->ToSharedRef(), Writer);
+
+		URL += TEXT("&variables=") + FGenericPlatformHttp::UrlEncode(VariablesJson);
+	}
+
+	if (URL.Len() > Settings->MaxGetURLLength)
+	{
+		UE_LOG(LogAssetRegister, Verbose, TEXT("FAssetRegisterTransport::TryMakeGetURL URL length %d exceeds MaxGetURLLength %d, using POST"), URL.Len(), Settings->MaxGetURLLength);
+		return false;
+	}
+
+	OutURL = MoveTemp(URL);
+	return true;
+}
+
+TFuture<FHttpResponsePtr> FAssetRegisterTransport::ProcessRequest(FAssetRegisterRequest&& InRequest)
+{
+	TSharedPtr<TPromise<FHttpResponsePtr>> Promise = MakeShared<TPromise<FHttpResponsePtr>>();
+	TFuture<FHttpResponsePtr> Future = Promise->GetFuture();
+
+	const UAssetRegisterSettings* Settings = GetDefault<UAssetRegisterSettings>();
+	check(Settings);
+
+	if (!Settings)
+	{
+		UE_LOG(LogAssetRegister, Warning, TEXT("UAssetRegisterQueryingLibrary::%s UAssetRegisterSettings was null"), InRequest.Context);
+		Promise->SetValue(FHttpResponsePtr());
+		return Future;
+	}
+
+	const TCHAR* Context = InRequest.Context;
+	const uint64 RequestId = InRequest.Id != 0 ? InRequest.Id : AssetRegisterTrace::TakeScopedRequestId();
+	const FAssetRegisterDeadline Deadline = InRequest.Deadline;
+	if (Deadline.HasExpired())
+	{
+		UE_LOG(LogAssetRegister, Verbose, TEXT("UAssetRegisterQueryingLibrary::%s [%llu] deadline expired, request dropped"), Context, RequestId);
+		FAssetRegisterMetrics::Get().RecordError(Context, EAssetRegisterErrorClass::Timeout);
+		Promise->SetValue(FHttpResponsePtr());
+		return Future;
+	}
+	
+	// copied before the body is moved into the request
+	const TSharedPtr<FAssetRegisterCaptureEntry> CaptureEntry = FAssetRegisterRecorder::Get().BeginEntry(Context, InRequest.Content);
+
+	const TSharedRef<IHttpRequest> Request = FHttpModule::Get().CreateRequest();
+
+	if (!InRequest.GetURL.IsEmpty())
+	{
+		Request->SetURL(InRequest.GetURL);
+		Request->SetVerb(TEXT("GET"));
+
+		if (!InRequest.ETag.IsEmpty())
+		{
+			Request->SetHeader(TEXT("If-None-Match"), InRequest.ETag);
+		}
+		if (!InRequest.LastModified.IsEmpty())
+		{
+			Request->SetHeader(TEXT("If-Modified-Since"), InRequest.LastModified);
+		}
+
+		UE_LOG(LogAssetRegister, Verbose, TEXT("UAssetRegisterQueryingLibrary::%s [%llu] Sending GET Request. URL: %s"), Context, RequestId, *InRequest.GetURL);
+	}
+	else
+	{
+		Request->SetURL(Settings->AssetRegisterURL);
+		Request->SetVerb(TEXT("POST"));
+		Request->SetHeader("content-type", "application/json");
+
+		UE_LOG(LogAssetRegister, Verbose, TEXT("UAssetRegisterQueryingLibrary::%s [%llu] Sending Request. URL: %s Content: %s"), Context, RequestId, *Settings->AssetRegisterURL, *QueryStringUtil::Utf8ToString(InRequest.Content));
+		Request->SetContent(MoveTemp(InRequest.Content));
+	}
+
+	const FString Host = FGenericPlatformHttp::GetUrlDomain(Request->GetURL());
+
+	INC_DWORD_STAT(STAT_AssetRegister_Requests);
+	FAssetRegisterMetrics::Get().RecordRequest(Context, InRequest.GetURL.IsEmpty() ? Request->GetContent().Num() : InRequest.GetURL.Len());
+	const double StartTime = FPlatformTime::Seconds();
+
+	// set when the scheduler sends the request, so the network phase excludes the queue wait
+	const TSharedRef<uint64> SendCycles = MakeShared<uint64>(0);
+	auto RequestCallback = [Promise, Context, Host, Deadline, RequestId, SendCycles, StartTime, CaptureEntry]
+	(FHttpRequestPtr Request, const FHttpResponsePtr& Response, bool bWasSuccessful) mutable
+	{
+		FAssetRegisterRequestScheduler::Get().Finish(Host, bWasSuccessful && Response.IsValid());
+
+		const uint64 NumBytes = Response.IsValid() ? Response->GetContent().Num() : 0;
+		INC_FLOAT_STAT_BY(STAT_AssetRegister_Network, FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - *SendCycles));
+		INC_DWORD_STAT_BY(STAT_AssetRegister_BytesReceived, NumBytes);
+		if (AssetRegisterTrace::IsEnabled())
+		{
+			AssetRegisterTrace::TracePhase(RequestId, EAssetRegisterPhase::Network, *SendCycles, NumBytes);
+		}
+
+		const int32 ResponseCode = Response.IsValid() ? Response->GetResponseCode() : 0;
+		FAssetRegisterMetrics::Get().RecordResponse(Context, FPlatformTime::Seconds() - StartTime, NumBytes, ResponseCode,
+			FAssetRegisterMetrics::ClassifyResponse(bWasSuccessful, ResponseCode, Deadline.HasExpired()));
+
+		if (CaptureEntry.IsValid())
+		{
+			CaptureEntry->Duration = FPlatformTime::ToSeconds64(FPlatformTime::Cycles64() - *SendCycles);
+			CaptureEntry->ResponseCode = ResponseCode;
+			if (Response.IsValid())
+			{
+				CaptureEntry->ETag = Response->GetHeader(TEXT("ETag"));
+				CaptureEntry->LastModified = Response->GetHeader(TEXT("Last-Modified"));
+				CaptureEntry->ResponseContent = Response->GetContent();
+			}
+			FAssetRegisterRecorder::Get().Record(MoveTemp(*CaptureEntry));
+		}
+
+		if (!bWasSuccessful || !Response.IsValid())
+		{
+			Promise->SetValue(FHttpResponsePtr());
+			return;
+		}
+
+		if (Response->GetResponseCode() == EHttpResponseCodes::NotModified)
+		{
+			UE_LOG(LogAssetRegister, Verbose, TEXT("UAssetRegisterQueryingLibrary::%s [%llu] Response: 304 Not Modified"), Context, RequestId);
+			Promise->SetValue(Response);
+			return;
+		}
+
+		if (Response->GetContent().IsEmpty())
+		{
+			Promise->SetValue(FHttpResponsePtr());
+			return;
+		}
+
+		UE_LOG(LogAssetRegister, Verbose, TEXT("UAssetRegisterQueryingLibrary::%s [%llu] Response: %s"), Context, RequestId, *QueryStringUtil::Utf8ToString(Response->GetContent()));
+		Promise->SetValue(Response);
+	};
+
+	Request->OnProcessRequestComplete().BindLambda(RequestCallback);
+	const uint64 QueueCycles = FPlatformTime::Cycles64();
+	FAssetRegisterRequestScheduler::Get().Schedule(Host, [Request, Promise, Context, Host, Deadline, RequestId, SendCycles, QueueCycles, CaptureEntry]()
+	{
+		*SendCycles = FPlatformTime::Cycles64();
+		INC_FLOAT_STAT_BY(STAT_AssetRegister_QueueWait, FPlatformTime::ToMilliseconds64(*SendCycles - QueueCycles));
+		if (AssetRegisterTrace::IsEnabled())
+		{
+			AssetRegisterTrace::TracePhase(RequestId, EAssetRegisterPhase::QueueWait, QueueCycles);
+		}
+
+		// the request may have waited in the queue, so the timeout is only known now. It's read once, as the deadline
+		// could expire between checking it and reading the timeout
+		const float Timeout = Deadline.GetRequestTimeout(60.f);
+		if (Timeout <= 0.f)
+		{
+			UE_LOG(LogAssetRegister, Verbose, TEXT("UAssetRegisterQueryingLibrary::%s [%llu] deadline expired while queued, request dropped"), Context, RequestId);
+			Request->OnProcessRequestComplete().Unbind();
+			FAssetRegisterRequestScheduler::Get().Cancel(Host);
+			FAssetRegisterMetrics::Get().RecordError(Context, EAssetRegisterErrorClass::Timeout);
+			// recorded as a request that failed without a response, so a replay sends the same requests
+			if (CaptureEntry.IsValid())
+			{
+				CaptureEntry->Duration = 0.0;
+				CaptureEntry->ResponseCode = 0;
+				FAssetRegisterRecorder::Get().Record(MoveTemp(*CaptureEntry));
+			}
+			Promise->SetValue(FHttpResponsePtr());
+			return;
+		}
+		
+		Request->SetTimeout(FMath::Max(Timeout, AssetRegisterTransport::MinRequestTimeout));
+		Request->ProcessRequest();
+	});
+
+	return Future;
+}
+
+TFuture<bool> FAssetRegisterTransport::Preconnect()
+{
+	const FAssetRegisterRequestScope RequestScope;
+	FAssetRegisterRequest Request;
+	Request.Context = TEXT("Preconnect");
+	Request.Content = QueryStringUtil::MakeQueryJsonUtf8(UTF8TEXTVIEW("{__typename}"));
+	
+	return ProcessRequest(MoveTemp(Request)).Next([](const FHttpResponsePtr& Response)
+	{
+		UE_LOG(LogAssetRegister, Log, TEXT("FAssetRegisterTransport::Preconnect %s"), Response.IsValid() ? TEXT("connected") : TEXT("failed to reach endpoint"));
+		return Response.IsValid();
+	});
+}
@@ -0,0 +1,72 @@
+// Copyright (c) 2025, Futureverse Corporation Limited. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AssetRegisterDeadline.h"
+#include "HttpFwd.h"
+
+/**
+ * A single request to the Asset Register GraphQL endpoint.
+ */
+struct FAssetRegisterRequest
+{
+	/** The UTF-8 encoded {"query": ...} json body. */
+	TArray<uint8> Content;
+
+	/** Name of the calling function, used for logging. */
+	const TCHAR* Context = TEXT("");
+
+	/**
+	 * Correlation ID of the request in logs and the AssetRegister trace channel, see AssetRegisterTrace::NewRequestId.
+	 * Assigned by ProcessRequest if 0.
+	 */
+	uint64 Id = 0;
+
+	/**
+	 * URL to send the request to as a GET instead of POSTing Content to the configured endpoint.
+	 * See FAssetRegisterTransport::TryMakeGetURL.
+	 */
+	FString GetURL;
+
+	/** ETag of a previous response for GetURL, sent as If-None-Match. */
+	FString ETag;
+
+	/** Last-Modified of a previous response for GetURL, sent as If-Modified-Since. */
+	FString LastModified;
+
+	/** The request times out at the deadline, and isn't sent at all if the deadline passed while it was queued. */
+	FAssetRegisterDeadline Deadline;
+};
+
+/**
+ * Sends requests to the Asset Register endpoint configured in UAssetRegisterSettings.
+ */
+class FAssetRegisterTransport
+{
+public:
+	/**
+	 * Builds the GET URL for a query json body, if GET requests are enabled in UAssetRegisterSettings.
+	 *
+	 * @param Content The UTF-8 encoded {"query": ..., "variables": ...} json body.
+	 * @param OutURL The endpoint URL with the query and variables encoded as URL parameters.
+	 * @return False if GET is disabled, the body isn't a read-only query, or the URL would exceed MaxGetURLLength.
+	 */
+	static bool TryMakeGetURL(TConstArrayView<uint8> Content, FString& OutURL);
+
+	/**
+	 * Sends the request.
+	 *
+	 * @return A future resolving to the response, or null if the request failed, ran past its deadline or returned no content.
+	 * A 304 Not Modified response is returned as-is even though it has no content.
+	 */
+	static TFuture<FHttpResponsePtr> ProcessRequest(FAssetRegisterRequest&& Request);
+
+	/**
+	 * Sends a minimal query to the configured endpoint so DNS resolution and the TLS handshake are done,
+	 * and a kept-alive connection exists, before the first real query.
+	 *
+	 * @return A future resolving to whether the endpoint could be reached.
+	 */
+	static TFuture<bool> Preconnect();
+};
@@ -0,0 +1,105 @@
+#include "AssetRegisterAssetStream.h"
+#include "AssetRegisterMockServer.h"
+#include "AssetRegisterQueryingLibrary.h"
+#include "AssetRegisterSettings.h"
+#include "QueryTestUtil.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(AssetStreamTest,
+								"UBFEmergenceDemo.sdk_unreal_asset_register.Source.AssetRegister.Private.AssetStreamTest",
+								EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+/**
+ * A stream over an endless inventory should only request a page when asked for one, follow the end cursor,
+ * and end once MaxItems assets were returned, trimming the last page.
+ */
+bool AssetStreamTest::RunTest(const FString& Parameters)
+{
+	// every page has three assets and claims there are more
+	const auto ResponseJson = TEXT(R"({
+	  "data": {
+	    "assets": {
+	      "edges": [
+	        { "cursor": "cursor-0", "node": { "tokenId": "0", "collectionId": "7668:root:1124" } },
+	        { "cursor": "cursor-1", "node": { "tokenId": "1", "collectionId": "7668:root:1124" } },
+	        { "cursor": "cursor-2", "node": { "tokenId": "2", "collectionId": "7668:root:1124" } }
+	      ],
+	      "pageInfo": { "endCursor": "cursor-2", "hasNextPage": true },
+	      "total": 1000
+	    }
+	  }
+	})");
+
+	TSharedRef<FAssetRegisterMockServer> Server = MakeShared<FAssetRegisterMockServer>();
+	if (!Server->Start())
+	{
+		AddError(TEXT("Failed to start mock server"));
+		return false;
+	}
+	Server->SetResponse(ResponseJson);
+
+	UAssetRegisterSettings* Settings = GetMutableDefault<UAssetRegisterSettings>();
+	const FString OriginalURL = Settings->AssetRegisterURL;
+	const bool bOriginalEnableDiskCache = Settings->bEnableDiskCache;
+	Settings->AssetRegisterURL = Server->GetURL();
+	// every page has to come from the server
+	Settings->bEnableDiskCache = false;
+
+	FAssetConnection AssetsInput;
+	AssetsInput.CollectionIds = {TEXT("7668:root:1124")};
+	AssetsInput.First = 3;
+	// without prefetching, so every page waits to be asked for
+	const TSharedRef<FAssetRegisterAssetStream> Stream = FAssetRegisterAssetStream::Create(AssetsInput, 7, FAssetRegisterDeadline(), 0);
+	TestEqual(TEXT("Opening a stream should not request anything"), Server->GetNumRequests(), 0);
+
+	TSharedRef<TArray<FLoadAssetsResult>> Pages = MakeShared<TArray<FLoadAssetsResult>>();
+	auto RequestPage = [this, Stream, Pages]()
+	{
+		Stream->Next().Next([Pages](const FLoadAssetsResult& Result)
+		{
+			Pages->Add(Result);
+		});
+		TestTrue(TEXT("A page should be pending until its request completes"), Stream->IsPending());
+		TestFalse(TEXT("A second page should not be requested while one is pending"), Stream->Next().Get().bSuccess);
+	};
+
+	RequestPage();
+	QueryTestUtil::WaitUntil(this, [Pages]() { return Pages->Num() == 1; });
+
+	// nothing is fetched ahead of the consumer
+	QueryTestUtil::Then([this, Server, RequestPage]()
+	{
+		TestEqual(TEXT("The next page should only be requested when asked for"), Server->GetNumRequests(), 1);
+		RequestPage();
+	});
+	QueryTestUtil::WaitUntil(this, [Pages]() { return Pages->Num() == 2; });
+	QueryTestUtil::Then(RequestPage);
+	QueryTestUtil::WaitUntil(this, [Pages]() { return Pages->Num() == 3; });
+
+	QueryTestUtil::Then([this, Server, Settings, Stream, Pages, OriginalURL, bOriginalEnableDiskCache]()
+	{
+		for (const FLoadAssetsResult& Page : *Pages)
+		{
+			TestTrue(TEXT("Every page should load"), Page.bSuccess);
+		}
+		if (TestEqual(TEXT("Every requested page should complete"), Pages->Num(), 3))
+		{
+			TestEqual(TEXT("Full pages should be returned whole"), (*Pages)[1].Value.Edges.Num(), 3);
+			TestEqual(TEXT("The last page should be trimmed to MaxItems"), (*Pages)[2].Value.Edges.Num(), 1);
+		}
+		TestEqual(TEXT("The stream should count the assets it returned"), Stream->GetNumItems(), 7);
+		TestFalse(TEXT("The stream should end at MaxItems"), Stream->HasNext());
+		TestFalse(TEXT("An ended stream should not request another page"), Stream->Next().Get().bSuccess);
+		TestEqual(TEXT("Each page should be requested once"), Server->GetNumRequests(), 3);
+
+		Server->Stop();
+		Settings->AssetRegisterURL = OriginalURL;
+		Settings->bEnableDiskCache = bOriginalEnableDiskCache;
+	});
+
+	return true;
+}
+
+#endif
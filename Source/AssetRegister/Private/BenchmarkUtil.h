@@ -0,0 +1,230 @@
+#pragma once
+
+#include "AssetRegisterLog.h"
+#include "Misc/CommandLine.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Parse.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonWriter.h"
+#include <atomic>
+
+/**
+ * Measurement helpers for the *BenchmarkTest automation tests, which run headless, e.g.
+ *
+ *	UnrealEditor-Cmd <Project> -ExecCmds="Automation RunTests DecodeBenchmarkTest; Quit" -unattended -nullrhi -nosplash
+ *
+ * Results are logged and written as json to Saved/AssetRegister/Benchmarks/<Suite>.json, or to the directory passed
+ * as -AssetRegisterBenchmarkDir=, so they can be collected per commit.
+ */
+namespace BenchmarkUtil
+{
+	/**
+	 * Forwards to the allocator it wraps and counts the allocations made on the threads that enabled counting.
+	 * Installed as GMalloc for the duration of a measurement.
+	 */
+	class FCountingMalloc final : public FMalloc
+	{
+	public:
+		explicit FCountingMalloc(FMalloc* InInner)
+			: Inner(InInner)
+		{
+		}
+
+		static bool& IsCountingThread()
+		{
+			static thread_local bool bCounting = false;
+			return bCounting;
+		}
+
+		void ResetCounters()
+		{
+			NumAllocations = 0;
+			BytesAllocated = 0;
+			LiveBytes = 0;
+			PeakLiveBytes = 0;
+		}
+
+		virtual void* Malloc(SIZE_T Count, uint32 Alignment) override
+		{
+			void* Ptr = Inner->Malloc(Count, Alignment);
+			OnAllocated(Ptr, Count);
+			return Ptr;
+		}
+
+		virtual void* TryMalloc(SIZE_T Count, uint32 Alignment) override
+		{
+			void* Ptr = Inner->TryMalloc(Count, Alignment);
+			OnAllocated(Ptr, Count);
+			return Ptr;
+		}
+
+		virtual void* Realloc(void* Original, SIZE_T Count, uint32 Alignment) override
+		{
+			OnFreed(Original);
+			void* Ptr = Inner->Realloc(Original, Count, Alignment);
+			OnAllocated(Ptr, Count);
+			return Ptr;
+		}
+
+		virtual void* TryRealloc(void* Original, SIZE_T Count, uint32 Alignment) override
+		{
+			OnFreed(Original);
+			void* Ptr = Inner->TryRealloc(Original, Count, Alignment);
+			OnAllocated(Ptr, Count);
+			return Ptr;
+		}
+
+		virtual void Free(void* Original) override
+		{
+			OnFreed(Original);
+			Inner->Free(Original);
+		}
+
+		virtual SIZE_T QuantizeSize(SIZE_T Count, uint32 Alignment) override { return Inner->QuantizeSize(Count, Alignment); }
+		virtual bool GetAllocationSize(void* Original, SIZE_T& SizeOut) override { return Inner->GetAllocationSize(Original, SizeOut); }
+		virtual void Trim(bool bTrimThreadCaches) override { Inner->Trim(bTrimThreadCaches); }
+		virtual void SetupTLSCachesOnCurrentThread() override { Inner->SetupTLSCachesOnCurrentThread(); }
+		virtual void ClearAndDisableTLSCachesOnCurrentThread() override { Inner->ClearAndDisableTLSCachesOnCurrentThread(); }
+		virtual void InitializeStatsMetadata() override { Inner->InitializeStatsMetadata(); }
+		virtual void UpdateStats() override { Inner->UpdateStats(); }
+		virtual void GetAllocatorStats(FGenericMemoryStats& OutStats) override { Inner->GetAllocatorStats(OutStats); }
+		virtual void DumpAllocatorStats(FOutputDevice& Ar) override { Inner->DumpAllocatorStats(Ar); }
+		virtual bool IsInternallyThreadSafe() const override { return Inner->IsInternallyThreadSafe(); }
+		virtual bool ValidateHeap() override { return Inner->ValidateHeap(); }
+		virtual const TCHAR* GetDescriptiveName() override { return Inner->GetDescriptiveName(); }
+
+		FMalloc* Inner;
+		std::atomic<uint64> NumAllocations = 0;
+		std::atomic<uint64> BytesAllocated = 0;
+		std::atomic<int64> LiveBytes = 0;
+		std::atomic<int64> PeakLiveBytes = 0;
+
+	private:
+		void OnAllocated(void* Ptr, SIZE_T Count)
+		{
+			if (!Ptr || !IsCountingThread())
+			{
+				return;
+			}
+
+			SIZE_T Size = Count;
+			Inner->GetAllocationSize(Ptr, Size);
+			++NumAllocations;
+			BytesAllocated += Size;
+			const int64 Live = LiveBytes += Size;
+			int64 Peak = PeakLiveBytes;
+			while (Live > Peak && !PeakLiveBytes.compare_exchange_weak(Peak, Live))
+			{
+			}
+		}
+
+		void OnFreed(void* Ptr)
+		{
+			SIZE_T Size = 0;
+			if (Ptr && IsCountingThread() && Inner->GetAllocationSize(Ptr, Size))
+			{
+				LiveBytes -= Size;
+			}
+		}
+	};
+
+	struct FResult
+	{
+		FString Name;
+		int32 NumOps = 0;
+		double Seconds = 0.0;
+		/** Allocations per op, made on the benchmarking thread. */
+		double AllocationsPerOp = 0.0;
+		double BytesAllocatedPerOp = 0.0;
+		/** Most bytes held at once by allocations made during the measurement, over the memory in use before it. */
+		int64 PeakBytes = 0;
+
+		double GetOpsPerSecond() const
+		{
+			return Seconds > 0.0 ? NumOps / Seconds : 0.0;
+		}
+	};
+
+	/**
+	 * Runs Op once to warm up, then NumOps times while timing it and counting its allocations.
+	 * Op only runs on the calling thread, work it hands to other threads isn't counted.
+	 */
+	inline FResult Measure(const FString& Name, int32 NumOps, TFunctionRef<void()> Op)
+	{
+		Op();
+
+		// never deleted, other threads may still be calling it after GMalloc is restored
+		static FCountingMalloc* CountingMalloc = new FCountingMalloc(GMalloc);
+		CountingMalloc->ResetCounters();
+
+		FMalloc* const OriginalMalloc = GMalloc;
+		GMalloc = CountingMalloc;
+		FCountingMalloc::IsCountingThread() = true;
+
+		const double StartTime = FPlatformTime::Seconds();
+		for (int32 Index = 0; Index < NumOps; ++Index)
+		{
+			Op();
+		}
+		const double Seconds = FPlatformTime::Seconds() - StartTime;
+
+		FCountingMalloc::IsCountingThread() = false;
+		GMalloc = OriginalMalloc;
+
+		FResult Result;
+		Result.Name = Name;
+		Result.NumOps = NumOps;
+		Result.Seconds = Seconds;
+		Result.AllocationsPerOp = static_cast<double>(CountingMalloc->NumAllocations) / NumOps;
+		Result.BytesAllocatedPerOp = static_cast<double>(CountingMalloc->BytesAllocated) / NumOps;
+		Result.PeakBytes = CountingMalloc->PeakLiveBytes;
+		return Result;
+	}
+
+	/** Logs Results and writes them to <Suite>.json in the benchmark output directory. */
+	inline void Report(const FString& Suite, const TArray<FResult>& Results)
+	{
+		FString OutputDir;
+		if (!FParse::Value(FCommandLine::Get(), TEXT("AssetRegisterBenchmarkDir="), OutputDir))
+		{
+			OutputDir = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("AssetRegister"), TEXT("Benchmarks"));
+		}
+
+		FString Json;
+		const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Json);
+		Writer->WriteObjectStart();
+		Writer->WriteValue(TEXT("suite"), Suite);
+		Writer->WriteValue(TEXT("timestamp"), FDateTime::UtcNow().ToIso8601());
+		Writer->WriteValue(TEXT("platform"), FString(FPlatformProperties::IniPlatformName()));
+		Writer->WriteArrayStart(TEXT("results"));
+		for (const FResult& Result : Results)
+		{
+			UE_LOG(LogAssetRegister, Display, TEXT("[%s] %s: %.1f ops/s, %.1f allocations/op, %.0f bytes allocated/op, peak %lld bytes"),
+				*Suite, *Result.Name, Result.GetOpsPerSecond(), Result.AllocationsPerOp, Result.BytesAllocatedPerOp, Result.PeakBytes);
+
+			Writer->WriteObjectStart();
+			Writer->WriteValue(TEXT("name"), Result.Name);
+			Writer->WriteValue(TEXT("ops"), Result.NumOps);
+			Writer->WriteValue(TEXT("seconds"), Result.Seconds);
+			Writer->WriteValue(TEXT("opsPerSecond"), Result.GetOpsPerSecond());
+			Writer->WriteValue(TEXT("allocationsPerOp"), Result.AllocationsPerOp);
+			Writer->WriteValue(TEXT("bytesAllocatedPerOp"), Result.BytesAllocatedPerOp);
+			Writer->WriteValue(TEXT("peakBytes"), Result.PeakBytes);
+			Writer->WriteObjectEnd();
+		}
+		Writer->WriteArrayEnd();
+		Writer->WriteObjectEnd();
+		Writer->Close();
+
+		const FString OutputPath = FPaths::Combine(OutputDir, Suite + TEXT(".json"));
+		if (FFileHelper::SaveStringToFile(Json, *OutputPath))
+		{
+			UE_LOG(LogAssetRegister, Display, TEXT("[%s] results written to %s"), *Suite, *FPaths::ConvertRelativePathToFull(OutputPath));
+		}
+		else
+		{
+			UE_LOG(LogAssetRegister, Warning, TEXT("[%s] failed to write results to %s"), *Suite, *OutputPath);
+		}
+	}
+}
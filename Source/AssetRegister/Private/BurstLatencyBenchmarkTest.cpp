@@ -0,0 +1,115 @@
+#include "AssetRegisterLog.h"
+#include "AssetRegisterMockServer.h"
+#include "AssetRegisterQueryingLibrary.h"
+#include "AssetRegisterSettings.h"
+#include "AssetRegisterTransport.h"
+#include "QueryTestUtil.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(BurstLatencyBenchmarkTest,
+								"UBFEmergenceDemo.sdk_unreal_asset_register.Source.AssetRegister.Private.BurstLatencyBenchmarkTest",
+								EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+namespace BurstLatencyBenchmark
+{
+	constexpr int32 NumRequests = 100;
+	
+	struct FBurst
+	{
+		double StartTime = 0.0;
+		TArray<double> Latencies;
+		int32 NumSucceeded = 0;
+	};
+
+	void SendBurst(const TSharedRef<FBurst>& Burst)
+	{
+		Burst->StartTime = FPlatformTime::Seconds();
+		for (int32 Index = 0; Index < NumRequests; ++Index)
+		{
+			UAssetRegisterQueryingLibrary::GetAssetProfile(FString::FromInt(Index), TEXT("7668:root:1124")).Next([Burst](const FLoadJsonResult& Result)
+			{
+				Burst->Latencies.Add(FPlatformTime::Seconds() - Burst->StartTime);
+				Burst->NumSucceeded += Result.bSuccess ? 1 : 0;
+			});
+		}
+	}
+
+	void LogBurst(const TCHAR* Name, const TSharedRef<FBurst>& Burst)
+	{
+		TArray<double> Latencies = Burst->Latencies;
+		Latencies.Sort();
+		auto Percentile = [&Latencies](double P)
+		{
+			return Latencies.IsEmpty() ? 0.0 : Latencies[FMath::Min(Latencies.Num() - 1, FMath::FloorToInt(P * Latencies.Num()))] * 1000.0;
+		};
+		
+		UE_LOG(LogAssetRegister, Display, TEXT("[BurstLatencyBenchmark] %s: %d/%d succeeded, p50 %.2fms p95 %.2fms max %.2fms"),
+			Name, Burst->NumSucceeded, NumRequests, Percentile(0.5), Percentile(0.95), Percentile(1.0));
+	}
+}
+
+/**
+ * Burst latency of concurrent GetAssetProfile calls, with and without the multiplexed connection mode.
+ * Note the local stand-in speaks HTTP/1.1 (the HTTPServer module has no h2c support), so this measures the
+ * scheduling and connection reuse side of the mode rather than HTTP/2 framing.
+ */
+bool BurstLatencyBenchmarkTest::RunTest(const FString& Parameters)
+{
+	using namespace BurstLatencyBenchmark;
+	
+	TSharedRef<FAssetRegisterMockServer> Server = MakeShared<FAssetRegisterMockServer>();
+	if (!Server->Start())
+	{
+		AddError(TEXT("Failed to start mock server"));
+		return false;
+	}
+	Server->SetResponse(TEXT(R"({"data":{"asset":{"profiles":{"asset-profile":"https://example.com/profile.json"}}}})"));
+
+	UAssetRegisterSettings* Settings = GetMutableDefault<UAssetRegisterSettings>();
+	const FString OriginalURL = Settings->AssetRegisterURL;
+	const bool bOriginalUseMultiplexedConnection = Settings->bUseMultiplexedConnection;
+	const bool bOriginalEnableAssetCache = Settings->bEnableAssetCache;
+	Settings->AssetRegisterURL = Server->GetURL();
+	Settings->bUseMultiplexedConnection = false;
+	// both bursts ask for the same assets, every request has to reach the server
+	Settings->bEnableAssetCache = false;
+
+	TSharedRef<FBurst> DefaultBurst = MakeShared<FBurst>();
+	SendBurst(DefaultBurst);
+	QueryTestUtil::WaitUntil(this, [DefaultBurst]() { return DefaultBurst->Latencies.Num() == NumRequests; }, 30.0);
+
+	TSharedRef<bool> bPreconnected = MakeShared<bool>(false);
+	QueryTestUtil::Then([Settings, bPreconnected]()
+	{
+		Settings->bUseMultiplexedConnection = true;
+		FAssetRegisterTransport::Preconnect().Next([bPreconnected](bool bConnected)
+		{
+			*bPreconnected = true;
+		});
+	});
+	QueryTestUtil::WaitUntil(this, [bPreconnected]() { return *bPreconnected; });
+
+	TSharedRef<FBurst> MultiplexedBurst = MakeShared<FBurst>();
+	QueryTestUtil::Then([MultiplexedBurst]() { SendBurst(MultiplexedBurst); });
+	QueryTestUtil::WaitUntil(this, [MultiplexedBurst]() { return MultiplexedBurst->Latencies.Num() == NumRequests; }, 30.0);
+
+	QueryTestUtil::Then([this, Server, Settings, OriginalURL, bOriginalUseMultiplexedConnection, bOriginalEnableAssetCache, DefaultBurst, MultiplexedBurst]()
+	{
+		LogBurst(TEXT("Default"), DefaultBurst);
+		LogBurst(TEXT("Multiplexed + preconnect"), MultiplexedBurst);
+		
+		TestEqual(TEXT("All default requests should succeed"), DefaultBurst->NumSucceeded, NumRequests);
+		TestEqual(TEXT("All multiplexed requests should succeed"), MultiplexedBurst->NumSucceeded, NumRequests);
+
+		Server->Stop();
+		Settings->AssetRegisterURL = OriginalURL;
+		Settings->bUseMultiplexedConnection = bOriginalUseMultiplexedConnection;
+		Settings->bEnableAssetCache = bOriginalEnableAssetCache;
+	});
+	
+	return true;
+}
+
+#endif
@@ -0,0 +1,134 @@
+#include "AssetRegisterCompletionQueue.h"
+#include "AssetRegisterLog.h"
+#include "AssetRegisterMockServer.h"
+#include "AssetRegisterQueryingLibrary.h"
+#include "AssetRegisterSettings.h"
+#include "QueryTestUtil.h"
+#include "Async/ParallelFor.h"
+#include "Misc/AutomationTest.h"
+#include "UObject/GarbageCollection.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(CompletionQueueTest,
+								"UBFEmergenceDemo.sdk_unreal_asset_register.Source.AssetRegister.Private.CompletionQueueTest",
+								EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+namespace CompletionQueue
+{
+	constexpr int32 NumCompletions = 500;
+	constexpr double CompletionSeconds = 0.00005;
+	constexpr double BudgetSeconds = 0.002;
+
+	const TCHAR* ResponseJson = TEXT(R"({"data":{"assets":{"edges":[
+		{"cursor":"cursor-0","node":{"tokenId":"1","collectionId":"7668:root:1124","ownership":{"owner":{"address":"0xffffffff00000000000000000000000000000f59"}}}},
+		{"cursor":"cursor-1","node":{"tokenId":"2","collectionId":"7668:root:1124","ownership":{"owner":{"address":"0xffffffff00000000000000000000000000000f59"}}}}
+	],"pageInfo":{"endCursor":"cursor-1","hasNextPage":false},"total":2}}})");
+
+	const TCHAR* Query = TEXT(R"({assets(collectionIds: ["7668:root:1124"], first: 2) {edges {cursor node {tokenId collectionId}}}})");
+
+	struct FCompletion
+	{
+		bool bCompleted = false;
+		bool bSuccess = false;
+		bool bOnGameThread = false;
+		bool bGCLocked = false;
+		bool bObjectsKeptAlive = false;
+		int32 NumEdges = 0;
+	};
+
+	void SendQuery(EAssetRegisterCompletionPolicy Policy, const TSharedRef<FCompletion>& Completion)
+	{
+		FAssetRegisterCompletionScope Scope(Policy);
+		UAssetRegisterQueryingLibrary::MakeAssetsQuery(Query).Next([Completion](const FLoadAssetsResult& Result)
+		{
+			Completion->bSuccess = Result.bSuccess;
+			Completion->NumEdges = Result.Value.Edges.Num();
+			Completion->bOnGameThread = IsInGameThread();
+			Completion->bGCLocked = IsGarbageCollectionLocked();
+			const UObject* Ownership = Result.Value.Edges.IsEmpty() ? nullptr : Result.Value.Edges[0].Node.OwnershipWrapper.Ownership;
+			Completion->bObjectsKeptAlive = Ownership && (IsInGameThread() || Ownership->HasAnyInternalFlags(EInternalObjectFlags::Async));
+			Completion->bCompleted = true;
+		});
+	}
+}
+
+/**
+ * A burst of completions queued from several threads should be delivered on the game thread over several budgeted
+ * drains, and queries should decode on a worker and complete where their completion policy says, without holding
+ * garbage collection locked while their continuations run.
+ */
+bool CompletionQueueTest::RunTest(const FString& Parameters)
+{
+	using namespace CompletionQueue;
+
+	FAssetRegisterCompletionQueue& Queue = FAssetRegisterCompletionQueue::Get();
+	const FAssetRegisterCompletionQueueStats StartStats = Queue.GetStats();
+
+	TSharedRef<std::atomic<int32>> NumDelivered = MakeShared<std::atomic<int32>>(0);
+	ParallelFor(NumCompletions, [&Queue, NumDelivered](int32 Index)
+	{
+		Queue.Enqueue([NumDelivered]()
+		{
+			check(IsInGameThread());
+			const double EndTime = FPlatformTime::Seconds() + CompletionSeconds;
+			while (FPlatformTime::Seconds() < EndTime)
+			{
+			}
+			++*NumDelivered;
+		});
+	});
+	TestEqual(TEXT("Every completion should be queued"), Queue.GetStats().NumQueued, StartStats.NumQueued + NumCompletions);
+
+	const int32 NumFirstFrame = Queue.Drain(BudgetSeconds);
+	TestTrue(TEXT("A budgeted drain should deliver some of a burst"), NumFirstFrame > 0 && NumFirstFrame < NumCompletions);
+
+	int32 NumFrames = 1;
+	while (*NumDelivered < NumCompletions && NumFrames < NumCompletions)
+	{
+		Queue.Drain(BudgetSeconds);
+		++NumFrames;
+	}
+	UE_LOG(LogAssetRegister, Display, TEXT("[CompletionQueueTest] %d completions of %.0fus delivered over %d frames of %.0fms"),
+		NumCompletions, CompletionSeconds * 1000000.0, NumFrames, BudgetSeconds * 1000.0);
+	TestEqual(TEXT("Every completion should be delivered"), NumDelivered->load(), NumCompletions);
+	TestTrue(TEXT("Frames that ran out of budget should be counted"), Queue.GetStats().NumDeferredFrames > StartStats.NumDeferredFrames);
+
+	TSharedRef<FAssetRegisterMockServer> Server = MakeShared<FAssetRegisterMockServer>();
+	if (!Server->Start())
+	{
+		AddError(TEXT("Failed to start mock server"));
+		return false;
+	}
+	Server->SetResponse(ResponseJson);
+
+	UAssetRegisterSettings* Settings = GetMutableDefault<UAssetRegisterSettings>();
+	const FString OriginalURL = Settings->AssetRegisterURL;
+	Settings->AssetRegisterURL = Server->GetURL();
+
+	TSharedRef<FCompletion> GameThreadCompletion = MakeShared<FCompletion>();
+	TSharedRef<FCompletion> WorkerCompletion = MakeShared<FCompletion>();
+	SendQuery(EAssetRegisterCompletionPolicy::GameThread, GameThreadCompletion);
+	SendQuery(EAssetRegisterCompletionPolicy::Worker, WorkerCompletion);
+
+	QueryTestUtil::WaitUntil(this, [GameThreadCompletion, WorkerCompletion]()
+	{
+		return GameThreadCompletion->bCompleted && WorkerCompletion->bCompleted;
+	});
+	QueryTestUtil::Then([this, Server, Settings, OriginalURL, GameThreadCompletion, WorkerCompletion]()
+	{
+		TestTrue(TEXT("Queries decoded on a worker should succeed"), GameThreadCompletion->bSuccess && WorkerCompletion->bSuccess);
+		TestEqual(TEXT("Every asset should be decoded"), GameThreadCompletion->NumEdges, 2);
+		TestTrue(TEXT("The GameThread policy should complete on the game thread"), GameThreadCompletion->bOnGameThread);
+		TestFalse(TEXT("The Worker policy should complete off the game thread"), WorkerCompletion->bOnGameThread);
+		TestFalse(TEXT("Continuations should run with garbage collection unlocked"), WorkerCompletion->bGCLocked);
+		TestTrue(TEXT("Decoded objects should be kept alive while the continuations run"), WorkerCompletion->bObjectsKeptAlive);
+
+		Server->Stop();
+		Settings->AssetRegisterURL = OriginalURL;
+	});
+
+	return true;
+}
+
+#endif
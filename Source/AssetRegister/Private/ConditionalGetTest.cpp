@@ -0,0 +1,99 @@
+#include "AssetRegisterMockServer.h"
+#include "AssetRegisterQueryingLibrary.h"
+#include "AssetRegisterQueryBuilder.h"
+#include "AssetRegisterSettings.h"
+#include "QueryTestUtil.h"
+#include "Misc/AutomationTest.h"
+#include "Schemas/Unions/NFTAssetOwnership.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(ConditionalGetTest,
+								"UBFEmergenceDemo.sdk_unreal_asset_register.Source.AssetRegister.Private.ConditionalGetTest",
+								EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool ConditionalGetTest::RunTest(const FString& Parameters)
+{
+	const auto ResponseJson = TEXT(R"({
+	  "data": {
+	    "asset": {
+	      "tokenId": "10",
+	      "collectionId": "7668:root:1124",
+	      "profiles": { "asset-profile": "https://example.com/10/profile.json" },
+	      "ownership": { "owner": { "address": "0xFfffFffF000000000000000000000000000012ef" } }
+	    }
+	  }
+	})");
+	
+	TSharedRef<FAssetRegisterMockServer> Server = MakeShared<FAssetRegisterMockServer>();
+	if (!Server->Start())
+	{
+		AddError(TEXT("Failed to start mock server"));
+		return false;
+	}
+	Server->SetResponse(ResponseJson, TEXT("\"v1\""));
+
+	UAssetRegisterSettings* Settings = GetMutableDefault<UAssetRegisterSettings>();
+	const FString OriginalURL = Settings->AssetRegisterURL;
+	const bool bOriginalUseGet = Settings->bUseGetForReadQueries;
+	Settings->AssetRegisterURL = Server->GetURL();
+	Settings->bUseGetForReadQueries = true;
+
+	auto AssetQuery = FAssetRegisterQueryBuilder::AddAssetQuery(FAssetInput(TEXT("10"), TEXT("7668:root:1124")));
+	AssetQuery->AddField(&FAsset::TokenId)->AddField(&FAsset::Profiles);
+	AssetQuery->OnMember(&FAsset::Ownership)->OnUnion<FNFTAssetOwnership>()
+		->OnMember(&FNFTAssetOwnership::Owner)
+			->AddField(&FAccount::Address);
+
+	TSharedRef<TArray<FLoadAssetResult>> Results = MakeShared<TArray<FLoadAssetResult>>();
+	auto SendQuery = [AssetQuery, Results]()
+	{
+		UAssetRegisterQueryingLibrary::MakeAssetQuery(AssetQuery->GetQueryJsonUtf8()).Next([Results](const FLoadAssetResult& Result)
+		{
+			Results->Add(Result);
+		});
+	};
+
+	// first request downloads and decodes the asset, second one should be revalidated with If-None-Match
+	SendQuery();
+	QueryTestUtil::WaitUntil(this, [Results]() { return Results->Num() == 1; });
+	QueryTestUtil::Then(SendQuery);
+	QueryTestUtil::WaitUntil(this, [Results]() { return Results->Num() == 2; });
+	
+	// with GET disabled the same query should go out as a POST
+	QueryTestUtil::Then([Settings, SendQuery]()
+	{
+		Settings->bUseGetForReadQueries = false;
+		SendQuery();
+	});
+	QueryTestUtil::WaitUntil(this, [Results]() { return Results->Num() == 3; });
+	
+	QueryTestUtil::Then([this, Server, Results, Settings, OriginalURL, bOriginalUseGet]()
+	{
+		TestEqual(TEXT("All requests should reach the server"), Server->GetNumRequests(), 3);
+		TestEqual(TEXT("Read queries should be sent as GET when enabled"), Server->GetNumGetRequests(), 2);
+		TestEqual(TEXT("Unchanged asset should be answered with 304"), Server->GetNumNotModified(), 1);
+
+		if (Results->Num() == 3)
+		{
+			for (const FLoadAssetResult& Result : *Results)
+			{
+				TestTrue(TEXT("Result should succeed"), Result.bSuccess);
+				TestEqual(TEXT("Asset profile should be decoded"),
+					Result.Value.Profiles.FindRef(TEXT("asset-profile")), TEXT("https://example.com/10/profile.json"));
+			}
+			
+			TestTrue(TEXT("304 should reuse the previously decoded asset"),
+				(*Results)[0].Value.OwnershipWrapper.Ownership != nullptr &&
+				(*Results)[0].Value.OwnershipWrapper.Ownership == (*Results)[1].Value.OwnershipWrapper.Ownership);
+		}
+
+		Server->Stop();
+		Settings->AssetRegisterURL = OriginalURL;
+		Settings->bUseGetForReadQueries = bOriginalUseGet;
+	});
+	
+	return true;
+}
+
+#endif
@@ -0,0 +1,137 @@
+#include "AssetRegisterCoroutines.h"
+#include "AssetRegisterMockServer.h"
+#include "AssetRegisterSettings.h"
+#include "QueryTestUtil.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#if WITH_ASSETREGISTER_COROUTINES
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(CoroutinesTest,
+								"UBFEmergenceDemo.sdk_unreal_asset_register.Source.AssetRegister.Private.CoroutinesTest",
+								EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+namespace Coroutines
+{
+	const TCHAR* ResponseJson = TEXT(R"({"data":{"assets":{"edges":[
+		{"cursor":"cursor-0","node":{"tokenId":"1","collectionId":"7668:root:1124"}},
+		{"cursor":"cursor-1","node":{"tokenId":"2","collectionId":"7668:root:1124"}},
+		{"cursor":"cursor-2","node":{"tokenId":"3","collectionId":"7668:root:1124"}}
+	],"pageInfo":{"endCursor":"cursor-2","hasNextPage":false},"total":3}}})");
+
+	struct FSteps
+	{
+		std::atomic<int32> NumSteps = 0;
+		std::atomic<bool> bResumedOnGameThread = false;
+	};
+
+	TAssetRegisterTask<int32> Sum(TFuture<int32> First, TFuture<int32> Second, TSharedRef<FSteps> Steps)
+	{
+		const int32 FirstValue = co_await AssetRegisterCoroutines::Await(MoveTemp(First));
+		++Steps->NumSteps;
+		const int32 SecondValue = co_await AssetRegisterCoroutines::Await(MoveTemp(Second), EAssetRegisterCompletionPolicy::GameThread);
+		++Steps->NumSteps;
+		Steps->bResumedOnGameThread = IsInGameThread();
+		co_return FirstValue + SecondValue;
+	}
+
+	TAssetRegisterTask<FLoadAssetResult> AwaitCancellable(TFuture<FLoadAssetResult> Future, FAssetRegisterCancellationToken Token, TSharedRef<FSteps> Steps)
+	{
+		FLoadAssetResult Result = co_await TAssetRegisterAwaitable<FLoadAssetResult>(MoveTemp(Future)).WithCancellation(Token);
+		++Steps->NumSteps;
+		co_return Result;
+	}
+
+	/** Awaits a coroutine that awaits a cancellable step, so cancelling the step should fail both. */
+	TAssetRegisterTask<bool> AwaitNested(TFuture<FLoadAssetResult> Future, FAssetRegisterCancellationToken Token, TSharedRef<FSteps> Steps)
+	{
+		const FLoadAssetResult Result = co_await AwaitCancellable(MoveTemp(Future), Token, Steps);
+		co_return Result.bSuccess;
+	}
+
+	TAssetRegisterTask<int32> CountAssets(TSharedRef<FSteps> Steps)
+	{
+		FAssetConnection AssetsInput;
+		AssetsInput.CollectionIds = {TEXT("7668:root:1124")};
+		AssetsInput.First = 3;
+
+		const FLoadAssetsResult Page = co_await AssetRegisterCoroutines::GetAssets(AssetsInput, EAssetRegisterCompletionPolicy::GameThread);
+		Steps->bResumedOnGameThread = IsInGameThread();
+		co_return Page.bSuccess ? Page.Value.Edges.Num() : INDEX_NONE;
+	}
+}
+
+/**
+ * Coroutines should be able to await futures and queries top to bottom, resume on the thread they ask for, and
+ * stop at a cancelled step, failing the coroutines awaiting them.
+ */
+bool CoroutinesTest::RunTest(const FString& Parameters)
+{
+	using namespace Coroutines;
+
+	TSharedRef<FSteps> SumSteps = MakeShared<FSteps>();
+	TSharedRef<TPromise<int32>> FirstPromise = MakeShared<TPromise<int32>>();
+	TSharedRef<TPromise<int32>> SecondPromise = MakeShared<TPromise<int32>>();
+	TSharedRef<TFuture<int32>> SumFuture = MakeShared<TFuture<int32>>(Sum(FirstPromise->GetFuture(), SecondPromise->GetFuture(), SumSteps));
+	TestEqual(TEXT("A coroutine should suspend at a future that isn't ready"), SumSteps->NumSteps.load(), 0);
+
+	// both values arrive from a worker, the second step asked to resume on the game thread
+	AsyncTask(ENamedThreads::AnyBackgroundThreadNormalTask, [FirstPromise, SecondPromise]()
+	{
+		FirstPromise->SetValue(2);
+		SecondPromise->SetValue(3);
+	});
+
+	TSharedRef<FSteps> CancelledSteps = MakeShared<FSteps>();
+	TSharedRef<TPromise<FLoadAssetResult>> PendingPromise = MakeShared<TPromise<FLoadAssetResult>>();
+	FAssetRegisterCancellationToken Token;
+	TFuture<bool> NestedFuture = AwaitNested(PendingPromise->GetFuture(), Token, CancelledSteps);
+	Token.Cancel();
+	TestTrue(TEXT("Cancelling should complete the awaiting coroutines"), NestedFuture.IsReady());
+	TestFalse(TEXT("A cancelled step should fail the coroutines awaiting it"), NestedFuture.IsReady() && NestedFuture.Get());
+	FLoadAssetResult LateResult;
+	LateResult.bSuccess = true;
+	PendingPromise->SetValue(LateResult);
+	TestEqual(TEXT("A cancelled coroutine should not resume when its future completes"), CancelledSteps->NumSteps.load(), 0);
+
+	TSharedRef<FAssetRegisterMockServer> Server = MakeShared<FAssetRegisterMockServer>();
+	if (!Server->Start())
+	{
+		AddError(TEXT("Failed to start mock server"));
+		return false;
+	}
+	Server->SetResponse(ResponseJson);
+
+	UAssetRegisterSettings* Settings = GetMutableDefault<UAssetRegisterSettings>();
+	const FString OriginalURL = Settings->AssetRegisterURL;
+	const bool bOriginalEnableAssetCache = Settings->bEnableAssetCache;
+	const bool bOriginalEnableDiskCache = Settings->bEnableDiskCache;
+	Settings->AssetRegisterURL = Server->GetURL();
+	Settings->bEnableAssetCache = false;
+	Settings->bEnableDiskCache = false;
+
+	TSharedRef<FSteps> QuerySteps = MakeShared<FSteps>();
+	TSharedRef<TFuture<int32>> CountFuture = MakeShared<TFuture<int32>>(CountAssets(QuerySteps));
+
+	QueryTestUtil::WaitUntil(this, [SumFuture, CountFuture]() { return SumFuture->IsReady() && CountFuture->IsReady(); });
+	QueryTestUtil::Then([this, SumFuture, SumSteps, CountFuture, QuerySteps, Server, Settings, OriginalURL, bOriginalEnableAssetCache,
+		bOriginalEnableDiskCache]()
+	{
+		TestEqual(TEXT("co_return should complete the coroutine's future"), SumFuture->Get(), 5);
+		TestTrue(TEXT("A step should resume on the thread it asked for"), SumSteps->bResumedOnGameThread.load());
+		TestEqual(TEXT("A query should be awaitable"), CountFuture->Get(), 3);
+		TestTrue(TEXT("A query should resume on the thread it asked for"), QuerySteps->bResumedOnGameThread.load());
+
+		Server->Stop();
+		Settings->AssetRegisterURL = OriginalURL;
+		Settings->bEnableAssetCache = bOriginalEnableAssetCache;
+		Settings->bEnableDiskCache = bOriginalEnableDiskCache;
+	});
+
+	return true;
+}
+
+#endif
+
+#endif
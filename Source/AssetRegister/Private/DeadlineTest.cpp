@@ -0,0 +1,178 @@
+#include "AssetFixtures.h"
+#include "AssetRegisterCapture.h"
+#include "AssetRegisterMetrics.h"
+#include "AssetRegisterMockServer.h"
+#include "AssetRegisterQueryBuilder.h"
+#include "AssetRegisterQueryingLibrary.h"
+#include "AssetRegisterSettings.h"
+#include "Algo/Count.h"
+#include "QueryTestUtil.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(DeadlineTest,
+								"UBFEmergenceDemo.sdk_unreal_asset_register.Source.AssetRegister.Private.DeadlineTest",
+								EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+namespace Deadline
+{
+	constexpr int32 NumAssets = 25;
+	constexpr int32 PageSize = 10;
+
+	struct FTimedResult
+	{
+		FLoadAssetResult Result;
+		double Seconds = 0.0;
+	};
+
+	struct FResults
+	{
+		TOptional<FTimedResult> Unbounded;
+		TOptional<FTimedResult> Queued;
+		TOptional<FTimedResult> Slow;
+		TOptional<FLoadAssetsResult> AllAssets;
+		double AllAssetsSeconds = 0.0;
+	};
+
+	TArray<uint8> MakeAssetQueryContent(const FString& TokenId)
+	{
+		auto AssetQuery = FAssetRegisterQueryBuilder::AddAssetQuery(FAssetInput(TokenId, AssetFixtures::CollectionId));
+		AssetQuery->AddField(&FAsset::TokenId)
+			->AddField(&FAsset::Profiles);
+		return AssetQuery->GetQueryJsonUtf8();
+	}
+
+	/** Sends an asset query, resolving to its result and the seconds it took. */
+	TFuture<FTimedResult> SendTimed(const FString& TokenId, const FAssetRegisterDeadline& Deadline)
+	{
+		const double StartTime = FPlatformTime::Seconds();
+		return UAssetRegisterQueryingLibrary::MakeAssetQuery(MakeAssetQueryContent(TokenId), Deadline).Next([StartTime](const FLoadAssetResult& Result)
+		{
+			return FTimedResult{Result, FPlatformTime::Seconds() - StartTime};
+		});
+	}
+
+	uint64 GetNumTimeouts()
+	{
+		return FAssetRegisterMetrics::Get().GetSnapshot().NumErrorsByClass[static_cast<int32>(EAssetRegisterErrorClass::Timeout)];
+	}
+}
+
+/**
+ * A request whose deadline passes while it waits in the scheduler queue should be dropped without being sent, a
+ * request should time out at its deadline rather than after the default timeout, and GetAllAssets should return the
+ * pages loaded before its deadline as a partial result. A dropped request should still be recorded in a capture.
+ */
+bool DeadlineTest::RunTest(const FString& Parameters)
+{
+	using namespace Deadline;
+
+	const FAssetRegisterDeadline Unset;
+	TestFalse(TEXT("A default deadline should never expire"), Unset.HasExpired());
+	TestEqual(TEXT("A default deadline should keep the default request timeout"), Unset.GetRequestTimeout(60.f), 60.f);
+	const FAssetRegisterDeadline Budget = FAssetRegisterDeadline::After(5.0);
+	TestTrue(TEXT("A request timeout should be capped by the remaining budget"), Budget.GetRequestTimeout(60.f) <= 5.f);
+	TestEqual(TEXT("A request timeout should be capped by the default timeout"), Budget.GetRequestTimeout(1.f), 1.f);
+
+	TSharedRef<FAssetRegisterMockServer> Server = MakeShared<FAssetRegisterMockServer>();
+	if (!Server->Start())
+	{
+		AddError(TEXT("Failed to start mock server"));
+		return false;
+	}
+	Server->SetAssets(AssetFixtures::MakeAssetJsons(NumAssets, 0));
+
+	UAssetRegisterSettings* Settings = GetMutableDefault<UAssetRegisterSettings>();
+	const FString OriginalURL = Settings->AssetRegisterURL;
+	const bool bOriginalEnableAssetCache = Settings->bEnableAssetCache;
+	const bool bOriginalEnableNegativeCache = Settings->bEnableNegativeCache;
+	const int32 OriginalMaxConcurrentRequests = Settings->MaxConcurrentRequests;
+	const int32 OriginalPagePrefetchDepth = Settings->PagePrefetchDepth;
+	const bool bOriginalAdaptivePageSize = Settings->bAdaptivePageSize;
+	Settings->AssetRegisterURL = Server->GetURL();
+	// every query should reach the server, one page at a time
+	Settings->bEnableAssetCache = false;
+	Settings->bEnableNegativeCache = false;
+	Settings->PagePrefetchDepth = 0;
+	Settings->bAdaptivePageSize = false;
+
+	TSharedRef<FResults> Results = MakeShared<FResults>();
+
+	// expired while queued: with a single request in flight, the second one waits for the first
+	constexpr float QueuedLatency = 0.5f;
+	Settings->MaxConcurrentRequests = 1;
+	Server->SetLatency(QueuedLatency);
+	const uint64 NumTimeoutsBefore = GetNumTimeouts();
+	FAssetRegisterRecorder::Get().Start();
+	SendTimed(TEXT("1"), FAssetRegisterDeadline()).Next([Results](const FTimedResult& Result) { Results->Unbounded = Result; });
+	SendTimed(TEXT("2"), FAssetRegisterDeadline::After(QueuedLatency * 0.4)).Next([Results](const FTimedResult& Result) { Results->Queued = Result; });
+
+	QueryTestUtil::WaitUntil(this, [Results]() { return Results->Unbounded.IsSet() && Results->Queued.IsSet(); });
+	QueryTestUtil::Then([this, Server, Settings, Results, QueuedLatency, NumTimeoutsBefore, OriginalMaxConcurrentRequests]()
+	{
+		if (TestTrue(TEXT("Both requests should complete"), Results->Unbounded.IsSet() && Results->Queued.IsSet()))
+		{
+			TestTrue(TEXT("The request without a deadline should succeed"), Results->Unbounded->Result.bSuccess);
+			TestFalse(TEXT("The request expired in the queue should fail"), Results->Queued->Result.bSuccess);
+			TestTrue(TEXT("The request should be dropped when it leaves the queue"), Results->Queued->Seconds >= QueuedLatency * 0.8);
+		}
+		TestEqual(TEXT("The request expired in the queue should never reach the server"), Server->GetNumRequests(), 1);
+		TestEqual(TEXT("The dropped request should be counted as a timeout"), GetNumTimeouts() - NumTimeoutsBefore, uint64(1));
+		const FAssetRegisterCapture Recorded = FAssetRegisterRecorder::Get().Stop();
+		TestEqual(TEXT("The dropped request should be recorded"), Recorded.Entries.Num(), 2);
+		const int32 NumWithoutResponse = static_cast<int32>(Algo::CountIf(Recorded.Entries, [](const FAssetRegisterCaptureEntry& Entry) { return Entry.ResponseCode == 0; }));
+		TestEqual(TEXT("The dropped request should be recorded without a response"), NumWithoutResponse, 1);
+		Settings->MaxConcurrentRequests = OriginalMaxConcurrentRequests;
+
+		// timeout from the remaining budget: the server answers long after the deadline
+		Server->SetLatency(3.f);
+		SendTimed(TEXT("3"), FAssetRegisterDeadline::After(0.5)).Next([Results](const FTimedResult& Result) { Results->Slow = Result; });
+	});
+
+	QueryTestUtil::WaitUntil(this, [Results]() { return Results->Slow.IsSet(); });
+	QueryTestUtil::Then([this, Server, Results]()
+	{
+		if (TestTrue(TEXT("The slow request should complete"), Results->Slow.IsSet()))
+		{
+			TestFalse(TEXT("The slow request should fail"), Results->Slow->Result.bSuccess);
+			TestTrue(TEXT("The slow request should time out at its deadline, not after the default timeout"), Results->Slow->Seconds < 2.0);
+		}
+
+		// mid-pagination: the first page arrives in time, the second one can't
+		Server->SetLatency(0.4f);
+		FAssetConnection AssetsInput;
+		AssetsInput.Addresses = {AssetFixtures::OwnerAddress};
+		AssetsInput.First = PageSize;
+		const double StartTime = FPlatformTime::Seconds();
+		UAssetRegisterQueryingLibrary::GetAllAssets(AssetsInput, FAssetRegisterDeadline::After(0.6)).Next([Results, StartTime](const FLoadAssetsResult& Result)
+		{
+			Results->AllAssetsSeconds = FPlatformTime::Seconds() - StartTime;
+			Results->AllAssets = Result;
+		});
+	});
+
+	QueryTestUtil::WaitUntil(this, [Results]() { return Results->AllAssets.IsSet(); });
+	QueryTestUtil::Then([this, Server, Settings, Results, OriginalURL, bOriginalEnableAssetCache, bOriginalEnableNegativeCache,
+		OriginalPagePrefetchDepth, bOriginalAdaptivePageSize]()
+	{
+		if (TestTrue(TEXT("GetAllAssets should complete"), Results->AllAssets.IsSet()))
+		{
+			TestTrue(TEXT("The pages loaded in time should be returned"), Results->AllAssets->bSuccess);
+			TestTrue(TEXT("The result should be marked partial"), Results->AllAssets->bPartial);
+			TestEqual(TEXT("Only the first page should be returned"), Results->AllAssets->Value.Edges.Num(), PageSize);
+			TestTrue(TEXT("GetAllAssets should return at its deadline"), Results->AllAssetsSeconds < 2.0);
+		}
+
+		Server->Stop();
+		Settings->AssetRegisterURL = OriginalURL;
+		Settings->bEnableAssetCache = bOriginalEnableAssetCache;
+		Settings->bEnableNegativeCache = bOriginalEnableNegativeCache;
+		Settings->PagePrefetchDepth = OriginalPagePrefetchDepth;
+		Settings->bAdaptivePageSize = bOriginalAdaptivePageSize;
+	});
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,168 @@
+#include "AssetFixtures.h"
+#include "AssetRegisterCapture.h"
+#include "AssetRegisterQueryingLibrary.h"
+#include "AssetRegisterSettings.h"
+#include "BenchmarkUtil.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/CommandLine.h"
+#include "Misc/Parse.h"
+#include "UObject/UObjectGlobals.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(DecodeBenchmarkTest,
+								"UBFEmergenceDemo.sdk_unreal_asset_register.Source.AssetRegister.Private.DecodeBenchmarkTest",
+								EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+namespace DecodeBenchmark
+{
+	constexpr int32 NumChildLinks = 3;
+	constexpr int32 NumQueryBuildOps = 10000;
+	constexpr int32 NumAssetOps = 2000;
+	constexpr int32 PageSizes[] = {10, 1000, 10000};
+	constexpr int32 NumCapturedOps = 5;
+
+	/** Fewer runs for larger pages, so each size takes about as long. */
+	int32 GetNumPageOps(int32 PageSize)
+	{
+		return FMath::Max(2, 20000 / PageSize);
+	}
+
+	/** The query GetAssets sends for a page of PageSize assets after the first. */
+	TSharedPtr<FQueryNode<FAssets>> MakeAssetsQuery(int32 PageSize)
+	{
+		FAssetConnection AssetsInput;
+		AssetsInput.Addresses = {AssetFixtures::OwnerAddress};
+		AssetsInput.CollectionIds = {AssetFixtures::CollectionId};
+		AssetsInput.First = PageSize;
+		AssetsInput.After = AssetFixtures::MakeCursor(PageSize);
+		return UAssetRegisterQueryingLibrary::GetAssetsQueryNode(AssetsInput);
+	}
+
+	TSharedPtr<FJsonObject> Parse(const FTCHARToUTF8& Json)
+	{
+		return QueryStringUtil::ParseJsonUtf8(TConstArrayView<uint8>(reinterpret_cast<const uint8*>(Json.Get()), Json.Length()));
+	}
+
+	/** The assets pages recorded in the capture passed as -AssetRegisterReplay=, see FAssetRegisterRecorder. */
+	TArray<TArray<uint8>> LoadCapturedPages()
+	{
+		FString CapturePath;
+		FAssetRegisterCapture Capture;
+		if (!FParse::Value(FCommandLine::Get(), TEXT("AssetRegisterReplay="), CapturePath) || !Capture.LoadFromFile(CapturePath))
+		{
+			return {};
+		}
+
+		TArray<TArray<uint8>> Pages;
+		for (FAssetRegisterCaptureEntry& Entry : Capture.Entries)
+		{
+			const TSharedPtr<FJsonObject> RootObject = QueryStringUtil::ParseJsonUtf8(Entry.ResponseContent);
+			const TSharedPtr<FJsonObject>* DataObject = nullptr;
+			if (RootObject.IsValid() && RootObject->TryGetObjectField(TEXT("data"), DataObject) && (*DataObject)->HasField(TEXT("assets")))
+			{
+				Pages.Add(MoveTemp(Entry.ResponseContent));
+			}
+		}
+		return Pages;
+	}
+}
+
+/**
+ * Throughput, allocations and peak memory of building and serializing the GetAssets query, and of parsing and
+ * decoding generated responses: a single asset and pages of 10, 1k and 10k assets, each with metadata, ownership and
+ * NumChildLinks links. Decoding runs with the asset cache off, so only the decode itself is measured.
+ *
+ * With -AssetRegisterReplay=<Path>, the assets pages recorded in that capture are parsed and decoded as well.
+ */
+bool DecodeBenchmarkTest::RunTest(const FString& Parameters)
+{
+	using namespace DecodeBenchmark;
+
+	UAssetRegisterSettings* Settings = GetMutableDefault<UAssetRegisterSettings>();
+	const bool bOriginalEnableAssetCache = Settings->bEnableAssetCache;
+	Settings->bEnableAssetCache = false;
+
+	TArray<BenchmarkUtil::FResult> Results;
+
+	int32 QueryLength = 0;
+	Results.Add(BenchmarkUtil::Measure(TEXT("QueryBuild"), NumQueryBuildOps, [&QueryLength]()
+	{
+		QueryLength = MakeAssetsQuery(100)->GetQueryString().Len();
+	}));
+	TestTrue(TEXT("The query should be built"), QueryLength > 0);
+
+	const TSharedPtr<FQueryNode<FAssets>> AssetsQuery = MakeAssetsQuery(100);
+	int32 QueryJsonSize = 0;
+	Results.Add(BenchmarkUtil::Measure(TEXT("QuerySerialize"), NumQueryBuildOps, [&AssetsQuery, &QueryJsonSize]()
+	{
+		QueryJsonSize = AssetsQuery->GetQueryJsonUtf8().Num();
+	}));
+	TestTrue(TEXT("The query should be serialized"), QueryJsonSize > QueryLength);
+
+	const FTCHARToUTF8 AssetJson(*AssetFixtures::MakeAssetResponseJson(1, NumChildLinks));
+	const TSharedPtr<FJsonObject> AssetRoot = Parse(AssetJson);
+	bool bAssetDecoded = false;
+	Results.Add(BenchmarkUtil::Measure(TEXT("ParseAsset"), NumAssetOps, [&AssetJson]()
+	{
+		Parse(AssetJson);
+	}));
+	Results.Add(BenchmarkUtil::Measure(TEXT("DecodeAssetResponse"), NumAssetOps, [&AssetRoot, &bAssetDecoded]()
+	{
+		const FLoadAssetResult Result = UAssetRegisterQueryingLibrary::DecodeAssetResponse(AssetRoot);
+		bAssetDecoded = Result.bSuccess && Result.Value.LinkWrapper.Links != nullptr;
+	}));
+	TestTrue(TEXT("The asset and its links should be decoded"), bAssetDecoded);
+
+	for (const int32 PageSize : PageSizes)
+	{
+		const FTCHARToUTF8 PageJson(*AssetFixtures::MakeAssetsResponseJson(PageSize, NumChildLinks, PageSize * 2));
+		const TSharedPtr<FJsonObject> PageRoot = Parse(PageJson);
+		const int32 NumOps = GetNumPageOps(PageSize);
+
+		Results.Add(BenchmarkUtil::Measure(FString::Printf(TEXT("ParseAssets%d"), PageSize), NumOps, [&PageJson]()
+		{
+			Parse(PageJson);
+		}));
+
+		int32 NumDecoded = 0;
+		Results.Add(BenchmarkUtil::Measure(FString::Printf(TEXT("DecodeAssetsResponse%d"), PageSize), NumOps, [&PageRoot, &NumDecoded]()
+		{
+			NumDecoded = UAssetRegisterQueryingLibrary::DecodeAssetsResponse(PageRoot).Value.Edges.Num();
+		}));
+		TestEqual(FString::Printf(TEXT("Every edge of the %d asset page should be decoded"), PageSize), NumDecoded, PageSize);
+
+		// drop the decoded UObjects before the next size
+		CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+	}
+
+	const TArray<TArray<uint8>> CapturedPages = LoadCapturedPages();
+	if (!CapturedPages.IsEmpty())
+	{
+		TArray<TSharedPtr<FJsonObject>> CapturedRoots;
+		for (const TArray<uint8>& Page : CapturedPages)
+		{
+			CapturedRoots.Add(QueryStringUtil::ParseJsonUtf8(Page));
+		}
+
+		Results.Add(BenchmarkUtil::Measure(TEXT("ParseCapturedAssets"), NumCapturedOps, [&CapturedPages]()
+		{
+			for (const TArray<uint8>& Page : CapturedPages)
+			{
+				QueryStringUtil::ParseJsonUtf8(Page);
+			}
+		}));
+		Results.Add(BenchmarkUtil::Measure(TEXT("DecodeCapturedAssetsResponses"), NumCapturedOps, [&CapturedRoots]()
+		{
+			for (const TSharedPtr<FJsonObject>& Root : CapturedRoots)
+			{
+				UAssetRegisterQueryingLibrary::DecodeAssetsResponse(Root);
+			}
+		}));
+		CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+	}
+
+	BenchmarkUtil::Report(TEXT("DecodeBenchmark"), Results);
+
+	Settings->bEnableAssetCache = bOriginalEnableAssetCache;
+
+	return true;
+}
@@ -0,0 +1,146 @@
+#include "AssetFixtures.h"
+#include "AssetRegisterAssetCache.h"
+#include "AssetRegisterDiskCache.h"
+#include "AssetRegisterLog.h"
+#include "AssetRegisterQueryingLibrary.h"
+#include "AssetRegisterSettings.h"
+#include "HAL/FileManager.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/Paths.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(DiskCacheWarmStartBenchmarkTest,
+								"UBFEmergenceDemo.sdk_unreal_asset_register.Source.AssetRegister.Private.DiskCacheWarmStartBenchmarkTest",
+								EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+namespace DiskCacheWarmStartBenchmark
+{
+	constexpr int32 NumAssets = 10000;
+	constexpr int32 PageSize = 100;
+
+	/** The input GetAllAssets sends for the page starting at FirstIndex. */
+	FAssetConnection MakePageInput(int32 FirstIndex)
+	{
+		FAssetConnection AssetsInput;
+		AssetsInput.Addresses = {AssetFixtures::OwnerAddress};
+		AssetsInput.First = PageSize;
+		if (FirstIndex > 0)
+		{
+			AssetsInput.After = AssetFixtures::MakeCursor(FirstIndex - 1);
+		}
+		return AssetsInput;
+	}
+}
+
+/**
+ * Time to first inventory on a warm start: a 10k asset inventory is written to the disk cache, the cache is
+ * reopened as on the next launch, and the inventory is loaded with GetAssets/GetAllAssets while the endpoint
+ * is unreachable, so every page has to be served from the mapped file. Once stale, a page should only be served
+ * with stale-while-revalidate on.
+ */
+bool DiskCacheWarmStartBenchmarkTest::RunTest(const FString& Parameters)
+{
+	using namespace DiskCacheWarmStartBenchmark;
+
+	UAssetRegisterSettings* Settings = GetMutableDefault<UAssetRegisterSettings>();
+	const FString OriginalURL = Settings->AssetRegisterURL;
+	const bool bOriginalEnableAssetCache = Settings->bEnableAssetCache;
+	const float OriginalFreshness = Settings->DiskCacheFreshness;
+	Settings->AssetRegisterURL = TEXT("http://localhost:1/graphql");
+	// measure the disk path, not the memory cache
+	Settings->bEnableAssetCache = false;
+	Settings->DiskCacheFreshness = 3600.f;
+
+	const FString CachePath = FPaths::Combine(FPaths::AutomationTransientDir(), TEXT("AssetRegister"), TEXT("AssetCache.bin"));
+	IFileManager::Get().Delete(*CachePath);
+
+	FAssetRegisterDiskCache& DiskCache = FAssetRegisterDiskCache::Get();
+	const bool bWasOpen = DiskCache.IsOpen();
+	DiskCache.Open(CachePath);
+
+	for (int32 FirstIndex = 0; FirstIndex < NumAssets; FirstIndex += PageSize)
+	{
+		const TSharedPtr<FQueryNode<FAssets>> AssetsQuery = UAssetRegisterQueryingLibrary::GetAssetsQueryNode(MakePageInput(FirstIndex));
+		const TSharedPtr<IQueryNode> NodeSelection = AssetsQuery->GetChildren().FindRef(TEXT("edges"))->GetChildren().FindRef(TEXT("node"));
+		DiskCache.AddAssetsPage(AssetsQuery->GetQueryJsonUtf8(), AssetFixtures::MakePage(FirstIndex, PageSize, NumAssets), *NodeSelection);
+	}
+
+	double StartTime = FPlatformTime::Seconds();
+	DiskCache.Close();
+	const double WriteSeconds = FPlatformTime::Seconds() - StartTime;
+	const int64 FileSize = IFileManager::Get().FileSize(*CachePath);
+
+	// next launch
+	StartTime = FPlatformTime::Seconds();
+	TestTrue(TEXT("Cache file should open"), DiskCache.Open(CachePath));
+	const double OpenSeconds = FPlatformTime::Seconds() - StartTime;
+	TestEqual(TEXT("Every asset and page should be a record"), DiskCache.GetNumRecords(), NumAssets + NumAssets / PageSize);
+
+	StartTime = FPlatformTime::Seconds();
+	TFuture<FLoadAssetsResult> FirstPage = UAssetRegisterQueryingLibrary::GetAssets(MakePageInput(0));
+	const double FirstPageSeconds = FPlatformTime::Seconds() - StartTime;
+	TestTrue(TEXT("First page should be served without a request"), FirstPage.IsReady() && FirstPage.Get().bSuccess);
+	if (FirstPage.IsReady())
+	{
+		TestEqual(TEXT("First page should hold a full page"), FirstPage.Get().Value.Edges.Num(), PageSize);
+	}
+
+	StartTime = FPlatformTime::Seconds();
+	TFuture<FLoadAssetsResult> Inventory = UAssetRegisterQueryingLibrary::GetAllAssets(MakePageInput(0), FAssetRegisterDeadline());
+	const double InventorySeconds = FPlatformTime::Seconds() - StartTime;
+	TestTrue(TEXT("Inventory should be served without a request"), Inventory.IsReady() && Inventory.Get().bSuccess);
+	if (Inventory.IsReady())
+	{
+		const FAssets& Assets = Inventory.Get().Value;
+		TestEqual(TEXT("Inventory should hold every asset"), Assets.Edges.Num(), NumAssets);
+		if (Assets.Edges.IsValidIndex(4242))
+		{
+			const FAsset& Asset = Assets.Edges[4242].Node;
+			TestEqual(TEXT("Asset should keep its token id"), Asset.TokenId, FString(TEXT("4242")));
+			TestEqual(TEXT("Asset should keep its profile"), Asset.Profiles.FindRef(TEXT("asset-profile")), FString(TEXT("https://example.com/profiles/4242.json")));
+			TestEqual(TEXT("Asset should keep its metadata attributes"), Asset.Metadata.Attributes.FindRef(TEXT("rarity")), FString(TEXT("common")));
+			TestTrue(TEXT("Asset should keep its metadata properties"), Asset.Metadata.Properties.JsonObject.IsValid());
+			const UNFTAssetOwnershipObject* Ownership = Cast<UNFTAssetOwnershipObject>(Asset.OwnershipWrapper.Ownership);
+			TestTrue(TEXT("Asset should keep its owner"), Ownership && Ownership->Data.Owner.Address == AssetFixtures::OwnerAddress);
+		}
+	}
+
+	// refetching every stored field of an asset should restart its age
+	FPlatformProcess::Sleep(0.2f);
+	{
+		const TSharedPtr<FQueryNode<FAssets>> AssetsQuery = UAssetRegisterQueryingLibrary::GetAssetsQueryNode(MakePageInput(0));
+		const TSharedPtr<IQueryNode> NodeSelection = AssetsQuery->GetChildren().FindRef(TEXT("edges"))->GetChildren().FindRef(TEXT("node"));
+		DiskCache.AddAsset(AssetFixtures::MakeAsset(0), *NodeSelection);
+
+		FAsset RefetchedAsset;
+		TSharedPtr<const IQueryNode> RefetchedSelection;
+		double Age = -1.0;
+		TestTrue(TEXT("A refetched asset should be found"), DiskCache.FindAsset(FAssetRegisterAssetKey(AssetFixtures::CollectionId, TEXT("0")),
+			RefetchedAsset, RefetchedSelection, Age));
+		TestTrue(TEXT("A refetched asset should not keep its old fetch time"), Age >= 0.0 && Age < 0.2);
+	}
+
+	// every page is stale from here on
+	const bool bOriginalStaleWhileRevalidate = Settings->bStaleWhileRevalidate;
+	Settings->DiskCacheFreshness = 0.f;
+	Settings->bStaleWhileRevalidate = true;
+	TestTrue(TEXT("A stale page should be served with stale-while-revalidate"), UAssetRegisterQueryingLibrary::GetAssets(MakePageInput(0)).IsReady());
+	Settings->bStaleWhileRevalidate = false;
+	TestFalse(TEXT("A stale page should be refetched first without stale-while-revalidate"), UAssetRegisterQueryingLibrary::GetAssets(MakePageInput(0)).IsReady());
+	Settings->bStaleWhileRevalidate = bOriginalStaleWhileRevalidate;
+
+	UE_LOG(LogAssetRegister, Display, TEXT("[DiskCacheWarmStartBenchmark] %d assets, %lld bytes written in %.2fms. Open %.3fms, first page %.3fms, full inventory %.2fms"),
+		NumAssets, FileSize, WriteSeconds * 1000.0, OpenSeconds * 1000.0, FirstPageSeconds * 1000.0, InventorySeconds * 1000.0);
+
+	DiskCache.Close();
+	IFileManager::Get().Delete(*CachePath);
+	if (bWasOpen)
+	{
+		DiskCache.Open(FAssetRegisterDiskCache::GetDefaultPath());
+	}
+
+	Settings->AssetRegisterURL = OriginalURL;
+	Settings->bEnableAssetCache = bOriginalEnableAssetCache;
+	Settings->DiskCacheFreshness = OriginalFreshness;
+
+	return true;
+}
@@ -0,0 +1,136 @@
+#include "AssetFixtures.h"
+#include "AssetRegisterAssetCache.h"
+#include "AssetRegisterSettings.h"
+#include "Misc/AutomationTest.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(EntityCachePlanningTest,
+								"UBFEmergenceDemo.sdk_unreal_asset_register.Source.AssetRegister.Private.EntityCachePlanningTest",
+								EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+/**
+ * Checks that assets cached from different queries are merged into one entry, and that a query the entry only
+ * partly answers is planned to request just the fields it lacks.
+ */
+bool EntityCachePlanningTest::RunTest(const FString& Parameters)
+{
+	UAssetRegisterSettings* Settings = GetMutableDefault<UAssetRegisterSettings>();
+	const bool bOriginalEnableAssetCache = Settings->bEnableAssetCache;
+	Settings->bEnableAssetCache = true;
+
+	FAssetRegisterAssetCache& Cache = FAssetRegisterAssetCache::Get();
+	Cache.Clear();
+
+	const FAsset FixtureAsset = AssetFixtures::MakeAsset(7);
+	const FAssetRegisterAssetKey Key(FixtureAsset);
+
+	// what a GetAssets page selects of an asset
+	const auto PageSelection = MakeShared<FQueryNode<FAsset>>(TEXT("node"));
+	PageSelection->AddField(&FAsset::TokenId)
+		->AddField(&FAsset::CollectionId)
+		->AddField(&FAsset::Profiles);
+	PageSelection->OnMember(&FAsset::Metadata)
+		->AddField(&FAssetMetadata::Attributes);
+	Cache.Add(FixtureAsset, *PageSelection);
+
+	// a later query for the owner merges into the same entry
+	const auto OwnershipSelection = MakeShared<FQueryNode<FAsset>>(TEXT("asset"));
+	OwnershipSelection->OnMember(&FAsset::Ownership)
+		->OnUnion<FNFTAssetOwnership>()
+			->OnMember(&FNFTAssetOwnership::Owner)
+				->AddField(&FAccount::Address);
+	Cache.Add(FixtureAsset, *OwnershipSelection);
+	TestEqual(TEXT("Both queries should share one entry"), Cache.GetStats().NumEntries, 1);
+
+	const auto KnownQuery = MakeShared<FQueryNode<FAsset>>(TEXT("asset"));
+	KnownQuery->AddField(&FAsset::Profiles);
+	KnownQuery->OnMember(&FAsset::Ownership)
+		->OnUnion<FNFTAssetOwnership>()
+			->OnMember(&FNFTAssetOwnership::Owner)
+				->AddField(&FAccount::Address);
+
+	FAsset Asset;
+	TestTrue(TEXT("Fields from both queries should be answered together"), Cache.Find(Key, *KnownQuery, Asset));
+	TestEqual(TEXT("Profiles should come from the page"), Asset.Profiles.FindRef(TEXT("asset-profile")), FString(TEXT("https://example.com/profiles/7.json")));
+	const UNFTAssetOwnershipObject* Ownership = Cast<UNFTAssetOwnershipObject>(Asset.OwnershipWrapper.Ownership);
+	TestTrue(TEXT("Owner should come from the ownership query"), Ownership && Ownership->Data.Owner.Address == AssetFixtures::OwnerAddress);
+
+	// profiles are known, metadata only partly and links not at all
+	const auto PartialQuery = MakeShared<FQueryNode<FAsset>>(TEXT("asset"));
+	PartialQuery->AddField(&FAsset::Profiles);
+	PartialQuery->OnMember(&FAsset::Metadata)
+		->AddField(&FAssetMetadata::Attributes)
+		->AddField(&FAssetMetadata::RawAttributes);
+	PartialQuery->OnMember(&FAsset::Links)
+		->OnUnion<FNFTAssetLink>()
+			->OnArray(&FNFTAssetLink::ChildLinks)
+				->AddField(&FLink::Path);
+
+	const uint64 PartialHitsBefore = Cache.GetStats().PartialHits;
+	TSharedPtr<const IQueryNode> KnownSelection;
+	TestFalse(TEXT("A partly known asset should not be a hit"), Cache.Find(Key, *PartialQuery, Asset, &KnownSelection));
+	TestEqual(TEXT("A partly known asset should count as a partial hit"), Cache.GetStats().PartialHits, PartialHitsBefore + 1);
+	if (!TestTrue(TEXT("A partial hit should return the known selection"), KnownSelection.IsValid()))
+	{
+		Cache.Clear();
+		Settings->bEnableAssetCache = bOriginalEnableAssetCache;
+		return false;
+	}
+	TestTrue(TEXT("Identity fields should always be known"), KnownSelection->GetChildren().Contains(TEXT("collectionId")));
+
+	const TSharedPtr<IQueryNode> Missing = PartialQuery->GetMissingSelection(*KnownSelection);
+	if (TestTrue(TEXT("Unknown fields should be planned"), Missing.IsValid()))
+	{
+		const TMap<FString, TSharedPtr<IQueryNode>>& MissingFields = Missing->GetChildren();
+		TestFalse(TEXT("Known profiles should not be requested again"), MissingFields.Contains(TEXT("profiles")));
+		TestTrue(TEXT("Unknown links should be requested"), MissingFields.Contains(TEXT("links")));
+		TestTrue(TEXT("Partly known metadata should be requested"), MissingFields.Contains(TEXT("metadata")));
+		if (const TSharedPtr<IQueryNode> MissingMetadata = MissingFields.FindRef(TEXT("metadata")))
+		{
+			// so the fetched metadata can replace the cached one whole
+			TestTrue(TEXT("Partly known metadata should be requested with its known fields"),
+				MissingMetadata->GetChildren().Contains(TEXT("attributes")) && MissingMetadata->GetChildren().Contains(TEXT("rawAttributes")));
+		}
+
+		// the planned fields answer the rest once merged into the entry
+		FAsset Fetched = FixtureAsset;
+		AssetFixtures::AddChildLinks(Fetched, 2);
+		Cache.Add(Fetched, *Missing);
+		TestTrue(TEXT("Merged entry should answer the whole query"), Cache.Find(Key, *PartialQuery, Asset));
+		const UNFTAssetLinkObject* Links = Cast<UNFTAssetLinkObject>(Asset.LinkWrapper.Links);
+		TestTrue(TEXT("Merged entry should hold the fetched links"), Links && Links->Data.ChildLinks.Num() == 2);
+		TestEqual(TEXT("Merged entry should keep the earlier profiles"), Asset.Profiles.Num(), 1);
+	}
+
+	TestFalse(TEXT("A fully known selection should plan nothing"), KnownQuery->GetMissingSelection(*KnownSelection).IsValid());
+
+	// the known selection is untyped, a typed query it is merged into should still take typed fields below it
+	const auto MergedQuery = MakeShared<FQueryNode<FAsset>>(TEXT("asset"));
+	MergedQuery->MergeSelection(*KnownSelection);
+	MergedQuery->OnMember(&FAsset::Metadata)->AddField(&FAssetMetadata::Uri);
+	const TSharedPtr<IQueryNode> MergedMetadata = MergedQuery->GetChildren().FindRef(TEXT("metadata"));
+	TestTrue(TEXT("An untyped child should be rebuilt typed before it is extended"), MergedMetadata.IsValid() && MergedMetadata->IsTyped());
+	TestTrue(TEXT("A rebuilt child should keep its fields"), MergedMetadata.IsValid()
+		&& MergedMetadata->GetChildren().Contains(TEXT("attributes")) && MergedMetadata->GetChildren().Contains(TEXT("uri")));
+	const TSharedPtr<IQueryNode> ClonedLinks = PartialQuery->CloneNode()->GetChildren().FindRef(TEXT("links"));
+	TestTrue(TEXT("A clone of a typed selection should stay typed"), ClonedLinks.IsValid() && ClonedLinks->IsTyped());
+
+	// the entry expires with its oldest field: refetching every field pushes the expiry out, refetching some doesn't
+	constexpr double ExpiresIn = 0.05;
+	const double AlmostExpired = Settings->AssetCacheTimeToLive - ExpiresIn;
+	Cache.Clear();
+	Cache.Add(FixtureAsset, *PageSelection, AlmostExpired);
+	Cache.Add(FixtureAsset, *PageSelection);
+	FPlatformProcess::Sleep(ExpiresIn * 2);
+	TestTrue(TEXT("A refetched entry should outlive its first expiry"), Cache.Find(Key, *PageSelection, Asset));
+
+	Cache.Clear();
+	Cache.Add(FixtureAsset, *PageSelection, AlmostExpired);
+	Cache.Add(FixtureAsset, *OwnershipSelection);
+	FPlatformProcess::Sleep(ExpiresIn * 2);
+	TestFalse(TEXT("Fields cached earlier should expire on their original schedule"), Cache.Find(Key, *OwnershipSelection, Asset));
+
+	Cache.Clear();
+	Settings->bEnableAssetCache = bOriginalEnableAssetCache;
+
+	return true;
+}
@@ -0,0 +1,154 @@
+#include "AssetRegisterFutures.h"
+#include "Async/ParallelFor.h"
+#include "Math/RandomStream.h"
+#include "Misc/AutomationTest.h"
+#include "QueryTestUtil.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FuturesTest,
+								"UBFEmergenceDemo.sdk_unreal_asset_register.Source.AssetRegister.Private.FuturesTest",
+								EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+namespace Futures
+{
+	constexpr int32 NumFutures = 64;
+	constexpr int32 NumIterations = 200;
+	constexpr float TimeoutSeconds = 0.2f;
+
+	struct FPromises
+	{
+		TArray<TPromise<FString>> Promises;
+
+		explicit FPromises(int32 Num)
+		{
+			Promises.SetNum(Num);
+		}
+
+		TArray<TFuture<FString>> GetFutures()
+		{
+			TArray<TFuture<FString>> Futures;
+			for (TPromise<FString>& Promise : Promises)
+			{
+				Futures.Add(Promise.GetFuture());
+			}
+			return Futures;
+		}
+
+		/** Completes every promise from the task graph, in a shuffled order. */
+		void CompleteInParallel(int32 Seed)
+		{
+			TArray<int32> Order;
+			for (int32 Index = 0; Index < Promises.Num(); ++Index)
+			{
+				Order.Add(Index);
+			}
+			const FRandomStream Random(Seed);
+			for (int32 Index = Order.Num() - 1; Index > 0; --Index)
+			{
+				Order.Swap(Index, Random.RandRange(0, Index));
+			}
+
+			ParallelFor(Order.Num(), [this, &Order](int32 OrderIndex)
+			{
+				Promises[Order[OrderIndex]].SetValue(FString::FromInt(Order[OrderIndex]));
+			});
+		}
+	};
+}
+
+/**
+ * Combinators should resolve with every result in the order of their futures, whatever thread and order those complete
+ * in, pick exactly one winner when futures race, and resolve on their timeout with whatever completed by then.
+ */
+bool FuturesTest::RunTest(const FString& Parameters)
+{
+	using namespace Futures;
+
+	for (int32 Iteration = 0; Iteration < NumIterations; ++Iteration)
+	{
+		FPromises Promises(NumFutures);
+		TFuture<TArray<FString>> AllFuture = AssetRegisterFutures::WhenAll(Promises.GetFutures());
+		Promises.CompleteInParallel(Iteration);
+
+		const TArray<FString>& Results = AllFuture.Get();
+		bool bInOrder = Results.Num() == NumFutures;
+		for (int32 Index = 0; bInOrder && Index < Results.Num(); ++Index)
+		{
+			bInOrder = Results[Index] == FString::FromInt(Index);
+		}
+		if (!TestTrue(FString::Printf(TEXT("WhenAll should keep the order of its futures (iteration %d)"), Iteration), bInOrder))
+		{
+			break;
+		}
+	}
+
+	for (int32 Iteration = 0; Iteration < NumIterations; ++Iteration)
+	{
+		FPromises Promises(NumFutures);
+		TFuture<TPair<int32, FString>> AnyFuture = AssetRegisterFutures::WhenAny(Promises.GetFutures());
+		Promises.CompleteInParallel(Iteration);
+
+		const TPair<int32, FString>& Winner = AnyFuture.Get();
+		if (!TestEqual(TEXT("WhenAny should resolve with the result of the future it names"), Winner.Value, FString::FromInt(Winner.Key)))
+		{
+			break;
+		}
+	}
+
+	TestTrue(TEXT("WhenAll of nothing should resolve at once"), AssetRegisterFutures::WhenAll(TArray<TFuture<FString>>()).IsReady());
+	TestEqual(TEXT("WhenAny of nothing should name no future"), AssetRegisterFutures::WhenAny(TArray<TFuture<FString>>()).Get().Key, INDEX_NONE);
+	const TFuture<TOptional<TPair<int32, FString>>> EmptyTimedAny = AssetRegisterFutures::WhenAny(TArray<TFuture<FString>>(), 5.f);
+	TestTrue(TEXT("WhenAny of nothing should not wait for its timeout"), EmptyTimedAny.IsReady() && !EmptyTimedAny.Get().IsSet());
+
+	{
+		FPromises Promises(3);
+		TFuture<TOptional<TArray<FString>>> AllFuture = AssetRegisterFutures::WhenAll(Promises.GetFutures(), TimeoutSeconds);
+		Promises.CompleteInParallel(0);
+		TestTrue(TEXT("WhenAll should resolve before its timeout if every future completed"), AllFuture.IsReady() && AllFuture.Get().IsSet());
+	}
+
+	// the slow futures complete after the timeout, which the combinators should ignore
+	TSharedRef<FPromises> SlowPromises = MakeShared<FPromises>(9);
+	TArray<TFuture<FString>> SlowFutures = SlowPromises->GetFutures();
+	TArray<TFuture<FString>> AllFutures, SettledFutures, AnyFutures;
+	for (int32 Index = 0; Index < 3; ++Index)
+	{
+		AllFutures.Add(MoveTemp(SlowFutures[Index]));
+		SettledFutures.Add(MoveTemp(SlowFutures[3 + Index]));
+		AnyFutures.Add(MoveTemp(SlowFutures[6 + Index]));
+	}
+	SlowPromises->Promises[0].SetValue(TEXT("0"));
+	SlowPromises->Promises[4].SetValue(TEXT("4"));
+
+	TSharedRef<TFuture<TOptional<TArray<FString>>>> AllFuture = MakeShared<TFuture<TOptional<TArray<FString>>>>(
+		AssetRegisterFutures::WhenAll(MoveTemp(AllFutures), TimeoutSeconds));
+	TSharedRef<TFuture<TArray<TOptional<FString>>>> SettledFuture = MakeShared<TFuture<TArray<TOptional<FString>>>>(
+		AssetRegisterFutures::WhenAllSettled(MoveTemp(SettledFutures), TimeoutSeconds));
+	TSharedRef<TFuture<TOptional<TPair<int32, FString>>>> AnyFuture = MakeShared<TFuture<TOptional<TPair<int32, FString>>>>(
+		AssetRegisterFutures::WhenAny(MoveTemp(AnyFutures), TimeoutSeconds));
+	TestFalse(TEXT("Timeout variants should wait for their timeout"), AllFuture->IsReady() || SettledFuture->IsReady() || AnyFuture->IsReady());
+
+	QueryTestUtil::WaitUntil(this, [AllFuture, SettledFuture, AnyFuture]()
+	{
+		return AllFuture->IsReady() && SettledFuture->IsReady() && AnyFuture->IsReady();
+	});
+	QueryTestUtil::Then([this, SlowPromises, AllFuture, SettledFuture, AnyFuture]()
+	{
+		for (int32 Index = 0; Index < SlowPromises->Promises.Num(); ++Index)
+		{
+			if (Index != 0 && Index != 4)
+			{
+				SlowPromises->Promises[Index].SetValue(FString::FromInt(Index));
+			}
+		}
+
+		TestFalse(TEXT("WhenAll should time out if a future didn't complete"), AllFuture->Get().IsSet());
+		TestFalse(TEXT("WhenAny should time out if no future completed"), AnyFuture->Get().IsSet());
+
+		const TArray<TOptional<FString>>& Settled = SettledFuture->Get();
+		TestEqual(TEXT("WhenAllSettled should have a slot per future"), Settled.Num(), 3);
+		TestTrue(TEXT("WhenAllSettled should keep the futures that completed in time"), Settled.Num() == 3 && Settled[1].IsSet() && *Settled[1] == TEXT("4"));
+		TestTrue(TEXT("WhenAllSettled should leave the others unset"), Settled.Num() == 3 && !Settled[0].IsSet() && !Settled[2].IsSet());
+	});
+
+	return true;
+}
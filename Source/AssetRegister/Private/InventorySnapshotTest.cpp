@@ -0,0 +1,211 @@
+#include "AssetRegisterInventorySnapshot.h"
+#include "AssetRegisterMockServer.h"
+#include "AssetRegisterSettings.h"
+#include "QueryStringUtil.h"
+#include "QueryTestUtil.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(InventorySnapshotTest,
+								"UBFEmergenceDemo.sdk_unreal_asset_register.Source.AssetRegister.Private.InventorySnapshotTest",
+								EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+namespace InventorySnapshot
+{
+	/** Recorded pages of an inventory of three assets. */
+	const auto BeforePage0Json = TEXT(R"({
+	  "data": {
+	    "assets": {
+	      "edges": [
+	        { "cursor": "cursor-0", "node": { "tokenId": "1", "collectionId": "7668:root:1124",
+	          "metadata": { "properties": { "name": "Sword \"of\" {Dawn}" }, "attributes": { "rarity": "common" } } } },
+	        { "cursor": "cursor-1", "node": { "tokenId": "2", "collectionId": "7668:root:1124",
+	          "metadata": { "properties": { "name": "Shield" }, "attributes": { "rarity": "common" } } } }
+	      ],
+	      "pageInfo": { "endCursor": "cursor-1", "hasNextPage": true },
+	      "total": 3
+	    }
+	  }
+	})");
+
+	const auto BeforePage1Json = TEXT(R"({
+	  "data": {
+	    "assets": {
+	      "edges": [
+	        { "cursor": "cursor-2", "node": { "tokenId": "3", "collectionId": "7668:root:1124",
+	          "metadata": { "properties": { "name": "Helmet" }, "attributes": { "rarity": "rare" } } } }
+	      ],
+	      "pageInfo": { "endCursor": "cursor-2", "hasNextPage": false },
+	      "total": 3
+	    }
+	  }
+	})");
+
+	/** The first page with the shield's node cut short. */
+	const auto BrokenPage0Json = TEXT(R"({
+	  "data": {
+	    "assets": {
+	      "edges": [
+	        { "cursor": "cursor-0", "node": { "tokenId": "1", "collectionId": "7668:root:1124",
+	          "metadata": { "properties": { "name": "Sword \"of\" {Dawn}" }, "attributes": { "rarity": "common" } } } },
+	        { "cursor": "cursor-1", "node": "truncated" }
+	      ],
+	      "pageInfo": { "endCursor": "cursor-1", "hasNextPage": true },
+	      "total": 3
+	    }
+	  }
+	})");
+
+	/** The same inventory after the shield was upgraded, the helmet traded away and a ring received. */
+	const auto AfterJson = TEXT(R"({
+	  "data": {
+	    "assets": {
+	      "edges": [
+	        { "cursor": "cursor-0", "node": { "tokenId": "1", "collectionId": "7668:root:1124",
+	          "metadata": { "properties": { "name": "Sword \"of\" {Dawn}" }, "attributes": { "rarity": "common" } } } },
+	        { "cursor": "cursor-1", "node": { "tokenId": "2", "collectionId": "7668:root:1124",
+	          "metadata": { "properties": { "name": "Shield" }, "attributes": { "rarity": "epic" } } } },
+	        { "cursor": "cursor-3", "node": { "tokenId": "4", "collectionId": "7668:root:1124",
+	          "metadata": { "properties": { "name": "Ring" }, "attributes": { "rarity": "rare" } } } }
+	      ],
+	      "pageInfo": { "endCursor": "cursor-3", "hasNextPage": false },
+	      "total": 3
+	    }
+	  }
+	})");
+
+	/** A page whose node metadata has a pageInfo of its own before the page's. */
+	const auto MetadataPageInfoJson = TEXT(R"({
+	  "data": {
+	    "assets": {
+	      "edges": [
+	        { "cursor": "cursor-0", "node": { "tokenId": "1", "collectionId": "7668:root:1124",
+	          "metadata": { "properties": { "pageInfo": { "endCursor": "metadata", "hasNextPage": true } } } } }
+	      ],
+	      "pageInfo": { "endCursor": "cursor-0", "hasNextPage": false },
+	      "total": 1
+	    }
+	  }
+	})");
+
+	TArray<uint8> ToUtf8(const TCHAR* Json)
+	{
+		const FTCHARToUTF8 Converted(Json);
+		return TArray<uint8>(reinterpret_cast<const uint8*>(Converted.Get()), Converted.Length());
+	}
+
+	TArray<FString> GetTokenIds(const TArray<FAsset>& Assets)
+	{
+		TArray<FString> TokenIds;
+		for (const FAsset& Asset : Assets)
+		{
+			TokenIds.Add(Asset.TokenId);
+		}
+		return TokenIds;
+	}
+}
+
+/**
+ * Refreshing a snapshot with recorded before and after pages should report only the added, changed and removed
+ * assets, and reuse the asset decoded earlier for a node whose bytes didn't change.
+ */
+bool InventorySnapshotTest::RunTest(const FString& Parameters)
+{
+	using namespace InventorySnapshot;
+
+	TSharedRef<FAssetRegisterMockServer> Server = MakeShared<FAssetRegisterMockServer>();
+	if (!Server->Start())
+	{
+		AddError(TEXT("Failed to start mock server"));
+		return false;
+	}
+	Server->SetResponse(AfterJson);
+
+	UAssetRegisterSettings* Settings = GetMutableDefault<UAssetRegisterSettings>();
+	const FString OriginalURL = Settings->AssetRegisterURL;
+	Settings->AssetRegisterURL = Server->GetURL();
+
+	FAssetConnection AssetsInput;
+	AssetsInput.Addresses = {TEXT("0xffffffff00000000000000000000000000000f59")};
+	const TSharedRef<FAssetRegisterInventorySnapshot> Snapshot = FAssetRegisterInventorySnapshot::Create(AssetsInput);
+
+	TSharedRef<TArray<FAssetRegisterInventoryDiff>> Events = MakeShared<TArray<FAssetRegisterInventoryDiff>>();
+	Snapshot->OnChanged.AddLambda([Events](const FAssetRegisterInventoryDiff& Diff)
+	{
+		Events->Add(Diff);
+	});
+
+	const FLoadInventoryDiffResult First = Snapshot->ApplyResponses({ToUtf8(BeforePage0Json), ToUtf8(BeforePage1Json)});
+	TestTrue(TEXT("The recorded pages should be applied"), First.bSuccess);
+	TestEqual(TEXT("A first refresh should add every asset"), GetTokenIds(First.Value.Added), TArray<FString>{TEXT("1"), TEXT("2"), TEXT("3")});
+	const FAssets FirstAssets = Snapshot->GetAssets();
+	if (!TestEqual(TEXT("The snapshot should hold every page"), FirstAssets.Edges.Num(), 3))
+	{
+		Server->Stop();
+		Settings->AssetRegisterURL = OriginalURL;
+		return false;
+	}
+	TestEqual(TEXT("Escaped quotes and braces should stay in the node"), FirstAssets.Edges[0].Node.Metadata.Properties.JsonObject->GetStringField(TEXT("name")),
+		FString(TEXT("Sword \"of\" {Dawn}")));
+	const TSharedPtr<FJsonObject> SwordJson = FirstAssets.Edges[0].Node.OriginalJsonData.JsonObject;
+
+	FString EndCursor;
+	bool bHasNextPage = true;
+	TestTrue(TEXT("The page info should be found"), QueryStringUtil::TryFindPageInfoUtf8(ToUtf8(MetadataPageInfoJson), EndCursor, bHasNextPage));
+	TestEqual(TEXT("A pageInfo in node metadata should not be taken for the page's"), EndCursor, FString(TEXT("cursor-0")));
+	TestFalse(TEXT("The page's hasNextPage should be read"), bHasNextPage);
+
+	const FLoadInventoryDiffResult Same = Snapshot->ApplyResponses({ToUtf8(BeforePage0Json), ToUtf8(BeforePage1Json)});
+	TestEqual(TEXT("Unchanged pages should reuse every asset"), Same.Value.NumUnchanged, 3);
+	TestTrue(TEXT("Unchanged pages should not be a change"), Same.Value.IsEmpty());
+	TestEqual(TEXT("Only refreshes with changes should be broadcast"), Events->Num(), 1);
+
+	AddExpectedError(TEXT("failed to decode the node"), EAutomationExpectedErrorFlags::Contains, 1);
+	AddExpectedError(TEXT("node isn't a json object"), EAutomationExpectedErrorFlags::Contains, 1);
+	const FLoadInventoryDiffResult Broken = Snapshot->ApplyResponses({ToUtf8(BrokenPage0Json), ToUtf8(BeforePage1Json)});
+	TestFalse(TEXT("A node that can't be decoded should fail the refresh"), Broken.bSuccess);
+	TestEqual(TEXT("A failed refresh should keep the snapshot"), Snapshot->GetNumAssets(), 3);
+	TestEqual(TEXT("A failed refresh should not be broadcast"), Events->Num(), 1);
+
+	TSharedRef<TArray<FLoadInventoryDiffResult>> Results = MakeShared<TArray<FLoadInventoryDiffResult>>();
+	Snapshot->Refresh().Next([Results](const FLoadInventoryDiffResult& Result)
+	{
+		Results->Add(Result);
+	});
+	TestTrue(TEXT("A refresh should be pending until its pages are loaded"), Snapshot->IsPending());
+	TestFalse(TEXT("Responses should not be applied during a refresh"), Snapshot->ApplyResponses({ToUtf8(AfterJson)}).bSuccess);
+	QueryTestUtil::WaitUntil(this, [Results]() { return Results->Num() == 1; });
+
+	QueryTestUtil::Then([this, Server, Settings, Snapshot, Events, Results, SwordJson, OriginalURL]()
+	{
+		if (TestEqual(TEXT("The refresh should complete"), Results->Num(), 1))
+		{
+			const FLoadInventoryDiffResult& Result = (*Results)[0];
+			TestTrue(TEXT("The refresh should succeed"), Result.bSuccess);
+			TestEqual(TEXT("The new asset should be added"), GetTokenIds(Result.Value.Added), TArray<FString>{TEXT("4")});
+			TestEqual(TEXT("The upgraded asset should be changed"), GetTokenIds(Result.Value.Changed), TArray<FString>{TEXT("2")});
+			TestEqual(TEXT("The traded asset should be removed"), Result.Value.Removed,
+				TArray<FAssetRegisterAssetKey>{FAssetRegisterAssetKey(TEXT("7668:root:1124"), TEXT("3"))});
+			TestEqual(TEXT("The untouched asset should be unchanged"), Result.Value.NumUnchanged, 1);
+		}
+
+		const FAssets Assets = Snapshot->GetAssets();
+		if (TestEqual(TEXT("The snapshot should hold the refreshed inventory"), Assets.Edges.Num(), 3))
+		{
+			TestTrue(TEXT("The untouched asset should not be decoded again"), Assets.Edges[0].Node.OriginalJsonData.JsonObject == SwordJson);
+			TestEqual(TEXT("The changed asset should be decoded again"),
+				Assets.Edges[1].Node.OriginalJsonData.JsonObject->GetObjectField(TEXT("metadata"))->GetObjectField(TEXT("attributes"))->GetStringField(TEXT("rarity")),
+				FString(TEXT("epic")));
+		}
+		TestEqual(TEXT("The refresh should be broadcast"), Events->Num(), 2);
+		TestFalse(TEXT("The refresh should have completed"), Snapshot->IsPending());
+
+		Server->Stop();
+		Settings->AssetRegisterURL = OriginalURL;
+	});
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,165 @@
+#include "AssetRegisterAssetCache.h"
+#include "AssetRegisterLinkResolver.h"
+#include "AssetRegisterMockServer.h"
+#include "AssetRegisterNegativeCache.h"
+#include "AssetRegisterSettings.h"
+#include "QueryTestUtil.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(LinkResolverTest,
+								"UBFEmergenceDemo.sdk_unreal_asset_register.Source.AssetRegister.Private.LinkResolverTest",
+								EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+namespace LinkResolver
+{
+	const FString CollectionId = TEXT("7668:root:1124");
+	const FAssetRegisterAssetKey Body(CollectionId, TEXT("1"));
+	const FAssetRegisterAssetKey Head(CollectionId, TEXT("2"));
+	const FAssetRegisterAssetKey Torso(CollectionId, TEXT("3"));
+	const FAssetRegisterAssetKey Badge(CollectionId, TEXT("4"));
+
+	/**
+	 * The stand-in answers every batch with the same body, so the first asset of a level always links to the head and
+	 * the torso, and the second one to the badge. The body links to the head and torso, the head to itself and the
+	 * torso, the torso to the badge, and the badge back to the head and torso.
+	 */
+	const auto BatchResponseJson = TEXT(R"({
+	  "data": {
+	    "asset0": { "links": { "childLinks": [
+	      { "path": "head", "asset": { "collectionId": "7668:root:1124", "tokenId": "2" } },
+	      { "path": "torso", "asset": { "collectionId": "7668:root:1124", "tokenId": "3" } }
+	    ] } },
+	    "asset1": { "links": { "childLinks": [
+	      { "path": "badge", "asset": { "collectionId": "7668:root:1124", "tokenId": "4" } }
+	    ] } }
+	  }
+	})");
+
+	void ForgetAssets()
+	{
+		for (const FAssetRegisterAssetKey& Key : {Body, Head, Torso, Badge})
+		{
+			FAssetRegisterAssetCache::Get().Remove(Key);
+			FAssetRegisterNegativeCache::Get().Remove(Key);
+		}
+	}
+}
+
+/**
+ * Resolving a link graph should send one batched request per level, hold every asset once even when it is linked to
+ * again or closes a cycle, stop loading links at the depth limit, and be answered from the asset cache next time.
+ */
+bool LinkResolverTest::RunTest(const FString& Parameters)
+{
+	using namespace LinkResolver;
+
+	TSharedRef<FAssetRegisterMockServer> Server = MakeShared<FAssetRegisterMockServer>();
+	if (!Server->Start())
+	{
+		AddError(TEXT("Failed to start mock server"));
+		return false;
+	}
+	Server->SetResponse(BatchResponseJson);
+
+	UAssetRegisterSettings* Settings = GetMutableDefault<UAssetRegisterSettings>();
+	const FString OriginalURL = Settings->AssetRegisterURL;
+	const bool bOriginalEnableAssetCache = Settings->bEnableAssetCache;
+	const bool bOriginalEnableDiskCache = Settings->bEnableDiskCache;
+	Settings->AssetRegisterURL = Server->GetURL();
+	Settings->bEnableAssetCache = true;
+	Settings->bEnableDiskCache = false;
+	ForgetAssets();
+
+	TSharedRef<TArray<FLoadLinkGraphResult>> Results = MakeShared<TArray<FLoadLinkGraphResult>>();
+	FAssetRegisterLinkResolver::Resolve(Body, 1).Next([Results](const FLoadLinkGraphResult& Result)
+	{
+		Results->Add(Result);
+	});
+	QueryTestUtil::WaitUntil(this, [Results]() { return Results->Num() == 1; });
+
+	QueryTestUtil::Then([this, Server, Results]()
+	{
+		TestEqual(TEXT("A single level should take a single request"), Server->GetNumRequests(), 1);
+		if (TestEqual(TEXT("The depth limited graph should complete"), Results->Num(), 1))
+		{
+			const FLoadLinkGraphResult& Result = (*Results)[0];
+			TestTrue(TEXT("A depth limited graph should resolve"), Result.bSuccess && !Result.bPartial);
+			TestEqual(TEXT("The root's children should be added"), Result.Value.Nodes.Num(), 3);
+			const FAssetRegisterLinkNode* HeadNode = Result.Value.Find(Head);
+			TestTrue(TEXT("Children at the depth limit should not be resolved"), HeadNode && !HeadNode->bResolved && HeadNode->Depth == 1);
+		}
+
+		ForgetAssets();
+		FAssetRegisterLinkResolver::Resolve(Body, 5).Next([Results](const FLoadLinkGraphResult& Result)
+		{
+			Results->Add(Result);
+		});
+	});
+	QueryTestUtil::WaitUntil(this, [Results]() { return Results->Num() == 2; });
+
+	QueryTestUtil::Then([this, Server, Results]()
+	{
+		TestEqual(TEXT("Each level should take one request"), Server->GetNumRequests() - 1, 3);
+		if (TestEqual(TEXT("The graph should complete"), Results->Num(), 2))
+		{
+			const FLoadLinkGraphResult& Result = (*Results)[1];
+			const FAssetRegisterLinkGraph& Graph = Result.Value;
+			TestTrue(TEXT("The graph should resolve"), Result.bSuccess && !Result.bPartial);
+			TestEqual(TEXT("Each level should be counted"), Graph.NumLevels, 3);
+			TestEqual(TEXT("Every asset should be held once"), Graph.Nodes.Num(), 4);
+
+			const FAssetRegisterLinkNode* HeadNode = Graph.Find(Head);
+			const FAssetRegisterLinkNode* TorsoNode = Graph.Find(Torso);
+			const FAssetRegisterLinkNode* BadgeNode = Graph.Find(Badge);
+			if (HeadNode && TorsoNode && BadgeNode)
+			{
+				TestEqual(TEXT("The root should come first"), Graph.Nodes[0].Key, Body);
+				TestEqual(TEXT("Depth should follow the shortest path"), BadgeNode->Depth, 2);
+				TestTrue(TEXT("Every asset should be resolved"), HeadNode->bResolved && TorsoNode->bResolved && BadgeNode->bResolved);
+				if (TestEqual(TEXT("The head should link to itself and the torso"), HeadNode->Children.Num(), 2))
+				{
+					TestEqual(TEXT("A link back to a node should reuse it"), HeadNode->Children[0].Child, Graph.NodeIndices[Head]);
+				}
+				if (TestEqual(TEXT("The badge should link to the head and the torso"), BadgeNode->Children.Num(), 2))
+				{
+					TestEqual(TEXT("A cycle should be linked, not resolved again"), BadgeNode->Children[1].Child, Graph.NodeIndices[Torso]);
+				}
+				if (TestEqual(TEXT("The torso should link to the badge"), TorsoNode->Children.Num(), 1))
+				{
+					TestEqual(TEXT("Links should keep their path"), TorsoNode->Children[0].Path, FString(TEXT("badge")));
+				}
+			}
+			else
+			{
+				AddError(TEXT("Every linked asset should be in the graph"));
+			}
+		}
+
+		FAssetRegisterLinkResolver::Resolve(Body, 5).Next([Results](const FLoadLinkGraphResult& Result)
+		{
+			Results->Add(Result);
+		});
+	});
+	QueryTestUtil::WaitUntil(this, [Results]() { return Results->Num() == 3; });
+
+	QueryTestUtil::Then([this, Server, Settings, Results, OriginalURL, bOriginalEnableAssetCache, bOriginalEnableDiskCache]()
+	{
+		TestEqual(TEXT("Cached links should be resolved again without requests"), Server->GetNumRequests(), 4);
+		if (TestEqual(TEXT("The cached graph should complete"), Results->Num(), 3))
+		{
+			TestEqual(TEXT("The cached graph should be the same"), (*Results)[2].Value.Nodes.Num(), 4);
+		}
+
+		ForgetAssets();
+		Server->Stop();
+		Settings->AssetRegisterURL = OriginalURL;
+		Settings->bEnableAssetCache = bOriginalEnableAssetCache;
+		Settings->bEnableDiskCache = bOriginalEnableDiskCache;
+	});
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,151 @@
+#include "AssetFixtures.h"
+#include "AssetRegisterLinkStore.h"
+#include "AssetRegisterLog.h"
+#include "AssetRegisterSettings.h"
+#include "Misc/AutomationTest.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(LinkStoreTest,
+								"UBFEmergenceDemo.sdk_unreal_asset_register.Source.AssetRegister.Private.LinkStoreTest",
+								EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+namespace LinkStore
+{
+	constexpr int32 NumCharacters = 1000;
+	constexpr int32 NumAccessories = 4;
+
+	FAssetRegisterAssetKey MakeKey(int32 TokenId)
+	{
+		return FAssetRegisterAssetKey(AssetFixtures::CollectionId, FString::FromInt(TokenId));
+	}
+
+	FAsset MakeLinkedAsset(int32 TokenId, int32 NumChildren)
+	{
+		FAsset Asset = AssetFixtures::MakeAsset(TokenId);
+		AssetFixtures::AddChildLinks(Asset, NumChildren);
+		return Asset;
+	}
+
+	/** An asset with no children whose parentLink is ParentTokenId, or empty for INDEX_NONE. */
+	FAsset MakeChildAsset(int32 TokenId, int32 ParentTokenId)
+	{
+		FAsset Asset = MakeLinkedAsset(TokenId, 0);
+		if (ParentTokenId != INDEX_NONE)
+		{
+			UNFTAssetLinkObject* Links = Cast<UNFTAssetLinkObject>(Asset.LinkWrapper.Links);
+			Links->Data.ParentLink.CollectionId = AssetFixtures::CollectionId;
+			Links->Data.ParentLink.TokenId = FString::FromInt(ParentTokenId);
+		}
+		return Asset;
+	}
+
+	/** A selection of links { ... on NFTAssetLink { parentLink } }. */
+	TSharedRef<IQueryNode> MakeParentLinkSelection()
+	{
+		const TSharedRef<IQueryNode> LinkUnion = MakeShared<IQueryNode>(TEXT("NFTAssetLink"), true);
+		LinkUnion->AddChild(MakeShared<IQueryNode>(TEXT("parentLink")));
+		const TSharedRef<IQueryNode> Links = MakeShared<IQueryNode>(TEXT("links"));
+		Links->AddChild(LinkUnion);
+		const TSharedRef<IQueryNode> Selection = MakeShared<IQueryNode>(TEXT("asset"));
+		Selection->AddChild(Links);
+		return Selection;
+	}
+
+	TArray<FString> GetTokenIds(const TArray<FAssetRegisterAssetKey>& Keys)
+	{
+		TArray<FString> TokenIds;
+		for (const FAssetRegisterAssetKey& Key : Keys)
+		{
+			TokenIds.Add(Key.TokenId);
+		}
+		return TokenIds;
+	}
+}
+
+/**
+ * Decoded links should be walkable from parent to child and back without a request, each asset once even through
+ * a cycle, and should be dropped when an asset is decoded with other links or another owner.
+ */
+bool LinkStoreTest::RunTest(const FString& Parameters)
+{
+	using namespace LinkStore;
+
+	UAssetRegisterSettings* Settings = GetMutableDefault<UAssetRegisterSettings>();
+	const bool bOriginalEnableLinkStore = Settings->bEnableLinkStore;
+	Settings->bEnableLinkStore = true;
+
+	FAssetRegisterLinkStore& Store = FAssetRegisterLinkStore::Get();
+	Store.Clear();
+
+	// 1 links to 2 and 3, 2 links to 3 and 4
+	Store.AddAsset(MakeLinkedAsset(1, 2));
+	Store.AddAsset(MakeLinkedAsset(2, 2));
+
+	TestEqual(TEXT("A shared child should know both parents"), GetTokenIds(Store.GetParents(MakeKey(3))), TArray<FString>{TEXT("1"), TEXT("2")});
+	TestEqual(TEXT("Children should keep their path"), Store.GetChildren(MakeKey(1))[1].Path, FString(TEXT("equipped_2")));
+	TestEqual(TEXT("The subtree should be breadth first"), GetTokenIds(Store.GetSubtree(MakeKey(1))), TArray<FString>{TEXT("2"), TEXT("3"), TEXT("4")});
+	TestEqual(TEXT("The subtree should stop at MaxDepth"), GetTokenIds(Store.GetSubtree(MakeKey(1), 1)), TArray<FString>{TEXT("2"), TEXT("3")});
+	TestEqual(TEXT("The root should be found through any parent"), GetTokenIds(Store.GetRoots(MakeKey(4))), TArray<FString>{TEXT("1")});
+	TestTrue(TEXT("Decoded links should be known"), Store.HasChildLinks(MakeKey(2)));
+	TestFalse(TEXT("Children without decoded links should not be known"), Store.HasChildLinks(MakeKey(4)));
+
+	FLink CycleLink;
+	CycleLink.Path = TEXT("equipped_1");
+	CycleLink.Asset.CollectionId = AssetFixtures::CollectionId;
+	CycleLink.Asset.TokenId = TEXT("1");
+	Store.SetChildLinks(MakeKey(4), {CycleLink});
+	TestEqual(TEXT("A cycle should be walked once"), Store.GetSubtree(MakeKey(1)).Num(), 3);
+	TestTrue(TEXT("A cycle should have no roots"), Store.GetRoots(MakeKey(4)).IsEmpty());
+	Store.Invalidate(MakeKey(4));
+	TestTrue(TEXT("Invalidating should drop the links to an asset"), Store.GetParents(MakeKey(4)).IsEmpty());
+
+	// 2 comes back without children
+	Store.AddAsset(MakeLinkedAsset(2, 0));
+	TestEqual(TEXT("Replaced links should be dropped from the children"), GetTokenIds(Store.GetParents(MakeKey(3))), TArray<FString>{TEXT("1")});
+
+	Store.AddAsset(AssetFixtures::MakeAsset(3));
+	FAsset Traded = AssetFixtures::MakeAsset(3);
+	Cast<UNFTAssetOwnershipObject>(Traded.OwnershipWrapper.Ownership)->Data.Owner.Address = TEXT("0xffffffff0000000000000000000000000000beef");
+	Store.AddAsset(Traded);
+	TestTrue(TEXT("A traded asset should no longer be linked"), Store.GetParents(MakeKey(3)).IsEmpty());
+	TestEqual(TEXT("The parent of a traded asset should lose it"), Store.GetChildren(MakeKey(1)).Num(), 1);
+	TestEqual(TEXT("Owner changes should be counted"), Store.GetStats().NumOwnerChanges, uint64(1));
+
+	// 100 is moved from 101 to 102, then unequipped
+	const TSharedRef<IQueryNode> ParentLinkSelection = MakeParentLinkSelection();
+	Store.AddAsset(MakeChildAsset(100, 101), &ParentLinkSelection.Get());
+	Store.AddAsset(MakeChildAsset(100, 102), &ParentLinkSelection.Get());
+	TestEqual(TEXT("A selected parentLink should replace the parents"), GetTokenIds(Store.GetParents(MakeKey(100))), TArray<FString>{TEXT("102")});
+	TestTrue(TEXT("The old parent should lose the child"), Store.GetChildren(MakeKey(101)).IsEmpty());
+	Store.AddAsset(MakeChildAsset(100, INDEX_NONE));
+	TestEqual(TEXT("Parents should be kept when parentLink isn't selected"), GetTokenIds(Store.GetParents(MakeKey(100))), TArray<FString>{TEXT("102")});
+	Store.AddAsset(MakeChildAsset(100, INDEX_NONE), &ParentLinkSelection.Get());
+	TestTrue(TEXT("An empty selected parentLink should clear the parents"), Store.GetParents(MakeKey(100)).IsEmpty());
+
+	// every character links to the accessories with the token ids following its own
+	Store.Clear();
+	const int32 Stride = NumAccessories + 1;
+	for (int32 Character = 0; Character < NumCharacters; ++Character)
+	{
+		Store.AddAsset(MakeLinkedAsset(Character * Stride, NumAccessories));
+	}
+	TestEqual(TEXT("Every link should be stored"), Store.GetStats().NumLinks, NumCharacters * NumAccessories);
+
+	int32 NumParents = 0;
+	const double StartTime = FPlatformTime::Seconds();
+	for (int32 Character = 0; Character < NumCharacters; ++Character)
+	{
+		for (int32 Accessory = 1; Accessory <= NumAccessories; ++Accessory)
+		{
+			NumParents += Store.GetParents(MakeKey(Character * Stride + Accessory)).Num();
+		}
+	}
+	const double Seconds = FPlatformTime::Seconds() - StartTime;
+	UE_LOG(LogAssetRegister, Display, TEXT("[LinkStoreTest] %d parent lookups in %.2fms, %.2fus each"),
+		NumCharacters * NumAccessories, Seconds * 1000.0, Seconds * 1000000.0 / (NumCharacters * NumAccessories));
+	TestEqual(TEXT("Every accessory should find its character"), NumParents, NumCharacters * NumAccessories);
+
+	Store.Clear();
+	Settings->bEnableLinkStore = bOriginalEnableLinkStore;
+
+	return true;
+}
@@ -0,0 +1,112 @@
+#include "AssetRegisterMetrics.h"
+#include "AssetRegisterMockServer.h"
+#include "AssetRegisterQueryBuilder.h"
+#include "AssetRegisterQueryingLibrary.h"
+#include "AssetRegisterSettings.h"
+#include "HAL/IConsoleManager.h"
+#include "QueryTestUtil.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(MetricsTest,
+								"UBFEmergenceDemo.sdk_unreal_asset_register.Source.AssetRegister.Private.MetricsTest",
+								EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+namespace Metrics
+{
+	constexpr uint64 NumValues = 100000;
+
+	/** Relative error the histogram guarantees, one sub-bucket. */
+	constexpr double Precision = 1.0 / 128;
+
+	const TCHAR* ResponseJson = TEXT(R"({"data":{"asset":{"tokenId":"10","collectionId":"7668:root:1124"}}})");
+
+	bool IsWithinPrecision(uint64 Actual, uint64 Expected)
+	{
+		return FMath::Abs(static_cast<double>(Actual) - Expected) <= Expected * Precision + 1;
+	}
+}
+
+/**
+ * The histogram should report percentiles within its precision, errors should be classified by status code, and
+ * requests sent through the library should be counted per query type.
+ */
+bool MetricsTest::RunTest(const FString& Parameters)
+{
+	using namespace Metrics;
+
+	FAssetRegisterHistogram Histogram;
+	for (uint64 Value = 1; Value <= NumValues; ++Value)
+	{
+		Histogram.Record(Value);
+	}
+	TestEqual(TEXT("Every value should be counted"), Histogram.GetTotalCount(), NumValues);
+	TestEqual(TEXT("Max should be exact"), Histogram.GetMax(), NumValues);
+	TestTrue(TEXT("p50 should be within precision"), IsWithinPrecision(Histogram.GetValueAtPercentile(50.0), NumValues / 2));
+	TestTrue(TEXT("p99 should be within precision"), IsWithinPrecision(Histogram.GetValueAtPercentile(99.0), NumValues * 99 / 100));
+	TestEqual(TEXT("p100 should be the max"), Histogram.GetValueAtPercentile(100.0), NumValues);
+
+	FAssetRegisterHistogram Outliers;
+	Outliers.Record(FAssetRegisterHistogram::MaxValue * 2);
+	Histogram.Add(Outliers);
+	TestEqual(TEXT("Values past MaxValue should be clamped"), Histogram.GetMax(), FAssetRegisterHistogram::MaxValue);
+
+	TestTrue(TEXT("No response should be a connection error"),
+		FAssetRegisterMetrics::ClassifyResponse(false, 0, false) == EAssetRegisterErrorClass::Connection);
+	TestTrue(TEXT("No response past the deadline should be a timeout"),
+		FAssetRegisterMetrics::ClassifyResponse(false, 0, true) == EAssetRegisterErrorClass::Timeout);
+	TestTrue(TEXT("429 should be rate limited"),
+		FAssetRegisterMetrics::ClassifyResponse(true, 429, false) == EAssetRegisterErrorClass::RateLimited);
+	TestTrue(TEXT("503 should be a server error"),
+		FAssetRegisterMetrics::ClassifyResponse(true, 503, false) == EAssetRegisterErrorClass::ServerError);
+	TestFalse(TEXT("304 should not be an error"), FAssetRegisterMetrics::ClassifyResponse(true, 304, false).IsSet());
+
+	TestNotNull(TEXT("ar.stats should be registered"), IConsoleManager::Get().FindConsoleObject(TEXT("ar.stats")));
+
+	TSharedRef<FAssetRegisterMockServer> Server = MakeShared<FAssetRegisterMockServer>();
+	if (!Server->Start())
+	{
+		AddError(TEXT("Failed to start mock server"));
+		return false;
+	}
+	Server->SetResponse(ResponseJson);
+
+	UAssetRegisterSettings* Settings = GetMutableDefault<UAssetRegisterSettings>();
+	const FString OriginalURL = Settings->AssetRegisterURL;
+	Settings->AssetRegisterURL = Server->GetURL();
+
+	FAssetRegisterMetrics::Get().Reset();
+
+	auto AssetQuery = FAssetRegisterQueryBuilder::AddAssetQuery(FAssetInput(TEXT("10"), TEXT("7668:root:1124")));
+	AssetQuery->AddField(&FAsset::TokenId);
+
+	TSharedRef<bool> bDone = MakeShared<bool>(false);
+	UAssetRegisterQueryingLibrary::MakeAssetQuery(AssetQuery->GetQueryJsonUtf8()).Next([bDone](const FLoadAssetResult&)
+	{
+		*bDone = true;
+	});
+
+	QueryTestUtil::WaitUntil(this, [bDone]() { return *bDone; });
+	QueryTestUtil::Then([this, Server, Settings, OriginalURL]()
+	{
+		const FAssetRegisterMetricsSnapshot Snapshot = FAssetRegisterMetrics::Get().GetSnapshot();
+		TestEqual(TEXT("The request should be counted"), Snapshot.NumRequests, uint64(1));
+		TestEqual(TEXT("A successful request should not be an error"), Snapshot.NumErrors, uint64(0));
+		TestTrue(TEXT("Bytes should be counted both ways"), Snapshot.BytesSent > 0 && Snapshot.BytesReceived > 0);
+
+		const FAssetRegisterQueryMetrics* Query = Snapshot.Queries.Find(TEXT("MakeAssetQuery"));
+		if (TestNotNull(TEXT("The query type should have its own metrics"), Query))
+		{
+			TestEqual(TEXT("The query type's latency should be recorded"), Query->Latency.GetTotalCount(), uint64(1));
+		}
+		TestTrue(TEXT("The report should list the query type"), Snapshot.ToString().Contains(TEXT("MakeAssetQuery")));
+
+		Server->Stop();
+		Settings->AssetRegisterURL = OriginalURL;
+	});
+
+	return true;
+}
+
+#endif
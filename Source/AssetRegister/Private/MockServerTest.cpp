@@ -0,0 +1,132 @@
+#include "AssetFixtures.h"
+#include "AssetRegisterAssetCache.h"
+#include "AssetRegisterMockServer.h"
+#include "AssetRegisterNegativeCache.h"
+#include "AssetRegisterQueryingLibrary.h"
+#include "AssetRegisterSettings.h"
+#include "QueryTestUtil.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(MockServerTest,
+								"UBFEmergenceDemo.sdk_unreal_asset_register.Source.AssetRegister.Private.MockServerTest",
+								EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+namespace MockServer
+{
+	constexpr int32 NumAssets = 25;
+	constexpr int32 PageSize = 10;
+	constexpr int32 NumChildLinks = 2;
+
+	struct FResults
+	{
+		TOptional<FLoadAssetsResult> AllAssets;
+		TOptional<TArray<FLoadAssetResult>> Batched;
+		TOptional<FLoadAssetsResult> Failed;
+	};
+}
+
+/**
+ * Served from a dataset, every page of an inventory should be reachable through the cursors, aliased asset queries
+ * should get their own selection, missing assets should be null, and injected failures should fail the request.
+ */
+bool MockServerTest::RunTest(const FString& Parameters)
+{
+	using namespace MockServer;
+
+	TSharedRef<FAssetRegisterMockServer> Server = MakeShared<FAssetRegisterMockServer>();
+	if (!Server->Start())
+	{
+		AddError(TEXT("Failed to start mock server"));
+		return false;
+	}
+	Server->SetAssets(AssetFixtures::MakeAssetJsons(NumAssets, NumChildLinks));
+
+	UAssetRegisterSettings* Settings = GetMutableDefault<UAssetRegisterSettings>();
+	const FString OriginalURL = Settings->AssetRegisterURL;
+	const bool bOriginalEnableAssetCache = Settings->bEnableAssetCache;
+	const bool bOriginalEnableNegativeCache = Settings->bEnableNegativeCache;
+	Settings->AssetRegisterURL = Server->GetURL();
+	// every lookup should reach the server
+	Settings->bEnableAssetCache = false;
+	Settings->bEnableNegativeCache = false;
+
+	TSharedRef<FResults> Results = MakeShared<FResults>();
+
+	FAssetConnection AssetsInput;
+	AssetsInput.Addresses = {AssetFixtures::OwnerAddress};
+	AssetsInput.CollectionIds = {AssetFixtures::CollectionId};
+	AssetsInput.First = PageSize;
+	UAssetRegisterQueryingLibrary::GetAllAssets(AssetsInput, FAssetRegisterDeadline()).Next([Results](const FLoadAssetsResult& Result)
+	{
+		Results->AllAssets = Result;
+	});
+
+	const auto Selection = MakeShared<FQueryNode<FAsset>>(TEXT("asset"));
+	Selection->AddField(&FAsset::Profiles);
+	Selection->OnMember(&FAsset::Ownership)
+		->OnUnion<FNFTAssetOwnership>()
+			->OnMember(&FNFTAssetOwnership::Owner)
+				->AddField(&FAccount::Address);
+	const TArray<FAssetRegisterAssetKey> Keys = {
+		FAssetRegisterAssetKey(AssetFixtures::CollectionId, TEXT("3")),
+		FAssetRegisterAssetKey(AssetFixtures::CollectionId, FString::FromInt(NumAssets + 1))
+	};
+	UAssetRegisterQueryingLibrary::GetAssetsBatched(Keys, Selection, 0.0).Next([Results](const TArray<FLoadAssetResult>& Result)
+	{
+		Results->Batched = Result;
+	});
+
+	QueryTestUtil::WaitUntil(this, [Results]() { return Results->AllAssets.IsSet() && Results->Batched.IsSet(); });
+	QueryTestUtil::Then([this, Server, Results]()
+	{
+		const FLoadAssetsResult& AllAssets = Results->AllAssets.GetValue();
+		TestTrue(TEXT("Every page should load"), AllAssets.bSuccess);
+		if (TestEqual(TEXT("Every asset should be returned once"), AllAssets.Value.Edges.Num(), NumAssets))
+		{
+			for (int32 Index = 0; Index < NumAssets; ++Index)
+			{
+				TestEqual(TEXT("Assets should be paged in order"), AllAssets.Value.Edges[Index].Node.TokenId, FString::FromInt(Index));
+			}
+		}
+
+		const TArray<FLoadAssetResult>& Batched = Results->Batched.GetValue();
+		if (TestEqual(TEXT("Every batched asset should have a result"), Batched.Num(), 2))
+		{
+			TestTrue(TEXT("The aliased asset should load"), Batched[0].bSuccess);
+			TestTrue(TEXT("The aliased asset should have its profiles"), Batched[0].Value.Profiles.Contains(TEXT("asset-profile")));
+			const UNFTAssetOwnershipObject* Ownership = Cast<UNFTAssetOwnershipObject>(Batched[0].Value.OwnershipWrapper.Ownership);
+			TestTrue(TEXT("The aliased asset should have its owner"),
+				Ownership && Ownership->Data.Owner.Address == AssetFixtures::OwnerAddress);
+			TestTrue(TEXT("A missing asset should be reported as not found"), Batched[1].bNotFound);
+		}
+		TestEqual(TEXT("Each page and the batch should be one request"), Server->GetNumRequests(),
+			FMath::DivideAndRoundUp(NumAssets, PageSize) + 1);
+
+		Server->FailNextRequests(1, 503);
+		FAssetConnection PageInput;
+		PageInput.First = PageSize;
+		UAssetRegisterQueryingLibrary::GetAssets(PageInput).Next([Results](const FLoadAssetsResult& Result)
+		{
+			Results->Failed = Result;
+		});
+	});
+
+	QueryTestUtil::WaitUntil(this, [Results]() { return Results->Failed.IsSet(); });
+	QueryTestUtil::Then([this, Server, Results, Settings, OriginalURL, bOriginalEnableAssetCache, bOriginalEnableNegativeCache]()
+	{
+		TestFalse(TEXT("An injected failure should fail the request"), Results->Failed.GetValue().bSuccess);
+		TestEqual(TEXT("The injected failure should be counted"), Server->GetNumFailed(), 1);
+
+		Server->Stop();
+		FAssetRegisterNegativeCache::Get().Clear();
+		Settings->AssetRegisterURL = OriginalURL;
+		Settings->bEnableAssetCache = bOriginalEnableAssetCache;
+		Settings->bEnableNegativeCache = bOriginalEnableNegativeCache;
+	});
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,112 @@
+#include "AssetRegisterAssetCache.h"
+#include "AssetRegisterMockServer.h"
+#include "AssetRegisterNegativeCache.h"
+#include "AssetRegisterQueryingLibrary.h"
+#include "AssetRegisterSettings.h"
+#include "QueryTestUtil.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(NegativeCacheTest,
+								"UBFEmergenceDemo.sdk_unreal_asset_register.Source.AssetRegister.Private.NegativeCacheTest",
+								EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+/**
+ * Looking up a missing asset or an asset without an asset-profile a second time should fail without a request,
+ * and the negative cache should stay within its size cap.
+ */
+bool NegativeCacheTest::RunTest(const FString& Parameters)
+{
+	const FString CollectionId = TEXT("7668:root:1124");
+	const FString MissingTokenId = TEXT("340");
+	const FString NoProfileTokenId = TEXT("341");
+
+	UAssetRegisterSettings* Settings = GetMutableDefault<UAssetRegisterSettings>();
+	const FString OriginalURL = Settings->AssetRegisterURL;
+	const bool bOriginalEnableAssetCache = Settings->bEnableAssetCache;
+	const bool bOriginalEnableNegativeCache = Settings->bEnableNegativeCache;
+	const int32 OriginalMaxEntries = Settings->NegativeCacheMaxEntries;
+	// without the asset cache every lookup that isn't a known miss goes to the server
+	Settings->bEnableAssetCache = false;
+	Settings->bEnableNegativeCache = true;
+
+	FAssetRegisterNegativeCache& NegativeCache = FAssetRegisterNegativeCache::Get();
+	NegativeCache.Clear();
+
+	// size cap
+	Settings->NegativeCacheMaxEntries = 100;
+	for (int32 Index = 0; Index < 1000; ++Index)
+	{
+		NegativeCache.Add(FAssetRegisterAssetKey(CollectionId, FString::FromInt(Index)), EAssetRegisterMiss::Asset);
+	}
+	TestEqual(TEXT("Negative cache should stay within its cap"), NegativeCache.GetStats().NumEntries, 100);
+	TestTrue(TEXT("Newest misses should be kept"), NegativeCache.Contains(FAssetRegisterAssetKey(CollectionId, TEXT("999")), EAssetRegisterMiss::Asset));
+	TestFalse(TEXT("Oldest misses should be evicted"), NegativeCache.Contains(FAssetRegisterAssetKey(CollectionId, TEXT("0")), EAssetRegisterMiss::Asset));
+	TestFalse(TEXT("Misses should be kept per kind"), NegativeCache.Contains(FAssetRegisterAssetKey(CollectionId, TEXT("999")), EAssetRegisterMiss::AssetProfile));
+	NegativeCache.Remove(FAssetRegisterAssetKey(CollectionId, TEXT("999")));
+	TestFalse(TEXT("Removed misses should be forgotten"), NegativeCache.Contains(FAssetRegisterAssetKey(CollectionId, TEXT("999")), EAssetRegisterMiss::Asset));
+	NegativeCache.Clear();
+	Settings->NegativeCacheMaxEntries = OriginalMaxEntries;
+	const uint64 HitsBefore = NegativeCache.GetStats().Hits;
+
+	TSharedRef<FAssetRegisterMockServer> Server = MakeShared<FAssetRegisterMockServer>();
+	if (!Server->Start())
+	{
+		AddError(TEXT("Failed to start mock server"));
+		Settings->bEnableAssetCache = bOriginalEnableAssetCache;
+		return false;
+	}
+	Server->SetResponse(TEXT(R"({ "data": { "asset": null } })"));
+	Settings->AssetRegisterURL = Server->GetURL();
+
+	TSharedRef<TArray<FLoadJsonResult>> Results = MakeShared<TArray<FLoadJsonResult>>();
+	UAssetRegisterQueryingLibrary::GetAssetProfile(MissingTokenId, CollectionId).Next([Results](const FLoadJsonResult& Result)
+	{
+		Results->Add(Result);
+	});
+	QueryTestUtil::WaitUntil(this, [Results]() { return Results->Num() == 1; });
+
+	QueryTestUtil::Then([this, Server, CollectionId, MissingTokenId, NoProfileTokenId, Results]()
+	{
+		if (TestEqual(TEXT("The missing asset lookup should complete"), Results->Num(), 1))
+		{
+			TestTrue(TEXT("A missing asset should be reported as not found"), (*Results)[0].bNotFound);
+		}
+
+		TFuture<FLoadJsonResult> Future = UAssetRegisterQueryingLibrary::GetAssetProfile(MissingTokenId, CollectionId);
+		TestTrue(TEXT("A known missing asset should fail without a request"), Future.IsReady() && Future.Get().bNotFound);
+
+		Server->SetResponse(TEXT(R"({ "data": { "asset": { "profiles": { "other-profile": "https://example.com/341.json" } } } })"));
+		UAssetRegisterQueryingLibrary::GetAssetProfile(NoProfileTokenId, CollectionId).Next([Results](const FLoadJsonResult& Result)
+		{
+			Results->Add(Result);
+		});
+	});
+	QueryTestUtil::WaitUntil(this, [Results]() { return Results->Num() == 2; });
+
+	QueryTestUtil::Then([this, Server, Settings, CollectionId, NoProfileTokenId, Results, HitsBefore, OriginalURL,
+		bOriginalEnableAssetCache, bOriginalEnableNegativeCache]()
+	{
+		if (TestEqual(TEXT("The asset-profile lookup should complete"), Results->Num(), 2))
+		{
+			TestTrue(TEXT("An asset without an asset-profile should be reported as not found"), (*Results)[1].bNotFound);
+		}
+
+		TFuture<FLoadJsonResult> Future = UAssetRegisterQueryingLibrary::GetAssetProfile(NoProfileTokenId, CollectionId);
+		TestTrue(TEXT("A known missing asset-profile should fail without a request"), Future.IsReady() && Future.Get().bNotFound);
+
+		TestEqual(TEXT("Only the first lookup of each miss should reach the server"), Server->GetNumRequests(), 2);
+		TestEqual(TEXT("Both repeated lookups should be negative cache hits"), FAssetRegisterNegativeCache::Get().GetStats().Hits - HitsBefore, uint64(2));
+
+		Server->Stop();
+		FAssetRegisterNegativeCache::Get().Clear();
+		Settings->AssetRegisterURL = OriginalURL;
+		Settings->bEnableAssetCache = bOriginalEnableAssetCache;
+		Settings->bEnableNegativeCache = bOriginalEnableNegativeCache;
+	});
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,137 @@
+#include "AssetFixtures.h"
+#include "AssetRegisterAssetStream.h"
+#include "AssetRegisterLog.h"
+#include "AssetRegisterMockServer.h"
+#include "AssetRegisterSettings.h"
+#include "QueryTestUtil.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(PagePrefetchBenchmarkTest,
+								"UBFEmergenceDemo.sdk_unreal_asset_register.Source.AssetRegister.Private.PagePrefetchBenchmarkTest",
+								EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+namespace PagePrefetchBenchmark
+{
+	constexpr int32 NumPages = 20;
+	constexpr int32 PageSize = 200;
+	constexpr float Latency = 0.05f;
+	const TArray<int32> PrefetchDepths = {0, 1, 2};
+
+	struct FWalk
+	{
+		double StartTime = 0.0;
+		double Seconds = 0.0;
+		int32 NumPages = 0;
+		int32 NumItems = 0;
+		int32 NumRequests = 0;
+		bool bFinished = false;
+	};
+
+	/** A page of PageSize assets that always claims there are more, the stream's MaxItems ends the walk. */
+	FString MakePageResponse()
+	{
+		FString Edges;
+		for (int32 Index = 0; Index < PageSize; ++Index)
+		{
+			if (Index > 0)
+			{
+				Edges += TEXT(",");
+			}
+			Edges += FString::Printf(TEXT(R"({"cursor":"%s","node":{"tokenId":"%d","collectionId":"%s",)"
+				R"("profiles":{"asset-profile":"https://example.com/profiles/%d.json"},)"
+				R"("metadata":{"attributes":{"rarity":"common"},"rawAttributes":[{"trait_type":"level","value":"%d"}],)"
+				R"("properties":{"name":"Fixture #%d","image":"https://example.com/images/%d.png"}}}})"),
+				*AssetFixtures::MakeCursor(Index), Index, AssetFixtures::CollectionId, Index, Index % 7, Index, Index);
+		}
+
+		return FString::Printf(TEXT(R"({"data":{"assets":{"edges":[%s],"pageInfo":{"endCursor":"%s","hasNextPage":true},"total":%d}}})"),
+			*Edges, *AssetFixtures::MakeCursor(PageSize - 1), NumPages * PageSize);
+	}
+
+	void ReadPages(const TSharedRef<FAssetRegisterAssetStream>& Stream, const TSharedRef<FWalk>& Walk)
+	{
+		Stream->Next().Next([Stream, Walk](const FLoadAssetsResult& Result)
+		{
+			if (Result.bSuccess)
+			{
+				++Walk->NumPages;
+				Walk->NumItems += Result.Value.Edges.Num();
+			}
+
+			if (!Result.bSuccess || !Stream->HasNext())
+			{
+				Walk->Seconds = FPlatformTime::Seconds() - Walk->StartTime;
+				Walk->bFinished = true;
+				return;
+			}
+			ReadPages(Stream, Walk);
+		});
+	}
+}
+
+/**
+ * End-to-end time of walking a 20 page collection from a local stand-in with injected latency, at different
+ * prefetch depths. Without prefetching every page is requested only after the previous one was decoded.
+ */
+bool PagePrefetchBenchmarkTest::RunTest(const FString& Parameters)
+{
+	using namespace PagePrefetchBenchmark;
+
+	TSharedRef<FAssetRegisterMockServer> Server = MakeShared<FAssetRegisterMockServer>();
+	if (!Server->Start())
+	{
+		AddError(TEXT("Failed to start mock server"));
+		return false;
+	}
+	Server->SetResponse(MakePageResponse());
+	Server->SetLatency(Latency);
+
+	UAssetRegisterSettings* Settings = GetMutableDefault<UAssetRegisterSettings>();
+	const FString OriginalURL = Settings->AssetRegisterURL;
+	const bool bOriginalEnableDiskCache = Settings->bEnableDiskCache;
+	Settings->AssetRegisterURL = Server->GetURL();
+	// every page has to come from the server
+	Settings->bEnableDiskCache = false;
+
+	TArray<TSharedRef<FWalk>> Walks;
+	for (const int32 PrefetchDepth : PrefetchDepths)
+	{
+		TSharedRef<FWalk> Walk = Walks.Add_GetRef(MakeShared<FWalk>());
+		QueryTestUtil::Then([Server, Walk, PrefetchDepth]()
+		{
+			FAssetConnection AssetsInput;
+			AssetsInput.CollectionIds = {AssetFixtures::CollectionId};
+			AssetsInput.First = PageSize;
+
+			Walk->NumRequests = -Server->GetNumRequests();
+			Walk->StartTime = FPlatformTime::Seconds();
+			ReadPages(FAssetRegisterAssetStream::Create(AssetsInput, NumPages * PageSize, FAssetRegisterDeadline(), PrefetchDepth), Walk);
+		});
+		QueryTestUtil::WaitUntil(this, [Walk]() { return Walk->bFinished; }, 60.0);
+		QueryTestUtil::Then([Server, Walk]() { Walk->NumRequests += Server->GetNumRequests(); });
+	}
+
+	QueryTestUtil::Then([this, Server, Settings, Walks, OriginalURL, bOriginalEnableDiskCache]()
+	{
+		for (int32 Index = 0; Index < Walks.Num(); ++Index)
+		{
+			const FWalk& Walk = *Walks[Index];
+			UE_LOG(LogAssetRegister, Display, TEXT("[PagePrefetchBenchmark] prefetch depth %d: %d pages of %d assets with %.0fms latency in %.2fms"),
+				PrefetchDepths[Index], Walk.NumPages, PageSize, Latency * 1000.f, Walk.Seconds * 1000.0);
+
+			TestEqual(TEXT("Every page should be walked"), Walk.NumPages, NumPages);
+			TestEqual(TEXT("Every asset should be walked"), Walk.NumItems, NumPages * PageSize);
+			TestEqual(TEXT("No page should be requested past MaxItems"), Walk.NumRequests, NumPages);
+		}
+
+		Server->Stop();
+		Settings->AssetRegisterURL = OriginalURL;
+		Settings->bEnableDiskCache = bOriginalEnableDiskCache;
+	});
+
+	return true;
+}
+
+#endif
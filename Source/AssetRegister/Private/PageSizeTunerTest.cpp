@@ -0,0 +1,107 @@
+#include "AssetRegisterPageSizeTuner.h"
+#include "AssetRegisterSettings.h"
+#include "Misc/AutomationTest.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(PageSizeTunerTest,
+								"UBFEmergenceDemo.sdk_unreal_asset_register.Source.AssetRegister.Private.PageSizeTunerTest",
+								EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+namespace PageSizeTuner
+{
+	FAssetRegisterPageSample MakeSample(int32 NumItems, double ResponseSeconds, double DecodeSeconds = 0.01)
+	{
+		FAssetRegisterPageSample Sample;
+		Sample.bSuccess = true;
+		Sample.NumItems = NumItems;
+		Sample.NumBytes = NumItems * 1024;
+		Sample.ResponseSeconds = ResponseSeconds;
+		Sample.DecodeSeconds = DecodeSeconds;
+		return Sample;
+	}
+}
+
+/**
+ * The page size of a query shape should double while full pages get faster per asset, hold once they stop
+ * improving, halve on slow or failed pages, and stay within the configured range.
+ */
+bool PageSizeTunerTest::RunTest(const FString& Parameters)
+{
+	using namespace PageSizeTuner;
+
+	UAssetRegisterSettings* Settings = GetMutableDefault<UAssetRegisterSettings>();
+	const int32 OriginalMinPageSize = Settings->MinAdaptivePageSize;
+	const int32 OriginalMaxPageSize = Settings->MaxAdaptivePageSize;
+	const float OriginalSlowPageTime = Settings->SlowPageTime;
+	const float OriginalSlowPageDecodeTime = Settings->SlowPageDecodeTime;
+	Settings->MinAdaptivePageSize = 20;
+	Settings->MaxAdaptivePageSize = 400;
+	Settings->SlowPageTime = 2.f;
+	Settings->SlowPageDecodeTime = 0.05f;
+
+	FAssetRegisterPageSizeTuner& Tuner = FAssetRegisterPageSizeTuner::Get();
+	Tuner.Reset();
+
+	FAssetConnection CollectionInput;
+	CollectionInput.CollectionIds = {TEXT("7668:root:1124")};
+	FAssetConnection NextPageInput = CollectionInput;
+	NextPageInput.After = TEXT("cursor-99");
+	NextPageInput.First = 100;
+	FAssetConnection AddressInput;
+	AddressInput.Addresses = {TEXT("0xffffffff00000000000000000000000000000f59")};
+
+	const uint64 Shape = FAssetRegisterPageSizeTuner::GetQueryShape(CollectionInput);
+	TestEqual(TEXT("Pagination arguments should not change the shape"), FAssetRegisterPageSizeTuner::GetQueryShape(NextPageInput), Shape);
+	TestNotEqual(TEXT("Filters should change the shape"), FAssetRegisterPageSizeTuner::GetQueryShape(AddressInput), Shape);
+
+	TestEqual(TEXT("An unknown shape should start at the initial size"), Tuner.GetPageSize(Shape, 50), 50);
+
+	// round trips dominate, so bigger pages keep getting faster per asset
+	Tuner.ReportPage(Shape, 50, MakeSample(50, 0.5));
+	TestEqual(TEXT("A first full page should grow the page size"), Tuner.GetPageSize(Shape, 50), 100);
+	Tuner.ReportPage(Shape, 100, MakeSample(100, 0.6));
+	TestEqual(TEXT("Improving throughput should keep growing the page size"), Tuner.GetPageSize(Shape, 50), 200);
+	Tuner.ReportPage(Shape, 200, MakeSample(200, 1.2));
+	TestEqual(TEXT("Throughput that stopped improving should hold the page size"), Tuner.GetPageSize(Shape, 50), 200);
+	Tuner.ReportPage(Shape, 100, MakeSample(100, 0.1));
+	TestEqual(TEXT("A page of an older size should be ignored"), Tuner.GetPageSize(Shape, 50), 200);
+	Tuner.ReportPage(Shape, 200, MakeSample(120, 0.2));
+	TestEqual(TEXT("A short last page should be ignored"), Tuner.GetPageSize(Shape, 50), 200);
+	Tuner.ReportPage(Shape, 200, MakeSample(200, 0.5));
+	TestEqual(TEXT("The page size should grow up to the maximum"), Tuner.GetPageSize(Shape, 50), 400);
+	Tuner.ReportPage(Shape, 400, MakeSample(400, 0.5));
+	TestEqual(TEXT("The page size should not grow past the maximum"), Tuner.GetPageSize(Shape, 50), 400);
+
+	Tuner.ReportPage(Shape, 400, MakeSample(400, 3.0));
+	TestEqual(TEXT("A slow page should halve the page size"), Tuner.GetPageSize(Shape, 50), 200);
+	Tuner.ReportPage(Shape, 200, MakeSample(200, 0.5, 0.2));
+	TestEqual(TEXT("A page slow to decode should halve the page size"), Tuner.GetPageSize(Shape, 50), 100);
+	FAssetRegisterPageSample Failed;
+	for (int32 Index = 0; Index < 4; ++Index)
+	{
+		Tuner.ReportPage(Shape, Tuner.GetPageSize(Shape, 50), Failed);
+	}
+	TestEqual(TEXT("Failed pages should halve the page size down to the minimum"), Tuner.GetPageSize(Shape, 50), 20);
+
+	const uint64 AddressShape = FAssetRegisterPageSizeTuner::GetQueryShape(AddressInput);
+	TestEqual(TEXT("Other shapes should not be affected"), Tuner.GetPageSize(AddressShape, 50), 50);
+
+	const TMap<uint64, FAssetRegisterPageSizeStats> Stats = Tuner.GetStats();
+	if (const FAssetRegisterPageSizeStats* ShapeStats = Stats.Find(Shape))
+	{
+		TestEqual(TEXT("Stats should count every page"), ShapeStats->NumPages, 13);
+		TestEqual(TEXT("Stats should count the growths"), ShapeStats->NumGrowths, 3);
+		TestEqual(TEXT("Stats should count the backoffs"), ShapeStats->NumBackoffs, 5);
+	}
+	else
+	{
+		AddError(TEXT("Stats should hold the shape"));
+	}
+
+	Tuner.Reset();
+	Settings->MinAdaptivePageSize = OriginalMinPageSize;
+	Settings->MaxAdaptivePageSize = OriginalMaxPageSize;
+	Settings->SlowPageTime = OriginalSlowPageTime;
+	Settings->SlowPageDecodeTime = OriginalSlowPageDecodeTime;
+
+	return true;
+}
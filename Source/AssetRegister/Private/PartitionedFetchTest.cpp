@@ -0,0 +1,146 @@
+#include "AssetRegisterLog.h"
+#include "AssetRegisterMockServer.h"
+#include "AssetRegisterQueryingLibrary.h"
+#include "AssetRegisterSettings.h"
+#include "QueryTestUtil.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(PartitionedFetchTest,
+								"UBFEmergenceDemo.sdk_unreal_asset_register.Source.AssetRegister.Private.PartitionedFetchTest",
+								EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+namespace PartitionedFetch
+{
+	constexpr float Latency = 0.2f;
+
+	TArray<FString> GetTokenIds(const FAssets& Assets)
+	{
+		TArray<FString> TokenIds;
+		for (const FAssetEdge& Edge : Assets.Edges)
+		{
+			TokenIds.Add(Edge.Node.TokenId);
+		}
+		return TokenIds;
+	}
+}
+
+/**
+ * A query over three collections should be sent as three concurrent sub-queries whose assets are merged in sort
+ * order. The stand-in answers every sub-query with the same assets, so they are all duplicates of each other. A sort
+ * by a field the merge can't compare should be sent as a single query.
+ */
+bool PartitionedFetchTest::RunTest(const FString& Parameters)
+{
+	using namespace PartitionedFetch;
+
+	const auto ResponseJson = TEXT(R"({
+	  "data": {
+	    "assets": {
+	      "edges": [
+	        { "cursor": "cursor-0", "node": { "tokenId": "2", "collectionId": "7668:root:1124" } },
+	        { "cursor": "cursor-1", "node": { "tokenId": "10", "collectionId": "7668:root:1124" } },
+	        { "cursor": "cursor-2", "node": { "tokenId": "31", "collectionId": "7668:root:1124" } },
+	        { "cursor": "cursor-3", "node": { "tokenId": "9007199254740992", "collectionId": "7668:root:1124" } },
+	        { "cursor": "cursor-4", "node": { "tokenId": "9007199254740993", "collectionId": "7668:root:1124" } }
+	      ],
+	      "pageInfo": { "endCursor": "cursor-4", "hasNextPage": false },
+	      "total": 5
+	    }
+	  }
+	})");
+
+	TSharedRef<FAssetRegisterMockServer> Server = MakeShared<FAssetRegisterMockServer>();
+	if (!Server->Start())
+	{
+		AddError(TEXT("Failed to start mock server"));
+		return false;
+	}
+	Server->SetResponse(ResponseJson);
+	Server->SetLatency(Latency);
+
+	UAssetRegisterSettings* Settings = GetMutableDefault<UAssetRegisterSettings>();
+	const FString OriginalURL = Settings->AssetRegisterURL;
+	const bool bOriginalEnableDiskCache = Settings->bEnableDiskCache;
+	Settings->AssetRegisterURL = Server->GetURL();
+	// every sub-query has to come from the server
+	Settings->bEnableDiskCache = false;
+
+	FAssetConnection AssetsInput;
+	AssetsInput.CollectionIds = {TEXT("7668:root:1124"), TEXT("7668:root:2148"), TEXT("7668:root:3172")};
+	AssetsInput.Sort.AddDefaulted_GetRef().Name = TEXT("tokenId");
+
+	TSharedRef<TArray<FLoadAssetsResult>> Results = MakeShared<TArray<FLoadAssetsResult>>();
+	const double StartTime = FPlatformTime::Seconds();
+	UAssetRegisterQueryingLibrary::GetAllAssetsPartitioned(AssetsInput, EAssetRegisterPartition::ByCollection, FAssetRegisterDeadline())
+		.Next([Results, StartTime](const FLoadAssetsResult& Result)
+	{
+		UE_LOG(LogAssetRegister, Display, TEXT("[PartitionedFetchTest] 3 partitions with %.0fms latency merged in %.2fms"),
+			Latency * 1000.f, (FPlatformTime::Seconds() - StartTime) * 1000.0);
+		Results->Add(Result);
+	});
+	QueryTestUtil::WaitUntil(this, [Results]() { return Results->Num() == 1; });
+
+	QueryTestUtil::Then([this, Server, AssetsInput, Results]()
+	{
+		TestEqual(TEXT("Every partition should be requested"), Server->GetNumRequests(), 3);
+		if (TestEqual(TEXT("The merged query should complete"), Results->Num(), 1))
+		{
+			TestTrue(TEXT("The merged query should succeed"), (*Results)[0].bSuccess);
+			TestEqual(TEXT("Partitions should be merged in sort order"), GetTokenIds((*Results)[0].Value),
+				TArray<FString>{TEXT("2"), TEXT("2"), TEXT("2"), TEXT("10"), TEXT("10"), TEXT("10"), TEXT("31"), TEXT("31"), TEXT("31"),
+					TEXT("9007199254740992"), TEXT("9007199254740992"), TEXT("9007199254740992"),
+					TEXT("9007199254740993"), TEXT("9007199254740993"), TEXT("9007199254740993")});
+		}
+
+		FAssetConnection DistinctInput = AssetsInput;
+		DistinctInput.RemoveDuplicates = true;
+		UAssetRegisterQueryingLibrary::GetAllAssetsPartitioned(DistinctInput, EAssetRegisterPartition::ByCollection, FAssetRegisterDeadline())
+			.Next([Results](const FLoadAssetsResult& Result)
+		{
+			Results->Add(Result);
+		});
+	});
+	QueryTestUtil::WaitUntil(this, [Results]() { return Results->Num() == 2; });
+
+	QueryTestUtil::Then([this, AssetsInput, Results]()
+	{
+		if (TestEqual(TEXT("The distinct query should complete"), Results->Num(), 2))
+		{
+			TestTrue(TEXT("The merged query should succeed"), (*Results)[1].bSuccess);
+			TestEqual(TEXT("Duplicates should only be kept once"), GetTokenIds((*Results)[1].Value),
+				TArray<FString>{TEXT("2"), TEXT("10"), TEXT("31"), TEXT("9007199254740992"), TEXT("9007199254740993")});
+			TestEqual(TEXT("Total should count the distinct assets"), (*Results)[1].Value.Total, 5.f);
+		}
+
+		// a nested field can't be compared when merging
+		FAssetConnection NestedSortInput = AssetsInput;
+		NestedSortInput.Sort[0].Name = TEXT("collection.name");
+		AddExpectedError(TEXT("can't merge by sort field"), EAutomationExpectedErrorFlags::Contains, 1);
+		UAssetRegisterQueryingLibrary::GetAllAssetsPartitioned(NestedSortInput, EAssetRegisterPartition::ByCollection, FAssetRegisterDeadline())
+			.Next([Results](const FLoadAssetsResult& Result)
+		{
+			Results->Add(Result);
+		});
+	});
+	QueryTestUtil::WaitUntil(this, [Results]() { return Results->Num() == 3; });
+
+	QueryTestUtil::Then([this, Server, Settings, Results, OriginalURL, bOriginalEnableDiskCache]()
+	{
+		TestEqual(TEXT("A sort the merge can't compare should be sent as a single query"), Server->GetNumRequests(), 7);
+		if (TestEqual(TEXT("The nested sort query should complete"), Results->Num(), 3))
+		{
+			TestEqual(TEXT("The single query should keep the server's order"), GetTokenIds((*Results)[2].Value),
+				TArray<FString>{TEXT("2"), TEXT("10"), TEXT("31"), TEXT("9007199254740992"), TEXT("9007199254740993")});
+		}
+
+		Server->Stop();
+		Settings->AssetRegisterURL = OriginalURL;
+		Settings->bEnableDiskCache = bOriginalEnableDiskCache;
+	});
+
+	return true;
+}
+
+#endif
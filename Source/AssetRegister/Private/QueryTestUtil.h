@@ -1,5 +1,7 @@
 #pragma once
 
+#include "Misc/AutomationTest.h"
+
 namespace QueryTestUtil
 {
 	inline FString RemoveAllWhitespace(const FString& Input)
@@ -16,4 +18,41 @@ namespace QueryTestUtil
 
 		return Result;
 	}
+
+	/**
+	 * Queues a latent command that lets the engine tick (and so http requests complete) until Predicate returns true.
+	 * Adds an error to Test if it takes longer than TimeoutSeconds.
+	 */
+	inline void WaitUntil(FAutomationTestBase* Test, TFunction<bool()> Predicate, const double TimeoutSeconds = 10.0)
+	{
+		ADD_LATENT_AUTOMATION_COMMAND(FFunctionLatentCommand([Test, Predicate = MoveTemp(Predicate), TimeoutSeconds, StartTime = -1.0]() mutable
+		{
+			if (StartTime < 0.0)
+			{
+				StartTime = FPlatformTime::Seconds();
+			}
+			if (Predicate())
+			{
+				return true;
+			}
+			if (FPlatformTime::Seconds() - StartTime > TimeoutSeconds)
+			{
+				Test->AddError(FString::Printf(TEXT("Timed out after %.1fs"), TimeoutSeconds));
+				return true;
+			}
+			return false;
+		}));
+	}
+
+	/**
+	 * Queues a latent command that runs Function once, after all previously queued latent commands finished.
+	 */
+	inline void Then(TFunction<void()> Function)
+	{
+		ADD_LATENT_AUTOMATION_COMMAND(FFunctionLatentCommand([Function = MoveTemp(Function)]()
+		{
+			Function();
+			return true;
+		}));
+	}
 }
@@ -0,0 +1,195 @@
+#include "AssetFixtures.h"
+#include "AssetRegisterCapture.h"
+#include "AssetRegisterLog.h"
+#include "AssetRegisterMetrics.h"
+#include "AssetRegisterMockServer.h"
+#include "AssetRegisterQueryBuilder.h"
+#include "AssetRegisterQueryingLibrary.h"
+#include "AssetRegisterReplay.h"
+#include "AssetRegisterSettings.h"
+#include "Algo/Count.h"
+#include "QueryTestUtil.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/CommandLine.h"
+#include "Misc/Parse.h"
+#include "Misc/Paths.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(ReplayTest,
+								"UBFEmergenceDemo.sdk_unreal_asset_register.Source.AssetRegister.Private.ReplayTest",
+								EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+namespace Replay
+{
+	constexpr int32 NumAssets = 25;
+	constexpr int32 PageSize = 10;
+	constexpr float Speed = 10.f;
+
+	struct FResults
+	{
+		TOptional<FLoadAssetsResult> AllAssets;
+		TOptional<FLoadAssetResult> Asset;
+		TOptional<FLoadAssetResult> MissingAsset;
+		TSharedPtr<FAssetRegisterCapture> Capture;
+		TOptional<TArray<FAssetRegisterReplayResult>> Replayed;
+	};
+
+	TArray<uint8> MakeAssetQueryContent(const FString& TokenId)
+	{
+		auto AssetQuery = FAssetRegisterQueryBuilder::AddAssetQuery(FAssetInput(TokenId, AssetFixtures::CollectionId));
+		AssetQuery->AddField(&FAsset::TokenId)
+			->AddField(&FAsset::Profiles);
+		return AssetQuery->GetQueryJsonUtf8();
+	}
+
+	void LogSummary(const TArray<FAssetRegisterReplayResult>& Results)
+	{
+		FAssetRegisterHistogram Latency;
+		int32 NumFailed = 0;
+		int64 NumBytes = 0;
+		for (const FAssetRegisterReplayResult& Result : Results)
+		{
+			Latency.Record(static_cast<uint64>(Result.Latency * 1000000.0));
+			NumFailed += Result.bSuccess ? 0 : 1;
+			NumBytes += Result.NumBytes;
+		}
+		UE_LOG(LogAssetRegister, Display, TEXT("[Replay] %d requests, %d failed, %lld bytes, latency p50 %.1f ms, p99 %.1f ms, max %.1f ms"),
+			Results.Num(), NumFailed, NumBytes, Latency.GetValueAtPercentile(50.0) / 1000.0, Latency.GetValueAtPercentile(99.0) / 1000.0,
+			Latency.GetMax() / 1000.0);
+	}
+}
+
+/**
+ * Traffic recorded with FAssetRegisterRecorder should survive a save and load, and replaying it against a mock server
+ * answering from the capture should send every request again with the recorded outcome.
+ *
+ * With -AssetRegisterReplay=<Path>, the capture at Path is replayed instead, at -AssetRegisterReplaySpeed= (1 by
+ * default), and the latencies are logged.
+ */
+bool ReplayTest::RunTest(const FString& Parameters)
+{
+	using namespace Replay;
+
+	TSharedRef<FAssetRegisterMockServer> Server = MakeShared<FAssetRegisterMockServer>();
+	if (!Server->Start())
+	{
+		AddError(TEXT("Failed to start mock server"));
+		return false;
+	}
+
+	UAssetRegisterSettings* Settings = GetMutableDefault<UAssetRegisterSettings>();
+	const FString OriginalURL = Settings->AssetRegisterURL;
+	const bool bOriginalEnableAssetCache = Settings->bEnableAssetCache;
+	const bool bOriginalEnableNegativeCache = Settings->bEnableNegativeCache;
+	Settings->AssetRegisterURL = Server->GetURL();
+	// every query should reach the server, when recording and when replaying
+	Settings->bEnableAssetCache = false;
+	Settings->bEnableNegativeCache = false;
+
+	TSharedRef<FResults> Results = MakeShared<FResults>();
+
+	FString ReplayPath;
+	const bool bReplayFile = FParse::Value(FCommandLine::Get(), TEXT("AssetRegisterReplay="), ReplayPath);
+	float ReplaySpeed = Speed;
+	if (bReplayFile)
+	{
+		ReplaySpeed = 1.f;
+		FParse::Value(FCommandLine::Get(), TEXT("AssetRegisterReplaySpeed="), ReplaySpeed);
+
+		Results->Capture = MakeShared<FAssetRegisterCapture>();
+		if (!Results->Capture->LoadFromFile(ReplayPath))
+		{
+			AddError(FString::Printf(TEXT("Failed to load %s"), *ReplayPath));
+		}
+	}
+	else
+	{
+		Server->SetAssets(AssetFixtures::MakeAssetJsons(NumAssets, 1));
+		FAssetRegisterRecorder::Get().Start();
+
+		FAssetConnection AssetsInput;
+		AssetsInput.Addresses = {AssetFixtures::OwnerAddress};
+		AssetsInput.First = PageSize;
+		UAssetRegisterQueryingLibrary::GetAllAssets(AssetsInput, FAssetRegisterDeadline()).Next([Results](const FLoadAssetsResult& Result)
+		{
+			Results->AllAssets = Result;
+		});
+		UAssetRegisterQueryingLibrary::MakeAssetQuery(MakeAssetQueryContent(TEXT("3"))).Next([Results](const FLoadAssetResult& Result)
+		{
+			Results->Asset = Result;
+		});
+		UAssetRegisterQueryingLibrary::MakeAssetQuery(MakeAssetQueryContent(FString::FromInt(NumAssets + 1))).Next([Results](const FLoadAssetResult& Result)
+		{
+			Results->MissingAsset = Result;
+		});
+
+		QueryTestUtil::WaitUntil(this, [Results]()
+		{
+			return Results->AllAssets.IsSet() && Results->Asset.IsSet() && Results->MissingAsset.IsSet();
+		});
+		QueryTestUtil::Then([this, Results]()
+		{
+			const FAssetRegisterCapture Recorded = FAssetRegisterRecorder::Get().Stop();
+			const int32 NumPages = FMath::DivideAndRoundUp(NumAssets, PageSize);
+			TestEqual(TEXT("Every request should be recorded"), Recorded.Entries.Num(), NumPages + 2);
+			for (int32 Index = 1; Index < Recorded.Entries.Num(); ++Index)
+			{
+				TestTrue(TEXT("Requests should be recorded in the order they were made"),
+					Recorded.Entries[Index].SendTime >= Recorded.Entries[Index - 1].SendTime);
+			}
+
+			const FString Path = FPaths::Combine(FPaths::AutomationTransientDir(), TEXT("AssetRegister"), TEXT("Replay.arcap"));
+			TestTrue(TEXT("The capture should be saved"), Recorded.SaveToFile(Path));
+			Results->Capture = MakeShared<FAssetRegisterCapture>();
+			if (TestTrue(TEXT("The capture should be loaded"), Results->Capture->LoadFromFile(Path)))
+			{
+				TestEqual(TEXT("Every entry should be loaded"), Results->Capture->Entries.Num(), Recorded.Entries.Num());
+				TestEqual(TEXT("The bodies should be loaded unchanged"), Results->Capture->GetNumContentBytes(), Recorded.GetNumContentBytes());
+			}
+		});
+	}
+
+	QueryTestUtil::Then([Server, Results, ReplaySpeed]()
+	{
+		Server->SetCapture(*Results->Capture, ReplaySpeed);
+		FAssetRegisterReplay::Run(*Results->Capture, ReplaySpeed).Next([Results](const TArray<FAssetRegisterReplayResult>& Replayed)
+		{
+			Results->Replayed = Replayed;
+		});
+	});
+
+	QueryTestUtil::WaitUntil(this, [Results]() { return Results->Replayed.IsSet(); });
+	QueryTestUtil::Then([this, Server, Results, bReplayFile, Settings, OriginalURL, bOriginalEnableAssetCache, bOriginalEnableNegativeCache]()
+	{
+		if (TestTrue(TEXT("The capture should be replayed"), Results->Replayed.IsSet()))
+		{
+			const TArray<FAssetRegisterReplayResult>& Replayed = Results->Replayed.GetValue();
+			TestEqual(TEXT("Every recorded request should be replayed"), Replayed.Num(), Results->Capture->Entries.Num());
+			LogSummary(Replayed);
+
+			if (!bReplayFile)
+			{
+				// everything but the missing asset was found when recording
+				const int32 NumSucceeded = static_cast<int32>(Algo::CountIf(Replayed, [](const FAssetRegisterReplayResult& Result) { return Result.bSuccess; }));
+				TestEqual(TEXT("Replayed requests should have the recorded outcome"), NumSucceeded, Replayed.Num() - 1);
+			}
+		}
+
+		if (!bReplayFile && TestTrue(TEXT("Every recorded request should complete"),
+			Results->AllAssets.IsSet() && Results->Asset.IsSet() && Results->MissingAsset.IsSet()))
+		{
+			TestTrue(TEXT("The recorded requests should have succeeded"), Results->AllAssets->bSuccess && Results->Asset->bSuccess);
+			TestTrue(TEXT("The missing asset should have been reported as not found"), Results->MissingAsset->bNotFound);
+		}
+
+		Server->Stop();
+		Settings->AssetRegisterURL = OriginalURL;
+		Settings->bEnableAssetCache = bOriginalEnableAssetCache;
+		Settings->bEnableNegativeCache = bOriginalEnableNegativeCache;
+	});
+
+	return true;
+}
+
+#endif
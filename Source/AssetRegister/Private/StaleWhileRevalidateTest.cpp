@@ -0,0 +1,122 @@
+#include "AssetRegisterAssetCache.h"
+#include "AssetRegisterMockServer.h"
+#include "AssetRegisterQueryingLibrary.h"
+#include "AssetRegisterSettings.h"
+#include "QueryTestUtil.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(StaleWhileRevalidateTest,
+								"UBFEmergenceDemo.sdk_unreal_asset_register.Source.AssetRegister.Private.StaleWhileRevalidateTest",
+								EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+namespace StaleWhileRevalidate
+{
+	FString MakeProfileResponse(const FString& ProfileURI)
+	{
+		return FString::Printf(TEXT(R"({ "data": { "asset": { "profiles": { "asset-profile": "%s" } } } })"), *ProfileURI);
+	}
+}
+
+/**
+ * A stale cached profile should be returned without waiting for the network, refetched in the background, and
+ * reported through OnChanged when the refetched profile differs. With stale-while-revalidate off, it should be
+ * refetched before the lookup completes.
+ */
+bool StaleWhileRevalidateTest::RunTest(const FString& Parameters)
+{
+	using namespace StaleWhileRevalidate;
+
+	const FString TokenId = TEXT("33");
+	const FString CollectionId = TEXT("7668:root:1124");
+	const FString ProfileV1 = TEXT("https://example.com/33/profile-v1.json");
+	const FString ProfileV2 = TEXT("https://example.com/33/profile-v2.json");
+
+	TSharedRef<FAssetRegisterMockServer> Server = MakeShared<FAssetRegisterMockServer>();
+	if (!Server->Start())
+	{
+		AddError(TEXT("Failed to start mock server"));
+		return false;
+	}
+	Server->SetResponse(MakeProfileResponse(ProfileV1));
+
+	UAssetRegisterSettings* Settings = GetMutableDefault<UAssetRegisterSettings>();
+	const FString OriginalURL = Settings->AssetRegisterURL;
+	const bool bOriginalEnableAssetCache = Settings->bEnableAssetCache;
+	const bool bOriginalStaleWhileRevalidate = Settings->bStaleWhileRevalidate;
+	const float OriginalProfileFreshness = Settings->AssetProfileFreshness;
+	Settings->AssetRegisterURL = Server->GetURL();
+	Settings->bEnableAssetCache = true;
+	Settings->bStaleWhileRevalidate = true;
+	// every cached profile is stale
+	Settings->AssetProfileFreshness = 0.f;
+	FAssetRegisterAssetCache::Get().Remove(FAssetRegisterAssetKey(CollectionId, TokenId));
+
+	TSharedRef<TArray<FLoadJsonResult>> Results = MakeShared<TArray<FLoadJsonResult>>();
+	TSharedRef<TArray<FLoadJsonResult>> Changes = MakeShared<TArray<FLoadJsonResult>>();
+
+	// the first lookup has nothing cached and has to wait for the request
+	UAssetRegisterQueryingLibrary::GetAssetProfile(TokenId, CollectionId).Next([Results](const FLoadJsonResult& Result)
+	{
+		Results->Add(Result);
+	});
+	QueryTestUtil::WaitUntil(this, [Results]() { return Results->Num() == 1; });
+
+	QueryTestUtil::Then([this, Server, TokenId, CollectionId, ProfileV1, ProfileV2, Results, Changes]()
+	{
+		Server->SetResponse(MakeProfileResponse(ProfileV2));
+
+		TFuture<FLoadJsonResult> Future = UAssetRegisterQueryingLibrary::GetAssetProfile(TokenId, CollectionId, FAssetRegisterDeadline(),
+			[Changes](const FLoadJsonResult& Changed)
+		{
+			Changes->Add(Changed);
+		});
+
+		TestTrue(TEXT("A stale profile should be returned without waiting for the request"), Future.IsReady());
+		if (Future.IsReady())
+		{
+			TestEqual(TEXT("The stale profile should be returned"), Future.Get().Value, ProfileV1);
+			Results->Add(Future.Get());
+		}
+	});
+	QueryTestUtil::WaitUntil(this, [Changes]() { return Changes->Num() == 1; });
+
+	QueryTestUtil::Then([this, Settings, TokenId, CollectionId, ProfileV2, Changes, Results]()
+	{
+		if (TestEqual(TEXT("OnChanged should be called for the refetched profile"), Changes->Num(), 1))
+		{
+			TestEqual(TEXT("OnChanged should receive the refetched profile"), (*Changes)[0].Value, ProfileV2);
+		}
+
+		Settings->bStaleWhileRevalidate = false;
+		TFuture<FLoadJsonResult> Future = UAssetRegisterQueryingLibrary::GetAssetProfile(TokenId, CollectionId);
+		TestFalse(TEXT("Without stale-while-revalidate a stale profile should be refetched first"), Future.IsReady());
+		Future.Next([Results](const FLoadJsonResult& Result)
+		{
+			Results->Add(Result);
+		});
+	});
+	QueryTestUtil::WaitUntil(this, [Results]() { return Results->Num() == 3; });
+
+	QueryTestUtil::Then([this, Server, Settings, ProfileV2, Results, Changes, OriginalURL, bOriginalEnableAssetCache,
+		bOriginalStaleWhileRevalidate, OriginalProfileFreshness]()
+	{
+		TestEqual(TEXT("Every lookup should reach the server once"), Server->GetNumRequests(), 3);
+		TestEqual(TEXT("OnChanged should be called once per changed refetch"), Changes->Num(), 1);
+		if (Results->Num() == 3)
+		{
+			TestEqual(TEXT("The refetched profile should be returned"), (*Results)[2].Value, ProfileV2);
+		}
+
+		Server->Stop();
+		Settings->AssetRegisterURL = OriginalURL;
+		Settings->bEnableAssetCache = bOriginalEnableAssetCache;
+		Settings->bStaleWhileRevalidate = bOriginalStaleWhileRevalidate;
+		Settings->AssetProfileFreshness = OriginalProfileFreshness;
+	});
+
+	return true;
+}
+
+#endif
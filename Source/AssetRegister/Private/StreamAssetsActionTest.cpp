@@ -0,0 +1,116 @@
+#include "AssetFixtures.h"
+#include "AssetRegisterMockServer.h"
+#include "AssetRegisterSettings.h"
+#include "AssetRegisterStreamAssetsAction.h"
+#include "QueryTestUtil.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(StreamAssetsActionTest,
+								"UBFEmergenceDemo.sdk_unreal_asset_register.Source.AssetRegister.Private.StreamAssetsActionTest",
+								EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+namespace StreamAssetsAction
+{
+	constexpr int32 PageSize = 3;
+	constexpr int32 MaxItems = 7;
+	constexpr float Latency = 0.2f;
+
+	/** A page of PageSize assets that always claims there are more, MaxItems ends the stream. */
+	FString MakePageResponse()
+	{
+		FString Edges;
+		for (int32 Index = 0; Index < PageSize; ++Index)
+		{
+			if (Index > 0)
+			{
+				Edges += TEXT(",");
+			}
+			Edges += FString::Printf(TEXT(R"({"cursor":"%s","node":{"tokenId":"%d","collectionId":"%s"}})"),
+				*AssetFixtures::MakeCursor(Index), Index, AssetFixtures::CollectionId);
+		}
+
+		return FString::Printf(TEXT(R"({"data":{"assets":{"edges":[%s],"pageInfo":{"endCursor":"%s","hasNextPage":true},"total":100}}})"),
+			*Edges, *AssetFixtures::MakeCursor(PageSize - 1));
+	}
+
+	UAssetRegisterStreamAssetsAction* StartAction()
+	{
+		FAssetConnection AssetsInput;
+		AssetsInput.CollectionIds = {AssetFixtures::CollectionId};
+		AssetsInput.First = PageSize;
+
+		UAssetRegisterStreamAssetsAction* Action = UAssetRegisterStreamAssetsAction::StreamAssetPages(nullptr, AssetsInput, MaxItems, 0.f);
+		// there is no game instance to keep the action alive
+		Action->AddToRoot();
+		Action->Activate();
+		return Action;
+	}
+}
+
+/**
+ * The node should deliver every page up to MaxItems and then finish, and deliver nothing once cancelled.
+ */
+bool StreamAssetsActionTest::RunTest(const FString& Parameters)
+{
+	using namespace StreamAssetsAction;
+
+	TSharedRef<FAssetRegisterMockServer> Server = MakeShared<FAssetRegisterMockServer>();
+	if (!Server->Start())
+	{
+		AddError(TEXT("Failed to start mock server"));
+		return false;
+	}
+	Server->SetResponse(MakePageResponse());
+
+	UAssetRegisterSettings* Settings = GetMutableDefault<UAssetRegisterSettings>();
+	const FString OriginalURL = Settings->AssetRegisterURL;
+	const bool bOriginalEnableAssetCache = Settings->bEnableAssetCache;
+	const bool bOriginalEnableDiskCache = Settings->bEnableDiskCache;
+	Settings->AssetRegisterURL = Server->GetURL();
+	Settings->bEnableAssetCache = false;
+	Settings->bEnableDiskCache = false;
+
+	UAssetRegisterStreamAssetsAction* Action = StartAction();
+	QueryTestUtil::WaitUntil(this, [Action]() { return !Action->IsRunning(); });
+	QueryTestUtil::Then([this, Action]()
+	{
+		TestEqual(TEXT("Every page should be delivered"), Action->GetNumPages(), 3);
+		TestEqual(TEXT("The stream should stop at MaxItems"), Action->GetNumItems(), MaxItems);
+		Action->RemoveFromRoot();
+	});
+
+	TSharedRef<UAssetRegisterStreamAssetsAction*> CancelledAction = MakeShared<UAssetRegisterStreamAssetsAction*>(nullptr);
+	TSharedRef<int32> NumRequests = MakeShared<int32>(0);
+	TSharedRef<double> CancelTime = MakeShared<double>(0.0);
+	QueryTestUtil::Then([this, Server, CancelledAction, NumRequests, CancelTime]()
+	{
+		Server->SetLatency(Latency);
+		*NumRequests = Server->GetNumRequests();
+		*CancelTime = FPlatformTime::Seconds();
+		*CancelledAction = StartAction();
+		(*CancelledAction)->Cancel();
+		TestFalse(TEXT("A cancelled node should stop"), (*CancelledAction)->IsRunning());
+	});
+
+	// give the response that was in flight time to arrive
+	QueryTestUtil::WaitUntil(this, [Server, NumRequests, CancelTime]()
+	{
+		return Server->GetNumRequests() > *NumRequests && FPlatformTime::Seconds() - *CancelTime > Latency * 3;
+	});
+	QueryTestUtil::Then([this, Server, Settings, OriginalURL, bOriginalEnableAssetCache, bOriginalEnableDiskCache, CancelledAction]()
+	{
+		TestEqual(TEXT("A cancelled node should deliver nothing"), (*CancelledAction)->GetNumPages(), 0);
+		(*CancelledAction)->RemoveFromRoot();
+
+		Server->Stop();
+		Settings->AssetRegisterURL = OriginalURL;
+		Settings->bEnableAssetCache = bOriginalEnableAssetCache;
+		Settings->bEnableDiskCache = bOriginalEnableDiskCache;
+	});
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,76 @@
+#include "AssetRegisterTrace.h"
+#include "Async/ParallelFor.h"
+#include "Misc/AutomationTest.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(TraceTest,
+								"UBFEmergenceDemo.sdk_unreal_asset_register.Source.AssetRegister.Private.TraceTest",
+								EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+namespace PhaseTrace
+{
+	constexpr int32 NumRequestIds = 1000;
+
+	bool SetChannelEnabled(bool bEnabled)
+	{
+		const bool bWasEnabled = AssetRegisterTrace::IsEnabled();
+		UE::Trace::ToggleChannel(TEXT("AssetRegister"), bEnabled);
+		return bWasEnabled;
+	}
+}
+
+/**
+ * Request IDs should be unique across threads, a request scope should hand its ID to the first request sent in it,
+ * and a phase scope should attribute the phases nested in it to its request while the channel is enabled, and do
+ * nothing while it is disabled.
+ */
+bool TraceTest::RunTest(const FString& Parameters)
+{
+	using namespace PhaseTrace;
+
+	TArray<uint64> RequestIds;
+	RequestIds.SetNumZeroed(NumRequestIds);
+	ParallelFor(NumRequestIds, [&RequestIds](int32 Index)
+	{
+		RequestIds[Index] = AssetRegisterTrace::NewRequestId();
+	});
+
+	TSet<uint64> UniqueIds(RequestIds);
+	TestEqual(TEXT("Request IDs should be unique"), UniqueIds.Num(), NumRequestIds);
+	TestFalse(TEXT("0 should never be a request ID"), UniqueIds.Contains(0));
+
+	{
+		const FAssetRegisterRequestScope RequestScope;
+		const uint64 ScopedId = AssetRegisterTrace::GetCurrentRequestId();
+		TestNotEqual(TEXT("A request scope should allocate its request ID"), ScopedId, uint64(0));
+		TestEqual(TEXT("The first request sent in a scope should take its ID"), AssetRegisterTrace::TakeScopedRequestId(), ScopedId);
+		TestNotEqual(TEXT("A second request sent in a scope should get its own ID"), AssetRegisterTrace::TakeScopedRequestId(), ScopedId);
+	}
+	TestEqual(TEXT("No request should be current outside of a request scope"), AssetRegisterTrace::GetCurrentRequestId(), uint64(0));
+
+	const bool bWasEnabled = SetChannelEnabled(false);
+	{
+		ASSETREGISTER_TRACE_PHASE(RequestIds[0], Decode);
+		TestEqual(TEXT("A disabled channel should not track the current request"), AssetRegisterTrace::GetCurrentRequestId(), uint64(0));
+	}
+
+	SetChannelEnabled(true);
+	if (AssetRegisterTrace::IsEnabled())
+	{
+		{
+			ASSETREGISTER_TRACE_PHASE(RequestIds[0], Decode);
+			{
+				ASSETREGISTER_TRACE_PHASE(0, CreateObjects);
+				TestEqual(TEXT("A nested phase should belong to the enclosing request"), AssetRegisterTrace::GetCurrentRequestId(), RequestIds[0]);
+			}
+			TestEqual(TEXT("The request should be current until its phase ends"), AssetRegisterTrace::GetCurrentRequestId(), RequestIds[0]);
+		}
+		TestEqual(TEXT("No request should be current outside of a phase"), AssetRegisterTrace::GetCurrentRequestId(), uint64(0));
+	}
+	else
+	{
+		AddInfo(TEXT("Trace is compiled out, skipping the enabled channel checks"));
+	}
+	SetChannelEnabled(bWasEnabled);
+
+	return true;
+}
@@ -0,0 +1,172 @@
+// Copyright (c) 2025, Futureverse Corporation Limited. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/GCObject.h"
+#include "QueryNode.h"
+#include "Schemas/Asset.h"
+#include <atomic>
+
+/**
+ * Identity of an asset.
+ */
+struct FAssetRegisterAssetKey
+{
+	FAssetRegisterAssetKey() {}
+	FAssetRegisterAssetKey(const FString& InCollectionId, const FString& InTokenId)
+		: CollectionId(InCollectionId), TokenId(InTokenId) {}
+
+	explicit FAssetRegisterAssetKey(const FAsset& Asset)
+		: CollectionId(Asset.CollectionId), TokenId(Asset.TokenId) {}
+
+	FString CollectionId;
+	FString TokenId;
+
+	bool IsValid() const
+	{
+		return !CollectionId.IsEmpty() && !TokenId.IsEmpty();
+	}
+
+	bool operator==(const FAssetRegisterAssetKey& Other) const
+	{
+		return CollectionId == Other.CollectionId && TokenId == Other.TokenId;
+	}
+
+	friend uint32 GetTypeHash(const FAssetRegisterAssetKey& Key)
+	{
+		return HashCombine(GetTypeHash(Key.CollectionId), GetTypeHash(Key.TokenId));
+	}
+
+	FString ToString() const
+	{
+		return CollectionId + TEXT(":") + TokenId;
+	}
+};
+
+/**
+ * Counters of an FAssetRegisterAssetCache.
+ */
+struct FAssetRegisterAssetCacheStats
+{
+	uint64 Hits = 0;
+	/** Lookups of a cached asset that didn't hold every selected field. */
+	uint64 PartialHits = 0;
+	uint64 Misses = 0;
+	uint64 Evictions = 0;
+	uint64 Expirations = 0;
+	int32 NumEntries = 0;
+	int64 MemoryUsed = 0;
+
+	double GetHitRate() const
+	{
+		const uint64 Lookups = Hits + PartialHits + Misses;
+		return Lookups > 0 ? static_cast<double>(Hits) / Lookups : 0.0;
+	}
+};
+
+/**
+ * In-memory cache of decoded assets shared by the UAssetRegisterQueryingLibrary entry points.
+ *
+ * Assets are normalized by identity: each (CollectionId, TokenId) has a single entry, holding the asset and the
+ * selection of fields known for it, merged from every query that returned the asset. A lookup is answered when
+ * the known selection covers the selection asked for; otherwise the known selection lets the caller request only
+ * the missing fields (see IQueryNode::GetMissingSelection).
+ *
+ * Entries are spread over independently locked shards, each keeping its entries in least recently used order.
+ * Entries expire after UAssetRegisterSettings::AssetCacheTimeToLive, and least recently used entries are evicted
+ * once the approximate memory use exceeds AssetCacheMemoryBudget.
+ */
+class ASSETREGISTER_API FAssetRegisterAssetCache : public FGCObject
+{
+public:
+	static FAssetRegisterAssetCache& Get();
+
+	FAssetRegisterAssetCache();
+
+	/**
+	 * Finds an unexpired asset holding every field in Selection and marks it as recently used.
+	 *
+	 * @param OutKnownSelection If set and the asset is cached without all of Selection, receives the fields that are
+	 * known, and OutAsset the cached asset, so the caller can plan a query for the rest.
+	 * @param OutAge If set, receives the seconds since the oldest of the known fields in Selection was fetched.
+	 * @return False on a miss or partial hit, or if the cache is disabled in UAssetRegisterSettings.
+	 */
+	bool Find(const FAssetRegisterAssetKey& Key, const IQueryNode& Selection, FAsset& OutAsset,
+		TSharedPtr<const IQueryNode>* OutKnownSelection = nullptr, double* OutAge = nullptr);
+
+	/**
+	 * Adds a decoded asset. If the asset is already cached, the fields in Selection replace the cached ones
+	 * and the rest of the cached asset is kept.
+	 *
+	 * @param Asset The asset, CollectionId and TokenId have to be set.
+	 * @param Selection The fields selected below the asset by the query which produced it.
+	 * @param Age Seconds since the asset was fetched, for assets that were loaded from elsewhere, e.g. the disk cache.
+	 */
+	void Add(const FAsset& Asset, const IQueryNode& Selection, double Age = 0.0);
+
+	void Remove(const FAssetRegisterAssetKey& Key);
+
+	void Clear();
+
+	FAssetRegisterAssetCacheStats GetStats() const;
+
+	//~ FGCObject
+	virtual void AddReferencedObjects(FReferenceCollector& Collector) override;
+	virtual FString GetReferencerName() const override;
+
+	/** Approximate number of bytes an asset takes up in the cache. */
+	static int64 EstimateMemoryUsage(const FAsset& Asset);
+
+	/** Copies the fields of Source that are direct children of Selection over Target. */
+	static void CopyFields(const FAsset& Source, FAsset& Target, const IQueryNode& Selection);
+
+private:
+	struct FEntry
+	{
+		FAssetRegisterAssetKey Key;
+		FAsset Asset;
+		/** Shared with callers of Find, so it is replaced rather than modified when fields are added. */
+		TSharedPtr<const IQueryNode> Selection;
+		/** FPlatformTime::Seconds() each top level field of Selection was fetched at. */
+		TMap<FString, double> FetchedAt;
+		double ExpiresAt = 0.0;
+		int64 MemoryUsage = 0;
+
+		/** Neighbours in the shard's recently used list, indices into FShard::Entries. */
+		int32 Newer = INDEX_NONE;
+		int32 Older = INDEX_NONE;
+	};
+
+	struct FShard
+	{
+		mutable FCriticalSection CriticalSection;
+		TMap<FAssetRegisterAssetKey, int32> Lookup;
+		TSparseArray<FEntry> Entries;
+		int32 Newest = INDEX_NONE;
+		int32 Oldest = INDEX_NONE;
+		int64 MemoryUsed = 0;
+	};
+
+	static constexpr int32 NumShards = 16;
+
+	/** A copy of Selection, with the fields identifying the asset. */
+	static TSharedRef<const IQueryNode> MakeSelection(const IQueryNode& Selection);
+
+	/** Sets the fetch time of the top level fields of Selection. */
+	static void SetFetchedAt(FEntry& Entry, const IQueryNode& Selection, double FetchedAt);
+
+	FShard& GetShard(const FAssetRegisterAssetKey& Key);
+
+	static void Unlink(FShard& Shard, int32 Index);
+	static void LinkAsNewest(FShard& Shard, int32 Index);
+	static void RemoveEntry(FShard& Shard, int32 Index);
+
+	FShard Shards[NumShards];
+
+	std::atomic<uint64> Hits = 0;
+	std::atomic<uint64> PartialHits = 0;
+	std::atomic<uint64> Misses = 0;
+	std::atomic<uint64> Evictions = 0;
+	std::atomic<uint64> Expirations = 0;
+};
@@ -0,0 +1,148 @@
+// Copyright (c) 2025, Futureverse Corporation Limited. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AssetRegisterDeadline.h"
+#include "AssetRegisterQueryingLibrary.h"
+#include "UObject/Object.h"
+#include <atomic>
+#include "AssetRegisterAssetStream.generated.h"
+
+/**
+ * The pages of a GetAssets query, requested by following PageInfo.EndCursor.
+ *
+ * Pages are requested as the consumer asks for them with Next, at most PrefetchDepth pages ahead of the one being
+ * returned, so a slow consumer holds the stream back instead of the pages piling up. A prefetched page is requested
+ * as soon as the end cursor of the one before it has been downloaded, while that one is still being decoded.
+ *
+ * With UAssetRegisterSettings::bAdaptivePageSize, the size of each page is picked by FAssetRegisterPageSizeTuner,
+ * and the pages the stream loads are reported back to it.
+ */
+class ASSETREGISTER_API FAssetRegisterAssetStream : public TSharedFromThis<FAssetRegisterAssetStream>
+{
+public:
+	/**
+	 * @param AssetsInput The connection input used to filter and sort assets. First is used as the page size (100 if unset).
+	 * @param MaxItems Number of assets after which the stream ends, 0 for no limit.
+	 * @param Deadline Bounds every page request of the stream.
+	 * @param PrefetchDepth Number of pages requested ahead, INDEX_NONE for UAssetRegisterSettings::PagePrefetchDepth.
+	 */
+	static TSharedRef<FAssetRegisterAssetStream> Create(const FAssetConnection& AssetsInput, int32 MaxItems = 0,
+		const FAssetRegisterDeadline& Deadline = FAssetRegisterDeadline(), int32 PrefetchDepth = INDEX_NONE);
+
+	/**
+	 * Requests the next page. Fails without a request if the stream has ended or the previous page hasn't completed yet.
+	 * A failed page request doesn't end the stream, so calling Next again retries it.
+	 */
+	TFuture<FLoadAssetsResult> Next();
+
+	/** Whether there may be another page, false once the last page or MaxItems was reached. */
+	bool HasNext() const { return !bDone; }
+
+	/** Whether a page was requested and hasn't completed yet. */
+	bool IsPending() const { return bPending; }
+
+	/** Number of assets the stream has returned so far. */
+	int32 GetNumItems() const { return NumItems; }
+
+	/** Number of pages the stream has returned so far. */
+	int32 GetNumPages() const { return NumPages; }
+
+private:
+	/** A requested page that wasn't returned yet. */
+	struct FPage
+	{
+		int32 First = 0;
+		double RequestTime = 0.0;
+		/** When the response was downloaded, 0 if it was served from a cache. */
+		double DownloadedTime = 0.0;
+		int64 NumBytes = 0;
+		/** Set once the end cursor is known, from the downloaded response or else from the decoded page. */
+		bool bPageInfoKnown = false;
+		FPageInfo PageInfo;
+		TOptional<FLoadAssetsResult> Result;
+	};
+
+	FAssetRegisterAssetStream(const FAssetConnection& InAssetsInput, int32 InMaxItems, const FAssetRegisterDeadline& InDeadline,
+		int32 InPrefetchDepth);
+
+	/** Requests the page following the cursor PageAfter, as the last one in Pages. */
+	void RequestPageLocked(const FString& PageAfter, int32 First);
+
+	/** Size of the next page to request, less than the page size if it would go past MaxItems. */
+	int32 GetNextPageSizeLocked() const;
+
+	/** Requests pages after the last one in Pages while their cursors are known, up to PrefetchDepth ahead. */
+	void PrefetchLocked();
+
+	void OnPageInfo(const TSharedRef<FPage>& Page, const FPageInfo& PageInfo, int64 NumBytes);
+
+	void OnPageLoaded(const TSharedRef<FPage>& Page, FLoadAssetsResult&& Result);
+
+	/** Drops the pages requested after Page, e.g. because they followed a cursor the decoded page doesn't agree with. */
+	void DropPagesAfterLocked(const TSharedRef<FPage>& Page);
+
+	/** Returns the first page to the consumer if it was asked for and has loaded. */
+	void ReturnLoadedPage();
+
+	FAssetConnection AssetsInput;
+	int32 PageSize = 0;
+	int32 MaxItems = 0;
+	FAssetRegisterDeadline Deadline;
+	int32 PrefetchDepth = 0;
+	/** Set if the page size is picked by FAssetRegisterPageSizeTuner, starting from PageSize. */
+	bool bAdaptivePageSize = false;
+	uint64 QueryShape = 0;
+
+	FCriticalSection CriticalSection;
+	/** Pages in cursor order, the first one is returned by the next call to Next. */
+	TArray<TSharedRef<FPage>> Pages;
+	/** Cursor of the last page returned. */
+	FString After;
+	/** Promise of the page the consumer is waiting for. */
+	TSharedPtr<TPromise<FLoadAssetsResult>> Waiting;
+
+	std::atomic<bool> bPending = false;
+	std::atomic<bool> bDone = false;
+	std::atomic<int32> NumItems = 0;
+	std::atomic<int32> NumPages = 0;
+};
+
+/**
+ * Delegate used for receiving a page of an asset stream.
+ *
+ * @param bSuccess Whether the page was loaded.
+ * @param bHasNextPage Whether the stream has another page to request.
+ * @param Page The assets of the page (if successful).
+ */
+DECLARE_DYNAMIC_DELEGATE_ThreeParams(FGetAssetsPageCompleted, bool, bSuccess, bool, bHasNextPage, const FAssets&, Page);
+
+/**
+ * Blueprint handle of an FAssetRegisterAssetStream, opened with UAssetRegisterQueryingLibrary::StreamAssets.
+ */
+UCLASS(BlueprintType)
+class ASSETREGISTER_API UAssetRegisterAssetStream : public UObject
+{
+	GENERATED_BODY()
+
+public:
+	void SetStream(const TSharedRef<FAssetRegisterAssetStream>& InStream) { Stream = InStream; }
+
+	/**
+	 * Requests the next page of the stream.
+	 *
+	 * @param OnPage Callback invoked when the page was loaded or failed.
+	 */
+	UFUNCTION(BlueprintCallable, meta = (AutoCreateRefTerm = "OnPage"))
+	void RequestNextPage(const FGetAssetsPageCompleted& OnPage);
+
+	UFUNCTION(BlueprintPure)
+	bool HasNextPage() const { return Stream.IsValid() && Stream->HasNext(); }
+
+	UFUNCTION(BlueprintPure)
+	int32 GetNumItems() const { return Stream.IsValid() ? Stream->GetNumItems() : 0; }
+
+private:
+	TSharedPtr<FAssetRegisterAssetStream> Stream;
+};
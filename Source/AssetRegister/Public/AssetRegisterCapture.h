@@ -0,0 +1,116 @@
+// Copyright (c) 2025, Futureverse Corporation Limited. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include <atomic>
+
+/**
+ * A request sent to the Asset Register and the response it got, see FAssetRegisterRecorder.
+ */
+struct FAssetRegisterCaptureEntry
+{
+	/** Name of the function that sent the request, e.g. FAssetRegisterRequest::Context. */
+	FString Context;
+
+	/** Seconds from the start of the capture to when the request was made, before it was queued. */
+	double SendTime = 0.0;
+
+	/** Seconds from sending the request to its response, without the time it was queued. */
+	double Duration = 0.0;
+
+	/** The HTTP status code, 0 if the request failed without a response. */
+	int32 ResponseCode = 0;
+
+	/** ETag and Last-Modified of the response, if it had them. */
+	FString ETag;
+	FString LastModified;
+
+	/** The UTF-8 {"query": ...} json body, also for requests sent as GET. */
+	TArray<uint8> RequestContent;
+
+	/** The UTF-8 response body. */
+	TArray<uint8> ResponseContent;
+
+	friend ASSETREGISTER_API FArchive& operator<<(FArchive& Ar, FAssetRegisterCaptureEntry& Entry);
+};
+
+/**
+ * Requests and responses recorded from real traffic, in the order they were made, to be replayed offline.
+ *
+ * Saved as a small versioned header followed by the zlib compressed entries. Queries and pages repeat most of their
+ * field names, so the file is a fraction of the size of the recorded json.
+ */
+struct ASSETREGISTER_API FAssetRegisterCapture
+{
+	TArray<FAssetRegisterCaptureEntry> Entries;
+
+	/** Saved/AssetRegister/Captures/Capture-<UTC time>.arcap */
+	static FString MakeDefaultPath();
+
+	bool SaveToFile(const FString& Path) const;
+
+	/**
+	 * Replaces Entries with the ones saved at Path.
+	 *
+	 * @return False if the file is missing, outdated or corrupt.
+	 */
+	bool LoadFromFile(const FString& Path);
+
+	/** Bytes of the recorded request and response bodies. */
+	int64 GetNumContentBytes() const;
+
+private:
+	static constexpr uint32 FileMagic = 0x50435241; // "ARCP"
+	static constexpr uint32 FileVersion = 1;
+};
+
+/**
+ * Records the requests FAssetRegisterTransport sends, with their responses and timing, e.g. during a playtest, so
+ * slow pages or giant inventories seen in the field can be replayed on a machine without network (see the ReplayTest
+ * automation test).
+ *
+ * `ar.capture start` starts recording and `ar.capture stop [Path]` saves what was recorded, by default to
+ * FAssetRegisterCapture::MakeDefaultPath. Running with -AssetRegisterCapture=<Path> records from startup and saves on
+ * shutdown. Requests cost nothing extra while not recording. Can be used from any thread.
+ */
+class ASSETREGISTER_API FAssetRegisterRecorder
+{
+public:
+	static FAssetRegisterRecorder& Get();
+
+	/**
+	 * Starts recording, dropping anything recorded before.
+	 *
+	 * @param InMaxContentBytes Requests past this many bytes of bodies are no longer recorded, so a long session
+	 * can't run out of memory.
+	 */
+	void Start(int64 InMaxContentBytes = 256 * 1024 * 1024);
+
+	/** Stops recording and returns what was recorded. */
+	FAssetRegisterCapture Stop();
+
+	bool IsRecording() const { return bRecording; }
+
+	/**
+	 * Starts an entry for a request about to be queued.
+	 *
+	 * @return The entry to fill in with the response and pass to Record, or null if not recording.
+	 */
+	TSharedPtr<FAssetRegisterCaptureEntry> BeginEntry(const TCHAR* Context, TConstArrayView<uint8> RequestContent) const;
+
+	/** Adds an entry started with BeginEntry, unless recording stopped in between. */
+	void Record(FAssetRegisterCaptureEntry&& Entry);
+
+private:
+	FAssetRegisterRecorder() = default;
+
+	mutable FCriticalSection CriticalSection;
+	FAssetRegisterCapture Capture;
+	int64 NumContentBytes = 0;
+	int64 MaxContentBytes = 0;
+	bool bDroppedEntries = false;
+
+	std::atomic<bool> bRecording = false;
+	std::atomic<double> StartTime = 0.0;
+};
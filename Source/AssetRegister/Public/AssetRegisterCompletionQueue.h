@@ -0,0 +1,86 @@
+// Copyright (c) 2025, Futureverse Corporation Limited. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AssetRegisterSettings.h"
+#include "Containers/Queue.h"
+#include "Containers/Ticker.h"
+#include <atomic>
+
+/**
+ * Counters of the FAssetRegisterCompletionQueue.
+ */
+struct FAssetRegisterCompletionQueueStats
+{
+	/** Completions waiting for the game thread. */
+	int32 NumQueued = 0;
+	uint64 NumDelivered = 0;
+	/** Most completions delivered in a single frame. */
+	int32 MaxDeliveredPerFrame = 0;
+	/** Frames that ran out of budget with completions left for the next frame. */
+	uint64 NumDeferredFrames = 0;
+};
+
+/**
+ * Delivers query completions on the game thread, spread over frames.
+ *
+ * Completions are queued from any thread into a lock-free queue, which the core ticker drains on the game thread once
+ * per frame until UAssetRegisterSettings::CompletionFrameBudget is spent. A burst of completions, e.g. every page of a
+ * large inventory arriving at once, then takes a few frames instead of hitching one.
+ */
+class ASSETREGISTER_API FAssetRegisterCompletionQueue
+{
+public:
+	static FAssetRegisterCompletionQueue& Get();
+
+	/** Queues Completion to be called on the game thread. Can be called from any thread. */
+	void Enqueue(TUniqueFunction<void()>&& Completion);
+
+	/**
+	 * Calls queued completions, in the order they were queued, until BudgetSeconds passed. Only called on the game
+	 * thread, once per frame by the core ticker.
+	 *
+	 * @return The number of completions called, at least one unless the queue was empty.
+	 */
+	int32 Drain(double BudgetSeconds);
+
+	/** Calls every queued completion and stops draining per frame, e.g. when the module shuts down. */
+	void Flush();
+
+	FAssetRegisterCompletionQueueStats GetStats() const;
+
+private:
+	FAssetRegisterCompletionQueue();
+
+	TQueue<TUniqueFunction<void()>, EQueueMode::Mpsc> Completions;
+	FTSTicker::FDelegateHandle TickerHandle;
+
+	std::atomic<int32> NumQueued = 0;
+	std::atomic<uint64> NumDelivered = 0;
+	std::atomic<int32> MaxDeliveredPerFrame = 0;
+	std::atomic<uint64> NumDeferredFrames = 0;
+};
+
+/**
+ * Overrides UAssetRegisterSettings::CompletionPolicy for the queries started on this thread while it is in scope.
+ *
+ *	FAssetRegisterCompletionScope Scope(EAssetRegisterCompletionPolicy::GameThread);
+ *	UAssetRegisterQueryingLibrary::GetAllAssets(AssetsInput, Deadline).Next(...);
+ */
+class ASSETREGISTER_API FAssetRegisterCompletionScope
+{
+public:
+	explicit FAssetRegisterCompletionScope(EAssetRegisterCompletionPolicy InPolicy);
+	~FAssetRegisterCompletionScope();
+
+	FAssetRegisterCompletionScope(const FAssetRegisterCompletionScope&) = delete;
+	FAssetRegisterCompletionScope& operator=(const FAssetRegisterCompletionScope&) = delete;
+
+	/** The policy of the innermost scope on this thread, or the one in UAssetRegisterSettings outside of any. */
+	static EAssetRegisterCompletionPolicy GetCurrentPolicy();
+
+private:
+	EAssetRegisterCompletionPolicy Policy;
+	const FAssetRegisterCompletionScope* OuterScope;
+};
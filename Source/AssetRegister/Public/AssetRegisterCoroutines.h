@@ -0,0 +1,339 @@
+// Copyright (c) 2025, Futureverse Corporation Limited. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AssetRegisterCompletionQueue.h"
+#include "AssetRegisterLog.h"
+#include "AssetRegisterQueryingLibrary.h"
+#include "Async/Async.h"
+#include <atomic>
+
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+#define WITH_ASSETREGISTER_COROUTINES 1
+#else
+#define WITH_ASSETREGISTER_COROUTINES 0
+#endif
+
+/**
+ * Cancels the coroutine steps awaited with it, see TAssetRegisterAwaitable::WithCancellation. Copies share the same
+ * state, so one token can be handed to every step of a flow and cancelled from anywhere.
+ */
+class ASSETREGISTER_API FAssetRegisterCancellationToken
+{
+public:
+	FAssetRegisterCancellationToken();
+
+	/** Cancels the token, calling every subscribed callback on this thread. Later calls do nothing. */
+	void Cancel();
+
+	bool IsCancelled() const;
+
+	/**
+	 * Calls OnCancel once the token is cancelled, right away if it already is.
+	 *
+	 * @return A handle for Unsubscribe, INDEX_NONE if OnCancel was called right away.
+	 */
+	int32 Subscribe(TUniqueFunction<void()>&& OnCancel) const;
+
+	void Unsubscribe(int32 Handle) const;
+
+private:
+	struct FState
+	{
+		FCriticalSection CriticalSection;
+		bool bCancelled = false;
+		int32 NextHandle = 0;
+		TMap<int32, TUniqueFunction<void()>> Callbacks;
+	};
+
+	TSharedRef<FState> State;
+};
+
+#if WITH_ASSETREGISTER_COROUTINES
+
+#include <coroutine>
+
+namespace AssetRegisterCoroutines
+{
+	/** Whether code running on this thread runs where Policy completes queries. Inline is any thread. */
+	inline bool IsOnThread(EAssetRegisterCompletionPolicy Policy)
+	{
+		switch (Policy)
+		{
+		case EAssetRegisterCompletionPolicy::GameThread:
+			return IsInGameThread();
+		case EAssetRegisterCompletionPolicy::Worker:
+			return !IsInGameThread();
+		default:
+			return true;
+		}
+	}
+
+	/** Resumes Handle on the thread Policy completes queries on, right here if this is one. */
+	inline void Resume(std::coroutine_handle<> Handle, EAssetRegisterCompletionPolicy Policy)
+	{
+		if (IsOnThread(Policy))
+		{
+			Handle.resume();
+		}
+		else if (Policy == EAssetRegisterCompletionPolicy::GameThread)
+		{
+			FAssetRegisterCompletionQueue::Get().Enqueue([Handle]() { Handle.resume(); });
+		}
+		else
+		{
+			AsyncTask(ENamedThreads::AnyBackgroundThreadNormalTask, [Handle]() { Handle.resume(); });
+		}
+	}
+}
+
+/**
+ * Awaits a TFuture in a coroutine. The result is moved out of the future into the awaiting coroutine's frame, and
+ * co_await returns it by value.
+ *
+ * Without WithCancellation, awaiting only costs the continuation TFuture::Then allocates anyway.
+ */
+template<typename T>
+class TAssetRegisterAwaitable
+{
+public:
+	explicit TAssetRegisterAwaitable(TFuture<T>&& InFuture)
+		: Future(MoveTemp(InFuture))
+	{
+	}
+
+	/** Resumes the awaiting coroutine on the thread Policy completes queries on. Inline by default. */
+	TAssetRegisterAwaitable&& ResumeOn(EAssetRegisterCompletionPolicy InPolicy) &&
+	{
+		Policy = InPolicy;
+		return MoveTemp(*this);
+	}
+
+	/**
+	 * Destroys the awaiting coroutine instead of resuming it if Token is cancelled before the future completes.
+	 * Destroying a coroutine that returns a TAssetRegisterTask completes its future with a default constructed value, a failure
+	 * for TLoadResult, so cancellation propagates to the coroutines awaiting it. The request the future waits for
+	 * isn't aborted, its result is dropped.
+	 */
+	TAssetRegisterAwaitable&& WithCancellation(const FAssetRegisterCancellationToken& InToken) &&
+	{
+		Token = InToken;
+		return MoveTemp(*this);
+	}
+
+	bool await_ready() const
+	{
+		return Future.IsReady() && (!Token.IsSet() || !Token->IsCancelled()) && AssetRegisterCoroutines::IsOnThread(Policy);
+	}
+
+	void await_suspend(std::coroutine_handle<> Handle)
+	{
+		// the coroutine may be resumed or destroyed from another thread as soon as the continuation is set, after
+		// which this awaiter, living in the coroutine frame, must not be touched
+		TFuture<T> LocalFuture = MoveTemp(Future);
+		const EAssetRegisterCompletionPolicy LocalPolicy = Policy;
+
+		if (!Token.IsSet())
+		{
+			LocalFuture.Then([this, Handle, LocalPolicy](TFuture<T> Self)
+			{
+				Result.Emplace(Self.Consume());
+				AssetRegisterCoroutines::Resume(Handle, LocalPolicy);
+			});
+			return;
+		}
+
+		// whichever of the future and the token comes first resumes or destroys the coroutine
+		const FAssetRegisterCancellationToken LocalToken = Token.GetValue();
+		TSharedRef<std::atomic<bool>> bSettled = MakeShared<std::atomic<bool>>(false);
+		const int32 Subscription = LocalToken.Subscribe([Handle, bSettled]()
+		{
+			if (!bSettled->exchange(true))
+			{
+				Handle.destroy();
+			}
+		});
+
+		LocalFuture.Then([this, Handle, LocalPolicy, LocalToken, Subscription, bSettled](TFuture<T> Self)
+		{
+			if (!bSettled->exchange(true))
+			{
+				LocalToken.Unsubscribe(Subscription);
+				Result.Emplace(Self.Consume());
+				AssetRegisterCoroutines::Resume(Handle, LocalPolicy);
+			}
+		});
+	}
+
+	T await_resume()
+	{
+		if (!Result.IsSet())
+		{
+			// await_ready let the coroutine continue without suspending
+			Result.Emplace(Future.Consume());
+		}
+		return MoveTemp(Result.GetValue());
+	}
+
+private:
+	TFuture<T> Future;
+	TOptional<T> Result;
+	EAssetRegisterCompletionPolicy Policy = EAssetRegisterCompletionPolicy::Inline;
+	TOptional<FAssetRegisterCancellationToken> Token;
+};
+
+template<typename T>
+class TAssetRegisterTask;
+
+namespace AssetRegisterCoroutines
+{
+	/**
+	 * The promise of a TAssetRegisterTask coroutine. A coroutine that is destroyed before returning, i.e. cancelled,
+	 * completes its future with a default constructed value.
+	 */
+	template<typename T>
+	struct TTaskPromiseBase
+	{
+		TPromise<T> Promise;
+		bool bReturned = false;
+
+		~TTaskPromiseBase()
+		{
+			if (!bReturned)
+			{
+				if constexpr (std::is_void_v<T>)
+				{
+					Promise.SetValue();
+				}
+				else
+				{
+					Promise.SetValue(T());
+				}
+			}
+		}
+
+		TAssetRegisterTask<T> get_return_object() { return TAssetRegisterTask<T>(Promise.GetFuture()); }
+		std::suspend_never initial_suspend() noexcept { return {}; }
+		std::suspend_never final_suspend() noexcept { return {}; }
+
+		void unhandled_exception()
+		{
+			// the frame is destroyed right after, completing the future as if the coroutine was cancelled
+			UE_LOG(LogAssetRegister, Error, TEXT("TAssetRegisterTask coroutine exited with an exception"));
+		}
+	};
+
+	template<typename T>
+	struct TTaskPromise : TTaskPromiseBase<T>
+	{
+		void return_value(T Value)
+		{
+			this->bReturned = true;
+			this->Promise.SetValue(MoveTemp(Value));
+		}
+	};
+
+	template<>
+	struct TTaskPromise<void> : TTaskPromiseBase<void>
+	{
+		void return_void()
+		{
+			bReturned = true;
+			Promise.SetValue();
+		}
+	};
+}
+
+/**
+ * The return type of an Asset Register coroutine. Converts to the TFuture that completes with its co_return value,
+ * and can itself be co_awaited (see TAssetRegisterAwaitable), so coroutines compose:
+ *
+ *	TAssetRegisterTask<int32> CountAssets(FAssetConnection Input);
+ *	TFuture<int32> Count = CountAssets(Input);
+ */
+template<typename T>
+class TAssetRegisterTask
+{
+public:
+	using promise_type = AssetRegisterCoroutines::TTaskPromise<T>;
+
+	explicit TAssetRegisterTask(TFuture<T>&& InFuture)
+		: Future(MoveTemp(InFuture))
+	{
+	}
+
+	operator TFuture<T>() &&
+	{
+		return MoveTemp(Future);
+	}
+
+	TFuture<T> GetFuture() &&
+	{
+		return MoveTemp(Future);
+	}
+
+	/** Awaits the task, resuming inline. Use AssetRegisterCoroutines::Await for another thread. */
+	TAssetRegisterAwaitable<T> operator co_await() &&
+	{
+		return TAssetRegisterAwaitable<T>(MoveTemp(Future));
+	}
+
+private:
+	TFuture<T> Future;
+};
+
+/**
+ * Awaitable versions of the UAssetRegisterQueryingLibrary queries, so flows like paging through an inventory,
+ * resolving links and fetching profiles can be written top to bottom:
+ *
+ *	TAssetRegisterTask<int32> CountEquipped(FAssetConnection Input, FAssetRegisterCancellationToken Token)
+ *	{
+ *		FLoadAssetsResult Page = co_await AssetRegisterCoroutines::GetAssets(Input, EAssetRegisterCompletionPolicy::GameThread)
+ *			.WithCancellation(Token);
+ *		...
+ *	}
+ *
+ * ResumeOn is also the completion policy the query is started with (see FAssetRegisterCompletionScope), so its
+ * response is decoded off the game thread unless ResumeOn is Inline.
+ */
+namespace AssetRegisterCoroutines
+{
+	/** Awaits a TFuture, which has no co_await of its own. */
+	template<typename T>
+	TAssetRegisterAwaitable<T> Await(TFuture<T>&& Future, EAssetRegisterCompletionPolicy ResumeOn = EAssetRegisterCompletionPolicy::Inline)
+	{
+		return TAssetRegisterAwaitable<T>(MoveTemp(Future)).ResumeOn(ResumeOn);
+	}
+
+	template<typename T>
+	TAssetRegisterAwaitable<T> Await(TAssetRegisterTask<T>&& Task, EAssetRegisterCompletionPolicy ResumeOn = EAssetRegisterCompletionPolicy::Inline)
+	{
+		return Await(MoveTemp(Task).GetFuture(), ResumeOn);
+	}
+
+	ASSETREGISTER_API TAssetRegisterAwaitable<FLoadJsonResult> GetAssetProfile(const FString& TokenId, const FString& CollectionId,
+		EAssetRegisterCompletionPolicy ResumeOn = EAssetRegisterCompletionPolicy::Inline, const FAssetRegisterDeadline& Deadline = FAssetRegisterDeadline());
+
+	ASSETREGISTER_API TAssetRegisterAwaitable<FLoadAssetResult> GetAssetLinks(const FString& TokenId, const FString& CollectionId,
+		EAssetRegisterCompletionPolicy ResumeOn = EAssetRegisterCompletionPolicy::Inline, const FAssetRegisterDeadline& Deadline = FAssetRegisterDeadline());
+
+	ASSETREGISTER_API TAssetRegisterAwaitable<FLoadAssetsResult> GetAssets(const FAssetConnection& AssetsInput,
+		EAssetRegisterCompletionPolicy ResumeOn = EAssetRegisterCompletionPolicy::Inline, const FAssetRegisterDeadline& Deadline = FAssetRegisterDeadline());
+
+	ASSETREGISTER_API TAssetRegisterAwaitable<FLoadAssetsResult> GetAllAssets(const FAssetConnection& AssetsInput,
+		EAssetRegisterCompletionPolicy ResumeOn = EAssetRegisterCompletionPolicy::Inline, const FAssetRegisterDeadline& Deadline = FAssetRegisterDeadline());
+
+	ASSETREGISTER_API TAssetRegisterAwaitable<FString> SendRequest(const FString& Content,
+		EAssetRegisterCompletionPolicy ResumeOn = EAssetRegisterCompletionPolicy::Inline);
+
+	/** See UAssetRegisterQueryingLibrary::MakeAssetQuery with an FAssetInput. */
+	ASSETREGISTER_API TAssetRegisterAwaitable<FLoadAssetResult> MakeAssetQuery(const FAssetInput& Input, const TSharedPtr<FQueryNode<FAsset>>& AssetQuery,
+		EAssetRegisterCompletionPolicy ResumeOn = EAssetRegisterCompletionPolicy::Inline, const FAssetRegisterDeadline& Deadline = FAssetRegisterDeadline());
+
+	/** Sends a custom assets query, e.g. one built with FAssetRegisterQueryBuilder::AddAssetsQuery. */
+	ASSETREGISTER_API TAssetRegisterAwaitable<FLoadAssetsResult> MakeAssetsQuery(const TSharedPtr<FQueryNode<FAssets>>& AssetsQuery,
+		EAssetRegisterCompletionPolicy ResumeOn = EAssetRegisterCompletionPolicy::Inline, const FAssetRegisterDeadline& Deadline = FAssetRegisterDeadline());
+}
+
+#endif
@@ -0,0 +1,50 @@
+// Copyright (c) 2025, Futureverse Corporation Limited. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * A point in time by which an operation, and every request it sends, has to be finished.
+ *
+ * Passed down from API calls to each HTTP request they make: requests use the remaining budget as their timeout,
+ * and work that would start after the deadline is dropped. A default constructed deadline never expires.
+ */
+struct FAssetRegisterDeadline
+{
+	FAssetRegisterDeadline() {}
+
+	/** A deadline Seconds from now. */
+	static FAssetRegisterDeadline After(const double Seconds)
+	{
+		FAssetRegisterDeadline Deadline;
+		Deadline.ExpiresAt = FPlatformTime::Seconds() + Seconds;
+		return Deadline;
+	}
+
+	/** Whether this deadline was set at all. */
+	bool IsSet() const
+	{
+		return ExpiresAt < TNumericLimits<double>::Max();
+	}
+
+	bool HasExpired() const
+	{
+		return IsSet() && FPlatformTime::Seconds() >= ExpiresAt;
+	}
+
+	/** Seconds left until the deadline, 0 once it expired. */
+	double GetRemainingSeconds() const
+	{
+		return IsSet() ? FMath::Max(0.0, ExpiresAt - FPlatformTime::Seconds()) : TNumericLimits<double>::Max();
+	}
+
+	/** The timeout to use for a request sent now: the remaining budget, capped by the default request timeout. */
+	float GetRequestTimeout(const float DefaultTimeout) const
+	{
+		return IsSet() ? static_cast<float>(FMath::Min<double>(DefaultTimeout, GetRemainingSeconds())) : DefaultTimeout;
+	}
+
+private:
+	double ExpiresAt = TNumericLimits<double>::Max();
+};
@@ -0,0 +1,281 @@
+// Copyright (c) 2025, Futureverse Corporation Limited. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Async/Future.h"
+#include "Containers/Ticker.h"
+#include <atomic>
+
+/**
+ * Combinators over TFutures, e.g. for the per-asset decodes of a page or the sub-queries of a partitioned fetch.
+ *
+ * Each combinator allocates a single shared state, holding its promise and one preallocated slot per future. A future
+ * completes into its own slot, so results keep the order of the futures, whatever order they complete in and on
+ * whichever thread. Results are moved into their slot, and the slots are moved into the returned future.
+ *
+ * A TFuture can't fail, so whether a result is a failure is up to its type, e.g. TLoadResult::bSuccess. WhenAllSettled
+ * therefore only differs from WhenAll in how it handles a timeout. Timeouts are counted on the core ticker, and
+ * futures completing after the combinator resolved are ignored.
+ */
+namespace AssetRegisterFutures
+{
+	namespace Private
+	{
+		/** Calls OnTimeout on the core ticker after TimeoutSeconds, if State is still alive then. */
+		template<typename TState>
+		void AddTimeout(const TSharedRef<TState>& State, float TimeoutSeconds, void (*OnTimeout)(TState&))
+		{
+			FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda([WeakState = TWeakPtr<TState>(State), OnTimeout](float)
+			{
+				if (const TSharedPtr<TState> PinnedState = WeakState.Pin())
+				{
+					OnTimeout(*PinnedState);
+				}
+				return false;
+			}), TimeoutSeconds);
+		}
+	}
+
+	/**
+	 * Resolves with the results of every future, in the order of Futures, once the last one completed.
+	 */
+	template<typename T>
+	TFuture<TArray<T>> WhenAll(TArray<TFuture<T>>&& Futures)
+	{
+		struct FState
+		{
+			TPromise<TArray<T>> Promise;
+			TArray<T> Results;
+			std::atomic<int32> NumPending = 0;
+		};
+
+		if (Futures.IsEmpty())
+		{
+			return MakeFulfilledPromise<TArray<T>>(TArray<T>()).GetFuture();
+		}
+
+		const TSharedRef<FState> State = MakeShared<FState>();
+		State->Results.SetNum(Futures.Num());
+		State->NumPending = Futures.Num();
+		TFuture<TArray<T>> Future = State->Promise.GetFuture();
+
+		for (int32 Index = 0; Index < Futures.Num(); ++Index)
+		{
+			Futures[Index].Next([State, Index](T Result)
+			{
+				State->Results[Index] = MoveTemp(Result);
+				// the last future to complete sees every slot the others wrote
+				if (State->NumPending.fetch_sub(1, std::memory_order_acq_rel) == 1)
+				{
+					State->Promise.SetValue(MoveTemp(State->Results));
+				}
+			});
+		}
+		return Future;
+	}
+
+	/**
+	 * WhenAll that gives up after TimeoutSeconds, resolving with an unset value if a future hadn't completed by then.
+	 */
+	template<typename T>
+	TFuture<TOptional<TArray<T>>> WhenAll(TArray<TFuture<T>>&& Futures, float TimeoutSeconds)
+	{
+		struct FState
+		{
+			FCriticalSection CriticalSection;
+			TPromise<TOptional<TArray<T>>> Promise;
+			TArray<T> Results;
+			int32 NumPending = 0;
+			bool bDone = false;
+		};
+
+		if (Futures.IsEmpty())
+		{
+			return MakeFulfilledPromise<TOptional<TArray<T>>>(TArray<T>()).GetFuture();
+		}
+
+		const TSharedRef<FState> State = MakeShared<FState>();
+		State->Results.SetNum(Futures.Num());
+		State->NumPending = Futures.Num();
+		TFuture<TOptional<TArray<T>>> Future = State->Promise.GetFuture();
+
+		for (int32 Index = 0; Index < Futures.Num(); ++Index)
+		{
+			Futures[Index].Next([State, Index](T Result)
+			{
+				TArray<T> Results;
+				{
+					FScopeLock Lock(&State->CriticalSection);
+					if (State->bDone)
+					{
+						return;
+					}
+					State->Results[Index] = MoveTemp(Result);
+					if (--State->NumPending > 0)
+					{
+						return;
+					}
+					State->bDone = true;
+					Results = MoveTemp(State->Results);
+				}
+				State->Promise.SetValue(MoveTemp(Results));
+			});
+		}
+
+		Private::AddTimeout<FState>(State, TimeoutSeconds, [](FState& TimedOutState)
+		{
+			{
+				FScopeLock Lock(&TimedOutState.CriticalSection);
+				if (TimedOutState.bDone)
+				{
+					return;
+				}
+				TimedOutState.bDone = true;
+			}
+			TimedOutState.Promise.SetValue(TOptional<TArray<T>>());
+		});
+		return Future;
+	}
+
+	/**
+	 * Resolves once every future completed or TimeoutSeconds passed, with the result of each future that completed
+	 * in time, in the order of Futures, and an unset value for the others.
+	 */
+	template<typename T>
+	TFuture<TArray<TOptional<T>>> WhenAllSettled(TArray<TFuture<T>>&& Futures, float TimeoutSeconds)
+	{
+		struct FState
+		{
+			FCriticalSection CriticalSection;
+			TPromise<TArray<TOptional<T>>> Promise;
+			TArray<TOptional<T>> Results;
+			int32 NumPending = 0;
+			bool bDone = false;
+		};
+
+		if (Futures.IsEmpty())
+		{
+			return MakeFulfilledPromise<TArray<TOptional<T>>>(TArray<TOptional<T>>()).GetFuture();
+		}
+
+		const TSharedRef<FState> State = MakeShared<FState>();
+		State->Results.SetNum(Futures.Num());
+		State->NumPending = Futures.Num();
+		TFuture<TArray<TOptional<T>>> Future = State->Promise.GetFuture();
+
+		for (int32 Index = 0; Index < Futures.Num(); ++Index)
+		{
+			Futures[Index].Next([State, Index](T Result)
+			{
+				TArray<TOptional<T>> Results;
+				{
+					FScopeLock Lock(&State->CriticalSection);
+					if (State->bDone)
+					{
+						return;
+					}
+					State->Results[Index].Emplace(MoveTemp(Result));
+					if (--State->NumPending > 0)
+					{
+						return;
+					}
+					State->bDone = true;
+					Results = MoveTemp(State->Results);
+				}
+				State->Promise.SetValue(MoveTemp(Results));
+			});
+		}
+
+		Private::AddTimeout<FState>(State, TimeoutSeconds, [](FState& TimedOutState)
+		{
+			TArray<TOptional<T>> Results;
+			{
+				FScopeLock Lock(&TimedOutState.CriticalSection);
+				if (TimedOutState.bDone)
+				{
+					return;
+				}
+				TimedOutState.bDone = true;
+				Results = MoveTemp(TimedOutState.Results);
+			}
+			TimedOutState.Promise.SetValue(MoveTemp(Results));
+		});
+		return Future;
+	}
+
+	/**
+	 * Resolves with the index and result of the first future to complete. Resolves with INDEX_NONE if Futures is empty.
+	 */
+	template<typename T>
+	TFuture<TPair<int32, T>> WhenAny(TArray<TFuture<T>>&& Futures)
+	{
+		struct FState
+		{
+			TPromise<TPair<int32, T>> Promise;
+			std::atomic<bool> bDone = false;
+		};
+
+		if (Futures.IsEmpty())
+		{
+			return MakeFulfilledPromise<TPair<int32, T>>(TPair<int32, T>(INDEX_NONE, T())).GetFuture();
+		}
+
+		const TSharedRef<FState> State = MakeShared<FState>();
+		TFuture<TPair<int32, T>> Future = State->Promise.GetFuture();
+
+		for (int32 Index = 0; Index < Futures.Num(); ++Index)
+		{
+			Futures[Index].Next([State, Index](T Result)
+			{
+				if (!State->bDone.exchange(true))
+				{
+					State->Promise.SetValue(TPair<int32, T>(Index, MoveTemp(Result)));
+				}
+			});
+		}
+		return Future;
+	}
+
+	/**
+	 * WhenAny that gives up after TimeoutSeconds, resolving with an unset value if no future had completed by then.
+	 * Resolves with an unset value right away if Futures is empty.
+	 */
+	template<typename T>
+	TFuture<TOptional<TPair<int32, T>>> WhenAny(TArray<TFuture<T>>&& Futures, float TimeoutSeconds)
+	{
+		struct FState
+		{
+			TPromise<TOptional<TPair<int32, T>>> Promise;
+			std::atomic<bool> bDone = false;
+		};
+
+		if (Futures.IsEmpty())
+		{
+			return MakeFulfilledPromise<TOptional<TPair<int32, T>>>(TOptional<TPair<int32, T>>()).GetFuture();
+		}
+
+		const TSharedRef<FState> State = MakeShared<FState>();
+		TFuture<TOptional<TPair<int32, T>>> Future = State->Promise.GetFuture();
+
+		for (int32 Index = 0; Index < Futures.Num(); ++Index)
+		{
+			Futures[Index].Next([State, Index](T Result)
+			{
+				if (!State->bDone.exchange(true))
+				{
+					State->Promise.SetValue(TPair<int32, T>(Index, MoveTemp(Result)));
+				}
+			});
+		}
+
+		Private::AddTimeout<FState>(State, TimeoutSeconds, [](FState& TimedOutState)
+		{
+			if (!TimedOutState.bDone.exchange(true))
+			{
+				TimedOutState.Promise.SetValue(TOptional<TPair<int32, T>>());
+			}
+		});
+		return Future;
+	}
+}
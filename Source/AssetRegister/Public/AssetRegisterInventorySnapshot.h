@@ -0,0 +1,130 @@
+// Copyright (c) 2025, Futureverse Corporation Limited. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AssetRegisterAssetCache.h"
+#include "AssetRegisterDeadline.h"
+#include "AssetRegisterQueryingLibrary.h"
+#include "UObject/GCObject.h"
+#include <atomic>
+
+/**
+ * What changed in an inventory between two refreshes of an FAssetRegisterInventorySnapshot.
+ */
+struct FAssetRegisterInventoryDiff
+{
+	/** Assets that weren't in the previous snapshot. */
+	TArray<FAsset> Added;
+	/** Assets whose node is different from the one in the previous snapshot, as decoded now. */
+	TArray<FAsset> Changed;
+	/** Assets of the previous snapshot that are gone. */
+	TArray<FAssetRegisterAssetKey> Removed;
+	/** Assets whose node is unchanged, and which were reused from the previous snapshot without being decoded. */
+	int32 NumUnchanged = 0;
+
+	bool IsEmpty() const
+	{
+		return Added.IsEmpty() && Changed.IsEmpty() && Removed.IsEmpty();
+	}
+};
+
+struct FLoadInventoryDiffResult final : TLoadResult<FAssetRegisterInventoryDiff> {};
+
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnAssetRegisterInventoryChanged, const FAssetRegisterInventoryDiff&);
+
+/**
+ * The assets of a GetAssets query as of its last refresh, e.g. a player's inventory, so a refresh can report what
+ * changed instead of replacing everything.
+ *
+ * The snapshot keeps a hash of the raw bytes of every node next to the asset decoded from it. A refreshed page is
+ * split into its nodes without parsing them, and only nodes whose hash isn't in the snapshot are decoded. The rest
+ * reuse the asset decoded by an earlier refresh.
+ */
+class ASSETREGISTER_API FAssetRegisterInventorySnapshot : public TSharedFromThis<FAssetRegisterInventorySnapshot>, public FGCObject
+{
+public:
+	/**
+	 * @param AssetsInput The connection input used to filter and sort assets. First is used as the page size (100 if unset).
+	 */
+	static TSharedRef<FAssetRegisterInventorySnapshot> Create(const FAssetConnection& AssetsInput);
+
+	/**
+	 * Loads every page of the query again and diffs it against the snapshot, which then holds the new inventory.
+	 * The first refresh reports every asset as added. A failed page, or a node in it that can't be decoded, fails the
+	 * refresh and keeps the snapshot as it was.
+	 * Fails without a request while another refresh is pending.
+	 */
+	TFuture<FLoadInventoryDiffResult> Refresh(const FAssetRegisterDeadline& Deadline = FAssetRegisterDeadline());
+
+	/**
+	 * Diffs the response bodies of every page of the query, e.g. recorded ones, against the snapshot like Refresh
+	 * does with downloaded pages. Fails while a refresh is pending.
+	 */
+	FLoadInventoryDiffResult ApplyResponses(TConstArrayView<TArray<uint8>> PageResponses);
+
+	/** The assets as of the last refresh, in query order. */
+	FAssets GetAssets() const;
+
+	int32 GetNumAssets() const;
+
+	/** Whether a refresh was started and hasn't completed yet. */
+	bool IsPending() const { return bPending; }
+
+	/** Broadcast after every refresh that added, removed or changed an asset. */
+	FOnAssetRegisterInventoryChanged OnChanged;
+
+	//~ FGCObject
+	virtual void AddReferencedObjects(FReferenceCollector& Collector) override;
+	virtual FString GetReferencerName() const override;
+
+private:
+	struct FNode
+	{
+		/** CityHash64 of the raw node bytes. */
+		uint64 Hash = 0;
+		FString Cursor;
+		FAsset Asset;
+	};
+
+	/** The nodes of a refresh in progress. */
+	struct FRefresh
+	{
+		TArray<FNode> Nodes;
+		TSet<FAssetRegisterAssetKey> Keys;
+		FAssetRegisterInventoryDiff Diff;
+		FAssetConnection PageInput;
+		FAssetRegisterDeadline Deadline;
+		TPromise<FLoadInventoryDiffResult> Promise;
+	};
+
+	explicit FAssetRegisterInventorySnapshot(const FAssetConnection& InAssetsInput);
+
+	void RequestPage(const TSharedRef<FRefresh>& InRefresh);
+
+	/**
+	 * Adds the nodes of a page response to Refresh, decoding only those that aren't in the snapshot.
+	 *
+	 * @return False if the response isn't an Assets response or one of its new nodes can't be decoded.
+	 */
+	bool ApplyPage(FRefresh& InRefresh, TConstArrayView<uint8> Response, FPageInfo& OutPageInfo) const;
+
+	/** Fills in the removed assets of Refresh and replaces the snapshot with its nodes. */
+	void Commit(FRefresh& InRefresh);
+
+	/** Completes a refresh, broadcasting OnChanged if anything changed. */
+	FLoadInventoryDiffResult Finish(FRefresh& InRefresh, bool bSuccess);
+
+	FAssetConnection AssetsInput;
+
+	mutable FCriticalSection CriticalSection;
+	TArray<FNode> Nodes;
+	/** Index in Nodes of every node hash. */
+	TMap<uint64, int32> NodesByHash;
+	/** Index in Nodes of every asset. */
+	TMap<FAssetRegisterAssetKey, int32> NodesByKey;
+
+	/** Nodes of the refresh in progress, kept alive for garbage collection. */
+	TSharedPtr<FRefresh> Pending;
+	std::atomic<bool> bPending = false;
+};
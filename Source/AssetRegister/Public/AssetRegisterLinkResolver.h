@@ -0,0 +1,103 @@
+// Copyright (c) 2025, Futureverse Corporation Limited. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AssetRegisterAssetCache.h"
+#include "AssetRegisterDeadline.h"
+#include "AssetRegisterQueryingLibrary.h"
+#include "UObject/GCObject.h"
+
+/**
+ * A link from an asset to one of its children.
+ */
+struct FAssetRegisterLinkEdge
+{
+	/** The path the child is linked at, as in FLink::Path. */
+	FString Path;
+	/** Index of the child in FAssetRegisterLinkGraph::Nodes. */
+	int32 Child = INDEX_NONE;
+};
+
+/**
+ * An asset of an FAssetRegisterLinkGraph.
+ */
+struct FAssetRegisterLinkNode
+{
+	FAssetRegisterAssetKey Key;
+	/** The asset with its links, set if bResolved. */
+	FAsset Asset;
+	/** Number of links between the root and the asset, along the shortest path. */
+	int32 Depth = 0;
+	/** Whether the asset's links were loaded. False if it is at the depth limit or its request failed. */
+	bool bResolved = false;
+	TArray<FAssetRegisterLinkEdge> Children;
+};
+
+/**
+ * The assets reachable from a root asset through child links, each held once however many assets link to it.
+ */
+struct FAssetRegisterLinkGraph
+{
+	/** Every asset reached, in breadth-first order, so the root is first. */
+	TArray<FAssetRegisterLinkNode> Nodes;
+	/** Index in Nodes of every asset. */
+	TMap<FAssetRegisterAssetKey, int32> NodeIndices;
+	/** Number of levels whose links were loaded, with at most one request each. */
+	int32 NumLevels = 0;
+
+	const FAssetRegisterLinkNode* Find(const FAssetRegisterAssetKey& Key) const
+	{
+		const int32* Index = NodeIndices.Find(Key);
+		return Index ? &Nodes[*Index] : nullptr;
+	}
+};
+
+struct FLoadLinkGraphResult final : TLoadResult<FAssetRegisterLinkGraph> {};
+
+/**
+ * Resolves the child links of an asset, and the links of its children, breadth first.
+ *
+ * The links of every asset on a level are loaded together with UAssetRegisterQueryingLibrary::GetAssetsBatched, so
+ * resolving a graph takes one request per level rather than one per asset. An asset that is linked to again, by
+ * another parent or by a cycle, is linked to the node already in the graph instead of being resolved again.
+ *
+ * The link objects of the assets resolved so far are kept alive for garbage collection until the graph is returned.
+ */
+class ASSETREGISTER_API FAssetRegisterLinkResolver : public TSharedFromThis<FAssetRegisterLinkResolver>, public FGCObject
+{
+public:
+	/**
+	 * @param Root The asset to start from.
+	 * @param MaxDepth Number of levels of children below the root. Assets at MaxDepth are added to the graph, but
+	 * their links aren't loaded.
+	 * @param Deadline Bounds the whole resolution. A graph cut short by it is returned as a partial result.
+	 * @return Fails if the root's links couldn't be loaded. A graph where other assets failed is a partial result.
+	 */
+	static TFuture<FLoadLinkGraphResult> Resolve(const FAssetRegisterAssetKey& Root, int32 MaxDepth,
+		const FAssetRegisterDeadline& Deadline = FAssetRegisterDeadline());
+
+	//~ FGCObject
+	virtual void AddReferencedObjects(FReferenceCollector& Collector) override;
+	virtual FString GetReferencerName() const override;
+
+private:
+	FAssetRegisterLinkResolver(int32 InMaxDepth, const FAssetRegisterDeadline& InDeadline);
+
+	/** Adds an unresolved node for Key, and returns its index. */
+	int32 AddNode(const FAssetRegisterAssetKey& Key, int32 Depth);
+
+	/** Loads the links of the nodes at Level, then of the children they add, until no level is left. */
+	void ResolveLevel(TArray<int32>&& Level);
+
+	void Finish();
+
+	int32 MaxDepth = 1;
+	FAssetRegisterDeadline Deadline;
+
+	/** Guards Graph against garbage collection while a level is added to it. */
+	FCriticalSection CriticalSection;
+	FAssetRegisterLinkGraph Graph;
+	bool bPartial = false;
+	TPromise<FLoadLinkGraphResult> Promise;
+};
@@ -0,0 +1,121 @@
+// Copyright (c) 2025, Futureverse Corporation Limited. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AssetRegisterAssetCache.h"
+#include "Schemas/Link.h"
+
+/**
+ * A child an asset links to, as known to FAssetRegisterLinkStore.
+ */
+struct FAssetRegisterChildLink
+{
+	/** The path the child is linked at, as in FLink::Path. */
+	FString Path;
+	FAssetRegisterAssetKey Child;
+};
+
+/**
+ * Counters of the FAssetRegisterLinkStore.
+ */
+struct FAssetRegisterLinkStoreStats
+{
+	int32 NumAssets = 0;
+	int32 NumLinks = 0;
+	/** Assets whose links were dropped because their owner changed. */
+	uint64 NumOwnerChanges = 0;
+};
+
+/**
+ * The links between assets as last decoded, with an index of every asset's parents next to its children, so the
+ * assets an accessory is equipped on, or everything equipped below an asset, are known without a request.
+ *
+ * Every decoded asset that selected links replaces the children recorded for it, and one that selected its
+ * parentLink replaces its parents. An asset that comes back with a
+ * different owner than before has all its links dropped, since a traded asset is no longer equipped where it was.
+ *
+ * Assets are numbered as they are first seen, and links refer to those numbers, so walking the graph only follows
+ * small adjacency arrays instead of looking up keys.
+ */
+class ASSETREGISTER_API FAssetRegisterLinkStore
+{
+public:
+	static FAssetRegisterLinkStore& Get();
+
+	/**
+	 * Records the links and owner of a decoded asset. The asset's children are replaced if it selected links, and its
+	 * parents are replaced by its parentLink (or cleared if that is empty) if Selection selected one. Ignored if the
+	 * store is disabled in UAssetRegisterSettings.
+	 *
+	 * @param Selection The fields the asset was decoded with. Without one, a parentLink on the asset is added to its
+	 * recorded parents and an empty one leaves them untouched.
+	 */
+	void AddAsset(const FAsset& Asset, const IQueryNode* Selection = nullptr);
+
+	/** Replaces the children Parent links to, updating the parents recorded for the old and new children. */
+	void SetChildLinks(const FAssetRegisterAssetKey& Parent, TConstArrayView<FLink> ChildLinks);
+
+	/** Drops every link from and to Key, e.g. when it changed in a way the store can't see. */
+	void Invalidate(const FAssetRegisterAssetKey& Key);
+
+	void Clear();
+
+	/** Whether links were recorded for Key, i.e. GetChildren is known rather than empty for lack of data. */
+	bool HasChildLinks(const FAssetRegisterAssetKey& Key) const;
+
+	TArray<FAssetRegisterChildLink> GetChildren(const FAssetRegisterAssetKey& Key) const;
+
+	/** The assets that link to Key. */
+	TArray<FAssetRegisterAssetKey> GetParents(const FAssetRegisterAssetKey& Key) const;
+
+	/**
+	 * The assets below Key, breadth first and each once, even where links form a cycle.
+	 *
+	 * @param MaxDepth Number of levels below Key to include, INDEX_NONE for all.
+	 */
+	TArray<FAssetRegisterAssetKey> GetSubtree(const FAssetRegisterAssetKey& Key, int32 MaxDepth = INDEX_NONE) const;
+
+	/** The assets above Key that no other asset links to, e.g. the character an accessory ends up equipped on. */
+	TArray<FAssetRegisterAssetKey> GetRoots(const FAssetRegisterAssetKey& Key) const;
+
+	FAssetRegisterLinkStoreStats GetStats() const;
+
+private:
+	struct FEdge
+	{
+		int32 Node = INDEX_NONE;
+		FString Path;
+	};
+
+	struct FNode
+	{
+		FAssetRegisterAssetKey Key;
+		/** Owner address the asset was last decoded with, empty if ownership wasn't selected. */
+		FString Owner;
+		bool bHasChildLinks = false;
+		TArray<FEdge, TInlineAllocator<4>> Children;
+		TArray<int32, TInlineAllocator<2>> Parents;
+	};
+
+	int32 FindOrAddNodeLocked(const FAssetRegisterAssetKey& Key);
+
+	void SetChildLinksLocked(int32 Parent, TConstArrayView<FLink> ChildLinks);
+
+	/** Adds a link from Parent to Child unless there is one already. */
+	void AddLinkLocked(int32 Parent, int32 Child, const FString& Path);
+
+	void RemoveChildLinksLocked(int32 Parent);
+
+	void RemoveParentLinksLocked(int32 Child);
+
+	/** Breadth first walk from Start along the children, or the parents, calling Visit with each node and its depth. */
+	template<typename TVisit>
+	void WalkLocked(int32 Start, bool bParents, int32 MaxDepth, TVisit Visit) const;
+
+	mutable FCriticalSection CriticalSection;
+	TArray<FNode> Nodes;
+	TMap<FAssetRegisterAssetKey, int32> NodeIndices;
+	int32 NumLinks = 0;
+	uint64 NumOwnerChanges = 0;
+};
@@ -0,0 +1,205 @@
+// Copyright (c) 2025, Futureverse Corporation Limited. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+
+/**
+ * Why a request failed, see FAssetRegisterMetrics::RecordResponse.
+ */
+enum class EAssetRegisterErrorClass : uint8
+{
+	/** No response, e.g. the host couldn't be reached or the connection dropped. */
+	Connection,
+	/** The request ran past its deadline, in the queue or on the network. */
+	Timeout,
+	/** 429 Too Many Requests. */
+	RateLimited,
+	/** Any other 4xx response. */
+	ClientError,
+	/** A 5xx response. */
+	ServerError,
+	/** The response arrived but couldn't be decoded. */
+	Decode,
+	Num
+};
+
+ASSETREGISTER_API const TCHAR* LexToString(EAssetRegisterErrorClass ErrorClass);
+
+/**
+ * A histogram of non-negative integer values with a bounded relative error, after HdrHistogram: values are grouped in
+ * power of two buckets, each split into SubBucketHalfCount linear sub-buckets, so any recorded value (up to MaxValue)
+ * is reported within 1/SubBucketHalfCount of itself while recording stays a couple of bit operations.
+ *
+ * Not thread-safe.
+ */
+class ASSETREGISTER_API FAssetRegisterHistogram
+{
+public:
+	/** Larger values are recorded as MaxValue. For microseconds, a little over an hour. */
+	static constexpr uint64 MaxValue = (1ull << 32) - 1;
+
+	FAssetRegisterHistogram();
+
+	void Record(uint64 Value, uint64 Count = 1);
+
+	/** Adds every value recorded in Other. */
+	void Add(const FAssetRegisterHistogram& Other);
+
+	void Reset();
+
+	/**
+	 * @param Percentile In [0, 100].
+	 * @return The highest value equivalent to the one at Percentile, but no more than GetMax. 0 if nothing was recorded.
+	 */
+	uint64 GetValueAtPercentile(double Percentile) const;
+
+	uint64 GetTotalCount() const { return TotalCount; }
+	uint64 GetMin() const { return TotalCount > 0 ? Min : 0; }
+	uint64 GetMax() const { return Max; }
+	double GetMean() const { return TotalCount > 0 ? static_cast<double>(Sum) / TotalCount : 0.0; }
+
+private:
+	static constexpr int32 SubBucketHalfCountMagnitude = 7;
+	static constexpr int32 SubBucketHalfCount = 1 << SubBucketHalfCountMagnitude;
+	static constexpr uint64 SubBucketMask = (2ull << SubBucketHalfCountMagnitude) - 1;
+
+	static int32 GetCountsIndex(uint64 Value);
+	static uint64 GetHighestEquivalentValue(int32 CountsIndex);
+
+	TArray<uint64> Counts;
+	uint64 TotalCount = 0;
+	uint64 Min = MAX_uint64;
+	uint64 Max = 0;
+	uint64 Sum = 0;
+};
+
+/**
+ * Counts events over a sliding window of whole seconds. Not thread-safe.
+ */
+class ASSETREGISTER_API FAssetRegisterRateCounter
+{
+public:
+	static constexpr int32 WindowSeconds = 10;
+
+	void Add(double Now, uint64 Amount = 1);
+
+	/** Average per second over the last WindowSeconds. */
+	double GetRate(double Now) const;
+
+	uint64 GetTotal() const { return Total; }
+
+private:
+	uint64 Amounts[WindowSeconds] = {};
+	int64 Seconds[WindowSeconds] = {};
+	uint64 Total = 0;
+};
+
+/**
+ * Metrics of one query type, i.e. the UAssetRegisterQueryingLibrary entry point that sent the request.
+ */
+struct FAssetRegisterQueryMetrics
+{
+	uint64 NumRequests = 0;
+	uint64 NumErrors = 0;
+	/** Time from sending the request to its response arriving, queue wait included, in microseconds. */
+	FAssetRegisterHistogram Latency;
+};
+
+/**
+ * Copy of the FAssetRegisterMetrics, with the cache and scheduler counters of the moment it was taken.
+ */
+struct ASSETREGISTER_API FAssetRegisterMetricsSnapshot
+{
+	uint64 NumRequests = 0;
+	double RequestsPerSecond = 0.0;
+	uint64 NumErrors = 0;
+	double ErrorsPerSecond = 0.0;
+	uint64 NumErrorsByClass[static_cast<int32>(EAssetRegisterErrorClass::Num)] = {};
+	/** 304 Not Modified responses, each one a decoded result reused. */
+	uint64 NumNotModified = 0;
+	uint64 BytesSent = 0;
+	uint64 BytesReceived = 0;
+	double BytesReceivedPerSecond = 0.0;
+
+	int32 NumInFlight = 0;
+	int32 NumQueued = 0;
+	int32 MaxInFlight = 0;
+	int32 MaxQueued = 0;
+
+	double AssetCacheHitRate = 0.0;
+	uint64 NegativeCacheHits = 0;
+
+	/** Every query type, in microseconds. */
+	FAssetRegisterHistogram Latency;
+	TMap<FString, FAssetRegisterQueryMetrics> Queries;
+
+	/** A multi-line report, as printed by ar.stats. */
+	FString ToString() const;
+};
+
+/**
+ * Rolling counters and latency histograms of the requests sent to the Asset Register, for catching regressions in
+ * playtests and on servers without attaching a profiler: `ar.stats` prints them (`ar.stats reset` clears them), and
+ * once per frame the AssetRegister CSV profiler category records requests, errors and bytes of the frame along with
+ * the in-flight and queued requests.
+ *
+ * Recording takes a lock, once or twice per request. Can be used from any thread.
+ */
+class ASSETREGISTER_API FAssetRegisterMetrics
+{
+public:
+	static FAssetRegisterMetrics& Get();
+
+	/**
+	 * @param QueryType Name of the function that sent the request, e.g. FAssetRegisterRequest::Context.
+	 * @param NumBytes Size of the request body or GET URL.
+	 */
+	void RecordRequest(const TCHAR* QueryType, int64 NumBytes);
+
+	/**
+	 * @param ResponseCode The HTTP status code, 0 if there was no response.
+	 * @param ErrorClass Why the request failed, unset if it succeeded.
+	 */
+	void RecordResponse(const TCHAR* QueryType, double LatencySeconds, int64 NumBytes, int32 ResponseCode,
+		TOptional<EAssetRegisterErrorClass> ErrorClass);
+
+	/** Records a failure outside of a response, e.g. a request dropped in the queue, or a response that couldn't be decoded. */
+	void RecordError(const TCHAR* QueryType, EAssetRegisterErrorClass ErrorClass);
+
+	/** The error class of a completed HTTP request, unset if it succeeded. */
+	static TOptional<EAssetRegisterErrorClass> ClassifyResponse(bool bWasSuccessful, int32 ResponseCode, bool bDeadlineExpired);
+
+	FAssetRegisterMetricsSnapshot GetSnapshot() const;
+
+	void Reset();
+
+private:
+	FAssetRegisterMetrics();
+
+	bool Tick(float DeltaTime);
+
+	FAssetRegisterQueryMetrics& FindOrAddQuery(const TCHAR* QueryType);
+
+	mutable FCriticalSection CriticalSection;
+	FTSTicker::FDelegateHandle TickerHandle;
+
+	FAssetRegisterRateCounter Requests;
+	FAssetRegisterRateCounter Errors;
+	FAssetRegisterRateCounter BytesReceived;
+	uint64 NumErrorsByClass[static_cast<int32>(EAssetRegisterErrorClass::Num)] = {};
+	uint64 NumNotModified = 0;
+	uint64 BytesSent = 0;
+	int32 MaxInFlight = 0;
+	int32 MaxQueued = 0;
+	FAssetRegisterHistogram Latency;
+	TMap<FString, FAssetRegisterQueryMetrics> Queries;
+
+	/** Totals at the previous tick, the CSV profiler records what changed during the frame. */
+	uint64 LastNumRequests = 0;
+	uint64 LastNumErrors = 0;
+	uint64 LastBytesReceived = 0;
+	/** Slowest response of the current frame, in milliseconds. */
+	double FrameMaxLatency = 0.0;
+};
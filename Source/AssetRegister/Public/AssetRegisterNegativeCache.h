@@ -0,0 +1,94 @@
+// Copyright (c) 2025, Futureverse Corporation Limited. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AssetRegisterAssetCache.h"
+#include <atomic>
+
+/**
+ * What a negative cache entry records as absent.
+ */
+enum class EAssetRegisterMiss : uint8
+{
+	/** The server answered that the asset doesn't exist. */
+	Asset,
+	/** The asset exists, but its profiles have no asset-profile key. */
+	AssetProfile,
+};
+
+/**
+ * Counters of an FAssetRegisterNegativeCache.
+ */
+struct FAssetRegisterNegativeCacheStats
+{
+	/** Lookups answered with a known miss, each one a request that wasn't sent. */
+	uint64 Hits = 0;
+	uint64 Evictions = 0;
+	int32 NumEntries = 0;
+};
+
+/**
+ * Remembers lookups that came back empty, so asking again for an asset that doesn't exist or a profile that
+ * isn't set fails right away instead of going to the network.
+ *
+ * Entries expire after UAssetRegisterSettings::NegativeCacheTimeToLive, and the oldest are evicted once there are
+ * more than NegativeCacheMaxEntries. Since every entry lives equally long, insertion order is expiry order, and
+ * both are handled by dropping entries from the front of a queue.
+ */
+class ASSETREGISTER_API FAssetRegisterNegativeCache
+{
+public:
+	static FAssetRegisterNegativeCache& Get();
+
+	/** Whether Key is a known, unexpired miss. Always false if the cache is disabled in UAssetRegisterSettings. */
+	bool Contains(const FAssetRegisterAssetKey& Key, EAssetRegisterMiss Miss);
+
+	/** Records a miss, restarting its time to live if it was already known. */
+	void Add(const FAssetRegisterAssetKey& Key, EAssetRegisterMiss Miss);
+
+	/** Forgets every miss recorded for Key, e.g. when the asset was returned by another query. */
+	void Remove(const FAssetRegisterAssetKey& Key);
+
+	void Clear();
+
+	FAssetRegisterNegativeCacheStats GetStats() const;
+
+private:
+	struct FMissKey
+	{
+		FAssetRegisterAssetKey Key;
+		EAssetRegisterMiss Miss = EAssetRegisterMiss::Asset;
+
+		bool operator==(const FMissKey& Other) const
+		{
+			return Miss == Other.Miss && Key == Other.Key;
+		}
+
+		friend uint32 GetTypeHash(const FMissKey& MissKey)
+		{
+			return HashCombine(GetTypeHash(MissKey.Key), static_cast<uint32>(MissKey.Miss));
+		}
+	};
+
+	struct FQueuedMiss
+	{
+		FMissKey MissKey;
+		double ExpiresAt = 0.0;
+	};
+
+	/** Drops expired entries and the oldest ones above MaxEntries from the front of the queue. */
+	void TrimLocked(double Now, int32 MaxEntries);
+
+	mutable FCriticalSection CriticalSection;
+	/** Expiry time of each known miss. */
+	TMap<FMissKey, double> Misses;
+	/** Misses in the order they were added. An entry is stale if Misses holds a later expiry for its key. */
+	TArray<FQueuedMiss> Queue;
+	int32 QueueHead = 0;
+
+	/** Lets lookups skip the lock while nothing is cached. */
+	std::atomic<int32> NumEntries = 0;
+	std::atomic<uint64> Hits = 0;
+	std::atomic<uint64> Evictions = 0;
+};
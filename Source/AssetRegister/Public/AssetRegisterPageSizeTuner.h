@@ -0,0 +1,68 @@
+// Copyright (c) 2025, Futureverse Corporation Limited. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Schemas/Inputs/AssetConnection.h"
+
+/**
+ * What a page request cost, as reported to FAssetRegisterPageSizeTuner.
+ */
+struct FAssetRegisterPageSample
+{
+	bool bSuccess = false;
+	int32 NumItems = 0;
+	int64 NumBytes = 0;
+	/** From sending the request until the page was decoded. */
+	double ResponseSeconds = 0.0;
+	/** Part of ResponseSeconds spent decoding the page. */
+	double DecodeSeconds = 0.0;
+};
+
+/**
+ * What FAssetRegisterPageSizeTuner learned about a query shape.
+ */
+struct FAssetRegisterPageSizeStats
+{
+	/** Page size the next page of the shape is requested with. */
+	int32 PageSize = 0;
+	/** Throughput of the last full page of PageSize that was neither slow nor failed. */
+	double ItemsPerSecond = 0.0;
+	double BytesPerSecond = 0.0;
+	double LastResponseSeconds = 0.0;
+	double LastDecodeSeconds = 0.0;
+	int32 NumPages = 0;
+	int32 NumGrowths = 0;
+	int32 NumBackoffs = 0;
+};
+
+/**
+ * Picks the page size of paginated fetches from how earlier pages of the same query shape went, when
+ * UAssetRegisterSettings::bAdaptivePageSize is on.
+ *
+ * The page size is doubled while the throughput of full pages keeps improving, and halved when a page fails, takes
+ * longer than SlowPageTime, or takes longer than SlowPageDecodeTime to decode. The shape of a query is everything
+ * but its pagination arguments, so each filter and selection learns its own size.
+ */
+class ASSETREGISTER_API FAssetRegisterPageSizeTuner
+{
+public:
+	static FAssetRegisterPageSizeTuner& Get();
+
+	/** Identifies the query AssetsInput pages through, ignoring After, Before, First and Last. */
+	static uint64 GetQueryShape(const FAssetConnection& AssetsInput);
+
+	/** Page size to request for Shape, InitialPageSize if nothing was learned about it yet. */
+	int32 GetPageSize(uint64 Shape, int32 InitialPageSize) const;
+
+	/** Adapts the page size of Shape to a page that was requested with PageSize. */
+	void ReportPage(uint64 Shape, int32 PageSize, const FAssetRegisterPageSample& Sample);
+
+	TMap<uint64, FAssetRegisterPageSizeStats> GetStats() const;
+
+	void Reset();
+
+private:
+	mutable FCriticalSection CriticalSection;
+	TMap<uint64, FAssetRegisterPageSizeStats> Shapes;
+};
@@ -3,13 +3,19 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "AssetRegisterDeadline.h"
 #include "QueryNode.h"
 #include "Kismet/BlueprintFunctionLibrary.h"
 #include "Schemas/Asset.h"
 #include "Schemas/Assets.h"
 #include "Schemas/Inputs/AssetConnection.h"
+#include "Schemas/Inputs/AssetInput.h"
 #include "AssetRegisterQueryingLibrary.generated.h"
 
+class FAssetRegisterAssetStream;
+class UAssetRegisterAssetStream;
+struct FAssetRegisterAssetKey;
+
 /**
  * Delegate used for receiving a JSON string result.
  *
@@ -34,10 +40,38 @@ DECLARE_DYNAMIC_DELEGATE_TwoParams(FGetAssetCompleted, bool, bSuccess, const FAs
  */
 DECLARE_DYNAMIC_DELEGATE_TwoParams(FGetAssetsCompleted, bool, bSuccess, const FAssets&, Assets);
 
+/**
+ * Delegate used for receiving all pages of a set of assets.
+ *
+ * @param bSuccess Whether the operation succeeded.
+ * @param bPartial Whether the timeout was reached before all pages were loaded, so Assets only contains the pages loaded in time.
+ * @param Assets The result containing the assets of all loaded pages (if successful).
+ */
+DECLARE_DYNAMIC_DELEGATE_ThreeParams(FGetAllAssetsCompleted, bool, bSuccess, bool, bPartial, const FAssets&, Assets);
+
+/**
+ * How GetAllAssetsPartitioned splits a query into concurrent sub-queries.
+ */
+UENUM(BlueprintType)
+enum class EAssetRegisterPartition : uint8
+{
+	/** One sub-query per entry of FAssetConnection::CollectionIds. */
+	ByCollection,
+	/** One sub-query per entry of FAssetConnection::Addresses. */
+	ByAddress,
+};
+
 template<typename T>
 struct TLoadResult
 {
 	bool bSuccess = false;
+
+	/** Set when the operation ran out of time (see FAssetRegisterDeadline) and Value only holds the work finished in time. */
+	bool bPartial = false;
+
+	/** Set when the operation failed because the server answered that what was asked for doesn't exist. */
+	bool bNotFound = false;
+	
 	T Value;
 
 	void SetResult(const T& InValue)
@@ -46,15 +80,35 @@ struct TLoadResult
 		Value = InValue;
 	}
 
+	void SetResult(T&& InValue)
+	{
+		bSuccess = true;
+		Value = MoveTemp(InValue);
+	}
+
+	void SetPartialResult(T&& InValue)
+	{
+		SetResult(MoveTemp(InValue));
+		bPartial = true;
+	}
+
 	void SetFailure()
 	{
 		bSuccess = false;
 	}
+
+	void SetNotFound()
+	{
+		SetFailure();
+		bNotFound = true;
+	}
 };
 
 struct FLoadJsonResult final : TLoadResult<FString> {};
 struct FLoadAssetResult final : TLoadResult<FAsset> {};
 struct FLoadAssetsResult final : TLoadResult<FAssets> {};
+/** The assets of a query selecting several of them under aliases, in the order they were selected. */
+struct FLoadAssetBatchResult final : TLoadResult<TArray<FLoadAssetResult>> {};
 
 /**
  * Utility library containing common Asset Register GraphQL queries.
@@ -79,8 +133,13 @@ public:
 
 	/**
 	 * C++ version of GetAssetProfile that returns a future containing JSON result.
+	 *
+	 * @param OnChanged Called if a cached profile older than UAssetRegisterSettings::AssetProfileFreshness was returned,
+	 * and the profile refetched in the background differs from it.
 	 */
-	static TFuture<FLoadJsonResult> GetAssetProfile(const FString& TokenId, const FString& CollectionId);
+	static TFuture<FLoadJsonResult> GetAssetProfile(const FString& TokenId, const FString& CollectionId,
+		const FAssetRegisterDeadline& Deadline = FAssetRegisterDeadline(),
+		const TFunction<void(const FLoadJsonResult&)>& OnChanged = nullptr);
 
 	/**
 	 * Retrieves asset links associated with a specific asset.
@@ -94,8 +153,13 @@ public:
 
 	/**
 	 * C++ version of GetAssetLinks that returns a future with the resolved asset.
+	 *
+	 * @param OnChanged Called if cached links older than UAssetRegisterSettings::AssetLinksFreshness were returned,
+	 * and the links refetched in the background differ from them.
 	 */
-	static TFuture<FLoadAssetResult> GetAssetLinks(const FString& TokenId, const FString& CollectionId);
+	static TFuture<FLoadAssetResult> GetAssetLinks(const FString& TokenId, const FString& CollectionId,
+		const FAssetRegisterDeadline& Deadline = FAssetRegisterDeadline(),
+		const TFunction<void(const FLoadAssetResult&)>& OnChanged = nullptr);
 
 	/**
 	 * Retrieves a list of assets using a FAssetConnection input.
@@ -108,18 +172,106 @@ public:
 
 	/**
 	 * C++ version of GetAssets that returns a future with a list of assets.
+	 *
+	 * @param OnPageInfo Called with the end cursor and size in bytes of a downloaded page before its assets are decoded,
+	 * so the next page can be requested meanwhile. Not called for pages served from a cache.
+	 */
+	static TFuture<FLoadAssetsResult> GetAssets(const FAssetConnection& AssetsInput,
+		const FAssetRegisterDeadline& Deadline = FAssetRegisterDeadline(),
+		const TFunction<void(const FPageInfo&, int64)>& OnPageInfo = nullptr);
+
+	/**
+	 * Retrieves every page of assets matching a FAssetConnection input, following PageInfo.EndCursor.
+	 *
+	 * @param AssetsInput The connection input used to filter and sort assets. First is used as the page size (100 if unset).
+	 * @param TimeoutSeconds Time budget for loading all pages, 0 for none. Pages that don't finish in time are dropped.
+	 * @param OnCompleted Callback invoked when all pages were loaded or the timeout was reached.
+	 */
+	UFUNCTION(BlueprintCallable, meta = (AutoCreateRefTerm = "OnCompleted"))
+	static void GetAllAssets(const FAssetConnection& AssetsInput, float TimeoutSeconds, const FGetAllAssetsCompleted& OnCompleted);
+
+	/**
+	 * C++ version of GetAllAssets. Every page request is bounded by the remaining time until Deadline,
+	 * and if it passes, the result holds the pages loaded so far with bPartial set.
+	 */
+	static TFuture<FLoadAssetsResult> GetAllAssets(const FAssetConnection& AssetsInput, const FAssetRegisterDeadline& Deadline);
+
+	/**
+	 * Retrieves every page of assets like GetAllAssets, but as one sub-query per collection id or address of AssetsInput.
+	 * The sub-queries page through their cursors concurrently, and their assets are merged back into AssetsInput.Sort
+	 * order. Assets returned by more than one sub-query are only kept once if AssetsInput.RemoveDuplicates is set.
+	 * If a Sort field isn't a member of FAsset, e.g. a nested field, a single query is sent instead, as in GetAllAssets.
+	 *
+	 * @param AssetsInput The connection input used to filter and sort assets. First is used as the page size (100 if unset).
+	 * @param Partition Whether to split by CollectionIds or by Addresses. With fewer than two of them this is GetAllAssets.
+	 * @param TimeoutSeconds Time budget for loading all pages, 0 for none.
+	 * @param OnCompleted Callback invoked when all pages were loaded or the timeout was reached.
+	 */
+	UFUNCTION(BlueprintCallable, meta = (AutoCreateRefTerm = "OnCompleted"))
+	static void GetAllAssetsPartitioned(const FAssetConnection& AssetsInput, EAssetRegisterPartition Partition, float TimeoutSeconds,
+		const FGetAllAssetsCompleted& OnCompleted);
+
+	/**
+	 * C++ version of GetAllAssetsPartitioned. bPartial is set if any sub-query ran out of time.
 	 */
-	static TFuture<FLoadAssetsResult> GetAssets(const FAssetConnection& AssetsInput);
+	static TFuture<FLoadAssetsResult> GetAllAssetsPartitioned(const FAssetConnection& AssetsInput, EAssetRegisterPartition Partition,
+		const FAssetRegisterDeadline& Deadline);
+
+	/**
+	 * Opens a stream over the pages of assets matching a FAssetConnection input. Each page is only requested when
+	 * RequestNextPage is called, so just one page is held at a time instead of the whole inventory.
+	 *
+	 * @param AssetsInput The connection input used to filter and sort assets. First is used as the page size (100 if unset).
+	 * @param MaxItems Number of assets after which the stream ends, 0 for no limit.
+	 */
+	UFUNCTION(BlueprintCallable)
+	static UAssetRegisterAssetStream* StreamAssets(const FAssetConnection& AssetsInput, int32 MaxItems);
+
+	/**
+	 * C++ version of StreamAssets. Every page request is bounded by Deadline.
+	 */
+	static TSharedRef<FAssetRegisterAssetStream> StreamAssets(const FAssetConnection& AssetsInput, int32 MaxItems,
+		const FAssetRegisterDeadline& Deadline);
 	
 	/**
 	* Makes the Assets query using the provided raw query string.
 	*/
 	static TFuture<FLoadAssetsResult> MakeAssetsQuery(const FString& QueryContent);
+
+	/**
+	* Makes the Assets query using a UTF-8 encoded query json body, e.g. from FQueryNode::GetQueryJsonUtf8.
+	* OnPageInfo is called as in GetAssets.
+	*/
+	static TFuture<FLoadAssetsResult> MakeAssetsQuery(TArray<uint8>&& QueryContentUtf8,
+		const FAssetRegisterDeadline& Deadline = FAssetRegisterDeadline(),
+		const TFunction<void(const FPageInfo&, int64)>& OnPageInfo = nullptr);
 	
 	/**
 	* Makes the Asset query using the provided raw query string.
 	*/
 	static TFuture<FLoadAssetResult> MakeAssetQuery(const FString& QueryContent);
+
+	/**
+	* Makes the Asset query using a UTF-8 encoded query json body, e.g. from FQueryNode::GetQueryJsonUtf8.
+	*/
+	static TFuture<FLoadAssetResult> MakeAssetQuery(TArray<uint8>&& QueryContentUtf8,
+		const FAssetRegisterDeadline& Deadline = FAssetRegisterDeadline());
+
+	/**
+	* Loads the fields AssetQuery selects of the asset Input identifies. Fields the asset cache already holds are
+	* answered from it, and only the missing ones are requested. Arguments on AssetQuery are ignored.
+	*/
+	static TFuture<FLoadAssetResult> MakeAssetQuery(const FAssetInput& Input, const TSharedPtr<FQueryNode<FAsset>>& AssetQuery,
+		const FAssetRegisterDeadline& Deadline = FAssetRegisterDeadline());
+	
+	/**
+	* Loads the fields Selection selects of several assets with a single request, each asset selected under its own
+	* alias. Assets the asset caches hold fresher than Freshness seconds are answered from them and left out of the
+	* request. The request is sent, decoded and completed like MakeAssetQuery's. The results are in the order of Keys.
+	*/
+	static TFuture<TArray<FLoadAssetResult>> GetAssetsBatched(const TArray<FAssetRegisterAssetKey>& Keys,
+		const TSharedRef<const IQueryNode>& Selection, double Freshness,
+		const FAssetRegisterDeadline& Deadline = FAssetRegisterDeadline());
 	
 	/**
 	 * Sends a raw GraphQL request and returns the result as a string.
@@ -129,47 +281,48 @@ public:
 	 */
 	static TFuture<FString> SendRequest(const FString& Content);
 
+	/**
+	* Decodes the raw bytes of a single node of an Assets response, e.g. one kept from an earlier response.
+	* Decoding happens on the calling thread.
+	*/
+	static FLoadAssetResult DecodeAssetNode(TConstArrayView<uint8> NodeUtf8);
+
+	/**
+	* Decodes a parsed Asset response, as MakeAssetQuery does with the response it receives.
+	* Decoding happens on the calling thread.
+	*/
+	static FLoadAssetResult DecodeAssetResponse(const TSharedPtr<FJsonObject>& RootObject);
+
+	/**
+	* Decodes a parsed Assets response, as GetAssets does with the response it receives.
+	* Decoding happens on the calling thread.
+	*/
+	static FLoadAssetsResult DecodeAssetsResponse(const TSharedPtr<FJsonObject>& RootObject);
+
+	/**
+	* Builds the query GetAssets sends for AssetsInput.
+	*/
+	static TSharedPtr<FQueryNode<FAssets>> GetAssetsQueryNode(const FAssetConnection& AssetsInput);
+
 private:
+	/**
+	* Requests the next pages of a GetAllAssets call, until one has to be waited for or the call completes.
+	*/
+	static void GetNextAssetsPage(const TSharedRef<struct FGetAllAssetsState>& State);
+	
 	/**
 	* Handles deserializing the response from Assets query.
 	*/
-	static TFuture<FLoadAssetsResult> HandleAssetsResponse(const FString& ResponseJson);
+	static TFuture<FLoadAssetsResult> HandleAssetsResponse(const TSharedPtr<FJsonObject>& RootObject);
 	
 	/**
 	* Handles deserializing the response from Asset query.
 	*/
-	static TFuture<FLoadAssetResult> HandleAssetResponse(const FString& ResponseJson);
-	
-	static TSharedPtr<FQueryNode<FAssets>> GetAssetsQueryNode(const FAssetConnection& AssetsInput);
-	
-	template<typename T>
-	static TFuture<TArray<T>> WhenAll(TArray<TFuture<T>>& Futures)
-	{
-		TSharedPtr<TPromise<TArray<T>>> Promise = MakeShared<TPromise<TArray<T>>>();
-		TSharedRef<TArray<T>> Results = MakeShared<TArray<T>>();
-		TSharedRef<FThreadSafeCounter> Counter = MakeShared<FThreadSafeCounter>(Futures.Num());
-
-		Results->SetNum(Futures.Num());
-
-		if (Futures.IsEmpty())
-		{
-			Promise->SetValue(*Results);
-			return Promise->GetFuture();
-		}
-
-		for (int32 Index = 0; Index < Futures.Num(); ++Index)
-		{
-			TFuture<T>& Future = Futures[Index]; // non-const ref
-			Future.Next([Index, Results, Counter, Promise, Total = Futures.Num()](const T& Result)
-			{
-				(*Results)[Index] = Result;
-				if (Counter->Decrement() == 0)
-				{
-					Promise->SetValue(*Results);
-				}
-			});
-		}
-
-		return Promise->GetFuture();
-	}
+	static TFuture<FLoadAssetResult> HandleAssetResponse(const TSharedPtr<FJsonObject>& RootObject);
+
+	/**
+	* Handles deserializing the response from a query selecting assets under Aliases, see GetAssetsBatched.
+	*/
+	static TFuture<FLoadAssetBatchResult> HandleAssetBatchResponse(const TSharedPtr<FJsonObject>& RootObject,
+		const TArray<FString>& Aliases);
 };
@@ -5,6 +5,23 @@
 #include "CoreMinimal.h"
 #include "AssetRegisterSettings.generated.h"
 
+/**
+ * Where query responses are decoded, and where the futures and Blueprint delegates of queries complete.
+ */
+UENUM()
+enum class EAssetRegisterCompletionPolicy : uint8
+{
+	/** Decode and complete on the thread the HTTP response is delivered on. */
+	Inline,
+	/**
+	 * Decode on a worker thread and complete there. The decoded UObjects are only kept alive while the continuations
+	 * run, a continuation has to reference them (UPROPERTY, FGCObject) to keep them.
+	 */
+	Worker,
+	/** Decode on a worker thread and complete on the game thread, spread over frames by FAssetRegisterCompletionQueue. */
+	GameThread,
+};
+
 /**
  * 
  */
@@ -19,6 +36,140 @@ public:
 	UPROPERTY(EditAnywhere, Config, meta=(GetOptions="GetURLOptions"))
 	FString AssetRegisterURL = "https://ar-api.futureverse.app/graphql";
 
+	/**
+	 * Send read-only queries as GET requests with the query in the URL, so HTTP caches can serve them and
+	 * repeated queries can be revalidated with If-None-Match/If-Modified-Since instead of re-downloading.
+	 */
+	UPROPERTY(EditAnywhere, Config, Category = "Transport")
+	bool bUseGetForReadQueries = false;
+
+	/** Queries whose GET URL would be longer than this are sent as POST instead. */
+	UPROPERTY(EditAnywhere, Config, Category = "Transport", meta = (EditCondition = "bUseGetForReadQueries", ClampMin = 256))
+	int32 MaxGetURLLength = 2048;
+
+	/**
+	 * Funnel requests through a single kept-alive connection. The module pre-connects to the endpoint on startup so
+	 * DNS/TLS are done before the first query, and a burst of requests waits for that connection instead of each
+	 * opening its own, so they reuse the keep-alive connection. If that first request fails, the waiting requests
+	 * are sent together rather than one at a time.
+	 * The plugin doesn't configure HTTP/2 (or h2c), requests are only multiplexed if the platform's HTTP module
+	 * negotiates it by itself, and the burst latency benchmark only exercises HTTP/1.1 keep-alive.
+	 */
+	UPROPERTY(EditAnywhere, Config, Category = "Transport")
+	bool bUseMultiplexedConnection = false;
+
+	/** Maximum number of requests in flight at once, further requests are queued. 0 for no limit. */
+	UPROPERTY(EditAnywhere, Config, Category = "Transport", meta = (ClampMin = 0))
+	int32 MaxConcurrentRequests = 0;
+
+	/**
+	 * Number of pages GetAllAssets and asset streams request ahead of the one being returned. A page is requested as
+	 * soon as the end cursor of the one before it has been downloaded, while that one is still being decoded.
+	 * 0 requests every page only after the previous one was returned.
+	 */
+	UPROPERTY(EditAnywhere, Config, Category = "Transport", meta = (ClampMin = 0, ClampMax = 8))
+	int32 PagePrefetchDepth = 1;
+
+	/**
+	 * Let GetAllAssets and asset streams pick their page size, starting from FAssetConnection::First. It is doubled while
+	 * full pages come back faster per asset, and halved when a page fails or is slow. Learned per query shape, see
+	 * FAssetRegisterPageSizeTuner::GetStats.
+	 */
+	UPROPERTY(EditAnywhere, Config, Category = "Transport")
+	bool bAdaptivePageSize = false;
+
+	UPROPERTY(EditAnywhere, Config, Category = "Transport", meta = (EditCondition = "bAdaptivePageSize", ClampMin = 1))
+	int32 MinAdaptivePageSize = 20;
+
+	UPROPERTY(EditAnywhere, Config, Category = "Transport", meta = (EditCondition = "bAdaptivePageSize", ClampMin = 1))
+	int32 MaxAdaptivePageSize = 1000;
+
+	/** A page that takes longer than this from request to decoded halves the page size. */
+	UPROPERTY(EditAnywhere, Config, Category = "Transport", meta = (EditCondition = "bAdaptivePageSize", ClampMin = 0, Units = "s"))
+	float SlowPageTime = 2.f;
+
+	/** A page that takes longer than this to decode halves the page size, so decoding doesn't hitch a frame. */
+	UPROPERTY(EditAnywhere, Config, Category = "Transport", meta = (EditCondition = "bAdaptivePageSize", ClampMin = 0, Units = "s"))
+	float SlowPageDecodeTime = 0.05f;
+
+	/**
+	 * Where responses are decoded and queries complete. Can be overridden for the queries started within an
+	 * FAssetRegisterCompletionScope.
+	 */
+	UPROPERTY(EditAnywhere, Config, Category = "Transport")
+	EAssetRegisterCompletionPolicy CompletionPolicy = EAssetRegisterCompletionPolicy::Inline;
+
+	/**
+	 * Time the game thread spends per frame on the completions queued by the GameThread completion policy. At least
+	 * one completion is delivered per frame, the rest wait for the next one.
+	 */
+	UPROPERTY(EditAnywhere, Config, Category = "Transport", meta = (ClampMin = 0, Units = "ms"))
+	float CompletionFrameBudget = 2.f;
+
+	/** Keep decoded assets in memory so repeated lookups of the same asset don't go to the network. */
+	UPROPERTY(EditAnywhere, Config, Category = "Cache")
+	bool bEnableAssetCache = true;
+
+	/** How long a cached asset is served before it has to be fetched again. */
+	UPROPERTY(EditAnywhere, Config, Category = "Cache", meta = (EditCondition = "bEnableAssetCache", ClampMin = 0, Units = "s"))
+	float AssetCacheTimeToLive = 60.f;
+
+	/** Approximate memory the asset cache may use before least recently used assets are evicted. */
+	UPROPERTY(EditAnywhere, Config, Category = "Cache", meta = (EditCondition = "bEnableAssetCache", ClampMin = 1, Units = "MB"))
+	int32 AssetCacheMemoryBudget = 64;
+
+	/**
+	 * Return cached assets that are older than their freshness right away, and refetch them in the background.
+	 * When off, they are refetched before the query completes.
+	 */
+	UPROPERTY(EditAnywhere, Config, Category = "Cache")
+	bool bStaleWhileRevalidate = true;
+
+	/** How long a cached asset profile is returned by GetAssetProfile before it is refetched. */
+	UPROPERTY(EditAnywhere, Config, Category = "Cache", meta = (ClampMin = 0, Units = "s"))
+	float AssetProfileFreshness = 30.f;
+
+	/** How long cached asset links are returned by GetAssetLinks before they are refetched. */
+	UPROPERTY(EditAnywhere, Config, Category = "Cache", meta = (ClampMin = 0, Units = "s"))
+	float AssetLinksFreshness = 10.f;
+
+	/**
+	 * Remember assets that don't exist and asset profiles that aren't set, so looking them up again fails without
+	 * a request until the entry expires.
+	 */
+	UPROPERTY(EditAnywhere, Config, Category = "Cache")
+	bool bEnableNegativeCache = true;
+
+	/** How long a missing asset or asset profile is remembered. */
+	UPROPERTY(EditAnywhere, Config, Category = "Cache", meta = (EditCondition = "bEnableNegativeCache", ClampMin = 0, Units = "s"))
+	float NegativeCacheTimeToLive = 30.f;
+
+	/** Number of missing assets and asset profiles remembered before the oldest are forgotten. */
+	UPROPERTY(EditAnywhere, Config, Category = "Cache", meta = (EditCondition = "bEnableNegativeCache", ClampMin = 1))
+	int32 NegativeCacheMaxEntries = 10000;
+
+	/**
+	 * Keep the child links of every asset fetched for the asset cache in a local graph that also indexes each asset's parents, so
+	 * FAssetRegisterLinkStore can walk links in either direction without a request.
+	 */
+	UPROPERTY(EditAnywhere, Config, Category = "Cache")
+	bool bEnableLinkStore = true;
+
+	/**
+	 * Persist decoded assets and asset pages to Saved/AssetRegister/AssetCache.bin, so the next launch can serve
+	 * them before any request completes.
+	 */
+	UPROPERTY(EditAnywhere, Config, Category = "Cache")
+	bool bEnableDiskCache = false;
+
+	/** Entries older than this are refetched, in the background when bStaleWhileRevalidate is on. */
+	UPROPERTY(EditAnywhere, Config, Category = "Cache", meta = (EditCondition = "bEnableDiskCache", ClampMin = 0, Units = "s"))
+	float DiskCacheFreshness = 300.f;
+
+	/** Oldest entries are dropped when the disk cache is written and would be larger than this. */
+	UPROPERTY(EditAnywhere, Config, Category = "Cache", meta = (EditCondition = "bEnableDiskCache", ClampMin = 1, Units = "MB"))
+	int32 DiskCacheMaxSize = 256;
+
 	UFUNCTION()
 	TArray<FString> GetURLOptions() const
 	{
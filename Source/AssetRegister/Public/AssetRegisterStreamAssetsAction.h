@@ -0,0 +1,87 @@
+// Copyright (c) 2025, Futureverse Corporation Limited. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AssetRegisterQueryingLibrary.h"
+#include "Kismet/BlueprintAsyncActionBase.h"
+#include "AssetRegisterStreamAssetsAction.generated.h"
+
+class FAssetRegisterAssetStream;
+
+/**
+ * Output pin of UAssetRegisterStreamAssetsAction.
+ *
+ * @param Page The assets of the page, empty for OnCompleted and OnFailed.
+ * @param NumItems Number of assets delivered so far.
+ */
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FAssetRegisterAssetsPageDelegate, const FAssets&, Page, int32, NumItems);
+
+/**
+ * Blueprint node that loads every page of a GetAssets query and delivers them one by one as they are decoded, so a
+ * list can be populated progressively. Only the page being delivered is held, never the whole inventory.
+ *
+ * Pages are delivered on the game thread. The node stops at the first page that fails, when the deadline passes, or
+ * when Cancel is called, after which nothing more is delivered.
+ */
+UCLASS()
+class ASSETREGISTER_API UAssetRegisterStreamAssetsAction : public UBlueprintAsyncActionBase
+{
+	GENERATED_BODY()
+
+public:
+	/**
+	 * Loads the pages of assets matching AssetsInput, following PageInfo.EndCursor.
+	 *
+	 * @param AssetsInput The connection input used to filter and sort assets. First is used as the page size (100 if unset).
+	 * @param MaxItems Number of assets after which the stream ends, 0 for no limit.
+	 * @param TimeoutSeconds Time budget for loading all pages, 0 for none.
+	 */
+	UFUNCTION(BlueprintCallable, meta = (BlueprintInternalUseOnly = "true", WorldContext = "WorldContextObject", DisplayName = "Stream Asset Pages"))
+	static UAssetRegisterStreamAssetsAction* StreamAssetPages(UObject* WorldContextObject, const FAssetConnection& AssetsInput,
+		int32 MaxItems, float TimeoutSeconds);
+
+	/** Called with every page, in cursor order. */
+	UPROPERTY(BlueprintAssignable)
+	FAssetRegisterAssetsPageDelegate OnPage;
+
+	/** Called after the last page. */
+	UPROPERTY(BlueprintAssignable)
+	FAssetRegisterAssetsPageDelegate OnCompleted;
+
+	/** Called if a page failed to load or ran past the timeout. */
+	UPROPERTY(BlueprintAssignable)
+	FAssetRegisterAssetsPageDelegate OnFailed;
+
+	/** Stops requesting pages and drops the one in flight. Neither OnCompleted nor OnFailed are called. */
+	UFUNCTION(BlueprintCallable)
+	void Cancel();
+
+	UFUNCTION(BlueprintPure)
+	bool IsRunning() const { return bRunning; }
+
+	UFUNCTION(BlueprintPure)
+	int32 GetNumItems() const { return NumItems; }
+
+	UFUNCTION(BlueprintPure)
+	int32 GetNumPages() const { return NumPages; }
+
+	//~ UBlueprintAsyncActionBase
+	virtual void Activate() override;
+
+private:
+	void RequestNextPage();
+
+	void OnPageLoaded(FLoadAssetsResult&& Result);
+
+	void Finish();
+
+	FAssetConnection AssetsInput;
+	int32 MaxItems = 0;
+	float TimeoutSeconds = 0.f;
+
+	TSharedPtr<FAssetRegisterAssetStream> Stream;
+	bool bRunning = false;
+	int32 NumItems = 0;
+	int32 NumPages = 0;
+};
@@ -0,0 +1,121 @@
+// Copyright (c) 2025, Futureverse Corporation Limited. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "Stats/Stats.h"
+#include "Trace/Trace.h"
+
+/**
+ * Trace channel of the Asset Register, enabled with -trace=AssetRegister (or Trace.Enable AssetRegister at runtime).
+ * Every request phase is traced as a CPU profiler scope, where it runs synchronously, and as an AssetRegister.RequestPhase
+ * event carrying the request's correlation ID, its start and end cycles and the bytes it handled.
+ */
+UE_TRACE_CHANNEL_EXTERN(AssetRegisterChannel, ASSETREGISTER_API);
+
+DECLARE_STATS_GROUP(TEXT("AssetRegister"), STATGROUP_AssetRegister, STATCAT_Advanced);
+
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Query Build"), STAT_AssetRegister_QueryBuild, STATGROUP_AssetRegister, ASSETREGISTER_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Serialize"), STAT_AssetRegister_Serialize, STATGROUP_AssetRegister, ASSETREGISTER_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Parse"), STAT_AssetRegister_Parse, STATGROUP_AssetRegister, ASSETREGISTER_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Decode"), STAT_AssetRegister_Decode, STATGROUP_AssetRegister, ASSETREGISTER_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("UObject Creation"), STAT_AssetRegister_CreateObjects, STATGROUP_AssetRegister, ASSETREGISTER_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Delegate Dispatch"), STAT_AssetRegister_Dispatch, STATGROUP_AssetRegister, ASSETREGISTER_API);
+DECLARE_FLOAT_ACCUMULATOR_STAT_EXTERN(TEXT("Queue Wait (ms)"), STAT_AssetRegister_QueueWait, STATGROUP_AssetRegister, ASSETREGISTER_API);
+DECLARE_FLOAT_ACCUMULATOR_STAT_EXTERN(TEXT("Network (ms)"), STAT_AssetRegister_Network, STATGROUP_AssetRegister, ASSETREGISTER_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Bytes Received"), STAT_AssetRegister_BytesReceived, STATGROUP_AssetRegister, ASSETREGISTER_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Requests"), STAT_AssetRegister_Requests, STATGROUP_AssetRegister, ASSETREGISTER_API);
+
+/**
+ * The phases of a request, from building its query to calling back with the decoded result.
+ */
+enum class EAssetRegisterPhase : uint8
+{
+	QueryBuild,
+	Serialize,
+	/** Waiting for a slot in FAssetRegisterRequestScheduler. */
+	QueueWait,
+	/** From sending the request to its response being downloaded. */
+	Network,
+	Parse,
+	Decode,
+	CreateObjects,
+	/** Completing the query's future, i.e. running the continuations and delegates waiting for it. */
+	Dispatch,
+};
+
+namespace AssetRegisterTrace
+{
+	inline bool IsEnabled()
+	{
+		return UE_TRACE_CHANNELEXPR_IS_ENABLED(AssetRegisterChannel);
+	}
+
+	/** A new correlation ID, unique for the session and never 0. */
+	ASSETREGISTER_API uint64 NewRequestId();
+
+	/** The ID of the request whose phase is running on this thread, 0 outside of one. */
+	ASSETREGISTER_API uint64 GetCurrentRequestId();
+
+	/**
+	 * The ID of the innermost FAssetRegisterRequestScope on this thread if no request was sent with it yet, otherwise
+	 * a new one. Called once per request, when it is sent.
+	 */
+	ASSETREGISTER_API uint64 TakeScopedRequestId();
+
+	/**
+	 * Traces a phase of RequestId that ran from StartCycles (FPlatformTime::Cycles64) until now. Used directly for the
+	 * phases that don't run in one scope, e.g. the network round trip.
+	 */
+	ASSETREGISTER_API void TracePhase(uint64 RequestId, EAssetRegisterPhase Phase, uint64 StartCycles, uint64 NumBytes = 0);
+}
+
+/**
+ * Traces the phase running in its scope. Phases nested in it, e.g. the UObjects created while decoding, are
+ * attributed to the same request. Does nothing unless the AssetRegister channel is enabled.
+ */
+class ASSETREGISTER_API FAssetRegisterPhaseScope
+{
+public:
+	/** @param RequestId The request the phase belongs to, 0 for the request of the enclosing scope. */
+	FAssetRegisterPhaseScope(uint64 RequestId, EAssetRegisterPhase InPhase);
+	~FAssetRegisterPhaseScope();
+
+	FAssetRegisterPhaseScope(const FAssetRegisterPhaseScope&) = delete;
+	FAssetRegisterPhaseScope& operator=(const FAssetRegisterPhaseScope&) = delete;
+
+private:
+	uint64 RequestId = 0;
+	uint64 OuterRequestId = 0;
+	uint64 StartCycles = 0;
+	EAssetRegisterPhase Phase;
+};
+
+/**
+ * Allocates the ID of a request before its query is built, so the QueryBuild and Serialize phases in its scope are
+ * traced under the ID the request is then sent with (see AssetRegisterTrace::TakeScopedRequestId). A second request
+ * sent in the same scope gets an ID of its own.
+ */
+class ASSETREGISTER_API FAssetRegisterRequestScope
+{
+public:
+	FAssetRegisterRequestScope();
+	~FAssetRegisterRequestScope();
+
+	FAssetRegisterRequestScope(const FAssetRegisterRequestScope&) = delete;
+	FAssetRegisterRequestScope& operator=(const FAssetRegisterRequestScope&) = delete;
+
+private:
+	uint64 OuterRequestId = 0;
+	uint64 OuterScopedRequestId = 0;
+};
+
+/**
+ * Records a synchronous phase of a request as a cycle stat of STATGROUP_AssetRegister, a CPU profiler scope and an
+ * AssetRegister.RequestPhase event. Compiles to the phase event alone without stats, and that checks the channel first.
+ */
+#define ASSETREGISTER_TRACE_PHASE(RequestId, Phase) \
+	SCOPE_CYCLE_COUNTER(STAT_AssetRegister_##Phase); \
+	TRACE_CPUPROFILER_EVENT_SCOPE_ON_CHANNEL_STR("AssetRegister::" #Phase, AssetRegisterChannel); \
+	const FAssetRegisterPhaseScope PREPROCESSOR_JOIN(AssetRegisterPhaseScope, __LINE__)(RequestId, EAssetRegisterPhase::Phase)
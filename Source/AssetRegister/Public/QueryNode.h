@@ -13,6 +13,8 @@ public:
 	IQueryNode(const FString& InName, bool bIsUnion = false)
 	: Name(InName), bIsUnion(bIsUnion) {}
 
+	virtual ~IQueryNode() {}
+
 	/**
 	 * Builds the GraphQL-formatted string for all arguments on this node.
 	 */
@@ -36,39 +38,59 @@ public:
 	 */
 	static FString SerializeNode(const TSharedPtr<IQueryNode>& Node, int IndentLevel)
 	{
-		FString Indent = FString::ChrN(IndentLevel * 2, ' ');
-		FString Output;
+		TStringBuilder<1024> Output;
+		SerializeNode(Node, IndentLevel, Output);
+		return Output.ToString();
+	}
+
+	/**
+	 * Recursively serializes a node (and its children) into the given string builder.
+	 * Works for both TCHAR and UTF8CHAR builders so the request body can be produced in UTF-8 directly.
+	 */
+	template<typename CharType>
+	static void SerializeNode(const TSharedPtr<IQueryNode>& Node, int IndentLevel, TStringBuilderBase<CharType>& Output)
+	{
+		AppendIndent(IndentLevel, Output);
 		
-		if (Node->bIsUnion)
+		if (!Node->Alias.IsEmpty())
 		{
-			Output += Indent + TEXT("... on ") + Node->Name;
+			Output << Node->Alias << ": ";
 		}
-		else
+		if (Node->bIsUnion)
 		{
-			Output += Indent + Node->Name;
+			Output << "... on ";
 		}
+		Output << Node->Name;
 
 		if (!Node->Arguments.IsEmpty())
 		{
-			Output += "(" + Node->GetArgumentsString() + ")";
+			Output << "(" << Node->GetArgumentsString() << ")";
 		}
 
 		if (Node->ChildrenMap.IsEmpty())
 		{
-			Output += TEXT("\n");
-			return Output;
+			Output << "\n";
+			return;
 		}
 		
-		Output += TEXT(" {\n");
+		Output << " {\n";
 		
 		for (const auto& ChildPair : Node->ChildrenMap)
 		{
-			Output += SerializeNode(ChildPair.Value, IndentLevel + 1);
+			SerializeNode(ChildPair.Value, IndentLevel + 1, Output);
 		}
 		
-		Output += Indent + TEXT("}\n");
-
-		return Output;
+		AppendIndent(IndentLevel, Output);
+		Output << "}\n";
+	}
+	
+	template<typename CharType>
+	static void AppendIndent(int IndentLevel, TStringBuilderBase<CharType>& Output)
+	{
+		for (int Index = 0; Index < IndentLevel * 2; ++Index)
+		{
+			Output.AppendChar(' ');
+		}
 	}
 	
 	/**
@@ -76,7 +98,39 @@ public:
 	 */
 	FString GetQueryString()
 	{
-		return "query {\n" + SerializeNode(AsShared(), 0) + "\n}";
+		TStringBuilder<1024> Output;
+		WriteQueryString(Output);
+		return Output.ToString();
+	}
+
+	/**
+	 * Writes the complete raw GraphQL query string starting from this node into the given builder.
+	 */
+	template<typename CharType>
+	void WriteQueryString(TStringBuilderBase<CharType>& Output)
+	{
+		Output << "query {\n";
+		SerializeNode(AsShared(), 0, Output);
+		Output << "\n}";
+	}
+
+	/**
+	 * Returns a GraphQL query json body encoded as UTF-8 that selects every node in Nodes at the root, so all of them
+	 * are answered by a single request. Nodes selecting the same field need distinct aliases.
+	 */
+	static TArray<uint8> GetBatchQueryJsonUtf8(TConstArrayView<TSharedPtr<IQueryNode>> Nodes)
+	{
+		TUtf8StringBuilder<4096> QueryUtf8;
+		{
+			ASSETREGISTER_TRACE_PHASE(0, QueryBuild);
+			QueryUtf8 << "query {\n";
+			for (const TSharedPtr<IQueryNode>& Node : Nodes)
+			{
+				SerializeNode(Node, 0, QueryUtf8);
+			}
+			QueryUtf8 << "\n}";
+		}
+		return QueryStringUtil::MakeQueryJsonUtf8(QueryUtf8.ToView());
 	}
 
 	/**
@@ -93,7 +147,153 @@ public:
 		return OutJson;
 	}
 
+	/**
+	 * Returns the complete GraphQL query json body encoded as UTF-8, ready to be sent as the request content
+	 * without going through an intermediate TCHAR string.
+	 */
+	TArray<uint8> GetQueryJsonUtf8()
+	{
+		TUtf8StringBuilder<1024> QueryUtf8;
+		{
+			ASSETREGISTER_TRACE_PHASE(0, QueryBuild);
+			WriteQueryString(QueryUtf8);
+		}
+		return QueryStringUtil::MakeQueryJsonUtf8(QueryUtf8.ToView());
+	}
+
+	/** The GraphQL field or type name of this node. */
+	const FString& GetName() const
+	{
+		return Name;
+	}
+
+	bool IsUnion() const
+	{
+		return bIsUnion;
+	}
+
+	/** The name the field is returned under, empty to return it under its own name. */
+	const FString& GetAlias() const
+	{
+		return Alias;
+	}
+
+	/** Returns the field under another name, so the same field can be selected more than once in a query. */
+	void SetAlias(const FString& InAlias)
+	{
+		Alias = InAlias;
+	}
+
+	/** The selected child fields, by name. */
+	const TMap<FString, TSharedPtr<IQueryNode>>& GetChildren() const
+	{
+		return ChildrenMap;
+	}
+
+	/** Adds an untyped child node, replacing any child with the same name. */
+	void AddChild(const TSharedRef<IQueryNode>& Child)
+	{
+		ChildrenMap.Add(Child->Name, Child);
+	}
+
+	/** Whether this is an FQueryNode of the model its field holds, rather than an untyped node. */
+	virtual bool IsTyped() const
+	{
+		return false;
+	}
+
+	/** A node of the same type, name and kind as this one, without arguments or children. */
+	virtual TSharedRef<IQueryNode> MakeEmptyNode() const
+	{
+		return MakeShared<IQueryNode>(Name, bIsUnion);
+	}
+
+	/** Deep copies this node and its children, keeping the type of each. */
+	TSharedRef<IQueryNode> CloneNode() const
+	{
+		TSharedRef<IQueryNode> Clone = MakeEmptyNode();
+		CopySelection(*this, *Clone);
+		return Clone;
+	}
+
+	/**
+	 * Whether every field selected below Other is also selected below this node. Arguments aren't compared,
+	 * so this tells if a result fetched with this selection holds everything Other asks for.
+	 */
+	bool CoversSelection(const IQueryNode& Other) const
+	{
+		for (const auto& ChildPair : Other.ChildrenMap)
+		{
+			const TSharedPtr<IQueryNode>* Child = ChildrenMap.Find(ChildPair.Key);
+			if (!Child || !(*Child)->CoversSelection(*ChildPair.Value))
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	/** Adds the fields selected below Other to this node. */
+	void MergeSelection(const IQueryNode& Other)
+	{
+		for (const auto& ChildPair : Other.ChildrenMap)
+		{
+			if (const TSharedPtr<IQueryNode>* Child = ChildrenMap.Find(ChildPair.Key))
+			{
+				(*Child)->MergeSelection(*ChildPair.Value);
+			}
+			else
+			{
+				ChildrenMap.Add(ChildPair.Key, ChildPair.Value->CloneNode());
+			}
+		}
+	}
+
+	/**
+	 * Plans the part of this selection that Known doesn't answer: a node named like this one, holding the direct
+	 * children Known doesn't fully cover. A partially covered child is selected with the union of both selections,
+	 * so the field it fetches can replace the known one whole.
+	 *
+	 * @return Null if Known covers the whole selection.
+	 */
+	TSharedPtr<IQueryNode> GetMissingSelection(const IQueryNode& Known) const
+	{
+		TSharedPtr<IQueryNode> Missing;
+		for (const auto& ChildPair : ChildrenMap)
+		{
+			const TSharedPtr<IQueryNode>* KnownChild = Known.ChildrenMap.Find(ChildPair.Key);
+			if (KnownChild && (*KnownChild)->CoversSelection(*ChildPair.Value))
+			{
+				continue;
+			}
+
+			if (!Missing.IsValid())
+			{
+				Missing = MakeEmptyNode();
+			}
+
+			TSharedRef<IQueryNode> MissingChild = ChildPair.Value->CloneNode();
+			if (KnownChild)
+			{
+				MissingChild->MergeSelection(**KnownChild);
+			}
+			Missing->ChildrenMap.Add(ChildPair.Key, MissingChild);
+		}
+		return Missing;
+	}
+
 protected:
+	/** Copies the arguments, alias and children of From, deep copied, to To. */
+	static void CopySelection(const IQueryNode& From, IQueryNode& To)
+	{
+		To.Arguments = From.Arguments;
+		To.Alias = From.Alias;
+		for (const auto& ChildPair : From.ChildrenMap)
+		{
+			To.ChildrenMap.Add(ChildPair.Key, ChildPair.Value->CloneNode());
+		}
+	}
+
 	/** GraphQL argument strings (usually JSON-formatted). */
 	TArray<FString> Arguments;
 	
@@ -105,6 +305,9 @@ protected:
 
 	/** Whether this node represents a union type selection. */
 	bool bIsUnion = false;
+
+	/** The name the field is returned under, see SetAlias. */
+	FString Alias;
 };
 
 /**
@@ -120,6 +323,16 @@ public:
 	
 	FQueryNode(const FString& InName, bool bIsUnion = false) : IQueryNode(InName, bIsUnion) {}
 
+	virtual bool IsTyped() const override
+	{
+		return true;
+	}
+
+	virtual TSharedRef<IQueryNode> MakeEmptyNode() const override
+	{
+		return MakeShared<FQueryNode<TModel>>(Name, bIsUnion);
+	}
+
 	/** Returns the GraphQL name for the model type. */
 	FString GetModelString() const
 	{
@@ -211,13 +424,7 @@ public:
 	template<typename TParent, typename TField> requires std::is_same_v<TParent, TModel>
 	FQueryNode<TField>* OnMember(TField TParent::* FieldPtr)
 	{
-		FString FieldName = QueryStringUtil::GetQueryName<TParent>(FieldPtr);
-		if (!ChildrenMap.Contains(FieldName))
-		{
-			ChildrenMap.Add(FieldName, MakeShared<FQueryNode<TField>>(FieldName));
-		}
-		
-		return StaticCastSharedPtr<FQueryNode<TField>>(ChildrenMap[FieldName]).Get();
+		return FindOrAddTypedChild<TField>(QueryStringUtil::GetQueryName<TParent>(FieldPtr));
 	}
 
 	/**
@@ -232,13 +439,7 @@ public:
 	{
 		using Derived = std::remove_pointer_t<TDerived>;
 		
-		FString FieldName = QueryStringUtil::GetQueryName<Derived>(false);
-		if (!ChildrenMap.Contains(FieldName))
-		{
-			ChildrenMap.Add(FieldName, MakeShared<FQueryNode<Derived>>(FieldName, true));
-		}
-		
-		return StaticCastSharedPtr<FQueryNode<Derived>>(ChildrenMap[FieldName]).Get();
+		return FindOrAddTypedChild<Derived>(QueryStringUtil::GetQueryName<Derived>(false), true);
 	}
 
 	/**
@@ -251,13 +452,29 @@ public:
 	requires std::is_same_v<TParent, TModel>
 	FQueryNode<TElement>* OnArray(TArray<TElement> TParent::* ArrayPtr)
 	{
-		FString FieldName = QueryStringUtil::GetQueryName<TParent>(ArrayPtr);
-		if (!ChildrenMap.Contains(FieldName))
+		return FindOrAddTypedChild<TElement>(QueryStringUtil::GetQueryName<TParent>(ArrayPtr));
+	}
+
+private:
+	/**
+	 * The child node for FieldName, added if missing. A child merged in from an untyped selection, e.g. one read back
+	 * from the disk cache, is rebuilt as an FQueryNode<TChild> first so it can be cast to one.
+	 */
+	template<typename TChild>
+	FQueryNode<TChild>* FindOrAddTypedChild(const FString& FieldName, bool bChildIsUnion = false)
+	{
+		TSharedPtr<IQueryNode>& Child = ChildrenMap.FindOrAdd(FieldName);
+		if (!Child.IsValid() || !Child->IsTyped())
 		{
-			ChildrenMap.Add(FieldName, MakeShared<FQueryNode<TElement>>(FieldName));
+			TSharedRef<FQueryNode<TChild>> TypedChild = MakeShared<FQueryNode<TChild>>(FieldName, bChildIsUnion);
+			if (Child.IsValid())
+			{
+				CopySelection(*Child, *TypedChild);
+			}
+			Child = TypedChild;
 		}
 		
-		return StaticCastSharedPtr<FQueryNode<TElement>>(ChildrenMap[FieldName]).Get();
+		return StaticCastSharedPtr<FQueryNode<TChild>>(Child).Get();
 	}
 };
 
@@ -1,6 +1,7 @@
 #pragma once
 #include "JsonObjectConverter.h"
 #include "AssetRegisterLog.h"
+#include "AssetRegisterTrace.h"
 
 namespace QueryStringUtil
 {
@@ -189,47 +190,386 @@ namespace QueryStringUtil
 		return nullptr;
 	}
 
-	template<typename TModel>
-	bool TryGetModel(const FString& JsonString, TModel& OutStruct)
+	/**
+	 * Converts a UTF-8 byte buffer to an FString. Only used where a TCHAR string is actually required
+	 * (logging, the raw SendRequest result), the request/response pipeline itself stays in UTF-8.
+	 */
+	inline FString Utf8ToString(TConstArrayView<uint8> Utf8)
 	{
-		TSharedPtr<FJsonObject> RootObject;
-		TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(JsonString);
+		const FUTF8ToTCHAR Converted(reinterpret_cast<const ANSICHAR*>(Utf8.GetData()), Utf8.Num());
+		return FString(Converted.Length(), Converted.Get());
+	}
 
-		const FString ModelName = GetQueryName<TModel>();
+	/**
+	 * Appends Utf8 to OutJson as the contents of a JSON string literal, escaping quotes, backslashes and control characters.
+	 */
+	inline void AppendJsonEscapedUtf8(FUtf8StringView Utf8, TArray<uint8>& OutJson)
+	{
+		static const ANSICHAR* HexDigits = "0123456789abcdef";
+		
+		for (const UTF8CHAR Char : Utf8)
+		{
+			const uint8 Byte = static_cast<uint8>(Char);
+			switch (Byte)
+			{
+			case '"':  OutJson.Add('\\'); OutJson.Add('"'); break;
+			case '\\': OutJson.Add('\\'); OutJson.Add('\\'); break;
+			case '\n': OutJson.Add('\\'); OutJson.Add('n'); break;
+			case '\r': OutJson.Add('\\'); OutJson.Add('r'); break;
+			case '\t': OutJson.Add('\\'); OutJson.Add('t'); break;
+			default:
+				if (Byte < 0x20)
+				{
+					OutJson.Append(reinterpret_cast<const uint8*>("\\u00"), 4);
+					OutJson.Add(HexDigits[Byte >> 4]);
+					OutJson.Add(HexDigits[Byte & 0xF]);
+				}
+				else
+				{
+					OutJson.Add(Byte);
+				}
+			}
+		}
+	}
+
+	/**
+	 * Wraps a UTF-8 GraphQL query in the {"query": "..."} request body expected by the Asset Register.
+	 */
+	inline TArray<uint8> MakeQueryJsonUtf8(FUtf8StringView QueryUtf8)
+	{
+		ASSETREGISTER_TRACE_PHASE(0, Serialize);
+
+		static constexpr ANSICHAR Prefix[] = "{\"query\":\"";
+		static constexpr ANSICHAR Suffix[] = "\"}";
+		
+		TArray<uint8> OutJson;
+		OutJson.Reserve(QueryUtf8.Len() + QueryUtf8.Len() / 8 + UE_ARRAY_COUNT(Prefix) + UE_ARRAY_COUNT(Suffix));
+		OutJson.Append(reinterpret_cast<const uint8*>(Prefix), UE_ARRAY_COUNT(Prefix) - 1);
+		AppendJsonEscapedUtf8(QueryUtf8, OutJson);
+		OutJson.Append(reinterpret_cast<const uint8*>(Suffix), UE_ARRAY_COUNT(Suffix) - 1);
+		return OutJson;
+	}
+
+	/**
+	 * Parses a UTF-8 JSON buffer (e.g. IHttpResponse::GetContent()) without transcoding it to TCHAR first.
+	 *
+	 * @return The root object, or null if the buffer isn't a valid JSON object.
+	 */
+	inline TSharedPtr<FJsonObject> ParseJsonUtf8(TConstArrayView<uint8> Utf8Json)
+	{
+		TSharedPtr<FJsonObject> RootObject;
+		const FUtf8StringView JsonView(reinterpret_cast<const UTF8CHAR*>(Utf8Json.GetData()), Utf8Json.Num());
+		TSharedRef<TJsonReader<UTF8CHAR>> Reader = TJsonReaderFactory<UTF8CHAR>::CreateFromView(JsonView);
+		
 		if (!FJsonSerializer::Deserialize(Reader, RootObject) || !RootObject.IsValid())
 		{
-			UE_LOG(LogAssetRegister, Error, TEXT("Failed to deserialize string: %s."), *JsonString);
+			return nullptr;
+		}
+		return RootObject;
+	}
+
+	/**
+	 * Index just past the JSON value (object, array, string or literal) that starts at Start.
+	 *
+	 * @return INDEX_NONE if the value doesn't end within JsonView.
+	 */
+	inline int32 SkipJsonValueUtf8(FUtf8StringView JsonView, int32 Start)
+	{
+		int32 Depth = 0;
+		bool bInString = false;
+		for (int32 Index = Start; Index < JsonView.Len(); ++Index)
+		{
+			const UTF8CHAR Char = JsonView[Index];
+			if (bInString)
+			{
+				if (Char == '\\')
+				{
+					++Index;
+				}
+				else if (Char == '"')
+				{
+					bInString = false;
+					if (Depth == 0)
+					{
+						return Index + 1;
+					}
+				}
+				continue;
+			}
+
+			switch (Char)
+			{
+			case '"':
+				bInString = true;
+				break;
+			case '{':
+			case '[':
+				++Depth;
+				break;
+			case '}':
+			case ']':
+				// a literal ends at the bracket closing its parent
+				if (Depth == 0)
+				{
+					return Index;
+				}
+				if (--Depth == 0)
+				{
+					return Index + 1;
+				}
+				break;
+			case ',':
+				if (Depth == 0)
+				{
+					return Index;
+				}
+				break;
+			default:
+				break;
+			}
+		}
+		return INDEX_NONE;
+	}
+
+	/**
+	 * Reads endCursor and hasNextPage from the "pageInfo" object of a UTF-8 Assets response, without parsing the rest
+	 * of it. Lets the next page be requested while the edges are still being decoded.
+	 *
+	 * @param SearchFrom Where to look for pageInfo from, e.g. the end of the edges array found by TryFindEdgesUtf8.
+	 * By default the edges array is skipped first, so a "pageInfo" key in a node's metadata isn't taken for the page's.
+	 * @return Whether a pageInfo object was found.
+	 */
+	inline bool TryFindPageInfoUtf8(TConstArrayView<uint8> Utf8Json, FString& OutEndCursor, bool& bOutHasNextPage,
+		int32 SearchFrom = INDEX_NONE)
+	{
+		const FUtf8StringView JsonView(reinterpret_cast<const UTF8CHAR*>(Utf8Json.GetData()), Utf8Json.Num());
+		if (SearchFrom == INDEX_NONE)
+		{
+			SearchFrom = 0;
+			if (int32 EdgesIndex = JsonView.Find(UTF8TEXTVIEW("\"edges\"")); EdgesIndex != INDEX_NONE)
+			{
+				EdgesIndex += 7;
+				while (EdgesIndex < JsonView.Len() && (JsonView[EdgesIndex] == ':' || FChar::IsWhitespace(JsonView[EdgesIndex])))
+				{
+					++EdgesIndex;
+				}
+				SearchFrom = SkipJsonValueUtf8(JsonView, EdgesIndex);
+				if (SearchFrom == INDEX_NONE)
+				{
+					return false;
+				}
+			}
+		}
+
+		const int32 FoundIndex = JsonView.RightChop(SearchFrom).Find(UTF8TEXTVIEW("\"pageInfo\""));
+		const int32 KeyIndex = FoundIndex == INDEX_NONE ? INDEX_NONE : SearchFrom + FoundIndex;
+		if (KeyIndex == INDEX_NONE)
+		{
 			return false;
 		}
+
+		int32 Start = INDEX_NONE;
+		int32 End = INDEX_NONE;
+		bool bInString = false;
+		for (int32 Index = KeyIndex + 10; Index < JsonView.Len() && End == INDEX_NONE; ++Index)
+		{
+			const UTF8CHAR Char = JsonView[Index];
+			if (bInString)
+			{
+				if (Char == '\\')
+				{
+					++Index;
+				}
+				else if (Char == '"')
+				{
+					bInString = false;
+				}
+			}
+			else if (Char == '"')
+			{
+				bInString = true;
+			}
+			else if (Char == '{' && Start == INDEX_NONE)
+			{
+				Start = Index;
+			}
+			else if (Char == '}' && Start != INDEX_NONE)
+			{
+				// pageInfo only holds scalars
+				End = Index;
+			}
+			else if (Start == INDEX_NONE && Char != ':' && !FChar::IsWhitespace(Char))
+			{
+				return false;
+			}
+		}
+		if (End == INDEX_NONE)
+		{
+			return false;
+		}
+
+		TSharedPtr<FJsonObject> PageInfoObject;
+		TSharedRef<TJsonReader<UTF8CHAR>> Reader = TJsonReaderFactory<UTF8CHAR>::CreateFromView(JsonView.Mid(Start, End - Start + 1));
+		if (!FJsonSerializer::Deserialize(Reader, PageInfoObject) || !PageInfoObject.IsValid())
+		{
+			return false;
+		}
+
+		OutEndCursor.Reset();
+		bOutHasNextPage = false;
+		PageInfoObject->TryGetStringField(TEXT("endCursor"), OutEndCursor);
+		PageInfoObject->TryGetBoolField(TEXT("hasNextPage"), bOutHasNextPage);
+		return true;
+	}
+
+	/** An edge of a UTF-8 Assets response, with its node left undecoded. */
+	struct FEdgeUtf8
+	{
+		FString Cursor;
+		/** The raw bytes of the node object, a view into the response. */
+		TConstArrayView<uint8> Node;
+	};
+
+	/**
+	 * Splits the "edges" array of a UTF-8 Assets response into the cursor and the raw node bytes of each edge,
+	 * without parsing the nodes. Lets a node be compared with an earlier response before it is decoded.
+	 *
+	 * @param OutEndIndex If set, receives the index just past the edges array.
+	 * @return Whether a well-formed edges array was found.
+	 */
+	inline bool TryFindEdgesUtf8(TConstArrayView<uint8> Utf8Json, TArray<FEdgeUtf8>& OutEdges, int32* OutEndIndex = nullptr)
+	{
+		const FUtf8StringView JsonView(reinterpret_cast<const UTF8CHAR*>(Utf8Json.GetData()), Utf8Json.Num());
+		int32 Index = JsonView.Find(UTF8TEXTVIEW("\"edges\""));
+		if (Index == INDEX_NONE)
+		{
+			return false;
+		}
+
+		auto SkipSeparators = [&JsonView, &Index]()
+		{
+			while (Index < JsonView.Len() && (JsonView[Index] == ':' || JsonView[Index] == ',' || FChar::IsWhitespace(JsonView[Index])))
+			{
+				++Index;
+			}
+			return Index < JsonView.Len();
+		};
+
+		Index += 7;
+		if (!SkipSeparators() || JsonView[Index] != '[')
+		{
+			return false;
+		}
+		++Index;
+
+		OutEdges.Reset();
+		while (SkipSeparators())
+		{
+			if (JsonView[Index] == ']')
+			{
+				if (OutEndIndex)
+				{
+					*OutEndIndex = Index + 1;
+				}
+				return true;
+			}
+			if (JsonView[Index] != '{')
+			{
+				return false;
+			}
+			++Index;
+
+			FEdgeUtf8& Edge = OutEdges.AddDefaulted_GetRef();
+			while (SkipSeparators() && JsonView[Index] != '}')
+			{
+				const int32 KeyEnd = JsonView[Index] == '"' ? SkipJsonValueUtf8(JsonView, Index) : INDEX_NONE;
+				if (KeyEnd == INDEX_NONE)
+				{
+					return false;
+				}
+				const FUtf8StringView Key = JsonView.Mid(Index + 1, KeyEnd - Index - 2);
+
+				Index = KeyEnd;
+				if (!SkipSeparators())
+				{
+					return false;
+				}
+				const int32 ValueEnd = SkipJsonValueUtf8(JsonView, Index);
+				if (ValueEnd == INDEX_NONE)
+				{
+					return false;
+				}
+
+				const FUtf8StringView Value = JsonView.Mid(Index, ValueEnd - Index);
+				if (Key == UTF8TEXTVIEW("node"))
+				{
+					Edge.Node = MakeArrayView(Utf8Json.GetData() + Index, ValueEnd - Index);
+				}
+				else if (Key == UTF8TEXTVIEW("cursor") && Value.Len() >= 2 && Value[0] == '"')
+				{
+					Edge.Cursor = FString(Value.Mid(1, Value.Len() - 2));
+				}
+				Index = ValueEnd;
+			}
+			++Index;
+		}
+		return false;
+	}
+
+	template<typename TModel>
+	bool TryGetModel(const TSharedPtr<FJsonObject>& RootObject, TModel& OutStruct)
+	{
+		const FString ModelName = GetQueryName<TModel>();
 		const TSharedPtr<FJsonValue> TargetField = FindFieldRecursively(RootObject, ModelName);
-		if (!TargetField)
+		if (!TargetField || TargetField->Type != EJson::Object)
 		{
-			UE_LOG(LogAssetRegister, Error, TEXT("Failed to find field '%s' in Json string: %s"), *ModelName, *JsonString);
+			UE_LOG(LogAssetRegister, Error, TEXT("Failed to find field '%s' in Json object"), *ModelName);
 			return false;
 		}
 		
 		return FJsonObjectConverter::JsonObjectToUStruct<TModel>(TargetField->AsObject().ToSharedRef(), &OutStruct);
 	}
 
-	template<typename TStruct>
-	bool TryGetModelField(const FString& JsonString, const FString& TargetFieldName, TStruct& OutStruct)
+	template<typename TModel>
+	bool TryGetModel(const FString& JsonString, TModel& OutStruct)
 	{
 		TSharedPtr<FJsonObject> RootObject;
 		TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(JsonString);
-	
+
 		if (!FJsonSerializer::Deserialize(Reader, RootObject) || !RootObject.IsValid())
 		{
-			UE_LOG(LogAssetRegister, Error, TEXT("Failed to parse JSON string."));
+			UE_LOG(LogAssetRegister, Error, TEXT("Failed to deserialize string: %s."), *JsonString);
 			return false;
 		}
 		
+		return TryGetModel(RootObject, OutStruct);
+	}
+
+	template<typename TStruct>
+	bool TryGetModelField(const TSharedPtr<FJsonObject>& RootObject, const FString& TargetFieldName, TStruct& OutStruct)
+	{
 		const TSharedPtr<FJsonValue> TargetField = FindFieldRecursively(RootObject, TargetFieldName);
-		if (!TargetField)
+		if (!TargetField || TargetField->Type != EJson::Object)
 		{
-			UE_LOG(LogAssetRegister, Verbose, TEXT("Failed to find field '%s' in Json string: %s"), *TargetFieldName, *JsonString);
+			UE_LOG(LogAssetRegister, Verbose, TEXT("Failed to find field '%s' in Json object"), *TargetFieldName);
 			return false;
 		}
 
 		return FJsonObjectConverter::JsonObjectToUStruct<TStruct>(TargetField->AsObject().ToSharedRef(), &OutStruct);
 	}
+
+	template<typename TStruct>
+	bool TryGetModelField(const FString& JsonString, const FString& TargetFieldName, TStruct& OutStruct)
+	{
+		TSharedPtr<FJsonObject> RootObject;
+		TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(JsonString);
+	
+		if (!FJsonSerializer::Deserialize(Reader, RootObject) || !RootObject.IsValid())
+		{
+			UE_LOG(LogAssetRegister, Error, TEXT("Failed to parse JSON string."));
+			return false;
+		}
+		
+		return TryGetModelField(RootObject, TargetFieldName, OutStruct);
+	}
 };